@@ -9,6 +9,8 @@ try: range = xrange
 except: pass
 
 __all__ = ['blankCells', '_blankCells', 'blankCellsTetra', 'blankCellsTri', 'blankIntersectingCells', 'chimeraTransfer', 'connectMatch', 
+    'createBodyMask', 'deleteBodyMask', 'classifyPoints', 'getSignedDistance', 
+    'createXRayMask', 'deleteXRayMask', 'saveXRayMask', 'loadXRayMask', 
     'getIntersectingDomainsAABB', 'maximizeBlankedCells', 'optimizeOverlap', 'setDoublyDefinedBC', 'setHoleInterpolatedPoints', 
     'setIBCTransfers', 'setIBCTransfersD', 'setInterpTransfers', 'setInterpTransfersD', 'writeCoefs','maskXRay__',
     '_applyBCOverlapsStruct__', 'applyBCOverlapsStruct__', 'applyBCOverlapsNG__',
@@ -251,25 +253,65 @@ def _blankCells(coords, cellnfields, body, blankingType=1, \
                 XRaydim1=1000, XRaydim2=1000, cellNName='cellN'):
     """Blank cells in coords by a X-Ray mask defined by the body,
     within a distance delta. cellnfields is modified in place without copy.
+    body can also be a mask created by createXRayMask.
     Usage: blankCells(coords, cellnfields, body, blankingType, delta, dim, maskNot, tol)"""
     try: import Converter as C
     except: raise ImportError("blankCells: requires Converter module.")
-    # passe body en centres etendus si structure et pas node_in
+    # masque deja construit : delta et masknot sont ceux du masque
+    if isinstance(body, list): bodyt = prepareXRayBody__(body, blankingType)
+    else: bodyt = body
+    if blankingType == 2: # center_in: simplement un node_in sur les centres
+        coords = C.node2Center(coords); blankingType = 0 
+
+    return connector._blankCells(coords, cellnfields, bodyt, blankingType, \
+                                 delta, dim, masknot, tol, XRaydim1, XRaydim2, cellNName)
+
+#------------------------------------------------------------------------------
+# Corps du masque X-Ray en TRI/BAR
+# passe body en centres etendus si structure et pas node_in
+#------------------------------------------------------------------------------
+def prepareXRayBody__(body, blankingType):
+    import Converter as C
     if blankingType != 0:
         # verif que ts les body sont structures
         struct = 1
         for z in body:
             if len(z) != 5: struct = 0; break
         if struct == 1: body = C.node2ExtCenter(body)
-    bodyt = []
-    for z in body:
-        z = C.convertArray2Tetra(z)
-        bodyt.append(z)
-    if blankingType == 2: # center_in: simplement un node_in sur les centres
-        coords = C.node2Center(coords); blankingType = 0 
+    return [C.convertArray2Tetra(z) for z in body]
 
-    return connector._blankCells(coords, cellnfields, bodyt, blankingType, \
-                                 delta, dim, masknot, tol, XRaydim1, XRaydim2, cellNName)
+#==============================================================================
+# Masque X-Ray reutilisable : les points de percage du corps sont calcules
+# une fois et le masque sert a tous les appels de _blankCells sur ce corps.
+# Si fileName est donne, le masque est relu de ce fichier s'il a ete construit
+# avec les memes parametres et le meme corps (somme de controle), sinon il est
+# construit et sauvegarde dans ce fichier.
+#==============================================================================
+def createXRayMask(body, blankingType=1, delta=1.e-10, dim=3, masknot=0,
+                   tol=1.e-8, XRaydim1=1000, XRaydim2=1000, fileName=None):
+    """Create a reusable X-Ray mask defined by body.
+    Usage: createXRayMask(body, blankingType, delta, dim, masknot, tol, XRaydim1, XRaydim2, fileName)"""
+    bodyt = prepareXRayBody__(body, blankingType)
+    if fileName is None: fileName = ''
+    return connector.createXRayMask(bodyt, delta, dim, masknot, tol,
+                                    XRaydim1, XRaydim2, fileName)
+
+def deleteXRayMask(mask):
+    """Delete a X-Ray mask.
+    Usage: deleteXRayMask(mask)"""
+    connector.deleteXRayMask(mask)
+    return None
+
+def saveXRayMask(mask, fileName):
+    """Save a X-Ray mask to a binary file.
+    Usage: saveXRayMask(mask, fileName)"""
+    connector.saveXRayMask(mask, fileName)
+    return None
+
+def loadXRayMask(fileName):
+    """Load a X-Ray mask saved by saveXRayMask.
+    Usage: loadXRayMask(fileName)"""
+    return connector.loadXRayMask(fileName)
 #==============================================================================
 # blankIntersectingCells
 # IN: a: 3D structured mesh with wall orthogonal to k direction
@@ -326,18 +368,17 @@ def blankCellsTetra(coords, cellnfields, meshT4, blankingType=1, tol = 1.e-12, c
 # OUT: returns the cellnfields, 0 for cells intersecting or inside the tet mesh
 #==============================================================================
 def blankCellsTri(coords, cellnfields, meshT3, blankingType=1, tol=1.e-12, 
-                  cellnval=0, overwrite=0, cellNName='cellN'):
+                  cellnval=0, overwrite=0, cellNName='cellN', mask=None):
     """Blank cells in coords (by setting the cellN to cellnval) falling inside a Triangular surface mesh mask defined by meshT3.
     If overwrite is enabled (1), cells detected outside have a celln reset to 1.
+    If mask (createBodyMask) is given, it is used instead of meshT3 and is not deleted.
     Usage: blankCellsTri(coords, cellnfields, meshT3, connectT4, blankingType, tol, cellnval, overwrite)"""
-    try: import Converter as C; import Transform as T
+    try: import Converter as C
     except: raise ImportError("blankCellsTetra: requires Converter module.")
     
     cellnt = []
-    meshT3 = T.reorderAll(meshT3, 1) # orient outward
-    meshT3 = T.join(meshT3)
-    
-    mask = connector.createTriMask(meshT3, tol)
+    if mask is None: hook = createBodyMask(meshT3, tol)
+    else: hook = mask
     
     for i in range(len(coords)):
       #print('coords : %d / %d' %(i+1, len(coords)))
@@ -345,10 +386,40 @@ def blankCellsTri(coords, cellnfields, meshT3, blankingType=1, tol=1.e-12,
       if blankingType == 2: # center_in: simplement un node_in sur les centres
         coords[i] = C.node2Center(coords[i])
         bt = 0
-      cellnt.append(connector.blankCellsTetra(coords[i], cellnfields[i], mask, bt, cellnval, overwrite, cellNName))
-    connector.deleteTriMask(mask)
+      cellnt.append(connector.blankCellsTetra(coords[i], cellnfields[i], hook, bt, cellnval, overwrite, cellNName))
+    if mask is None: connector.deleteTriMask(hook)
     return cellnt
 
+#===============================================================================
+# Masque reutilisable sur un corps ferme (surface TRI) : arbre de boites
+# des triangles + lancer de rayons. Construit une fois, il sert a tous les
+# appels de blanking/classification sur ce corps.
+#===============================================================================
+def createBodyMask(meshT3, tol=1.e-12):
+    """Create a reusable inside/outside classifier of a closed triangular surface.
+    Usage: createBodyMask(meshT3, tol)"""
+    try: import Transform as T
+    except: raise ImportError("createBodyMask: requires Transform module.")
+    meshT3 = T.reorderAll(meshT3, 1) # orient outward
+    meshT3 = T.join(meshT3)
+    return connector.createTriMask(meshT3, tol)
+
+def deleteBodyMask(mask):
+    """Delete a body mask.
+    Usage: deleteBodyMask(mask)"""
+    connector.deleteTriMask(mask)
+    return None
+
+def classifyPoints(mask, a):
+    """Return a numpy with 1 for the points of a inside the body mask, 0 outside.
+    Usage: classifyPoints(mask, a)"""
+    return connector.classifyPointsTri(mask, a)
+
+def getSignedDistance(mask, a):
+    """Return a numpy with the signed distance of the points of a to the body mask (negative inside).
+    Usage: getSignedDistance(mask, a)"""
+    return connector.getSignedDistanceTri(mask, a)
+
 def getIntersectingDomainsAABB(arrays, tol=1.e-10):
     """Return the intersection list of a list of bounding boxes."""
     return connector.getIntersectingDomainsAABB(arrays, tol)
@@ -1,11 +1,10 @@
 ax = aa_vec[noind]*utau_vec[noind];
 px = gradP_vec[noind]/pow(utau_vec[noind],3);
 
-l11 = pow(ax+10.6,9.6);
 l12 = ax*(ax-8.15) + 86.;
 l13 = (2.*ax-8.15)/16.7;
 
-l1 = 5.424*atan(l13) + log10(l11/(l12*l12)) - 3.52; //MUSKER
+l1 = 5.424*atan(l13) + 9.6*log10(ax+10.6) - 2.*log10(l12) - 3.52; //MUSKER (sans pow, cf. musker_vec.h)
 l2 = 0.;
 l3 = 0.;
 
@@ -1,12 +1,11 @@
 ax = aa_vec[noind]*utau_vec[noind];
 px = gradP_vec[noind]/pow(utau_vec[noind],3.);
 
-l11 = pow(ax+10.6,9.6);
 l12 = ax*(ax-8.15) + 86.;
 l13 = (2.*ax-8.15)/16.7;
-tp =  aa_vec[noind]*( 9.6*pow((ax + 10.6),8.6)  - l11/l12*(  4.*aa_vec[noind]*utau_vec[noind] - 16.30 ) );
+tp =  aa_vec[noind]*( 9.6/(ax + 10.6)  - (  4.*aa_vec[noind]*utau_vec[noind] - 16.30 )/l12 );
 
-l1 = 0.649580838323*aa_vec[noind]/(1. + l13*l13 )  +  tp/(l11*2.302585093); //MUSKER
+l1 = 0.649580838323*aa_vec[noind]/(1. + l13*l13 )  +  tp/2.302585093; //MUSKER (sans pow, cf. muskerprime_vec.h)
 l2 = 0.;
 l3 = 0.;
 
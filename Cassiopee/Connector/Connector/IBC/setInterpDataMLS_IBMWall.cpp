@@ -34,6 +34,7 @@ using namespace std;
 // ============================================================================
 PyObject* K_CONNECTOR::setInterpData_IBMWall(PyObject* self, PyObject* args)
 {
+  K_PROFILE("setInterpData_IBMWall");
   E_Int dimPb, order;
   PyObject *arrayR, *arraysD;
   if (!PYPARSETUPLE_(args, OO_ II_,
@@ -0,0 +1,86 @@
+/*
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+# include "connector.h"
+# include <algorithm>
+using namespace std;
+
+// Nombre de bits par direction pour les cases (2^10 cases par direction)
+#define IBMBINS_NBITS 10
+
+//=============================================================================
+// Cle de Morton de la case (entrelacement des bits de (i,j,k))
+//=============================================================================
+static inline unsigned long long binKey(unsigned int X[3])
+{
+  unsigned long long key = 0;
+  for (E_Int j = IBMBINS_NBITS-1; j >= 0; j--)
+    for (E_Int i = 0; i < 3; i++) key = (key << 1) | ((X[i] >> j) & 1);
+  return key;
+}
+
+//=============================================================================
+// Ordre de parcours des points IBM : les points sont ranges dans une grille
+// cartesienne de cases couvrant leur boite englobante, les cases etant
+// parcourues suivant la courbe de Morton. Des points consecutifs dans order
+// sont donc proches et interrogent les memes branches des arbres de
+// projection : un paquet de points consecutifs traite par un thread reste
+// local en memoire.
+// IN: x, y, z: coordonnees des npts points
+// OUT: order: indices des points dans l'ordre de parcours (taille npts)
+//=============================================================================
+void K_CONNECTOR::sortIBMPtsByBins(E_Int npts, E_Float* x, E_Float* y,
+                                   E_Float* z, E_Int* order)
+{
+  E_Float xmin = K_CONST::E_MAX_FLOAT, ymin = K_CONST::E_MAX_FLOAT;
+  E_Float zmin = K_CONST::E_MAX_FLOAT;
+  E_Float xmax = -K_CONST::E_MAX_FLOAT, ymax = -K_CONST::E_MAX_FLOAT;
+  E_Float zmax = -K_CONST::E_MAX_FLOAT;
+
+  #pragma omp parallel for reduction(min:xmin,ymin,zmin) reduction(max:xmax,ymax,zmax)
+  for (E_Int i = 0; i < npts; i++)
+  {
+    xmin = K_FUNC::E_min(xmin, x[i]); xmax = K_FUNC::E_max(xmax, x[i]);
+    ymin = K_FUNC::E_min(ymin, y[i]); ymax = K_FUNC::E_max(ymax, y[i]);
+    zmin = K_FUNC::E_min(zmin, z[i]); zmax = K_FUNC::E_max(zmax, z[i]);
+  }
+
+  // cases cubiques : meme pas dans les trois directions
+  E_Float dmax = K_FUNC::E_max(xmax-xmin, K_FUNC::E_max(ymax-ymin, zmax-zmin));
+  E_Float scale = (dmax > 0.) ? ((1 << IBMBINS_NBITS)-1)/dmax : 0.;
+
+  vector< pair<unsigned long long, E_Int> > keys(npts);
+
+  #pragma omp parallel for
+  for (E_Int i = 0; i < npts; i++)
+  {
+    unsigned int X[3];
+    X[0] = (unsigned int)((x[i]-xmin)*scale);
+    X[1] = (unsigned int)((y[i]-ymin)*scale);
+    X[2] = (unsigned int)((z[i]-zmin)*scale);
+    keys[i].first = binKey(X);
+    keys[i].second = i;
+  }
+
+  // a cle egale, l'ordre initial est conserve
+  sort(keys.begin(), keys.end());
+
+  #pragma omp parallel for
+  for (E_Int i = 0; i < npts; i++) order[i] = keys[i].second;
+}
@@ -19,6 +19,7 @@ import Dist2Walls.PyTree as DTW
 import Distributor2.PyTree as D2
 import Post.PyTree as P
 import KCore.test as test
+import KCore.Profiler as Profiler
 import Converter
 import Generator
 import Transform
@@ -68,13 +69,18 @@ def getIBCDName(proposedName):
 #+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 ## MACRO FUNCTIONS
 #+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-def printTimeAndMemory__(message, time=-1):
-    Cmpi.barrier()
-    test.printMem("Info: prepareIBMDataPara: %s [%s]"%(message, 'end' if time > 0 else 'start'))
-    Cmpi.barrier()
-    if time > 0 and Cmpi.rank == 0: print("Info: prepareIBMDataPara: %s running time = %4.4fs"%(message, time))
-    Cmpi.barrier()
-
+# Ouvre (time < 0) ou ferme une phase du profileur. Pas de barriere : la
+# memoire de chaque rang est dans sa trace, le rang 0 ecrit la sienne et le
+# temps de la phase.
+def printTimeAndMemory__(message, time=-1, verbose=True):
+    if time < 0:
+        Profiler.begin("prepareIBMDataPara: %s"%message, memory=True)
+        return None
+    Profiler.end()
+    if verbose and Cmpi.rank == 0:
+        mem = Profiler.getMemory()
+        print("Info: prepareIBMDataPara: %s [end] heap = %4.1f MB, peak RSS = %4.1f MB"%(message, mem['heap']/1000., mem['peakRss']/1000.))
+        print("Info: prepareIBMDataPara: %s running time = %4.4fs"%(message, time))
     return None
 
 def computeMeshInfo__(z, dim):
@@ -141,11 +147,15 @@ def prepareIBMDataPara(t_case, t_out, tc_out, t_in=None, to=None, tbox=None, tin
                     snears=0.01, snearsf=None, dfar=10., dfarDir=0, dfarList=[], vmin=21, depth=2, frontType=1, mode=0,
                     IBCType=1, verbose=True,
                     check=False, balancing=False, distribute=False, twoFronts=False, cartesian=False,
-                    yplus=100., Lref=1., correctionMultiCorpsF42=False, blankingF42=False, wallAdaptF42=None, heightMaxF42=-1.):
+                    yplus=100., Lref=1., correctionMultiCorpsF42=False, blankingF42=False, wallAdaptF42=None, heightMaxF42=-1.,
+                    profile=None):
     
     import Generator.IBM as G_IBM
     import time as python_time
 
+    # profile: nom de la trace des phases (profile_<rang>.json par rang, profile.json fusionne)
+    if profile is not None: Profiler.enable(rank=Cmpi.rank)
+
     if isinstance(t_case, str): tb = C.convertFile2PyTree(t_case)
     else: tb = Internal.copyTree(t_case)
 
@@ -181,15 +191,14 @@ def prepareIBMDataPara(t_case, t_out, tc_out, t_in=None, to=None, tbox=None, tin
     # STEP 1 : GENERATE MESH
     #===================
     if t_in is None:
-        if verbose: pt0 = python_time.time(); printTimeAndMemory__('generate Cartesian mesh', time=-1)
-        test.printMem("Info: prepareIBMDataPara: generate Cartesian mesh [start]")
+        pt0 = python_time.time(); printTimeAndMemory__('generate Cartesian mesh', time=-1, verbose=verbose)
         t = G_IBM.generateIBMMeshPara(tb, vmin=vmin, snears=snears, dimPb=dimPb, dfar=dfar, dfarList=dfarList, tbox=tbox,
                     snearsf=snearsf, check=check, to=to, ext=depth+1,
                     expand=expand, dfarDir=dfarDir, check_snear=False, mode=mode)
         Internal._rmNodesFromName(tb,"SYM")
 
         if balancing and Cmpi.size > 1: _redispatch__(t=t)
-        if verbose: printTimeAndMemory__('generate Cartesian mesh', time=python_time.time()-pt0)
+        printTimeAndMemory__('generate Cartesian mesh', time=python_time.time()-pt0, verbose=verbose)
         
     else: 
         t = t_in
@@ -201,55 +210,55 @@ def prepareIBMDataPara(t_case, t_out, tc_out, t_in=None, to=None, tbox=None, tin
     #===================
     # STEP 2 : DIST2WALL
     #=================== 
-    if verbose: pt0 = python_time.time(); printTimeAndMemory__('compute wall distance', time=-1)
+    pt0 = python_time.time(); printTimeAndMemory__('compute wall distance', time=-1, verbose=verbose)
     _dist2wallIBM(t, tb, dimPb=dimPb, frontType=frontType, Reynolds=Reynolds, yplus=yplus, Lref=Lref,
                 correctionMultiCorpsF42=correctionMultiCorpsF42, heightMaxF42=heightMaxF42)
-    if verbose: printTimeAndMemory__('compute wall distance', time=python_time.time()-pt0)
+    printTimeAndMemory__('compute wall distance', time=python_time.time()-pt0, verbose=verbose)
 
     #===================
     # STEP 3 : BLANKING IBM
     #===================
-    if verbose: pt0 = python_time.time(); printTimeAndMemory__('blank by IBC bodies', time=-1)
+    pt0 = python_time.time(); printTimeAndMemory__('blank by IBC bodies', time=-1, verbose=verbose)
     _blankingIBM(t, tb, dimPb=dimPb, frontType=frontType, IBCType=IBCType, depth=depth, 
                 Reynolds=Reynolds, yplus=yplus, Lref=Lref, twoFronts=twoFronts, 
                 heightMaxF42=heightMaxF42, correctionMultiCorpsF42=correctionMultiCorpsF42, 
                 wallAdaptF42=wallAdaptF42, blankingF42=blankingF42)
     Cmpi.barrier()
     _redispatch__(t=t)
-    if verbose: printTimeAndMemory__('blank by IBC bodies', time=python_time.time()-pt0)
+    printTimeAndMemory__('blank by IBC bodies', time=python_time.time()-pt0, verbose=verbose)
 
     #===================
     # STEP 4 : INTERP DATA CHIM
     #===================
-    if verbose: pt0 = python_time.time(); printTimeAndMemory__('compute interpolation data (Abutting & Chimera)', time=-1)
+    pt0 = python_time.time(); printTimeAndMemory__('compute interpolation data (Abutting & Chimera)', time=-1, verbose=verbose)
     tc = C.node2Center(t)
 
     if Internal.getNodeFromType(t, "GridConnectivity1to1_t") is not None:
         Xmpi._setInterpData(t, tc, nature=1, loc='centers', storage='inverse', sameName=1, dim=dimPb, itype='abutting', order=2, cartesian=cartesian)
     Xmpi._setInterpData(t, tc, nature=1, loc='centers', storage='inverse', sameName=1, sameBase=1, dim=dimPb, itype='chimera', order=2, cartesian=cartesian)
-    if verbose: printTimeAndMemory__('compute interpolation data (Abutting & Chimera)', time=python_time.time()-pt0)
+    printTimeAndMemory__('compute interpolation data (Abutting & Chimera)', time=python_time.time()-pt0, verbose=verbose)
 
     #===================
     # STEP 4 : BUILD FRONT
     #===================
-    if verbose: pt0 = python_time.time(); printTimeAndMemory__('build IBM front', time=-1)
+    pt0 = python_time.time(); printTimeAndMemory__('build IBM front', time=-1, verbose=verbose)
     t, tc, front, front2 = buildFrontIBM(t, tc, dimPb=dimPb, frontType=frontType, 
                                         cartesian=cartesian, twoFronts=twoFronts, check=check)
-    if verbose: printTimeAndMemory__('build IBM front', time=python_time.time()-pt0)
+    printTimeAndMemory__('build IBM front', time=python_time.time()-pt0, verbose=verbose)
 
     #===================
     # STEP 5 : INTERP DATA IBM
     #===================
-    if verbose: pt0 = python_time.time(); printTimeAndMemory__('compute interpolation data (IBM)', time=-1)
+    pt0 = python_time.time(); printTimeAndMemory__('compute interpolation data (IBM)', time=-1, verbose=verbose)
     _setInterpDataIBM(t, tc, tb, front, front2=front2, dimPb=dimPb, frontType=frontType, IBCType=IBCType, depth=depth, 
                     Reynolds=Reynolds, yplus=yplus, Lref=Lref, 
                     cartesian=cartesian, twoFronts=twoFronts, check=check)
-    if verbose: printTimeAndMemory__('compute interpolation data (IBM)', time=python_time.time()-pt0)
+    printTimeAndMemory__('compute interpolation data (IBM)', time=python_time.time()-pt0, verbose=verbose)
 
     #===================
     # STEP 6 : INIT IBM
     #===================
-    if verbose: pt0 = python_time.time(); printTimeAndMemory__('initialize and clean', time=-1)
+    pt0 = python_time.time(); printTimeAndMemory__('initialize and clean', time=-1, verbose=verbose)
     t, tc, tc2 = initializeIBM(t, tc, tb, tinit=tinit, dimPb=dimPb, twoFronts=twoFronts)
 
     if distribute and Cmpi.size > 1: _redispatch__(t=t, tc=tc, tc2=tc2, twoFronts=twoFronts)
@@ -269,8 +278,14 @@ def prepareIBMDataPara(t_case, t_out, tc_out, t_in=None, to=None, tbox=None, tin
 
     _computeMeshInfo(t)
 
+    printTimeAndMemory__('initialize and clean', time=python_time.time()-pt0, verbose=verbose)
+
+    if profile is not None: Profiler.dump(profile+'_%d.json')
     if Cmpi.size > 1: Cmpi.barrier()
-    if verbose: printTimeAndMemory__('initialize and clean', time=python_time.time()-pt0)
+    if profile is not None:
+        if Cmpi.rank == 0: Profiler.merge([profile+'_%d.json'%i for i in range(Cmpi.size)], profile+'.json')
+        if verbose: Profiler.printSummary()
+        Profiler.enable(False)
 
     if tc2 is not None: return t, tc, tc2
     else: return t, tc
@@ -1198,14 +1213,38 @@ def _removeBlankedGrids(t, loc='centers'):
 # IN: loc: "centers" or "nodes"
 # IN: dim: 2 or 3
 #==============================================================================
-def blankByIBCBodies(t, tb, loc, dim, cellNName='cellN'):
+def blankByIBCBodies(t, tb, loc, dim, cellNName='cellN', masks=None):
     """Blank by immersed bodies."""
     tp = Internal.copyRef(t)
-    _blankByIBCBodies(tp, tb, loc, dim, cellNName=cellNName)
+    _blankByIBCBodies(tp, tb, loc, dim, cellNName=cellNName, masks=masks)
 
     return tp
 
-def _blankByIBCBodies(t, tb, loc, dim, cellNName='cellN'):
+#=============================================================================
+# Masques reutilisables des corps IBC (un par base de tb, algo 'tri' en 3D)
+# Construits une fois, ils evitent de reconstruire l'arbre de recherche des
+# triangles a chaque appel de _blankByIBCBodies. A detruire avec
+# deleteIBCBodyMasks.
+# OUT: [[zones du corps, inv, mask]]
+#=============================================================================
+def createIBCBodyMasks(tb):
+    """Create the reusable masks of immersed bodies."""
+    masks = []
+    for b in Internal.getBases(tb):
+        body = Internal.getNodesFromType1(b, 'Zone_t')
+        if body == []: continue
+        inv = Internal.getNodeFromName(body,'inv')
+        if inv is not None: inv = Internal.getValue(inv)
+        else: inv = 0
+        masks.append([body, inv, X.createBodyMask(body)])
+    return masks
+
+def deleteIBCBodyMasks(masks):
+    """Delete the masks of immersed bodies."""
+    for m in masks: X.deleteBodyMask(m[2])
+    return None
+
+def _blankByIBCBodies(t, tb, loc, dim, cellNName='cellN', masks=None):
     """Blank by immersed bodies."""
     DIM = dim
     blankalgo='tri'
@@ -1279,6 +1318,16 @@ def _blankByIBCBodies(t, tb, loc, dim, cellNName='cellN'):
             X._blankCells(t, bodies, BM, blankingType=typeb, delta=TOLDIST, XRaydim1=XRAYDIM1, XRaydim2=XRAYDIM2, dim=DIM, cellNName=cellNName)
     else:
         BM2 = numpy.ones((nbases,1),dtype=Internal.E_NpyInt)
+        if masks is not None: # masques deja construits (createIBCBodyMasks)
+            for body, inv, mask in masks:
+                if inv != 1: continue
+                print('Info: blankByIBCBodies: reverse blanking for body.')
+                X._blankCellsTri(t, [body], BM2, blankingType=typeb, cellNName=cellNName, mask=mask)
+                C._initVars(t,'{centers:%s}=1-{centers:%s}'%(cellNName,cellNName)) # ecoulement interne
+            for body, inv, mask in masks:
+                if inv == 1: continue
+                X._blankCellsTri(t, [body], BM2, blankingType=typeb, cellNName=cellNName, mask=mask)
+            return None
         for body in bodiesInv:
             print('Info: blankByIBCBodies: reverse blanking for body.')
             X._blankCellsTri(t, [body], BM2, blankingType=typeb, cellNName=cellNName)
@@ -1003,7 +1003,8 @@ def blankCells(t, bodies, blankingMatrix=[], depth=2,
 
 def _blankCells(a, bodies, blankingMatrix=[], depth=2,
                 blankingType='cell_intersect', delta=1.e-10, dim=3,
-                tol=1.e-8, XRaydim1=1000, XRaydim2=1000, cellNName='cellN'):
+                tol=1.e-8, XRaydim1=1000, XRaydim2=1000, cellNName='cellN',
+                masks=None):
     try: import Transform as T
     except: raise ImportError("_blankCells: requires Transform module.")
     if depth != 1 and depth != 2:
@@ -1043,6 +1044,9 @@ def _blankCells(a, bodies, blankingMatrix=[], depth=2,
     if bases == []: raise ValueError("_blankCells: no CGNS base found in input tree.")
 
     if isinstance(blankingMatrix, list) and blankingMatrix == []: blankingMatrix = numpy.ones((len(bases), len(bodies)), dtype=Internal.E_NpyInt)
+    # masques X-Ray construits une seule fois par corps (et masknot),
+    # reutilises pour toutes les bases
+    built = {}
     for b in bases:
         coords = C.getFields(Internal.__GridCoordinates__, b, api=2) # api=1 a cause de node2Center en center_in dans le Connector.py
         if coords != []:
@@ -1051,22 +1055,33 @@ def _blankCells(a, bodies, blankingMatrix=[], depth=2,
             for nb2 in range(len(bodies)):
                 blanking = blankingMatrix[nb, nb2]
                 if bodies[nb2] != [] and (blanking == 1 or blanking == -1):
-                    bc = []
-                    for z in bodies[nb2]:
-                        c = C.getFields(Internal.__GridCoordinates__, z)
-                        if c != []:
-                            c = c[0]
-                            if len(c) == 5: # structure
-                                # pour le 2D
-                                if c[2] == 2: c = T.reorder(c, (-3,1,2))
-                                elif c[3] == 2: c = T.reorder(c, (1,-3,2))
-                            bc.append(c)
                     masknot = 0
                     if blanking == -1: masknot = 1
-                    Connector._blankCells(coords, cellN, bc, blankingType=blankType, \
+                    if masks is not None: mask = masks[nb2]
+                    elif (nb2, masknot) in built: mask = built[(nb2, masknot)]
+                    else:
+                        bc = []
+                        for z in bodies[nb2]:
+                            c = C.getFields(Internal.__GridCoordinates__, z)
+                            if c != []:
+                                c = c[0]
+                                if len(c) == 5: # structure
+                                    # pour le 2D
+                                    if c[2] == 2: c = T.reorder(c, (-3,1,2))
+                                    elif c[3] == 2: c = T.reorder(c, (1,-3,2))
+                                bc.append(c)
+                        try:
+                            mask = Connector.createXRayMask(bc, blankingType=blankType, \
+                                                            delta=delta, dim=dim, masknot=masknot, tol=tol, \
+                                                            XRaydim1=XRaydim1, XRaydim2=XRaydim2)
+                        except (TypeError, ValueError): mask = bc # corps vide ou facettes ambigues : ancien chemin
+                        built[(nb2, masknot)] = mask
+                    Connector._blankCells(coords, cellN, mask, blankingType=blankType, \
                                           delta=delta, dim=dim, masknot=masknot, tol=tol,\
                                           XRaydim1=XRaydim1, XRaydim2=XRaydim2, cellNName=cellNName)
         nb += 1
+    for mask in built.values():
+        if not isinstance(mask, list): Connector.deleteXRayMask(mask)
     return None
 
 #==============================================================================
@@ -1186,7 +1201,7 @@ def blankCellsTri(t, mT3, blankingMatrix=[], blankingType='node_in',
     return a
 
 def _blankCellsTri(a, mT3, blankingMatrix=[], blankingType='node_in',
-                    tol=1.e-12, cellnval=0, overwrite=0, cellNName='cellN'):
+                    tol=1.e-12, cellnval=0, overwrite=0, cellNName='cellN', mask=None):
     try: import Transform as T
     except: raise ImportError("blankCellsTri: requires Transform module.")
 
@@ -1231,13 +1246,44 @@ def _blankCellsTri(a, mT3, blankingMatrix=[], blankingType='node_in',
         if bc == []:
             #print('Warning: nothing to mask for base %d'%(nb))
             continue
-        bc = Converter.convertArray2Tetra(bc); bc = T.join(bc)
+        # mask deja construit sur les corps (createBodyMask) : reutilise tel quel
+        if mask is None: bc = Converter.convertArray2Tetra(bc); bc = T.join(bc)
         cellN = Connector.blankCellsTri(coords, cellN, bc, blankingType=blankType, tol=tol, \
-                                        cellnval=cellnval, overwrite=overwrite, cellNName=cellNName)
+                                        cellnval=cellnval, overwrite=overwrite, cellNName=cellNName, mask=mask)
         bc = None; coords = None
         C.setFields(cellN, b, loc, False)
     return None
 
+#==============================================================================
+# Masque reutilisable (classification interieur/exterieur) sur les zones
+# surfaciques fermees de tb. A detruire avec deleteBodyMask.
+#==============================================================================
+def createBodyMask(tb, tol=1.e-12):
+    """Create a reusable inside/outside classifier of closed surface zones.
+    Usage: createBodyMask(tb, tol)"""
+    try: import Transform as T
+    except: raise ImportError("createBodyMask: requires Transform module.")
+    bc = C.getFields(Internal.__GridCoordinates__, Internal.getZones(tb))
+    bc = [c for c in bc if c != []]
+    if bc == []: raise ValueError("createBodyMask: no body found.")
+    bc = Converter.convertArray2Tetra(bc); bc = T.join(bc)
+    return Connector.createBodyMask(bc, tol)
+
+def deleteBodyMask(mask):
+    """Delete a body mask.
+    Usage: deleteBodyMask(mask)"""
+    return Connector.deleteBodyMask(mask)
+
+def classifyPoints(mask, z):
+    """Return a numpy with 1 for the nodes of z inside the body mask, 0 outside.
+    Usage: classifyPoints(mask, z)"""
+    return Connector.classifyPoints(mask, C.getFields(Internal.__GridCoordinates__, z)[0])
+
+def getSignedDistance(mask, z):
+    """Return a numpy with the signed distance of the nodes of z to the body mask.
+    Usage: getSignedDistance(mask, z)"""
+    return Connector.getSignedDistance(mask, C.getFields(Internal.__GridCoordinates__, z)[0])
+
 # cellN modifications
 def _modCellN1(t, cellNName='cellN'):
     return C.__TZA2(t, 'centers', Connector._modCellN1, cellNName)
@@ -382,10 +382,13 @@ extern "C"
 
 //============================================================================
 /* Blank cells defined in arrays by a X-Ray mask
-    version in place / getFromArray2 */
+    version in place / getFromArray2
+    Le 3eme argument est soit la liste des corps, soit un masque deja
+    construit (createXRayMask) */
 //============================================================================
 PyObject* K_CONNECTOR::_blankCells(PyObject* self, PyObject* args)
 {
+  K_PROFILE("_blankCells");
   PyObject *coordArrays, *cellNArrays, *bodyArrays;
   E_Float delta; E_Float tol;
   E_Int isNot;
@@ -409,11 +412,12 @@ PyObject* K_CONNECTOR::_blankCells(PyObject* self, PyObject* args)
                     "_blankCells: second argument must be a list.");
     return NULL;
   }
+  XRayMask* mask = NULL;
   if (PyList_Check(bodyArrays) == 0)
   {
-    PyErr_SetString(PyExc_TypeError,
-                    "_blankCells: third argument must be a list.");
-    return NULL;
+    mask = getXRayMask(bodyArrays, "_blankCells");
+    if (mask == NULL) return NULL;
+    isNot = mask->isNot; delta = mask->delta;
   }
 
   if (delta < 0.)
@@ -540,7 +544,8 @@ PyObject* K_CONNECTOR::_blankCells(PyObject* self, PyObject* args)
 
   // Extract infos from body arrays: non structures
   /* Extraction de la surface de masquage */
-  E_Int nzonesB = PyList_Size(bodyArrays);
+  E_Int nzonesB = 0;
+  if (mask == NULL) nzonesB = PyList_Size(bodyArrays);
   E_Int elevationDir = 3;
 
   vector<PyObject*> vectOfObjs3;
@@ -631,9 +636,13 @@ PyObject* K_CONNECTOR::_blankCells(PyObject* self, PyObject* args)
     vectOfCellNI.push_back(cellnI);
   }
 
-  blankCellsStruct(elevationDir, isNot, blankingType, delta, tol, dim1, dim2,
-                   posxt, posyt, poszt, nit, njt, nkt, vectOfCoords,
-                   vectOfCellNI, posxb, posyb, poszb, vectOfBodies, vectOfConnect3);
+  if (mask != NULL)
+    blankCellsStructXRay(*mask, blankingType, posxt, posyt, poszt,
+                         nit, njt, nkt, vectOfCoords, vectOfCellNI);
+  else
+    blankCellsStruct(elevationDir, isNot, blankingType, delta, tol, dim1, dim2,
+                     posxt, posyt, poszt, nit, njt, nkt, vectOfCoords,
+                     vectOfCellNI, posxb, posyb, poszb, vectOfBodies, vectOfConnect3);
 
   for (E_Int noc = 0; noc < nzonesA; noc++)
   {
@@ -658,6 +667,7 @@ PyObject* K_CONNECTOR::_blankCells(PyObject* self, PyObject* args)
 //============================================================================
 PyObject* K_CONNECTOR::blankCells(PyObject* self, PyObject* args)
 {
+  K_PROFILE("blankCells");
   PyObject* coordArrays; PyObject* cellnArrays;
   PyObject* bodyArrays;
   char* cellNName;
@@ -1295,18 +1305,41 @@ void K_CONNECTOR::blankCellsStruct(
   vector<FldArrayF*>& fieldsb,
   vector<FldArrayI*>& cnb)
 {
-  list<XRayPlane*> planes;
+  XRayMask mask;
+  mask.elevationDir = elevationDir; mask.isNot = isNot; mask.delta = delta;
   // creation du masque
-  E_Float xmin, ymin, zmin, xmax, ymax, zmax;
-  E_Float xminz, yminz, zminz, xmaxz, ymaxz, zmaxz;
-
   compCharacteristics(isNot, elevationDir, dim1, dim2, tol, delta,
-                      posxb, posyb, poszb, fieldsb, cnb, planes,
-                      xmin, ymin, zmin, xmax, ymax, zmax);
+                      posxb, posyb, poszb, fieldsb, cnb, mask.planes,
+                      mask.xmin, mask.ymin, mask.zmin,
+                      mask.xmax, mask.ymax, mask.zmax);
 
-  xmin = xmin - delta; xmax = xmax + delta;
-  ymin = ymin - delta; ymax = ymax + delta;
-  zmin = zmin - delta; zmax = zmax + delta;
+  mask.xmin = mask.xmin - delta; mask.xmax = mask.xmax + delta;
+  mask.ymin = mask.ymin - delta; mask.ymax = mask.ymax + delta;
+  mask.zmin = mask.zmin - delta; mask.zmax = mask.zmax + delta;
+
+  blankCellsStructXRay(mask, blankingType, posxt, posyt, poszt,
+                       nit, njt, nkt, blankedCoords, cellns);
+  // nettoyage
+  deleteXRayPlanes(mask.planes);
+}
+
+//=============================================================================
+/* Masquage des domaines structures par un masque X-Ray deja construit
+   IN: mask: plans de percage et bbox du corps elargie de delta
+   IN/OUT: cellns: cellN (0: M / 2: I / 1: N) */
+//=============================================================================
+void K_CONNECTOR::blankCellsStructXRay(
+  XRayMask& mask, E_Int blankingType,
+  vector<E_Int>& posxt, vector<E_Int>& posyt,
+  vector<E_Int>& poszt,
+  vector<E_Int>& nit, vector<E_Int>& njt, vector<E_Int>& nkt,
+  vector<FldArrayF*>& blankedCoords,
+  vector<FldArrayI*>& cellns)
+{
+  E_Int elevationDir = mask.elevationDir;
+  E_Int isNot = mask.isNot;
+  E_Float delta = mask.delta;
+  E_Float xminz, yminz, zminz, xmaxz, ymaxz, zmaxz;
 
   // masquage des domaines a masquer
   E_Int nzones = blankedCoords.size();
@@ -1321,7 +1354,7 @@ void K_CONNECTOR::blankCellsStruct(
                               *blankedCoords[zone],
                               xminz, yminz, zminz, xmaxz, ymaxz, zmaxz);
       intersect = K_COMPGEOM::compBoundingBoxIntersection(
-        xmin, xmax, ymin, ymax, zmin, zmax,
+        mask.xmin, mask.xmax, mask.ymin, mask.ymax, mask.zmin, mask.zmax,
         xminz, xmaxz, yminz, ymaxz, zminz, zmaxz, 1.e-6);
     }
     if (intersect != 0)
@@ -1341,7 +1374,7 @@ void K_CONNECTOR::blankCellsStruct(
 
       E_Int isMasked =
       searchForBlankedCellsStruct(elevationDir, blankingType,
-        isNot, delta, planes,
+        isNot, delta, mask.planes,
         nit[zone], njt[zone], nkt[zone],
         posxt[zone], posyt[zone], poszt[zone],
         *blankedCoords[zone],
@@ -1365,10 +1398,6 @@ void K_CONNECTOR::blankCellsStruct(
       }
     }
   }
-  // nettoyage
-  for (list<XRayPlane*>::iterator itr = planes.begin();
-       itr != planes.end(); itr++)
-  {delete [] (*itr)->tempZ; delete *itr; }
 }
 
 //=============================================================================
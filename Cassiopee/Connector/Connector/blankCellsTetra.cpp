@@ -263,6 +263,122 @@ PyObject* K_CONNECTOR::deleteTriMask(PyObject* self, PyObject* args)
   return Py_None;
 }
 
+//=============================================================================
+/* Get the TRI mask of a hook. Returns NULL (python error set) if invalid. */
+//=============================================================================
+static K_CONNECTOR::maskGen* getTriMask(PyObject* hook, const char* name)
+{
+  void** packet = NULL;
+#if (PY_MAJOR_VERSION == 2 && PY_MINOR_VERSION < 7) || (PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION < 1)
+  packet = (void**) PyCObject_AsVoidPtr(hook);
+#else
+  packet = (void**) PyCapsule_GetPointer(hook, NULL);
+#endif
+  if (packet == NULL || *(E_Int*)packet[0] != TRI_HOOK_ID || packet[1] == NULL)
+  {
+    PyErr_Format(PyExc_TypeError, "%s: a TRI mask hook is required.", name);
+    return NULL;
+  }
+  K_CONNECTOR::maskGen* mask = (K_CONNECTOR::maskGen*)packet[1];
+  if (mask->nb_points() == 0 || mask->nb_elts() == 0)
+  {
+    PyErr_Format(PyExc_ValueError, "%s: the input mask is empty.", name);
+    return NULL;
+  }
+  return mask;
+}
+
+//=============================================================================
+/* Classify points against a closed TRI mask (hook).
+   The mask is built once (createTriMask) and can be queried many times.
+   IN: array: points (structured or unstructured array, coordinates)
+   OUT: numpy: 1 if the point is inside (or on) the mask, 0 otherwise */
+//=============================================================================
+PyObject* K_CONNECTOR::classifyPointsTri(PyObject* self, PyObject* args)
+{
+  PyObject* maskHook; PyObject* array;
+  if (!PYPARSETUPLE_(args, OO_, &maskHook, &array)) return NULL;
+
+  K_CONNECTOR::maskGen* mask = getTriMask(maskHook, "classifyPoints");
+  if (mask == NULL) return NULL;
+
+  E_Int ni, nj, nk;
+  K_FLD::FldArrayF* f(0); K_FLD::FldArrayI* cn(0);
+  char* varString; char* eltType;
+  E_Int res = K_ARRAY::getFromArray(array, varString, f, ni, nj, nk, cn, eltType);
+  std::unique_ptr<K_FLD::FldArrayF> af(f);
+  std::unique_ptr<K_FLD::FldArrayI> acn(cn);
+  if (res != 1 && res != 2)
+  {
+    PyErr_SetString(PyExc_TypeError, "classifyPoints: invalid array.");
+    return NULL;
+  }
+  E_Int posx = K_ARRAY::isCoordinateXPresent(varString);
+  E_Int posy = K_ARRAY::isCoordinateYPresent(varString);
+  E_Int posz = K_ARRAY::isCoordinateZPresent(varString);
+  if (posx == -1 || posy == -1 || posz == -1)
+  {
+    PyErr_SetString(PyExc_TypeError, "classifyPoints: array must contain coordinates.");
+    return NULL;
+  }
+  posx++; posy++; posz++;
+
+  E_Int npts = f->getSize();
+  K_FLD::FldArrayI isBlanked;
+  mask->blank(*f, posx, posy, posz, isBlanked, MASKED, true);
+
+  PyObject* tpl = K_NUMPY::buildNumpyArray(npts, 1, 1);
+  E_Int* inside = K_NUMPY::getNumpyPtrI(tpl);
+#pragma omp parallel for
+  for (E_Int i = 0; i < npts; i++) inside[i] = (isBlanked[i] == MASKED);
+  return tpl;
+}
+
+//=============================================================================
+/* Signed distance of points to a closed TRI mask (hook), negative inside.
+   IN: array: points (structured or unstructured array, coordinates)
+   OUT: numpy of distances */
+//=============================================================================
+PyObject* K_CONNECTOR::getSignedDistanceTri(PyObject* self, PyObject* args)
+{
+  PyObject* maskHook; PyObject* array;
+  if (!PYPARSETUPLE_(args, OO_, &maskHook, &array)) return NULL;
+
+  K_CONNECTOR::maskGen* mask = getTriMask(maskHook, "getSignedDistance");
+  if (mask == NULL) return NULL;
+
+  E_Int ni, nj, nk;
+  K_FLD::FldArrayF* f(0); K_FLD::FldArrayI* cn(0);
+  char* varString; char* eltType;
+  E_Int res = K_ARRAY::getFromArray(array, varString, f, ni, nj, nk, cn, eltType);
+  std::unique_ptr<K_FLD::FldArrayF> af(f);
+  std::unique_ptr<K_FLD::FldArrayI> acn(cn);
+  if (res != 1 && res != 2)
+  {
+    PyErr_SetString(PyExc_TypeError, "getSignedDistance: invalid array.");
+    return NULL;
+  }
+  E_Int posx = K_ARRAY::isCoordinateXPresent(varString);
+  E_Int posy = K_ARRAY::isCoordinateYPresent(varString);
+  E_Int posz = K_ARRAY::isCoordinateZPresent(varString);
+  if (posx == -1 || posy == -1 || posz == -1)
+  {
+    PyErr_SetString(PyExc_TypeError, "getSignedDistance: array must contain coordinates.");
+    return NULL;
+  }
+  posx++; posy++; posz++;
+
+  PyObject* tpl = K_NUMPY::buildNumpyArray(f->getSize(), 1, 0);
+  E_Float* dist = K_NUMPY::getNumpyPtrF(tpl);
+  if (mask->signedDistance(*f, posx, posy, posz, dist) != 0)
+  {
+    Py_DECREF(tpl);
+    PyErr_SetString(PyExc_TypeError, "getSignedDistance: a TRI mask is required.");
+    return NULL;
+  }
+  return tpl;
+}
+
 //static int xcount=0;
 
 struct MaskEntity
@@ -280,6 +396,7 @@ E_Int do_the_blanking(E_Int blankingType, MaskEntity& maskE, const K_FLD::FldArr
 //============================================================================
 PyObject* K_CONNECTOR::blankCellsTetra(PyObject* self, PyObject* args)
 {
+  K_PROFILE("blankCellsTetra");
   char* cellNName;
   PyObject* mesh;
   PyObject* celln;
@@ -38,7 +38,13 @@ static PyMethodDef Pyconnector [] =
   {"deleteTetraMask", K_CONNECTOR::deleteTetraMask, METH_VARARGS},
   {"createTriMask", K_CONNECTOR::createTriMask, METH_VARARGS},
   {"deleteTriMask", K_CONNECTOR::deleteTriMask, METH_VARARGS},
+  {"classifyPointsTri", K_CONNECTOR::classifyPointsTri, METH_VARARGS},
+  {"getSignedDistanceTri", K_CONNECTOR::getSignedDistanceTri, METH_VARARGS},
   {"maskXRay", K_CONNECTOR::maskXRay, METH_VARARGS},
+  {"createXRayMask", K_CONNECTOR::createXRayMask, METH_VARARGS},
+  {"deleteXRayMask", K_CONNECTOR::deleteXRayMask, METH_VARARGS},
+  {"saveXRayMask", K_CONNECTOR::saveXRayMask, METH_VARARGS},
+  {"loadXRayMask", K_CONNECTOR::loadXRayMask, METH_VARARGS},
   {"getIntersectingDomainsAABB", K_CONNECTOR::getIntersectingDomainsAABB, METH_VARARGS},
   {"setDoublyDefinedBC", K_CONNECTOR::setDoublyDefinedBC, METH_VARARGS},
   {"getOversetHolesInterpCellCenters", K_CONNECTOR::getOversetHolesInterpCellCenters, METH_VARARGS},
@@ -202,6 +202,33 @@ namespace K_CONNECTOR
       std::vector<E_Float>* tempZ; // temporary storage of Z
   };
 
+/* Masque X-Ray reutilisable (hook) : plans de percage deja compactes et
+   bbox du corps elargie de delta. Les parametres de construction et la
+   somme de controle du corps permettent de valider un masque relu */
+#define XRAY_HOOK_ID 11
+  struct XRayMask
+  {
+      E_Int elevationDir;
+      E_Int isNot;
+      E_Int dim, xraydim1, xraydim2;
+      E_Float delta, tol;
+      unsigned long long bodyKey; // somme de controle du corps
+      E_Float xmin, ymin, zmin;
+      E_Float xmax, ymax, zmax;
+      std::list<XRayPlane*> planes;
+  };
+
+/* Destruction des plans d'un masque */
+  void deleteXRayPlanes(std::list<XRayPlane*>& planes);
+
+/* Ecriture/lecture binaire d'un masque. Retourne 0 si ok.
+   En lecture, err vaut 1 si le fichier est absent, 2 s'il est invalide. */
+  E_Int writeXRayMask(XRayMask& mask, const char* fileName);
+  XRayMask* readXRayMask(const char* fileName, E_Int* err=NULL);
+
+/* Masque contenu dans un hook (NULL et erreur python sinon) */
+  XRayMask* getXRayMask(PyObject* hook, const char* name);
+
 /* C'est a l'appelant de detruire les planes */
   E_Int compCharacteristics(E_Int isNot, E_Int elevationDir,
                             E_Int dim1, E_Int dim2,
@@ -231,7 +258,8 @@ namespace K_CONNECTOR
                         K_FLD::FldArrayF& epsilon,
                         E_Float* xt, E_Float* yt, E_Float* zt,
                         E_Int ind1, E_Int ind2, E_Int ind3,
-                        struct XRayPlane* p);
+                        struct XRayPlane* p,
+                        E_Int imin, E_Int imax, E_Int jmin, E_Int jmax);
 /* Compute intersection between triangle defined by (x0, y0, z0),
    (x1, y1, z1), (x2, y2, z2) and ray (x,y). Result in z if found.
    Return value is : 0 non-intersection
@@ -364,6 +392,15 @@ namespace K_CONNECTOR
                         std::vector<K_FLD::FldArrayF*>& fieldsb,
                         std::vector<K_FLD::FldArrayI*>& cnb);
 
+/* Meme fonction avec un masque deja construit */
+  void blankCellsStructXRay(XRayMask& mask, E_Int blankingType,
+                            std::vector<E_Int>& posxt, std::vector<E_Int>& posyt,
+                            std::vector<E_Int>& poszt,
+                            std::vector<E_Int>& nit, std::vector<E_Int>& njt,
+                            std::vector<E_Int>& nkt,
+                            std::vector<K_FLD::FldArrayF*>& blankedCoords,
+                            std::vector<K_FLD::FldArrayI*>& cellns);
+
 /* Meme fonction mais avec des maillages non structures. Attention, dans
    ce cas, seul le blankingType 0 s'applique.
    IN: blankedCoords: coordonnees en noeuds, cnt connectivite associee
@@ -799,6 +836,11 @@ namespace K_CONNECTOR
   PyObject* getIBMPtsWithFront(PyObject* self, PyObject* args);
   PyObject* getIBMPtsWithTwoFronts(PyObject* self, PyObject* args);
   PyObject* getIBMPtsWithoutFront(PyObject* self, PyObject* args);
+  /* Ordre de parcours des points IBM par cases spatiales (Morton)
+     IN: x, y, z: coordonnees des npts points
+     OUT: order: indices des points tries par case */
+  void sortIBMPtsByBins(E_Int npts, E_Float* x, E_Float* y, E_Float* z,
+                        E_Int* order);
   PyObject* optimizeOverlap(PyObject* self, PyObject* args);
   PyObject* maximizeBlankedCells( PyObject* self, PyObject* args );
   PyObject* blankCells( PyObject* self, PyObject* args);
@@ -808,7 +850,13 @@ namespace K_CONNECTOR
   PyObject* deleteTetraMask( PyObject* self, PyObject* args);
   PyObject* createTriMask( PyObject* self, PyObject* args);
   PyObject* deleteTriMask( PyObject* self, PyObject* args);
+  PyObject* classifyPointsTri(PyObject* self, PyObject* args);
+  PyObject* getSignedDistanceTri(PyObject* self, PyObject* args);
   PyObject* maskXRay(PyObject* self, PyObject* args);
+  PyObject* createXRayMask(PyObject* self, PyObject* args);
+  PyObject* deleteXRayMask(PyObject* self, PyObject* args);
+  PyObject* saveXRayMask(PyObject* self, PyObject* args);
+  PyObject* loadXRayMask(PyObject* self, PyObject* args);
   PyObject* getIntersectingDomainsAABB(PyObject* self, PyObject* args);
   PyObject* applyBCOverlapStruct(PyObject* self, PyObject* args);
   PyObject* applyBCOverlapsNG(PyObject* self, PyObject* args);
@@ -39,6 +39,7 @@ using namespace K_SEARCH;
 // ============================================================================
 PyObject* K_CONNECTOR::getIBMPtsBasic(PyObject* self, PyObject* args)
 {
+    K_PROFILE("getIBMPtsBasic");
     PyObject *allCorrectedPts, *distName, *normalNames;
     if (!PYPARSETUPLE_(args, OOO_, &allCorrectedPts, &normalNames, &distName))
         return NULL;
@@ -221,6 +222,7 @@ PyObject* K_CONNECTOR::getIBMPtsBasic(PyObject* self, PyObject* args)
         E_Float* hit = correctedPts->begin(poshit[noz]);
         E_Float* het = correctedPts->begin(poshet[noz]);
 
+#pragma omp parallel for private(dist0, delta, dirx, diry, dirz, dirn)
         for (E_Int ind = 0; ind < npts; ind++)
         {
             //xc0 = ptrXC[ind]; yc0 = ptrYC[ind]; zc0 = ptrZC[ind];
@@ -51,6 +51,7 @@ using namespace K_SEARCH;
 // ============================================================================
 PyObject* K_CONNECTOR::getIBMPtsWithFront(PyObject* self, PyObject* args)
 {
+    K_PROFILE("getIBMPtsWithFront");
     PyObject *allCorrectedPts, *bodySurfaces, *frontSurfaces, *normalNames;
     PyObject *ListOfSnearsLoc;
     PyObject *ListOfModelisationHeightsLoc;
@@ -497,8 +498,24 @@ PyObject* K_CONNECTOR::getIBMPtsWithFront(PyObject* self, PyObject* args)
         }
         FldArrayI typeProj(npts); typeProj.setAllValuesAtNull();
         E_Int nType1=0, nType2=0, nType3=0, nType4=0;
-        for (E_Int ind = 0; ind < npts; ind++)
+
+        // Les points sont traites par paquets de points voisins (cases spatiales)
+        FldArrayI order(npts);
+        K_CONNECTOR::sortIBMPtsByBins(npts, ptrXC, ptrYC, ptrZC, order.begin());
+        E_Int* orderp = order.begin();
+        FldArrayI noIBCTypes(npts); // corps de projection de chaque point
+        E_Int* noIBCTypesp = noIBCTypes.begin();
+
+        // Arbres partages en lecture seule, variables des kernels de projection privees
+#pragma omp parallel for schedule(dynamic, __MIN_SIZE_MEAN__) reduction(+:nType1,nType2,nType3,nType4) \
+        private(dirx0, diry0, dirz0, xsf, ysf, zsf, xsb, ysb, zsb, xc0, yc0, zc0, xw0, yw0, zw0, xi0, yi0, zi0, \
+                dist2, distl, indicesBB, pr1, pr2, pt, p0, p1, p2, p, minB, maxB, ok, notri, \
+                indvert1, indvert2, indvert3, indp, rx, ry, rz, rad, nxp, nyp, nzp, nxs, nys, nzs, \
+                cnVert1, cnVert2, cnVert3, edgeLen1, edgeLen2, snearloc, \
+                xf_ortho, yf_ortho, zf_ortho, xb_ortho, yb_ortho, zb_ortho)
+        for (E_Int io = 0; io < npts; io++)
         {
+            E_Int ind = orderp[io];
             E_Int noibctype = -1;
             xc0 = ptrXC[ind]; yc0 = ptrYC[ind]; zc0 = ptrZC[ind];
             E_Float distF1 = -1.; E_Float distB1 = -1.;
@@ -623,13 +640,18 @@ PyObject* K_CONNECTOR::getIBMPtsWithFront(PyObject* self, PyObject* args)
                 ptrXI[ind] = xf_ortho; ptrYI[ind] = yf_ortho; ptrZI[ind] = zf_ortho;
             }// found CAS 1 = 0         
             end:;
-	    
+            noIBCTypesp[ind] = noibctype;
+        }// ind in zone
+
+        // BILAN : indices des points par type de paroi, dans l'ordre croissant
+        for (E_Int ind = 0; ind < npts; ind++)
+        {
+            E_Int noibctype = noIBCTypesp[ind];
             E_Int& nptsByType = nPtsPerIBCType[noibctype];
             E_Int* indicesForIBCType = vectOfIndicesByIBCType[noibctype]->begin();
             indicesForIBCType[nptsByType] = ind+1; 
             nptsByType += 1;
-            // BILAN 
-        }// ind in zone
+        }
         // printf(" ZONE %d Nb de type 1 : %d, type2 = %d, type3 = %d, type4 = %d\n", noz, nType1, nType2,nType3,nType4);
 
         PyObject* PyListIndicesByIBCTypeForZone = PyList_New(0);
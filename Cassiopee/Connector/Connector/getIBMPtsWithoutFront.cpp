@@ -44,6 +44,7 @@ using namespace K_SEARCH;
 // ============================================================================
 PyObject* K_CONNECTOR::getIBMPtsWithoutFront(PyObject* self, PyObject* args)
 {
+    K_PROFILE("getIBMPtsWithoutFront");
     PyObject *allCorrectedPts, *bodySurfaces, *normalNames, *distName;
     E_Int signOfDist; //if correctedPts are inside bodies: sign = -1, else sign=1
     if (!PYPARSETUPLE_(args, OOOO_ I_,
@@ -338,8 +339,20 @@ PyObject* K_CONNECTOR::getIBMPtsWithoutFront(PyObject* self, PyObject* args)
             nPtsPerIBCType[notype]=0;
         }
 
-        for (E_Int ind = 0; ind < npts; ind++)
+        // Les points sont traites par paquets de points voisins (cases spatiales)
+        FldArrayI order(npts);
+        K_CONNECTOR::sortIBMPtsByBins(npts, ptrXC, ptrYC, ptrZC, order.begin());
+        E_Int* orderp = order.begin();
+        FldArrayI noIBCTypes(npts); // corps de projection de chaque point
+        E_Int* noIBCTypesp = noIBCTypes.begin();
+
+        // Arbres partages en lecture seule, variables des kernels de projection privees
+#pragma omp parallel for schedule(dynamic, __MIN_SIZE_MEAN__) \
+        private(dirn, dirx0, diry0, dirz0, xsb, ysb, zsb, dist0, xc0, yc0, zc0, xw0, yw0, zw0, xi0, yi0, zi0, \
+                dist2, distl, indicesBB, pr1, pr2, pt, p0, p1, p2, p, minB, maxB, ok, notri, indp, rx, ry, rz, rad)
+        for (E_Int io = 0; io < npts; io++)
         {
+            E_Int ind = orderp[io];
             xc0 = ptrXC[ind]; yc0 = ptrYC[ind]; zc0 = ptrZC[ind];
             E_Int noibctype = -1;
 
@@ -388,11 +401,18 @@ PyObject* K_CONNECTOR::getIBMPtsWithoutFront(PyObject* self, PyObject* args)
             ptrYI[ind] = ptrYW[ind] + diry0*dist0;
             ptrZI[ind] = ptrZW[ind] + dirz0*dist0;
 
+            noIBCTypesp[ind] = noibctype;
+        }//ind
+
+        // indices des points par type de paroi, dans l'ordre croissant
+        for (E_Int ind = 0; ind < npts; ind++)
+        {
+            E_Int noibctype = noIBCTypesp[ind];
             E_Int& nptsByType = nPtsPerIBCType[noibctype];
             E_Int* indicesForIBCType = vectOfIndicesByIBCType[noibctype]->begin();
             indicesForIBCType[nptsByType] = ind+1; 
             nptsByType+=1;
-        }//ind
+        }
 
         PyObject* PyListIndicesByIBCTypeForZone = PyList_New(0);
         for (E_Int noibctype = 0; noibctype < nbodies; noibctype++)
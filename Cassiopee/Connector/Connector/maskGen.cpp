@@ -95,6 +95,49 @@ namespace K_CONNECTOR
     return 0;
   }
    
+  ///
+  E_Int maskGen::signedDistance
+  (const K_FLD::FldArrayF& coord, E_Int px, E_Int py, E_Int pz, E_Float* dist)
+  {
+    if (_ELType != TRI) return 1;
+
+    K_FLD::ArrayAccessor<K_FLD::FldArrayF> cA(coord, px, py, pz);
+    E_Int sz = cA.size();
+
+#pragma omp parallel
+    {
+      E_Float P[3], Q0[3], Q1[3], Q2[3], mB[3], MB[3];
+      E_Float d, d2, dt2, xp, yp, zp, s0, s1;
+      E_Boolean in;
+      E_Int Ti[3];
+      Vector_t<E_Int> boxes;
+
+#pragma omp for
+      for (E_Int i = 0; i < sz; i++)
+      {
+        cA.getEntry(i, P);
+        // the closest mask node bounds the distance to the surface
+        _kdtree->getClosest(P, d2);
+        d = ::sqrt(d2) + _tolerance;
+        for (E_Int k = 0; k < 3; k++) { mB[k] = P[k]-d; MB[k] = P[k]+d; }
+        boxes.clear();
+        _tree->getOverlappingBoxes(mB, MB, boxes);
+        for (size_t b = 0; b < boxes.size(); b++)
+        {
+          _connT4->getEntry(boxes[b], Ti);
+          _coordT4.getEntry(Ti[0], Q0);
+          _coordT4.getEntry(Ti[1], Q1);
+          _coordT4.getEntry(Ti[2], Q2);
+          if (K_COMPGEOM::distanceToTriangle(Q0, Q1, Q2, P, 2, dt2, in,
+                                             xp, yp, zp, s0, s1) == 0 && dt2 < d2) d2 = dt2;
+        }
+        d = ::sqrt(d2);
+        dist[i] = (is_inside<K_MESH::Triangle>(P, boxes) ? -d : d);
+      }
+    }
+    return 0;
+  }
+
   ///
   template <typename T>
   void maskGen::__blank
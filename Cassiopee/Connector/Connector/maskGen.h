@@ -58,6 +58,9 @@ namespace K_CONNECTOR
       ~maskGen();
       
       E_Int blank(const K_FLD::FldArrayF& coord, E_Int px, E_Int py, E_Int pz, K_FLD::FldArrayI& isBlanked, E_Int cellnval=0, bool overwrite=false);
+
+      /// Signed distance of the points to a TRI mask (negative inside). Returns 1 for a TH4 mask.
+      E_Int signedDistance(const K_FLD::FldArrayF& coord, E_Int px, E_Int py, E_Int pz, E_Float* dist);
      
       ///
       inline E_Int nb_points() const { return _coordT4.size();}
@@ -18,6 +18,7 @@
 */
 
 # include "connector.h"
+# include <algorithm>
 
 using namespace std;
 using namespace K_FLD;
@@ -203,13 +204,18 @@ E_Int K_CONNECTOR::compCharacteristics(
     E_Int poszb = poszt[zone]; 
     FldArrayF& fieldb = *fields[zone];
     FldArrayI& cnb = *cnt[zone];
-    comp = computeZ(elevationDir, xmin, ymin, xmax, ymax,
-                    epsilon, fieldb.begin(posxb), fieldb.begin(posyb), 
-                    fieldb.begin(poszb), cnb, p);
+    comp += computeZ(elevationDir, xmin, ymin, xmax, ymax,
+                     epsilon, fieldb.begin(posxb), fieldb.begin(posyb), 
+                     fieldb.begin(poszb), cnb, p);
   }
   E_Int nambig = comp; comp = 0;
+  E_Int nrays = p->ni * p->nj;
   while (nambig > 0 && niter <= nitermax)
   {
+    // Les rayons perturbes sont recalcules : on repart de zero
+#pragma omp parallel for
+    for (E_Int r = 0; r < nrays; r++) p->tempZ[r].clear();
+
     // Compute Z intersections
     for (E_Int zone = 0; zone < nzones; zone++)
     {
@@ -218,9 +224,9 @@ E_Int K_CONNECTOR::compCharacteristics(
       E_Int poszb = poszt[zone]; 
       FldArrayF& fieldb = *fields[zone];
       FldArrayI& cnb = *cnt[zone];
-      comp = computeZ(elevationDir, xmin, ymin, xmax, ymax,
-                      epsilon, fieldb.begin(posxb), fieldb.begin(posyb), 
-                      fieldb.begin(poszb), cnb, p);
+      comp += computeZ(elevationDir, xmin, ymin, xmax, ymax,
+                       epsilon, fieldb.begin(posxb), fieldb.begin(posyb), 
+                       fieldb.begin(poszb), cnb, p);
     }
     nambig = comp; comp = 0;
     niter++;
@@ -235,8 +241,51 @@ E_Int K_CONNECTOR::compCharacteristics(
   return 1;
 }
 //=============================================================================
-/* Compute the Z pierce points for a body defined by fieldb */
+/* Rayons concernes par un triangle (bornes incluses, vides si min > max) */
 //=============================================================================
+static void triangleRays(E_Int elevationDir, struct K_CONNECTOR::XRayPlane* p,
+                         E_Float x0, E_Float y0, E_Float x1, E_Float y1,
+                         E_Float x2, E_Float y2,
+                         E_Int& imin, E_Int& imax, E_Int& jmin, E_Int& jmax)
+{
+  E_Float eps = K_CONST::E_GEOM_CUTOFF;
+  E_Float xmin = p->xmin; E_Float ymin = p->ymin;
+  E_Float hi = p->hi; E_Float hj = p->hj;
+  imin = E_Int((x0-xmin-eps)/hi);
+  imax = E_Int((x0-xmin+eps)/hi)+1;
+  imin = K_FUNC::E_min( imin, E_Int((x1-xmin-eps)/hi) );
+  imax = K_FUNC::E_max( imax, E_Int((x1-xmin+eps)/hi)+1 );
+  imin = K_FUNC::E_min( imin, E_Int((x2-xmin-eps)/hi));
+  imax = K_FUNC::E_max( imax, E_Int((x2-xmin+eps)/hi)+1);
+  imax = K_FUNC::E_min( imax, p->ni-1 );
+  imin = K_FUNC::E_max( imin, E_Int(0) );
+
+  if (elevationDir != 2)
+  {
+    jmin = E_Int((y0-ymin-eps)/hj);
+    jmax = E_Int((y0-ymin+eps)/hj)+1;
+    jmin = K_FUNC::E_min( jmin, E_Int((y1-ymin-eps)/hj) );
+    jmax = K_FUNC::E_max( jmax, E_Int((y1-ymin+eps)/hj)+1 );
+    jmin = K_FUNC::E_min( jmin, E_Int((y2-ymin-eps)/hj) );
+    jmax = K_FUNC::E_max( jmax, E_Int((y2-ymin+eps)/hj)+1 );
+    jmax = K_FUNC::E_min( jmax, p->nj-1 );
+    jmin = K_FUNC::E_max( jmin, E_Int(0) );
+  }
+  else
+  {
+    jmin = 0;
+    jmax = 0;
+  }
+}
+
+//=============================================================================
+/* Compute the Z pierce points for a body defined by fieldb
+   Les rayons sont groupes en paquets de XRAY_PACKET x XRAY_PACKET rayons.
+   Les triangles sont repartis dans les paquets qu'ils couvrent, puis les
+   paquets sont traites en parallele : chaque rayon n'est ecrit que par le
+   thread qui traite son paquet. */
+//=============================================================================
+#define XRAY_PACKET 16
 E_Int K_CONNECTOR::computeZ(
   E_Int elevationDir,
   E_Float xmin, E_Float ymin, E_Float xmax, E_Float ymax, 
@@ -253,37 +302,86 @@ E_Int K_CONNECTOR::computeZ(
 
   if (nvert == 3) cn3 = cnb.begin(3);
 
-//#pragma omp parallel for default(shared) reduction(+:comp)
+  E_Int ni = p->ni; E_Int nj = p->nj;
+  E_Int npi = (ni+XRAY_PACKET-1)/XRAY_PACKET;
+  E_Int npj = (nj+XRAY_PACKET-1)/XRAY_PACKET;
+  E_Int npackets = npi*npj;
+
+  // Rayons couverts par chaque triangle
+  FldArrayI range(nelts, 4);
+  E_Int* rimin = range.begin(1); E_Int* rimax = range.begin(2);
+  E_Int* rjmin = range.begin(3); E_Int* rjmax = range.begin(4);
+#pragma omp parallel for
   for (E_Int et = 0; et < nelts; et++)
   {
     E_Int ind1 = cn1[et]-1; E_Int ind2 = cn2[et]-1; E_Int ind3 = cn3[et]-1;
-    comp = comp + triangleOnPlane(elevationDir, xmin, ymin, xmax, ymax, 
-                                  epsilon, xtb, ytb, ztb, 
-                                  ind1, ind2, ind3, p);
+    triangleRays(elevationDir, p, xtb[ind1], ytb[ind1], xtb[ind2], ytb[ind2],
+                 xtb[ind3], ytb[ind3], rimin[et], rimax[et], rjmin[et], rjmax[et]);
+  }
+
+  // Triangles de chaque paquet (stockage compact, par ordre croissant)
+  vector<E_Int> ptr(npackets+1, 0);
+  for (E_Int et = 0; et < nelts; et++)
+  {
+    if (rimin[et] > rimax[et] || rjmin[et] > rjmax[et]) continue;
+    for (E_Int pj = rjmin[et]/XRAY_PACKET; pj <= rjmax[et]/XRAY_PACKET; pj++)
+      for (E_Int pi = rimin[et]/XRAY_PACKET; pi <= rimax[et]/XRAY_PACKET; pi++)
+        ptr[pi+pj*npi+1]++;
+  }
+  for (E_Int pk = 0; pk < npackets; pk++) ptr[pk+1] += ptr[pk];
+  vector<E_Int> elts(ptr[npackets]);
+  vector<E_Int> pos(ptr.begin(), ptr.end()-1);
+  for (E_Int et = 0; et < nelts; et++)
+  {
+    if (rimin[et] > rimax[et] || rjmin[et] > rjmax[et]) continue;
+    for (E_Int pj = rjmin[et]/XRAY_PACKET; pj <= rjmax[et]/XRAY_PACKET; pj++)
+      for (E_Int pi = rimin[et]/XRAY_PACKET; pi <= rimax[et]/XRAY_PACKET; pi++)
+        elts[pos[pi+pj*npi]++] = et;
+  }
+
+#pragma omp parallel for schedule(dynamic) reduction(+:comp)
+  for (E_Int pk = 0; pk < npackets; pk++)
+  {
+    E_Int pi = pk%npi; E_Int pj = pk/npi;
+    E_Int i0 = pi*XRAY_PACKET; E_Int i1 = K_FUNC::E_min(i0+XRAY_PACKET-1, ni-1);
+    E_Int j0 = pj*XRAY_PACKET; E_Int j1 = K_FUNC::E_min(j0+XRAY_PACKET-1, nj-1);
+    for (E_Int n = ptr[pk]; n < ptr[pk+1]; n++)
+    {
+      E_Int et = elts[n];
+      E_Int ind1 = cn1[et]-1; E_Int ind2 = cn2[et]-1; E_Int ind3 = cn3[et]-1;
+      comp += triangleOnPlane(elevationDir, xmin, ymin, xmax, ymax, 
+                              epsilon, xtb, ytb, ztb, 
+                              ind1, ind2, ind3, p,
+                              K_FUNC::E_max(rimin[et], i0), K_FUNC::E_min(rimax[et], i1),
+                              K_FUNC::E_max(rjmin[et], j0), K_FUNC::E_min(rjmax[et], j1));
+    }
   }
   return comp;
 }
 //=============================================================================
+/* Intersection d'un triangle avec les rayons [imin,imax]x[jmin,jmax]
+   Un rayon ambigu est perturbe (epsilon) pour la passe suivante.
+   Retourne le nombre d'intersections ambigues. */
+//=============================================================================
 E_Int K_CONNECTOR::triangleOnPlane(E_Int elevationDir, 
                                    E_Float xmina, E_Float ymina, 
                                    E_Float xmaxa, E_Float ymaxa,
                                    FldArrayF& epsilon, 
                                    E_Float* xt, E_Float* yt, E_Float* zt, 
                                    E_Int ind1, E_Int ind2, E_Int ind3,
-                                   struct XRayPlane* p)
+                                   struct XRayPlane* p,
+                                   E_Int imin, E_Int imax,
+                                   E_Int jmin, E_Int jmax)
 {
   E_Int comp = 0;
-  E_Float eps = K_CONST::E_GEOM_CUTOFF;
   E_Float x, y, z;
   E_Float sgn1 = 0.;
   E_Float sgn2 = 0.;
   E_Int found;
   E_Float r1, r2, xp, yp;
-  E_Int imin, imax, jmin, jmax;
 
   // Plane data
   E_Int ni = p->ni;
-  E_Int nj = p->nj;
   E_Float xmin = p->xmin;
   E_Float ymin = p->ymin;
   E_Float hi = p->hi;
@@ -294,32 +392,6 @@ E_Int K_CONNECTOR::triangleOnPlane(E_Int elevationDir,
   E_Float x0 = xt[ind1]; E_Float y0 = yt[ind1]; E_Float z0 = zt[ind1];
   E_Float x1 = xt[ind2]; E_Float y1 = yt[ind2]; E_Float z1 = zt[ind2];
   E_Float x2 = xt[ind3]; E_Float y2 = yt[ind3]; E_Float z2 = zt[ind3];
-  // Find concerned rays
-  imin = E_Int((x0-xmin-eps)/hi);
-  imax = E_Int((x0-xmin+eps)/hi)+1;
-  imin = K_FUNC::E_min( imin, E_Int((x1-xmin-eps)/hi) );
-  imax = K_FUNC::E_max( imax, E_Int((x1-xmin+eps)/hi)+1 );
-  imin = K_FUNC::E_min( imin, E_Int((x2-xmin-eps)/hi));
-  imax = K_FUNC::E_max( imax, E_Int((x2-xmin+eps)/hi)+1);
-  imax = K_FUNC::E_min( imax, ni-1 );
-  imin = K_FUNC::E_max( imin, 0 );
-
-  if (elevationDir != 2)
-  {
-    jmin = E_Int((y0-ymin-eps)/hj);
-    jmax = E_Int((y0-ymin+eps)/hj)+1;
-    jmin = K_FUNC::E_min( jmin, E_Int((y1-ymin-eps)/hj) );
-    jmax = K_FUNC::E_max( jmax, E_Int((y1-ymin+eps)/hj)+1 );
-    jmin = K_FUNC::E_min( jmin, E_Int((y2-ymin-eps)/hj) );
-    jmax = K_FUNC::E_max( jmax, E_Int((y2-ymin+eps)/hj)+1 );
-    jmax = K_FUNC::E_min( jmax, nj-1 );
-    jmin = K_FUNC::E_max( jmin, 0 );
-  }
-  else
-  {
-    jmin = 0;
-    jmax = 0;
-  }
 
   for (E_Int j = jmin; j <= jmax; j++)
     for (E_Int i = imin; i <= imax; i++)
@@ -334,11 +406,8 @@ E_Int K_CONNECTOR::triangleOnPlane(E_Int elevationDir,
       switch (found)
       {
         case 1:
-//#pragma omp critical
-        {
           p->tempZ[i+j*ni].push_back(z);
-        }
-        break;
+          break;
         case -1:
         case -2:
           sgn1 = K_NOISE::stdRand(&idum); sgn2 = K_NOISE::stdRand(&idum);
@@ -541,75 +610,47 @@ void K_CONNECTOR::compactZ(
   E_Float xmax, E_Float ymax, E_Float zmax,             
   XRayPlane* p)
 {
-  E_Int i, j, ind, in, start;
-  E_Float z, temp;
   E_Int n = p->ni * p->nj;
 
-  // Count the number of pierce points: size
-  E_Int size = 0;
-  for (i = 0; i < n; i++)
+  // Tri par ordre croissant, elimination des doublons (points distants de
+  // moins de tol) et parite, rayon par rayon
+#pragma omp parallel for schedule(dynamic, 64)
+  for (E_Int i = 0; i < n; i++)
   {
     vector<E_Float>& v = p->tempZ[i];
-    size = size+v.size();
-  }
-
-  E_Int s = 0;
-  E_Int c = 0;
-  p->Z.malloc(2*size); // dans le cas ou tous les pierce points sont impairs
-  // Compacting
-  c = 0;
-  for (i = 0; i < n; i++)
-  {
-    // Compacting one ray
-    start = c;
-    p->indir[i] = start;
-    vector<E_Float>& v = p->tempZ[i];
-    s = v.size();
-    for (j = 0; j < s; j++)
-    {
-      z = v[j];
-      p->Z[c] = z;
-      c++;
-    }
-
-    // Tri par ordre croissant
-    for (j = start; j < start+s; j++)
+    E_Int s = v.size();
+    if (s == 0) continue;
+    std::sort(v.begin(), v.end());
+    E_Int c = 0;
+    for (E_Int j = 1; j < s; j++)
     {
-      // Find smallest element
-      ind = j;
-      for (in = j+1; in < start+s; in++)
-      {
-        if (p->Z[in] < p->Z[ind])
-          ind = in;
-      }
-      if (ind != j)
-      {
-        temp = p->Z[j];
-        p->Z[j] = p->Z[ind];
-        p->Z[ind] = temp;
-      }
+      if (K_FUNC::E_abs(v[c] - v[j]) > tol) { v[c+1] = v[j]; c++; }
     }
-
-    // Elimination des doublons (points distant de moins de tol)
-    c = start;
-    for (j = start+1; j < start+s; j++)
-    {
-      if (K_FUNC::E_abs(p->Z[c] - p->Z[j]) > tol)
-      {
-        p->Z[c+1] = p->Z[j]; c++;
-      }
-    }
-    if (s > 0) c++;
+    c++;
+    v.resize(c);
     // Ajout pour obtenir un nombre pair d'elements
     // Dans le cas classique, on ajoute un point au dessus du dernier point
     // d'intersection
-    if ((c-start)%2 != 0)
-    { 
-      p->Z[c] = p->Z[c-1] + 1.e-6;
-      c++;
-    }
+    if (c%2 != 0) v.push_back(v[c-1] + 1.e-6);
+  }
+
+  // Compacting
+  E_Int c = 0;
+  for (E_Int i = 0; i < n; i++)
+  {
+    p->indir[i] = c;
+    c += p->tempZ[i].size();
+  }
+  p->Z.malloc(c);
+  E_Float* Z = p->Z.begin();
+#pragma omp parallel for schedule(dynamic, 64)
+  for (E_Int i = 0; i < n; i++)
+  {
+    vector<E_Float>& v = p->tempZ[i];
+    E_Int start = p->indir[i];
+    for (size_t j = 0; j < v.size(); j++) Z[start+j] = v[j];
   }
-  p->Z.reAlloc(c);
+  delete [] p->tempZ; p->tempZ = NULL;
 
   // Add delta
   if (delta > 0.) addDeltaToZ(isNot, elevationDir, delta, 
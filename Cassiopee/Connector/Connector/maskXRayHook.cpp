@@ -0,0 +1,469 @@
+/*
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+# include "connector.h"
+# include <stdio.h>
+
+using namespace std;
+using namespace K_FLD;
+
+// Entete des fichiers de masque X-Ray
+#define XRAY_MAGIC "XRAYMASK"
+#define XRAY_VERSION 2
+
+//=============================================================================
+/* Destruction des plans d'un masque */
+//=============================================================================
+void K_CONNECTOR::deleteXRayPlanes(list<XRayPlane*>& planes)
+{
+  for (list<XRayPlane*>::iterator itr = planes.begin();
+       itr != planes.end(); itr++)
+  {delete [] (*itr)->tempZ; delete *itr; }
+  planes.clear();
+}
+
+//=============================================================================
+/* Ecriture binaire d'un masque (plans compactes uniquement)
+   Format : magic, sizeof(E_Int), version, elevationDir, isNot, nplanes,
+   dim, xraydim1, xraydim2, delta, tol, bbox, somme de controle du corps,
+   puis pour chaque plan : bbox, hi, hj, ni, nj, nz, indir, Z.
+   Retourne 0 si ok. */
+//=============================================================================
+E_Int K_CONNECTOR::writeXRayMask(XRayMask& mask, const char* fileName)
+{
+  FILE* f = fopen(fileName, "wb");
+  if (f == NULL) return 1;
+
+  fwrite(XRAY_MAGIC, sizeof(char), 8, f);
+  E_Int head[8];
+  head[0] = sizeof(E_Int); head[1] = XRAY_VERSION;
+  head[2] = mask.elevationDir; head[3] = mask.isNot;
+  head[4] = mask.planes.size();
+  head[5] = mask.dim; head[6] = mask.xraydim1; head[7] = mask.xraydim2;
+  fwrite(head, sizeof(E_Int), 8, f);
+  E_Float bb[8];
+  bb[0] = mask.delta; bb[1] = mask.tol;
+  bb[2] = mask.xmin; bb[3] = mask.ymin; bb[4] = mask.zmin;
+  bb[5] = mask.xmax; bb[6] = mask.ymax; bb[7] = mask.zmax;
+  fwrite(bb, sizeof(E_Float), 8, f);
+  fwrite(&mask.bodyKey, sizeof(unsigned long long), 1, f);
+
+  for (list<XRayPlane*>::iterator itr = mask.planes.begin();
+       itr != mask.planes.end(); itr++)
+  {
+    XRayPlane* p = *itr;
+    E_Float pf[8];
+    pf[0] = p->xmin; pf[1] = p->ymin; pf[2] = p->zmin;
+    pf[3] = p->xmax; pf[4] = p->ymax; pf[5] = p->zmax;
+    pf[6] = p->hi; pf[7] = p->hj;
+    fwrite(pf, sizeof(E_Float), 8, f);
+    E_Int pi[3];
+    pi[0] = p->ni; pi[1] = p->nj; pi[2] = p->Z.getSize();
+    fwrite(pi, sizeof(E_Int), 3, f);
+    fwrite(p->indir.begin(), sizeof(E_Int), p->ni*p->nj, f);
+    fwrite(p->Z.begin(), sizeof(E_Float), pi[2], f);
+  }
+  E_Int err = ferror(f);
+  fclose(f);
+  return (err != 0);
+}
+
+//=============================================================================
+/* Lecture d'un masque ecrit par writeXRayMask.
+   Les tailles lues sont verifiees avant allocation (elles doivent tenir dans
+   la fin du fichier) et les indirections doivent rester dans Z.
+   Retourne NULL si le fichier est absent (err=1) ou invalide (err=2). */
+//=============================================================================
+K_CONNECTOR::XRayMask* K_CONNECTOR::readXRayMask(const char* fileName, E_Int* err)
+{
+  if (err != NULL) *err = 1;
+  FILE* f = fopen(fileName, "rb");
+  if (f == NULL) return NULL;
+  if (err != NULL) *err = 2;
+
+  // taille du fichier
+  if (fseek(f, 0, SEEK_END) != 0) { fclose(f); return NULL; }
+  long fileSize = ftell(f);
+  if (fileSize < 0 || fseek(f, 0, SEEK_SET) != 0) { fclose(f); return NULL; }
+
+  char magic[8];
+  E_Int head[8]; E_Float bb[8];
+  unsigned long long bodyKey;
+  if (fread(magic, sizeof(char), 8, f) != 8 ||
+      strncmp(magic, XRAY_MAGIC, 8) != 0 ||
+      fread(head, sizeof(E_Int), 2, f) != 2 ||
+      head[0] != E_Int(sizeof(E_Int)) || head[1] != XRAY_VERSION ||
+      fread(head+2, sizeof(E_Int), 6, f) != 6 ||
+      fread(bb, sizeof(E_Float), 8, f) != 8 ||
+      fread(&bodyKey, sizeof(unsigned long long), 1, f) != 1 ||
+      (head[2] != 2 && head[2] != 3) || head[4] < 0)
+  { fclose(f); return NULL; }
+
+  XRayMask* mask = new XRayMask;
+  mask->elevationDir = head[2]; mask->isNot = head[3];
+  mask->dim = head[5]; mask->xraydim1 = head[6]; mask->xraydim2 = head[7];
+  mask->delta = bb[0]; mask->tol = bb[1];
+  mask->xmin = bb[2]; mask->ymin = bb[3]; mask->zmin = bb[4];
+  mask->xmax = bb[5]; mask->ymax = bb[6]; mask->zmax = bb[7];
+  mask->bodyKey = bodyKey;
+
+  for (E_Int n = 0; n < head[4]; n++)
+  {
+    XRayPlane* p = new XRayPlane;
+    p->tempZ = NULL;
+    mask->planes.push_back(p);
+    E_Float pf[8]; E_Int pi[3];
+    E_Bool ok = (fread(pf, sizeof(E_Float), 8, f) == 8 &&
+                 fread(pi, sizeof(E_Int), 3, f) == 3 &&
+                 pi[0] >= 1 && pi[1] >= 1 && pi[2] >= 0);
+    if (ok)
+    {
+      // ni*nj entiers et nz reels doivent tenir dans la fin du fichier
+      long pos = ftell(f);
+      E_LONG remain = (pos < 0 ? 0 : (E_LONG)(fileSize-pos));
+      E_LONG nmax = remain/(E_LONG)sizeof(E_Int);
+      ok = ((E_LONG)pi[0] <= nmax && (E_LONG)pi[1] <= nmax/(E_LONG)pi[0]);
+      if (ok)
+      {
+        E_LONG nij = (E_LONG)pi[0]*(E_LONG)pi[1];
+        remain -= nij*(E_LONG)sizeof(E_Int);
+        ok = ((E_LONG)pi[2] <= remain/(E_LONG)sizeof(E_Float));
+      }
+    }
+    if (!ok) { deleteXRayPlanes(mask->planes); delete mask; fclose(f); return NULL; }
+    p->xmin = pf[0]; p->ymin = pf[1]; p->zmin = pf[2];
+    p->xmax = pf[3]; p->ymax = pf[4]; p->zmax = pf[5];
+    p->hi = pf[6]; p->hj = pf[7];
+    p->ni = pi[0]; p->nj = pi[1];
+    E_Int nij = p->ni*p->nj;
+    p->indir.malloc(nij);
+    p->Z.malloc(pi[2]);
+    if (fread(p->indir.begin(), sizeof(E_Int), nij, f) != size_t(nij) ||
+        fread(p->Z.begin(), sizeof(E_Float), pi[2], f) != size_t(pi[2]))
+    { deleteXRayPlanes(mask->planes); delete mask; fclose(f); return NULL; }
+
+    // le rayon r occupe Z[indir[r]:indir[r+1]] (Z[indir[r]:nz] pour le
+    // dernier) : indir croissant, dans [0,nz]
+    E_Int* indir = p->indir.begin();
+    ok = (indir[0] >= 0);
+    for (E_Int r = 1; r < nij && ok; r++) ok = (indir[r] >= indir[r-1]);
+    if (ok) ok = (indir[nij-1] <= pi[2]);
+    if (!ok) { deleteXRayPlanes(mask->planes); delete mask; fclose(f); return NULL; }
+  }
+  if (err != NULL) *err = 0;
+  fclose(f);
+  return mask;
+}
+
+//=============================================================================
+/* Masque contenu dans un hook */
+//=============================================================================
+K_CONNECTOR::XRayMask* K_CONNECTOR::getXRayMask(PyObject* hook, const char* name)
+{
+  void** packet = NULL;
+#if (PY_MAJOR_VERSION == 2 && PY_MINOR_VERSION < 7) || (PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION < 1)
+  if (PyCObject_Check(hook)) packet = (void**) PyCObject_AsVoidPtr(hook);
+#else
+  if (PyCapsule_CheckExact(hook)) packet = (void**) PyCapsule_GetPointer(hook, NULL);
+#endif
+  if (packet == NULL || *(E_Int*)packet[0] != XRAY_HOOK_ID)
+  {
+    PyErr_Format(PyExc_TypeError, "%s: body must be a list of arrays or a X-Ray mask hook.", name);
+    return NULL;
+  }
+  if (packet[1] == NULL)
+  {
+    PyErr_Format(PyExc_ValueError, "%s: X-Ray mask has been deleted.", name);
+    return NULL;
+  }
+  return (XRayMask*)packet[1];
+}
+
+//=============================================================================
+/* Somme de controle (FNV-1a) des coordonnees et connectivites du corps :
+   un masque relu n'est reutilise que si le corps n'a pas change */
+//=============================================================================
+static unsigned long long xrayBodyKey(vector<E_Int>& posxb, vector<E_Int>& posyb,
+                                      vector<E_Int>& poszb,
+                                      vector<FldArrayF*>& unstrF,
+                                      vector<FldArrayI*>& cnt)
+{
+  unsigned long long key = 14695981039346656037ULL;
+  auto hash = [&key](const void* data, size_t size)
+  {
+    const unsigned char* c = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++) { key ^= c[i]; key *= 1099511628211ULL; }
+  };
+  for (size_t nz = 0; nz < unstrF.size(); nz++)
+  {
+    FldArrayF& f = *unstrF[nz]; FldArrayI& cn = *cnt[nz];
+    E_Int npts = f.getSize(); E_Int nelts = cn.getSize(); E_Int nv = cn.getNfld();
+    hash(&npts, sizeof(E_Int)); hash(&nelts, sizeof(E_Int)); hash(&nv, sizeof(E_Int));
+    E_Float* xb = f.begin(posxb[nz]);
+    E_Float* yb = f.begin(posyb[nz]);
+    E_Float* zb = f.begin(poszb[nz]);
+    for (E_Int i = 0; i < npts; i++)
+    { hash(&xb[i], sizeof(E_Float)); hash(&yb[i], sizeof(E_Float)); hash(&zb[i], sizeof(E_Float)); }
+    for (E_Int v = 1; v <= nv; v++)
+    {
+      E_Int* cnv = cn.begin(v);
+      for (E_Int e = 0; e < nelts; e++) hash(&cnv[e], sizeof(E_Int));
+    }
+  }
+  return key;
+}
+
+//=============================================================================
+/* Le masque relu a-t-il ete construit avec les memes parametres ? */
+//=============================================================================
+static E_Bool sameXRayBuild(K_CONNECTOR::XRayMask& m1, K_CONNECTOR::XRayMask& m2)
+{
+  return (m1.elevationDir == m2.elevationDir && m1.isNot == m2.isNot &&
+          m1.dim == m2.dim && m1.xraydim1 == m2.xraydim1 &&
+          m1.xraydim2 == m2.xraydim2 && m1.delta == m2.delta &&
+          m1.tol == m2.tol && m1.bodyKey == m2.bodyKey);
+}
+
+//=============================================================================
+/* Destruction du hook par python : libere le masque s'il n'a pas ete
+   libere par deleteXRayMask */
+//=============================================================================
+#if !((PY_MAJOR_VERSION == 2 && PY_MINOR_VERSION < 7) || (PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION < 1))
+static void xrayHookDestructor(PyObject* hook)
+{
+  void** packet = (void**) PyCapsule_GetPointer(hook, NULL);
+  if (packet == NULL) return;
+  K_CONNECTOR::XRayMask* mask = (K_CONNECTOR::XRayMask*)packet[1];
+  if (mask != NULL) { K_CONNECTOR::deleteXRayPlanes(mask->planes); delete mask; }
+  delete (E_Int*)packet[0]; delete [] packet;
+}
+#endif
+
+//=============================================================================
+/* Cree le hook d'un masque */
+//=============================================================================
+static PyObject* buildXRayHook(K_CONNECTOR::XRayMask* mask)
+{
+  PyObject* hook;
+  E_Int* type = new E_Int; *type = XRAY_HOOK_ID;
+  void** packet = new void* [2];
+  packet[0] = type; // hook type
+  packet[1] = mask;
+#if (PY_MAJOR_VERSION == 2 && PY_MINOR_VERSION < 7) || (PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION < 1)
+  hook = PyCObject_FromVoidPtr(packet, NULL);
+#else
+  hook = PyCapsule_New(packet, NULL, xrayHookDestructor);
+#endif
+  return hook;
+}
+
+//=============================================================================
+/* Construction d'un masque X-Ray reutilisable (hook).
+   Le masque est construit une seule fois et peut ensuite etre applique
+   a plusieurs ensembles de zones (_blankCells) ou sauvegarde (saveXRayMask).
+   IN: body: liste d'arrays TRI ou BAR
+   IN: delta, dim, isNot, tol, xraydim1, xraydim2: comme blankCells
+   IN: fileName: si non vide, le masque est relu de ce fichier s'il a ete
+   construit avec les memes parametres et le meme corps, sinon il est
+   construit et sauvegarde dans ce fichier */
+//=============================================================================
+PyObject* K_CONNECTOR::createXRayMask(PyObject* self, PyObject* args)
+{
+  PyObject* body;
+  E_Float delta, tol;
+  E_Int isNot, dim;
+  E_Int xraydim1, xraydim2;
+  char* fileName;
+  if (!PYPARSETUPLE_(args, O_ R_ II_ R_ II_ S_,
+                    &body, &delta, &dim, &isNot, &tol, &xraydim1, &xraydim2,
+                    &fileName))
+  {
+      return NULL;
+  }
+  if (delta < 0.)
+  {
+    printf("Warning: createXRayMask: delta must be a positive value. Set to default (1.e-10).\n");
+    delta = 1.e-10;
+  }
+  if (isNot != 0 && isNot != 1)
+  {
+    printf("Warning: createXRayMask: masknot is not valid. Set to default (0)\n");
+    isNot = 0;
+  }
+
+  /* Extraction de la surface de masquage */
+  vector<E_Int> resl;
+  vector<char*> structVarString; vector<char*> unstrVarString;
+  vector<FldArrayF*> structF; vector<FldArrayF*> unstrF;
+  vector<E_Int> nit; vector<E_Int> njt; vector<E_Int> nkt;
+  vector<FldArrayI*> cnt; vector<char*> eltType;
+  vector<PyObject*> objs, obju;
+  E_Boolean skipNoCoord = true;
+  E_Boolean skipStructured = true;
+  E_Boolean skipUnstructured = false;
+  E_Boolean skipDiffVars = true;
+  E_Int res = K_ARRAY::getFromArrays(
+    body, resl, structVarString, unstrVarString,
+    structF, unstrF, nit, njt, nkt, cnt, eltType, objs, obju,
+    skipDiffVars, skipNoCoord, skipStructured, skipUnstructured, true);
+  E_Int nzones = unstrF.size();
+  if (res != 1 || nzones == 0)
+  {
+    for (E_Int iu = 0; iu < nzones; iu++)
+      RELEASESHAREDU(obju[iu], unstrF[iu], cnt[iu]);
+    PyErr_SetString(PyExc_TypeError,
+                    "createXRayMask: body arrays must be unstructured.");
+    return NULL;
+  }
+
+  E_Int elevationDir = 3;
+  if (dim == 2) elevationDir = 2;
+  vector<E_Int> posxb; vector<E_Int> posyb; vector<E_Int> poszb;
+  for (E_Int i = 0; i < nzones; i++)
+  {
+    E_Int posxi = K_ARRAY::isCoordinateXPresent(unstrVarString[i]);
+    E_Int posyi = K_ARRAY::isCoordinateYPresent(unstrVarString[i]);
+    E_Int poszi = K_ARRAY::isCoordinateZPresent(unstrVarString[i]);
+    if ((strcmp(eltType[i], "TRI") != 0 && strcmp(eltType[i], "BAR") != 0) ||
+        posxi == -1 || posyi == -1 || poszi == -1)
+    {
+      for (E_Int iu = 0; iu < nzones; iu++)
+        RELEASESHAREDU(obju[iu], unstrF[iu], cnt[iu]);
+      PyErr_SetString(PyExc_TypeError,
+                      "createXRayMask: body arrays must be all of TRI or BAR type with coordinates.");
+      return NULL;
+    }
+    posxb.push_back(posxi+1); posyb.push_back(posyi+1); poszb.push_back(poszi+1);
+    if (strcmp(eltType[i], "BAR") == 0) elevationDir = 2;
+  }
+
+  XRayMask* mask = new XRayMask;
+  mask->elevationDir = elevationDir; mask->isNot = isNot; mask->delta = delta;
+  mask->dim = dim; mask->xraydim1 = xraydim1; mask->xraydim2 = xraydim2;
+  mask->tol = tol;
+  mask->bodyKey = xrayBodyKey(posxb, posyb, poszb, unstrF, cnt);
+
+  /* Relecture si le fichier correspond */
+  if (fileName[0] != '\0')
+  {
+    E_Int err;
+    XRayMask* mask0 = readXRayMask(fileName, &err);
+    if (err == 2)
+      printf("Warning: createXRayMask: invalid X-Ray mask file %s. Mask is rebuilt.\n", fileName);
+    if (mask0 != NULL && sameXRayBuild(*mask0, *mask))
+    {
+      for (E_Int iu = 0; iu < nzones; iu++)
+        RELEASESHAREDU(obju[iu], unstrF[iu], cnt[iu]);
+      delete mask;
+      return buildXRayHook(mask0);
+    }
+    if (mask0 != NULL) { deleteXRayPlanes(mask0->planes); delete mask0; }
+  }
+
+  E_Int ok = compCharacteristics(isNot, elevationDir, xraydim1, xraydim2,
+                                 tol, delta, posxb, posyb, poszb, unstrF, cnt,
+                                 mask->planes,
+                                 mask->xmin, mask->ymin, mask->zmin,
+                                 mask->xmax, mask->ymax, mask->zmax);
+  for (E_Int iu = 0; iu < nzones; iu++)
+    RELEASESHAREDU(obju[iu], unstrF[iu], cnt[iu]);
+  if (ok == -1)
+  {
+    deleteXRayPlanes(mask->planes); delete mask;
+    PyErr_SetString(PyExc_ValueError,
+                    "createXRayMask: X-Ray mask has ambiguous faces.");
+    return NULL;
+  }
+  mask->xmin -= delta; mask->xmax += delta;
+  mask->ymin -= delta; mask->ymax += delta;
+  mask->zmin -= delta; mask->zmax += delta;
+
+  if (fileName[0] != '\0' && writeXRayMask(*mask, fileName) != 0)
+    printf("Warning: createXRayMask: can not write file %s.\n", fileName);
+
+  return buildXRayHook(mask);
+}
+
+//=============================================================================
+/* Libere le masque du hook. Le hook reste valide pour python mais tout
+   usage ulterieur du masque leve une erreur. */
+//=============================================================================
+PyObject* K_CONNECTOR::deleteXRayMask(PyObject* self, PyObject* args)
+{
+  PyObject* hook;
+  if (!PYPARSETUPLE_(args, O_, &hook)) return NULL;
+
+  XRayMask* mask = getXRayMask(hook, "deleteXRayMask");
+  if (mask == NULL) return NULL;
+  void** packet = NULL;
+#if (PY_MAJOR_VERSION == 2 && PY_MINOR_VERSION < 7) || (PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION < 1)
+  packet = (void**) PyCObject_AsVoidPtr(hook);
+#else
+  packet = (void**) PyCapsule_GetPointer(hook, NULL);
+#endif
+  deleteXRayPlanes(mask->planes);
+  delete mask;
+  packet[1] = NULL;
+#if (PY_MAJOR_VERSION == 2 && PY_MINOR_VERSION < 7) || (PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION < 1)
+  // pas de destructeur pour les CObject : le paquet est libere ici
+  delete (E_Int*)packet[0]; delete [] packet;
+#endif
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+//=============================================================================
+/* Sauvegarde le masque d'un hook dans un fichier */
+//=============================================================================
+PyObject* K_CONNECTOR::saveXRayMask(PyObject* self, PyObject* args)
+{
+  PyObject* hook; char* fileName;
+  if (!PYPARSETUPLE_(args, O_ S_, &hook, &fileName)) return NULL;
+
+  XRayMask* mask = getXRayMask(hook, "saveXRayMask");
+  if (mask == NULL) return NULL;
+  if (writeXRayMask(*mask, fileName) != 0)
+  {
+    PyErr_SetString(PyExc_IOError, "saveXRayMask: can not write file.");
+    return NULL;
+  }
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+//=============================================================================
+/* Relit un masque sauvegarde par saveXRayMask et retourne son hook */
+//=============================================================================
+PyObject* K_CONNECTOR::loadXRayMask(PyObject* self, PyObject* args)
+{
+  char* fileName;
+  if (!PYPARSETUPLE_(args, S_, &fileName)) return NULL;
+
+  E_Int err;
+  XRayMask* mask = readXRayMask(fileName, &err);
+  if (mask == NULL)
+  {
+    if (err == 1)
+      PyErr_SetString(PyExc_IOError, "loadXRayMask: can not read file.");
+    else
+      PyErr_SetString(PyExc_IOError, "loadXRayMask: invalid X-Ray mask file.");
+    return NULL;
+  }
+  return buildXRayHook(mask);
+}
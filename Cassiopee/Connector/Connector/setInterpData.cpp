@@ -48,6 +48,7 @@ using namespace K_FLD;
 //=============================================================================
 PyObject* K_CONNECTOR::setInterpData(PyObject* self, PyObject* args)
 {
+  K_PROFILE("setInterpData");
   PyObject* receiverArray;
   PyObject* donorArrays; // domaines d'interpolation
   E_Int Order;
@@ -579,6 +580,7 @@ PyObject* K_CONNECTOR::setInterpData(PyObject* self, PyObject* args)
 //=============================================================================
 PyObject* K_CONNECTOR::setInterpData(PyObject* self, PyObject* args)
 {
+  K_PROFILE("setInterpData");
   PyObject* receiverArray; 
   PyObject* donorArrays; // domaines d'interpolation
   E_Int Order;
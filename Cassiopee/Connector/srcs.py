@@ -12,6 +12,7 @@ cpp_srcs = ['Connector/KInterp/BlkInterp.cpp',
             'Connector/optimizeOverlap.cpp',
             'Connector/maximizeBlankedCells.cpp',
             'Connector/maskXRay.cpp',
+            'Connector/maskXRayHook.cpp',
             'Connector/maskGen.cpp',
             'Connector/blankCells.cpp',
             'Connector/blankCellsTetra.cpp',
@@ -54,6 +55,7 @@ cpp_srcs = ['Connector/KInterp/BlkInterp.cpp',
             "Connector/getIBMPtsWithTwoFronts.cpp",
             "Connector/getIBMPtsWithoutFront.cpp",
             "Connector/getIBMPtsBasic.cpp",
+            "Connector/IBC/sortIBMPtsByBins.cpp",
             "Connector/indiceToCoord2.cpp",
             "Connector/correctCoeffList.cpp",
             "Connector/modCellN.cpp",
@@ -0,0 +1,19 @@
+# - classifyPoints (array) -
+import Converter as C
+import Connector as X
+import Generator as G
+import Post as P
+
+# Tri mask
+m = G.cart((0.,0.,0.), (0.1,0.1,0.2), (10,10,10))
+m = P.exteriorFaces(m)
+m = C.convertArray2Tetra(m)
+mask = X.createBodyMask(m)
+
+a = G.cart((-0.5,-0.5,-0.5), (0.1,0.1,0.1), (25,25,30))
+inside = X.classifyPoints(mask, a)
+dist = X.getSignedDistance(mask, a)
+X.deleteBodyMask(mask)
+a = C.addVars(a, ['inside','dist'])
+a[1][3,:] = inside; a[1][4,:] = dist
+C.convertArrays2File(a, 'out.plt')
@@ -0,0 +1,26 @@
+# - classifyPoints/getSignedDistance (array) -
+import Converter as C
+import Connector as X
+import Generator as G
+import Post as P
+import KCore.test as test
+
+# Tri mask (boite fermee)
+m = G.cart((0.,0.,0.), (0.1,0.1,0.2), (10,10,10))
+m = P.exteriorFaces(m)
+m = C.convertArray2Tetra(m)
+mask = X.createBodyMask(m)
+
+# Points a classer
+a = G.cart((-0.5,-0.5,-0.5), (0.1,0.1,0.1), (25,25,30))
+inside = X.classifyPoints(mask, a)
+test.testO(inside, 1)
+dist = X.getSignedDistance(mask, a)
+test.testO(dist, 2)
+
+# Reutilisation du mask pour le blanking
+ca = C.array('cellN',25,25,30)
+ca = C.initVars(ca, 'cellN', 1.)
+celln = X.blankCellsTri([a], [ca], m, blankingType=0, mask=mask)
+test.testA(celln, 3)
+X.deleteBodyMask(mask)
@@ -0,0 +1,25 @@
+# - createXRayMask (array) -
+import Converter as C
+import Connector as X
+import Generator as G
+import Geom as D
+
+surf = D.sphere((0,0,0), 0.5, 20)
+
+# Le masque est construit une fois puis reutilise
+mask = X.createXRayMask([surf], blankingType=1, delta=0.)
+
+a = G.cart((-1.,-1.,-1.),(0.1,0.1,0.1), (20,20,20))
+ca = C.array('cellN',19,19,19)
+ca = C.initVars(ca, 'cellN', 1.)
+X._blankCells([a], [ca], mask, blankingType=1)
+
+b = G.cart((-0.6,-0.6,-0.6),(0.05,0.05,0.05), (25,25,25))
+cb = C.array('cellN',24,24,24)
+cb = C.initVars(cb, 'cellN', 1.)
+X._blankCells([b], [cb], mask, blankingType=1)
+X.deleteXRayMask(mask)
+
+a = C.node2Center(a); b = C.node2Center(b)
+celln = C.addVars([[a,b], [ca,cb]])
+C.convertArrays2File(celln, 'out.plt')
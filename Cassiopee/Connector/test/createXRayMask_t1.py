@@ -0,0 +1,87 @@
+# - createXRayMask (array) -
+import Converter as C
+import Connector as X
+import Generator as G
+import Geom as D
+import KCore.test as test
+
+surf = D.sphere((0,0,0), 0.5, 20)
+a = G.cart((-1.,-1.,-1.),(0.1,0.1,0.1), (20,20,20))
+
+c = 1
+for masknot in [0,1]:
+    for type in [1,0]:
+        mask = X.createXRayMask([surf], blankingType=type, delta=0., masknot=masknot)
+        if type == 0: ca = C.array('cellN',20,20,20)
+        else: ca = C.array('cellN',19,19,19)
+        ca = C.initVars(ca, 'cellN', 1.)
+        X._blankCells([a], [ca], mask, blankingType=type)
+        test.testA([ca], c)
+        # meme resultat qu'avec le corps
+        ca2 = C.initVars(ca, 'cellN', 1.)
+        X._blankCells([a], [ca2], [surf], type, 0., 3, masknot)
+        test.testA([ca2], c)
+        X.deleteXRayMask(mask)
+        c += 1
+
+# sauvegarde/relecture du masque
+import tempfile, os
+fd, fileName = tempfile.mkstemp(suffix='.xray'); os.close(fd); os.remove(fileName)
+mask = X.createXRayMask([surf], delta=0.1, fileName=fileName)
+mask2 = X.createXRayMask([surf], delta=0.1, fileName=fileName) # relu
+ca = C.array('cellN',19,19,19)
+ca = C.initVars(ca, 'cellN', 1.)
+X._blankCells([a], [ca], mask2, blankingType=1)
+test.testA([ca], c)
+X.deleteXRayMask(mask); X.deleteXRayMask(mask2)
+c += 1
+
+# parametres differents : le masque est reconstruit (et reecrit)
+mask = X.createXRayMask([surf], delta=0.2, fileName=fileName)
+ca = C.array('cellN',19,19,19)
+ca = C.initVars(ca, 'cellN', 1.)
+X._blankCells([a], [ca], mask, blankingType=1)
+test.testA([ca], c)
+ca2 = C.initVars(ca, 'cellN', 1.)
+X._blankCells([a], [ca2], [surf], 1, 0.2)
+test.testA([ca2], c)
+X.deleteXRayMask(mask)
+c += 1
+
+# corps different : le masque est reconstruit
+surf2 = D.sphere((0,0,0), 0.3, 20)
+mask = X.createXRayMask([surf2], delta=0.2, fileName=fileName)
+ca = C.array('cellN',19,19,19)
+ca = C.initVars(ca, 'cellN', 1.)
+X._blankCells([a], [ca], mask, blankingType=1)
+test.testA([ca], c)
+ca2 = C.initVars(ca, 'cellN', 1.)
+X._blankCells([a], [ca2], [surf2], 1, 0.2)
+test.testA([ca2], c)
+X.deleteXRayMask(mask)
+c += 1
+
+# fichier tronque : loadXRayMask leve une erreur, createXRayMask reconstruit
+mask = X.createXRayMask([surf], delta=0.1, fileName=fileName)
+X.deleteXRayMask(mask)
+size = os.path.getsize(fileName)
+with open(fileName, 'r+b') as f: f.truncate(size//2)
+try: X.loadXRayMask(fileName); ok = 0
+except IOError: ok = 1
+test.testO(ok, c)
+mask = X.createXRayMask([surf], delta=0.1, fileName=fileName)
+ca = C.array('cellN',19,19,19)
+ca = C.initVars(ca, 'cellN', 1.)
+X._blankCells([a], [ca], mask, blankingType=1)
+test.testA([ca], 5)
+test.testO(os.path.getsize(fileName) == size, c+1)
+c += 2
+
+# un masque libere n'est plus utilisable
+X.deleteXRayMask(mask)
+try: X._blankCells([a], [ca], mask, blankingType=1); ok = 0
+except ValueError: ok = 1
+try: X.deleteXRayMask(mask); ok2 = 0
+except ValueError: ok2 = 1
+test.testO([ok, ok2], c)
+os.remove(fileName)
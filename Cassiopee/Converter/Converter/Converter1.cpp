@@ -1061,25 +1061,27 @@ vector<E_Int> K_CONVERTER::getElementTypesId(const char* eltType)
 //=============================================================================
 // Lit les paths specifies dans le fichier file (seult HDF).
 // Retourne une liste d'objets pythons contenant les noeuds pointes par les
-// chemins 
+// chemins. Si links est une liste, les liens rencontres y sont ajoutes (HDF).
 //=============================================================================
 PyObject* K_CONVERTER::readPyTreeFromPaths(PyObject* self, PyObject* args)
 {
   char* fileName; char* format; 
   E_Int maxFloatSize; E_Int maxDepth; E_Int readMode; 
   PyObject* paths; PyObject* skipTypes; PyObject* dataShape; PyObject* mpi4pyCom;
-  if (!PYPARSETUPLE_(args, S_ O_ S_ III_ OOO_,
+  PyObject* links;
+  if (!PYPARSETUPLE_(args, S_ O_ S_ III_ OOOO_,
                      &fileName, &paths, &format, 
                      &maxFloatSize, &maxDepth, &readMode, 
-                     &dataShape, &skipTypes, &mpi4pyCom)) return NULL;
+                     &dataShape, &skipTypes, &mpi4pyCom, &links)) return NULL;
   
   if (skipTypes == Py_None) skipTypes = NULL;
   if (dataShape == Py_None) dataShape = NULL;
+  if (links == Py_None) links = NULL;
   PyObject* ret = NULL;
   if (K_STRING::cmp(format, "bin_cgns") == 0)
-    ret = K_IO::GenIO::getInstance()->hdfcgnsReadFromPaths(fileName, paths, maxFloatSize, maxDepth, readMode, dataShape, skipTypes, mpi4pyCom);
+    ret = K_IO::GenIO::getInstance()->hdfcgnsReadFromPaths(fileName, paths, maxFloatSize, maxDepth, readMode, dataShape, skipTypes, mpi4pyCom, links);
   else if (K_STRING::cmp(format, "bin_hdf") == 0)
-    ret = K_IO::GenIO::getInstance()->hdfcgnsReadFromPaths(fileName, paths, maxFloatSize, maxDepth, readMode, dataShape, skipTypes, mpi4pyCom);
+    ret = K_IO::GenIO::getInstance()->hdfcgnsReadFromPaths(fileName, paths, maxFloatSize, maxDepth, readMode, dataShape, skipTypes, mpi4pyCom, links);
   else if (K_STRING::cmp(format, "bin_adf") == 0)
     ret = K_IO::GenIO::getInstance()->adfcgnsReadFromPaths(fileName, paths, maxFloatSize, maxDepth);
   else
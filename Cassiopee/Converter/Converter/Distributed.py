@@ -10,6 +10,7 @@ from . import Converter
 from . import Internal
 from . import PyTree
 import numpy
+import os, pickle
 
 try: range = xrange
 except: pass
@@ -19,17 +20,137 @@ except: pass
 # Warning: pour l'instant limite a hdf et adf
 #==============================================================================
 def convertFile2SkeletonTree(fileName, format=None, maxFloatSize=5, 
-                             maxDepth=-1, dataShape=None, links=None):
+                             maxDepth=-1, dataShape=None, links=None, cache=False):
     """Read a file and return a skeleton tree."""
+    if cache and isHdf__(fileName, format):
+        t = readSkeletonIndex(fileName, maxFloatSize, maxDepth, dataShape, links)
+        if t is not None: return t
+        # rebuild index so that it also covers the previous index range
+        (mfs, md) = getSkeletonIndexRange__(fileName, maxFloatSize, maxDepth)
+        shape = {}; lks = []
+        t = PyTree.convertFile2PyTree(
+            fileName, format, skeletonData=[mfs,md], dataShape=shape, links=lks)
+        index = createSkeletonIndex__(t, fileName, mfs, md, shape, lks)
+        writeSkeletonIndex__(index, fileName)
+        return getSkeletonFromIndex__(index, maxFloatSize, maxDepth, dataShape, links)
     return PyTree.convertFile2PyTree(
         fileName, format, skeletonData=[maxFloatSize,maxDepth], 
         dataShape=dataShape, links=links)
 
+#==============================================================================
+# Index du squelette (fichier compagnon fileName.skel)
+# Contient l'arbre squelette, les chemins/types/shapes/offsets des datasets 
+# (dataShape) et les liens. L'index est valide tant que la date de 
+# modification et la taille du fichier n'ont pas change.
+# Un index lu avec (maxFloatSize, maxDepth) peut servir toute lecture avec
+# un maxFloatSize plus petit et un maxDepth plus faible.
+# Limite au format hdf.
+#==============================================================================
+SKELETON_INDEX_VERSION = 1
+
+def isHdf__(fileName, format=None):
+    if format is None: format = Converter.convertExt2Format__(fileName)
+    if format == 'bin_cgns' or format == 'unknown': format = Converter.checkFileType(fileName)
+    return format == 'bin_hdf'
+
+def getSkeletonIndexName__(fileName):
+    return fileName+'.skel'
+
+def getFileStamp__(fileName):
+    st = os.stat(fileName)
+    return (st.st_mtime_ns, st.st_size)
+
+# Profondeur d'un chemin (/Base/Zone -> 2)
+def getPathDepth__(path):
+    return len([p for p in path.split('/') if p != ''])
+
+# vrai si un index de profondeur d1 contient la profondeur d2
+def isDepthIncluded__(d2, d1):
+    if d1 == -1: return True
+    if d2 == -1: return False
+    return d2 <= d1
+
+# Reapplique les regles du lecteur squelette hdf sur un arbre deja squelette
+def _trimSkeleton__(node, maxFloatSize, maxDepth, depth=0):
+    v = node[1]
+    if isinstance(v, numpy.ndarray) and v.dtype.kind != 'S':
+        if node[3] == 'DataArray_t' or (node[3] == 'IndexArray_t' and v.dtype.kind != 'f'):
+            if maxFloatSize == 0 or v.size >= maxFloatSize: node[1] = None
+    if maxDepth != -1 and depth >= maxDepth: node[2] = []; return None
+    for n in node[2]: _trimSkeleton__(n, maxFloatSize, maxDepth, depth+1)
+    return None
+
+def loadSkeletonIndex__(fileName):
+    indexName = getSkeletonIndexName__(fileName)
+    if not os.access(indexName, os.R_OK): return None
+    try:
+        with open(indexName, 'rb') as f: index = pickle.load(f)
+    except Exception: return None
+    if not isinstance(index, dict) or index.get('version', 0) != SKELETON_INDEX_VERSION: return None
+    if index['stamp'] != getFileStamp__(fileName): return None
+    return index
+
+# Retourne le (maxFloatSize, maxDepth) couvrant la demande et l'index existant
+def getSkeletonIndexRange__(fileName, maxFloatSize, maxDepth):
+    index = loadSkeletonIndex__(fileName)
+    if index is None: return (maxFloatSize, maxDepth)
+    mfs = max(maxFloatSize, index['maxFloatSize'])
+    if isDepthIncluded__(maxDepth, index['maxDepth']): md = index['maxDepth']
+    else: md = maxDepth
+    return (mfs, md)
+
+def createSkeletonIndex__(t, fileName, maxFloatSize, maxDepth, dataShape=None, links=None):
+    return {'version':SKELETON_INDEX_VERSION, 'stamp':getFileStamp__(fileName),
+            'maxFloatSize':maxFloatSize, 'maxDepth':maxDepth, 'tree':t,
+            'dataShape':dataShape if dataShape is not None else {},
+            'links':links if links is not None else []}
+
+def writeSkeletonIndex__(index, fileName):
+    indexName = getSkeletonIndexName__(fileName)
+    tmpName = '%s.%d'%(indexName, os.getpid())
+    try:
+        with open(tmpName, 'wb') as f: pickle.dump(index, f, protocol=pickle.HIGHEST_PROTOCOL)
+        os.replace(tmpName, indexName)
+    except Exception:
+        print('Warning: writeSkeletonIndex: can not write %s.'%indexName)
+        if os.access(tmpName, os.F_OK): os.remove(tmpName)
+    return None
+
+# Extrait de l'index le squelette correspondant a (maxFloatSize, maxDepth)
+# Retourne None si l'index ne couvre pas la demande
+def getSkeletonFromIndex__(index, maxFloatSize, maxDepth, dataShape=None, links=None):
+    if maxFloatSize > index['maxFloatSize']: return None
+    if not isDepthIncluded__(maxDepth, index['maxDepth']): return None
+    if links is not None and index['links'] is None: return None
+    t = index['tree']
+    if maxFloatSize != index['maxFloatSize'] or maxDepth != index['maxDepth']:
+        _trimSkeleton__(t, maxFloatSize, maxDepth)
+    if dataShape is not None:
+        for p in index['dataShape']:
+            if maxDepth == -1 or getPathDepth__(p) <= maxDepth: dataShape[p] = index['dataShape'][p]
+    if links is not None:
+        for l in index['links']:
+            if maxDepth == -1 or getPathDepth__(l[3]) <= maxDepth: links.append(l)
+    return t
+
+def readSkeletonIndex(fileName, maxFloatSize=5, maxDepth=-1, dataShape=None, links=None):
+    """Read the skeleton index of a file. Return None if index is missing or outdated."""
+    index = loadSkeletonIndex__(fileName)
+    if index is None: return None
+    return getSkeletonFromIndex__(index, maxFloatSize, maxDepth, dataShape, links)
+
+def writeSkeletonIndex(t, fileName, maxFloatSize=5, maxDepth=-1, dataShape=None, links=None):
+    """Write the skeleton index of a file."""
+    index = createSkeletonIndex__(t, fileName, maxFloatSize, maxDepth, dataShape, links)
+    writeSkeletonIndex__(index, fileName)
+    return None
+
 #==============================================================================
 # Lit seulement un noeud de l'arbre ou ses enfants (suivant maxDepth)
+# si links est une liste, les liens rencontres y sont ajoutes (hdf)
 #==============================================================================
 def readNodesFromPaths(fileName, paths, format=None, maxFloatSize=-1, maxDepth=-1, 
-                       dataShape=None, skipTypes=None, com=None):
+                       dataShape=None, skipTypes=None, com=None, links=None):
   """Read nodes from file given their paths."""
   if format is None: format = Converter.convertExt2Format__(fileName)
   if not isinstance(paths, list): p = [paths]
@@ -38,7 +159,7 @@ def readNodesFromPaths(fileName, paths, format=None, maxFloatSize=-1, maxDepth=-
   if skipTypes is not None and isinstance(skipTypes, str): skipTypes = [skipTypes]
   if skipTypes is not None and isinstance(skipTypes, (str, tuple)): skipTypes = [skipTypes]
   
-  ret = Converter.converter.readPyTreeFromPaths(fileName, p, format, maxFloatSize, maxDepth, 0, dataShape, skipTypes, com)
+  ret = Converter.converter.readPyTreeFromPaths(fileName, p, format, maxFloatSize, maxDepth, 0, dataShape, skipTypes, com, links)
   if not isinstance(paths, list): return ret[0]
   else: return ret 
 
@@ -268,7 +389,7 @@ def _readZones(t, fileName, format=None, rank=None, zoneNames=None):
   if format is None: format = Converter.convertExt2Format__(fileName)
   if format == 'bin_cgns' or format == 'unknown': format = Converter.checkFileType(fileName)
 
-  loadedZones = Converter.converter.readPyTreeFromPaths(fileName, paths, format, -1, -1, 0, None, None, None)
+  loadedZones = Converter.converter.readPyTreeFromPaths(fileName, paths, format, -1, -1, 0, None, None, None, None)
 
   import Compressor.PyTree as Compressor
   for z in loadedZones: 
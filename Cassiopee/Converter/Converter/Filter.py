@@ -81,11 +81,12 @@ def writePyTreeFromFilter(t, fileName, filter, format='bin_hdf', com=None, skelD
 # ou de famille 'familySpecified:WALL'
 # maxDepth: peut-etre mis a 2 ou 3 suivant l'utilisant que l'on veut faire du squelette
 # readProcNode: si True, ajoute le procNode (pas lu si depth < 4)
+# cache: si True, utilise/ecrit l'index squelette fileName.skel (hdf)
 #============================================================================
 def readZoneHeaders(fileName, format=None, baseNames=None, familyZoneNames=None, BCType=None,
-                    maxDepth=3, readProcNode=False, readGridElementRange=False):
+                    maxDepth=3, readProcNode=False, readGridElementRange=False, cache=False):
     """Read zone headers."""
-    a = convertFile2SkeletonTree(fileName, format, maxDepth=maxDepth, maxFloatSize=6)
+    a = convertFile2SkeletonTree(fileName, format, maxDepth=maxDepth, maxFloatSize=6, cache=cache)
     # filter by base names
     if baseNames is not None:
         if not isinstance(baseNames, list): baseNames = [baseNames]
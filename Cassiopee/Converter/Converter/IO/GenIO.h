@@ -832,7 +832,8 @@ class GenIO
                                    E_Int maxFloatSize=1.e6, E_Int maxDepth=-1,
                                    E_Int readMode=0, PyObject* dataShape=NULL,
                                    PyObject* skipTypes=NULL, 
-                                   PyObject* mpi4pyCom=NULL);
+                                   PyObject* mpi4pyCom=NULL,
+                                   PyObject* links=NULL);
     PyObject* hdfcgnsReadFromPathsPartial(char* file, E_Int readMode,
                                           PyObject* Filters,
                                           PyObject* mpi4pyCom=NULL);
@@ -367,21 +367,22 @@ hid_t* K_IO::GenIOHdf::getChildren(hid_t nodeid)
 }
 
 //=============================================================================
-int HDF_Get_DataDimensions(hid_t nid, hsize_t *dims)
+// Dimensions du dataset did (deja ouvert)
+//=============================================================================
+int HDF_Get_DataDimensions(hid_t did, hsize_t *dims)
 {
   int n, ndims;
   hsize_t int_dim_vals[CGNSMAXDIM];
-  hid_t did, sid;
+  hid_t sid;
 
   L3M_CLEARDIMS(dims);
-  did = H5Dopen2(nid, L3S_DATA, H5P_DEFAULT);
   sid = H5Dget_space(did);
   ndims = H5Sget_simple_extent_ndims(sid);
   H5Sget_simple_extent_dims(sid, int_dim_vals, NULL);
 
   for (n = 0; n < ndims; n++){ dims[n] = int_dim_vals[n]; }
 
-  H5Dclose(did); H5Sclose(sid);
+  H5Sclose(sid);
 
   return 1;
 }
@@ -1330,7 +1331,8 @@ PyObject* K_IO::GenIO::hdfcgnsReadFromPaths(char* file, PyObject* paths,
                                             E_Int readMode, 
                                             PyObject* dataShape,
                                             PyObject* skipTypes,
-                                            PyObject* mpi4pyCom)
+                                            PyObject* mpi4pyCom,
+                                            PyObject* links)
 {
   if (PyList_Check(paths) == false)
   {
@@ -1437,7 +1439,7 @@ PyObject* K_IO::GenIO::hdfcgnsReadFromPaths(char* file, PyObject* paths,
       if (pos == std::string::npos) pos = 0; 
       shortPath = shortPath.erase(pos);
       HDF._stringStack.push_front(shortPath); // short path      
-      node = HDF.createNode(gid, dataShape, NULL);
+      node = HDF.createNode(gid, dataShape, links);
       HDF._stringStack.pop_front();
 
       PyObject* children = PyList_New(0);
@@ -1457,12 +1459,12 @@ PyObject* K_IO::GenIO::hdfcgnsReadFromPaths(char* file, PyObject* paths,
       shortPath = shortPath.erase(pos);
       
       HDF._stringStack.push_front(shortPath); // short path            
-      node = HDF.createNode(gid, dataShape, NULL);
+      node = HDF.createNode(gid, dataShape, links);
       HDF._stringStack.pop_front();
 
       HDF._stringStack.push_front(path);
       HDF._fatherStack.push_front(gid);
-      HDF.loadOne(node, 0, dataShape);
+      HDF.loadOne(node, 0, dataShape, links);
       HDF._fatherStack.pop_front();
       HDF._stringStack.pop_front();
       HDF._fatherStack.clear();
@@ -1630,9 +1632,12 @@ PyObject* K_IO::GenIOHdf::createNode(hid_t& node, PyObject* dataShape, PyObject*
   hid_t tid;
   tid = ADF_to_HDF_datatype(_dtype);
 
+  // dataset ouvert une fois pour les dimensions et l'offset
+  hid_t did = -1;
   if (strcmp(_dtype, L3T_MT) != 0)
   {
-    HDF_Get_DataDimensions(node, _dims2);
+    did = H5Dopen2(node, L3S_DATA, H5P_DEFAULT);
+    HDF_Get_DataDimensions(did, _dims2);
     for (d = 0; d < CGNSMAXDIM; d++)
     { if (_dims2[d] == -1) break; }
     dim = d;
@@ -1703,7 +1708,8 @@ PyObject* K_IO::GenIOHdf::createNode(hid_t& node, PyObject* dataShape, PyObject*
   if (dataShape != NULL)
   {
     // printf("Ajoute la shape au chemin \n");
-    PyObject* result = PyTuple_New(3);
+    // (1, dtype, shape, offset du dataset dans le fichier ou -1)
+    PyObject* result = PyTuple_New(4);
     PyObject* stid   = Py_BuildValue("h", 1);
     PyObject* type   = Py_BuildValue("s", _dtype);
         
@@ -1713,13 +1719,23 @@ PyObject* K_IO::GenIOHdf::createNode(hid_t& node, PyObject* dataShape, PyObject*
     PyObject* shape = PyTuple_New(dim);
     for (int i = 0; i < dim; i++) 
     {
-      // PyObject* temp = Py_BuildValue("%d", _dims[i]);
-      PyObject* temp = Py_BuildValue("h", _dims[i]);
+      PyObject* temp = Py_BuildValue("L", (long long)_dims[i]);
       PyTuple_SetItem(shape, i, temp);
     }
-    PyTuple_SetItem(result, 2, shape); 
-    PyDict_SetItemString(dataShape, _currentPath.c_str(), result); 
+    PyTuple_SetItem(result, 2, shape);
+
+    // offset du dataset (seulement pour les datasets contigus)
+    long long offset = -1;
+    if (did >= 0)
+    {
+      haddr_t addr = H5Dget_offset(did);
+      if (addr != HADDR_UNDEF) offset = (long long)addr;
+    }
+    PyTuple_SetItem(result, 3, Py_BuildValue("L", offset));
+    PyDict_SetItemString(dataShape, _currentPath.c_str(), result);
+    Py_DECREF(result);
   }
+  if (did >= 0) H5Dclose(did);
 
   // if (tid != 0) H5Tclose(tid);
   PyObject* s = Py_BuildValue("[sOOs]", _name, v, Py_None, _type);
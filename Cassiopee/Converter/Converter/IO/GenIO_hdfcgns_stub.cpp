@@ -38,7 +38,8 @@ E_Int K_IO::GenIO::hdfcgnsread(char* file, PyObject*& tree, PyObject* dataShape,
 PyObject* K_IO::GenIO::hdfcgnsReadFromPaths(char* file, PyObject* paths,
                                             E_Int maxFloatSize, E_Int maxDepth, E_Int readMode,
                                             PyObject* dataShape,
-                                            PyObject* skipTypes, PyObject* mpi4pyCom)
+                                            PyObject* skipTypes, PyObject* mpi4pyCom,
+                                            PyObject* links)
 { 
   printf("Error: Converter has been installed without CGNS/HDF support.\n");
   printf("Error: please install libhdf5 first for CGNS/HDF support.\n");
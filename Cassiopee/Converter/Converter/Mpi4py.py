@@ -440,16 +440,82 @@ def gatherZones(zones, root=0):
 #==============================================================================
 # Lecture du squelette d'un arbre dans un fichier
 # Lecture proc 0 + bcast
+# si cache=True (hdf): utilise l'index fileName.skel s'il est valide, sinon 
+# les sous-arbres des bases sont lus en parallele par les procs, fusionnes
+# et l'index est ecrit par le proc 0
 #==============================================================================
 def convertFile2SkeletonTree(fileName, format=None, maxFloatSize=5,
-                             maxDepth=-1, links=None):
+                             maxDepth=-1, links=None, cache=False):
     """Read a file and return a skeleton tree."""
-    if rank == 0: t = Distributed.convertFile2SkeletonTree(fileName, format, maxFloatSize, maxDepth, None, links)
+    if not cache or size == 1 or (maxDepth >= 0 and maxDepth <= 2):
+        if rank == 0: t = Distributed.convertFile2SkeletonTree(fileName, format, maxFloatSize, maxDepth, None, links, cache)
+        else: t = None
+        t = KCOMM.bcast(t)
+        if links is not None:
+            lk = KCOMM.bcast(links)
+            if rank > 0: links += lk
+        return t
+
+    # Essai de l'index
+    lks = []
+    if rank == 0:
+        hdf = Distributed.isHdf__(fileName, format)
+        if hdf: t = Distributed.readSkeletonIndex(fileName, maxFloatSize, maxDepth, None, lks)
+        else: t = Distributed.convertFile2SkeletonTree(fileName, format, maxFloatSize, maxDepth, None, lks)
+    else: t = None; hdf = None
+    (t, hdf, lks) = KCOMM.bcast((t, hdf, lks))
+    if t is not None or not hdf:
+        if links is not None: links += lks
+        return t
+
+    # Scan parallele: proc 0 lit les deux premiers niveaux
+    if rank == 0:
+        (mfs, md) = Distributed.getSkeletonIndexRange__(fileName, maxFloatSize, maxDepth)
+        shape = {}; lks = []
+        t = C.convertFile2PyTree(fileName, 'bin_hdf', skeletonData=[mfs,2], dataShape=shape, links=lks)
+    else: t = None; mfs = None; md = None
+    (t, mfs, md) = KCOMM.bcast((t, mfs, md))
+
+    # Sous-arbres a scanner (enfants des bases et noeuds non base de niveau 1)
+    paths = []
+    for n in t[2]:
+        if n[3] == 'CGNSBase_t':
+            for c in n[2]: paths.append('/%s/%s'%(n[0],c[0]))
+        elif n[2] != []: paths.append('/%s'%n[0])
+    npaths = len(paths)
+    start = (npaths*rank)//size; end = (npaths*(rank+1))//size
+    myPaths = paths[start:end]
+    myShape = {}; myLinks = []; myNodes = [None]*len(myPaths)
+    # lecture groupee par profondeur (profondeur relative au noeud lu)
+    depths = {}
+    for c, p in enumerate(myPaths):
+        d = Distributed.getPathDepth__(p)
+        if d not in depths: depths[d] = []
+        depths[d].append(c)
+    for d in depths:
+        rmd = -1
+        if md >= 0: rmd = md-d
+        nodes = Distributed.readNodesFromPaths(fileName, [myPaths[c] for c in depths[d]], 'bin_hdf', mfs, rmd, dataShape=myShape, links=myLinks)
+        for i, c in enumerate(depths[d]): myNodes[c] = nodes[i]
+    allNodes = KCOMM.gather((myPaths, myNodes, myShape, myLinks), root=0)
+
+    if rank == 0:
+        # un lien sur un chemin scanne est vu par le proc 0 et par le scan
+        lkPaths = set([l[3] for l in lks])
+        for (ps, nodes, sh, lk) in allNodes:
+            for c, p in enumerate(ps):
+                n = Internal.getNodeFromPath(t, p)
+                if n is not None: n[1] = nodes[c][1]; n[2] = nodes[c][2]
+            shape.update(sh)
+            for l in lk:
+                if l[3] not in lkPaths: lks.append(l); lkPaths.add(l[3])
+        index = Distributed.createSkeletonIndex__(t, fileName, mfs, md, shape, lks)
+        Distributed.writeSkeletonIndex__(index, fileName)
+        lks = []
+        t = Distributed.getSkeletonFromIndex__(index, maxFloatSize, maxDepth, None, lks)
     else: t = None
-    t = KCOMM.bcast(t)
-    if links is not None:
-        lk = KCOMM.bcast(links)
-        if rank > 0: links += lk
+    (t, lks) = KCOMM.bcast((t, lks))
+    if links is not None: links += lks
     return t
 
 #==============================================================================
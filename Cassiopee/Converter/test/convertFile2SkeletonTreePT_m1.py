@@ -0,0 +1,43 @@
+# - convertFile2SkeletonTree (pyTree) -
+# avec index squelette et scan parallele
+import Converter.PyTree as C
+import Converter.Internal as Internal
+import Generator.PyTree as G
+import Converter.Mpi as Cmpi
+import KCore.test as test
+
+LOCAL = test.getLocal()
+
+if Cmpi.rank == 0:
+    zones = [G.cart((i,0.,0.),(0.1,0.1,0.1),(11,11,11)) for i in range(5)]
+    t = C.newPyTree(['Base', zones])
+    C._addBC2Zone(t, 'wall', 'BCWall', 'imin')
+    C.convertPyTree2File(t, LOCAL+'/in.hdf')
+Cmpi.barrier()
+
+# scan parallele + ecriture de l'index
+t1 = Cmpi.convertFile2SkeletonTree(LOCAL+'/in.hdf', cache=True)
+if Cmpi.rank == 0: test.testT(t1, 1)
+
+# relecture de l'index
+t2 = Cmpi.convertFile2SkeletonTree(LOCAL+'/in.hdf', cache=True)
+if Cmpi.rank == 0: test.testT(t2, 1)
+
+# fichier avec liens : les liens sont gardes par le scan et par l'index
+if Cmpi.rank == 0:
+    C.convertPyTree2File(t, LOCAL+'/coord.hdf')
+    C._initVars(t, 'Density', 1.)
+    links = []
+    for z in Internal.getZones(t):
+        p = '/Base/%s/GridCoordinates'%z[0]
+        links.append(['.', LOCAL+'/coord.hdf', p, p])
+    C.convertPyTree2File(t, LOCAL+'/main.hdf', links=links)
+Cmpi.barrier()
+LC = []
+t3 = Cmpi.convertFile2SkeletonTree(LOCAL+'/main.hdf', cache=True, links=LC)
+LC2 = []
+t4 = Cmpi.convertFile2SkeletonTree(LOCAL+'/main.hdf', cache=True, links=LC2)
+if Cmpi.rank == 0:
+    test.testT(t3, 2)
+    test.testO(sorted([l[3] for l in LC]), 3)
+    test.testO(sorted([l[3] for l in LC2]), 3)
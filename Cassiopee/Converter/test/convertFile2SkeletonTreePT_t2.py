@@ -0,0 +1,30 @@
+# - convertFile2SkeletonTree (pyTree) -
+# avec index squelette
+import Converter.PyTree as C
+import Generator.PyTree as G
+import Converter.Distributed as Distributed
+import Converter.Filter as Filter
+import KCore.test as test
+
+LOCAL = test.getLocal()
+
+a = G.cart((0.,0.,0.),(0.1,0.1,0.1),(11,11,11))
+b = G.cart((1.,0.,0.),(0.1,0.1,0.1),(11,11,11))
+t = C.newPyTree(['Base', a, 'Base2', b])
+C._addBC2Zone(t, 'wall', 'BCWall', 'imin')
+C.convertPyTree2File(t, LOCAL+'/in.hdf')
+
+# cree l'index
+t1 = Distributed.convertFile2SkeletonTree(LOCAL+'/in.hdf', cache=True)
+test.testT(t1, 1)
+
+# relit depuis l'index
+shape = {}
+t2 = Distributed.convertFile2SkeletonTree(LOCAL+'/in.hdf', dataShape=shape, cache=True)
+test.testT(t2, 1)
+test.testO(shape['/Base/cart/GridCoordinates/CoordinateX'][2], 2)
+
+# lecture partielle depuis l'index
+a, znp = Filter.readZoneHeaders(LOCAL+'/in.hdf', cache=True)
+test.testT(a, 3)
+test.testO(znp, 4)
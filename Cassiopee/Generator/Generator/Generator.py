@@ -29,7 +29,7 @@ __all__ = ['cart', 'cartr1', 'cartr2', 'cartHexa', 'cartTetra', 'cartPenta',
     'cutOctant', 'octree', 'conformOctree3', 'adaptOctree', 'expandLayer',
     'forceMatch', '_forceMatch', 'getOrthogonalityMap', 'getRegularityMap',
     'getAngleRegularityMap', 'getTriQualityMap', 'getTriQualityStat',
-    'quad2Pyra', 'extendCartGrids', 'checkMesh']
+    'quad2Pyra', 'extendCartGrids', 'checkMesh', 'getMeshQuality']
 
 def cart(Xo, H, N, api=1):
     """Create a cartesian mesh defined by a structured array.
@@ -928,6 +928,7 @@ def stack(array1, array2=None):
 def TFI(arrays):
     """Generate a transfinite interpolation mesh from boundaries.
     Usage: TFI(arrays)"""
+    # arrays peut etre une liste de listes de frontieres : un bloc par liste
     return generator.TFI(arrays)
 
 def TFITri(a1, a2, a3):
@@ -966,10 +967,13 @@ def TFIStar2(a):
     from . import TFIs
     return TFIs.TFIStar2(a)
 
-def TTM(array, niter=100):
+def TTM(array, niter=100, eps=1.e-13):
     """Smooth a mesh with Thompson-Mastin elliptic generator.
-    Usage: TTM(array, niter)"""
-    return generator.TTM(array, niter)
+    Usage: TTM(array, niter, eps)"""
+    # les frontieres sont fixes : les raccords entre blocs sont conserves
+    if isinstance(array[0], list):
+        return [generator.TTM(a, niter, eps) for a in array]
+    return generator.TTM(array, niter, eps)
 
 def bboxOfCells(array):
     """Return the bounding box of all cells of an array.
@@ -1044,6 +1048,14 @@ def getSmoothNormalMap(array, niter=2, eps=0.4, cellN=None, algo=0):
 
     n = C.center2Node(n)
     n = C.normalize(n, ['sx','sy','sz'])
+
+    # surface TRI/QUAD sans cellN : iterations de lissage en une passe parallele
+    if cellN is None and len(array) == 4 and array[3] in ['TRI','QUAD']:
+        nit = int(numpy.ceil(niter))-1 # niter peut etre reel
+        if nit > 0:
+            if not isinstance(eps, numpy.ndarray): eps = float(eps)
+            generator.smoothNormalMap(array, n, eps, nit, algo)
+        return n
     
     while it < niter:
         np = C.node2Center(n)
@@ -2509,12 +2521,75 @@ def getMeshFieldInfo(array, field, critValue, verbose):
 
     return fmin, fmax, fsum/float(size), fcrit
 
+#==============================================================================
+# Qualite de grilles structurees en une seule passe parallele :
+# volume, orthogonalite, regularite et regularite angulaire
+# IN: crits: seuils [vol, orthogonality, regularity, regularityAngle]
+# IN: edges: bornes des histogrammes (4 listes croissantes) ou None
+# IN: fields: si True, retourne aussi les cartes en centres
+# OUT: dictionnaire par indicateur : min, max, mean, crit, size, zones
+# (par zone : [min, max, mean, crit, size]), worst ([no zone, indice de
+# cellule, valeur]), hist ; 'fields' : liste d'arrays en centres
+#==============================================================================
+__QUALITY_FIELDS__ = ['vol', 'orthogonality', 'regularity', 'regularityAngle']
+
+def getMeshQuality(array, crits=[0.,15.,0.1,15.], edges=None, fields=False):
+    """Return quality statistics of structured grids, computed in one pass.
+    Usage: getMeshQuality(array, crits, edges, fields)"""
+    if not isinstance(array[0], list): array = [array]
+    for a in array:
+        if len(a) != 5: raise TypeError("getMeshQuality: arrays must be structured.")
+    if edges is None: edgesN = []
+    else: edgesN = [numpy.array(e, dtype=numpy.float64) for e in edges]
+    (zstats, hists, worst, fl) = generator.getMeshQuality(array, [float(c) for c in crits], edgesN, int(fields))
+    sizes = [max(a[2]-1,1)*max(a[3]-1,1)*max(a[4]-1,1) for a in array]
+    size = sum(sizes)
+    ret = {}
+    for q, name in enumerate(__QUALITY_FIELDS__):
+        zs = zstats[:,4*q:4*q+4]
+        zones = [[zs[c,0], zs[c,1], zs[c,2]/float(sizes[c]), int(zs[c,3]), sizes[c]] for c in range(len(array))]
+        ret[name] = {'min':numpy.min(zs[:,0]), 'max':numpy.max(zs[:,1]),
+                     'mean':numpy.sum(zs[:,2])/float(size), 'crit':int(numpy.sum(zs[:,3])),
+                     'size':size, 'zones':zones, 'worst':worst[q]}
+        if edgesN != []: ret[name]['hist'] = hists[q]
+    if fields: ret['fields'] = fl
+    return ret
+
+# Affichage des statistiques d'un indicateur (meme format que getMeshFieldInfo)
+def printMeshQualityInfo__(stats, field, critValue, verbose, zoneNames=None):
+    info = 'INFO %s: min = %1.2e, max = %1.2e, mean = %1.2e, crit(%s %s %s) = %s cells out of %s | %2.2f%% (%s)'
+    op = '<' if field == 'vol' else '>'
+    s = stats[field]
+    fcrit_loc = 0
+    for cpt, z in enumerate(s['zones']):
+        (fmin_loc, fmax_loc, fmean_loc, fcrit_loc, size_loc) = z
+        if verbose == 2 or (verbose == 1 and fcrit_loc > 0):
+            name = zoneNames[cpt] if zoneNames is not None else "Zone %d"%(cpt)
+            print(info%(field.upper(),fmin_loc,fmax_loc,fmean_loc,field,op,critValue,fcrit_loc,size_loc,fcrit_loc/float(size_loc)*100,name))
+    if verbose == 2 or (verbose == 1 and fcrit_loc > 0):
+        print('#'*(len(field)+7))
+        print(info%(field.upper(),s['min'],s['max'],s['mean'],field,op,critValue,s['crit'],s['size'],s['crit']/float(s['size'])*100,'GLOBAL'))
+        print('#'*(len(field)+7)+'\n')
+    return s['min'], s['max'], s['mean'], s['crit']
+
 def checkMesh(array, critVol=0., critOrtho=15., critReg=0.1, critAngReg=15., addGC=False, verbose=0):
     """Return information on mesh quality."""
     if not isinstance(array[0], list): array = [array] 
 
     #addGC: dummy argument to match the pyTree function
 
+    # grilles structurees : une seule passe pour les 4 indicateurs
+    if all(len(a) == 5 for a in array):
+        stats = getMeshQuality(array, [critVol, critOrtho, critReg, critAngReg])
+        vmin,vmax,vmean,vcrit = printMeshQualityInfo__(stats, 'vol', critVol, verbose)
+        omin,omax,omean,ocrit = printMeshQualityInfo__(stats, 'orthogonality', critOrtho, verbose)
+        rmin,rmax,rmean,rcrit = printMeshQualityInfo__(stats, 'regularity', critReg, verbose)
+        amin,amax,amean,acrit = printMeshQualityInfo__(stats, 'regularityAngle', critAngReg, verbose)
+        return {'vmin':vmin,'vmax':vmax,'vmean':vmean,'vcrit':vcrit,
+                'rmin':rmin,'rmax':rmax,'rmean':rmean,'rcrit':rcrit,
+                'amin':amin,'amax':amax,'amean':amean,'acrit':acrit,
+                'omin':omin,'omax':omax,'omean':omean,'ocrit':ocrit}
+
     vmin,vmax,vmean,vcrit = getMeshFieldInfo(array, 'vol', critVol, verbose)
     omin,omax,omean,ocrit = getMeshFieldInfo(array, 'orthogonality', critOrtho, verbose)
     rmin,rmax,rmean,rcrit = getMeshFieldInfo(array, 'regularity', critReg, verbose)
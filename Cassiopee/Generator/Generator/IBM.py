@@ -398,7 +398,7 @@ def generateIBMMeshPara(tb, vmin=15, snears=None, dimPb=3, dfar=10., dfarList=[]
         o = buildOctree(tb, snears=snears, snearFactor=1., dfar=dfar, dfarList=dfarList,
                                 to=to, tbox=tbox, snearsf=snearsf,
                                 dimPb=dimPb, vmin=vmin, fileout=None, rank=Cmpi.rank,
-                                expand=expand, dfarDir=dfarDir, mode=mode)
+                                expand=expand, dfarDir=dfarDir, mode=mode, distrib=True)
 
     if Cmpi.rank==0 and check: C.convertPyTree2File(o,fileout)
     # build parent octree 3 levels higher
@@ -447,11 +447,11 @@ def generateIBMMeshPara(tb, vmin=15, snears=None, dimPb=3, dfar=10., dfarList=[]
 
         if Cmpi.rank==0 and check: C.convertPyTree2File(o,fileout)
 
-    # Split octree
+    # Split octree : plages de feuilles contigues suivant la courbe de Morton
     bb = G.bbox(o)
     NPI = Cmpi.size
     if NPI == 1: p = Internal.copyRef(o) # keep reference
-    else: p = T.splitNParts(o, N=NPI, recoverBC=False)[Cmpi.rank]
+    else: p = splitOctreeMorton__(o)
     del o
 
     # fill vmin + merge in parallel
@@ -498,8 +498,61 @@ def generateIBMMeshPara(tb, vmin=15, snears=None, dimPb=3, dfar=10., dfarList=[]
     return t
 
 
+#==============================================================================
+# Plage [n0,n1[ des feuilles de l'octree attribuee au rang rank
+# Chaque feuille donne un bloc de vmin^dim cellules : des plages de meme
+# nombre de feuilles portent le meme nombre de cellules.
+#==============================================================================
+def getOctreeRange__(nelts, rank, size):
+    n0 = (nelts*rank)//size
+    n1 = (nelts*(rank+1))//size
+    return n0, n1
+
+#==============================================================================
+# Partie de l'octree du rang courant : les feuilles sont ordonnees suivant la
+# courbe de Morton et chaque rang garde une plage contigue de feuilles
+# (sous-domaines compacts, peu de raccords entre rangs)
+# IN: o: octree identique sur tous les rangs
+#==============================================================================
+def splitOctreeMorton__(o):
+    o = T.renumber(o, method='morton')
+    nelts = Internal.getZoneDim(o)[2]
+    n0, n1 = getOctreeRange__(nelts, Cmpi.rank, Cmpi.size)
+    elts = numpy.arange(n0, n1, dtype=Internal.E_NpyInt)
+    return T.subzone(o, elts, type='elements')
+
+#==============================================================================
+# cellN aux centres de l'octree masque par les corps de tb
+# Si distrib: chaque rang masque sa plage de feuilles, les cellN des rangs
+# sont ensuite rassembles (l'octree doit etre identique sur tous les rangs)
+# OUT: champ cellN aux centres de l'octree
+#==============================================================================
+def blankOctree__(o, tb, dimPb, distrib=False, masks=None):
+    if not distrib or Cmpi.size == 1:
+        to = C.newPyTree(['Base',o])
+        to = X_IBM.blankByIBCBodies(to, tb, 'centers', dimPb, masks=masks)
+        return C.getField("centers:cellN", to)[0]
+
+    nelts = Internal.getZoneDim(o)[2]
+    n0, n1 = getOctreeRange__(nelts, Cmpi.rank, Cmpi.size)
+    if n1 > n0:
+        elts = numpy.arange(n0, n1, dtype=Internal.E_NpyInt)
+        p = T.subzone(o, elts, type='elements')
+        to = C.newPyTree(['Base',p])
+        to = X_IBM.blankByIBCBodies(to, tb, 'centers', dimPb, masks=masks)
+        cellNLoc = C.getField("centers:cellN", to)[0][1].ravel('k')
+    else: cellNLoc = numpy.empty(0, dtype=numpy.float64)
+    cellNLoc = Cmpi.allgather(cellNLoc)
+
+    C._initVars(o, 'centers:cellN', 1.)
+    cellN = C.getField("centers:cellN", o)[0]
+    C._rmVars(o, 'centers:cellN')
+    cellN[1][0,:] = numpy.concatenate(cellNLoc)
+    return cellN
+
 def buildOctree(tb, snears=None, snearFactor=1., dfar=10., dfarList=[], to=None, tbox=None, snearsf=None,
-                dimPb=3, vmin=15, balancing=2, fileout=None, rank=0, expand=2, dfarDir=0, mode=0):
+                dimPb=3, vmin=15, balancing=2, fileout=None, rank=0, expand=2, dfarDir=0, mode=0,
+                distrib=False):
     i = 0; surfaces=[]; snearso=[] # pas d'espace sur l'octree
     dfarListL = []
     bodies = Internal.getZones(tb)
@@ -536,6 +589,10 @@ def buildOctree(tb, snears=None, snearFactor=1., dfar=10., dfarList=[], to=None,
             o = addRefinementZones(o, tb, tbox, snearsf, vmin, dimPb)
             C._rmVars(o, ['centers:indicator', 'centers:cellN', 'centers:vol', 'centers:cellNBody'])
 
+        # en 3D, les masques des corps sont construits une fois pour toutes les passes
+        masks = None
+        if expand > 0 and dimPb == 3: masks = X_IBM.createIBCBodyMasks(tb)
+
         #if expand > 0: C.convertPyTree2File(o, 'startOctree.cgns')
         if expand == 0:
             G._expandLayer(o, level=0, corners=1, balancing=1)
@@ -543,10 +600,8 @@ def buildOctree(tb, snears=None, snearFactor=1., dfar=10., dfarList=[], to=None,
             vmint = 31
             if vmin < vmint:
                 if rank==0: print('buildOctree: octree finest level expanded (expandLayer activated).')
-                to = C.newPyTree(['Base',o])
-                to = X_IBM.blankByIBCBodies(to, tb, 'centers', dimPb)
+                cellN = blankOctree__(o, tb, dimPb, distrib, masks)
                 C._initVars(o, "centers:indicator", 0.)
-                cellN = C.getField("centers:cellN", to)[0]
                 octreeA = C.getFields(Internal.__GridCoordinates__, o)[0]
                 indic = C.getField("centers:indicator", o)[0]
                 indic = Generator.generator.modifyIndicToExpandLayer(octreeA, indic, 0, 0, 2)
@@ -558,9 +613,7 @@ def buildOctree(tb, snears=None, snearFactor=1., dfar=10., dfarList=[], to=None,
                 octreeA = Generator.adaptOctree(octreeA, indic, balancing=2)
                 o = C.convertArrays2ZoneNode(o[0], [octreeA])
 
-            to = C.newPyTree(['Base',o])
-            to = X_IBM.blankByIBCBodies(to, tb, 'centers', dimPb)
-            indic = C.getField("centers:cellN",to)[0]
+            indic = blankOctree__(o, tb, dimPb, distrib, masks)
             octreeA = C.getFields(Internal.__GridCoordinates__, o)[0]
             indic = Converter.initVars(indic, 'indicator', 0.)
             indic = Generator.generator.modifyIndicToExpandLayer(octreeA, indic, 0,0,1)
@@ -570,10 +623,8 @@ def buildOctree(tb, snears=None, snearFactor=1., dfar=10., dfarList=[], to=None,
 
         elif expand == 2: # expand minimum
             corner = 0
-            to = C.newPyTree(['Base',o])
-            to = X_IBM.blankByIBCBodies(to, tb, 'centers', dimPb)
+            cellN = blankOctree__(o, tb, dimPb, distrib, masks)
             C._initVars(o, "centers:indicator", 0.)
-            cellN = C.getField("centers:cellN", to)[0]
             octreeA = C.getFields(Internal.__GridCoordinates__, o)[0]
             indic = C.getField("centers:indicator", o)[0]
             indic = Converter.addVars([indic,cellN])
@@ -595,10 +646,8 @@ def buildOctree(tb, snears=None, snearFactor=1., dfar=10., dfarList=[], to=None,
         elif expand == 3: # expand minimum + 1 couche propagee
             #C.convertPyTree2File(o, 'octree1.cgns')
             corner = 0
-            to = C.newPyTree(['Base',o])
-            to = X_IBM.blankByIBCBodies(to, tb, 'centers', dimPb)
+            cellN = blankOctree__(o, tb, dimPb, distrib, masks)
             C._initVars(o, "centers:indicator", 0.)
-            cellN = C.getField("centers:cellN", to)[0]
             octreeA = C.getFields(Internal.__GridCoordinates__, o)[0]
             indic = C.getField("centers:indicator", o)[0]
             indic = Converter.addVars([indic,cellN])
@@ -607,10 +656,8 @@ def buildOctree(tb, snears=None, snearFactor=1., dfar=10., dfarList=[], to=None,
             o = C.convertArrays2ZoneNode(o[0], [octreeA])
 
             # passe 2
-            to = C.newPyTree(['Base',o])
-            to = X_IBM.blankByIBCBodies(to, tb, 'centers', dimPb)
+            cellN = blankOctree__(o, tb, dimPb, distrib, masks)
             C._initVars(o, "centers:indicator", 0.)
-            cellN = C.getField("centers:cellN", to)[0]
             octreeA = C.getFields(Internal.__GridCoordinates__, o)[0]
             indic = C.getField("centers:indicator", o)[0]
             indic = Converter.addVars([indic,cellN])
@@ -632,10 +679,8 @@ def buildOctree(tb, snears=None, snearFactor=1., dfar=10., dfarList=[], to=None,
 
         elif expand == 4: # expand minimum + 2 couche propagee
             corner = 0
-            to = C.newPyTree(['Base',o])
-            to = X_IBM.blankByIBCBodies(to, tb, 'centers', dimPb)
+            cellN = blankOctree__(o, tb, dimPb, distrib, masks)
             C._initVars(o, "centers:indicator", 0.)
-            cellN = C.getField("centers:cellN", to)[0]
             octreeA = C.getFields(Internal.__GridCoordinates__, o)[0]
             indic = C.getField("centers:indicator", o)[0]
             indic = Converter.addVars([indic,cellN])
@@ -644,10 +689,8 @@ def buildOctree(tb, snears=None, snearFactor=1., dfar=10., dfarList=[], to=None,
             o = C.convertArrays2ZoneNode(o[0], [octreeA])
 
             # passe 2
-            to = C.newPyTree(['Base',o])
-            to = X_IBM.blankByIBCBodies(to, tb, 'centers', dimPb)
+            cellN = blankOctree__(o, tb, dimPb, distrib, masks)
             C._initVars(o, "centers:indicator", 0.)
-            cellN = C.getField("centers:cellN", to)[0]
             octreeA = C.getFields(Internal.__GridCoordinates__, o)[0]
             indic = C.getField("centers:indicator", o)[0]
             indic = Converter.addVars([indic,cellN])
@@ -656,10 +699,8 @@ def buildOctree(tb, snears=None, snearFactor=1., dfar=10., dfarList=[], to=None,
             o = C.convertArrays2ZoneNode(o[0], [octreeA])
 
             # passe 3
-            to = C.newPyTree(['Base',o])
-            to = X_IBM.blankByIBCBodies(to, tb, 'centers', dimPb)
+            cellN = blankOctree__(o, tb, dimPb, distrib, masks)
             C._initVars(o, "centers:indicator", 0.)
-            cellN = C.getField("centers:cellN", to)[0]
             octreeA = C.getFields(Internal.__GridCoordinates__, o)[0]
             indic = C.getField("centers:indicator", o)[0]
             indic = Converter.addVars([indic,cellN])
@@ -667,6 +708,8 @@ def buildOctree(tb, snears=None, snearFactor=1., dfar=10., dfarList=[], to=None,
             octreeA = Generator.adaptOctree(octreeA, indic, balancing=2)
             o = C.convertArrays2ZoneNode(o[0], [octreeA])
 
+        if masks is not None: X_IBM.deleteIBCBodyMasks(masks)
+
         #if expand > 0: C.convertPyTree2File(o, 'endOctree.cgns')
         G._getVolumeMap(o); volmin = C.getMinValue(o, 'centers:vol')
         C._rmVars(o, 'centers:vol')
@@ -720,10 +763,12 @@ def addRefinementZones(o, tb, tbox, snearsf, vmin, dim):
     volmin0 = C.getMinValue(to, 'centers:vol')
     # volume minimum au dela duquel on ne peut pas raffiner
     volmin0 = 1.*volmin0
+    masks = None
+    if dim == 3: masks = X_IBM.createIBCBodyMasks(tb)
     while end == 0:
         # Do not refine inside obstacles
         C._initVars(to, 'centers:cellN', 1.)
-        to = X_IBM.blankByIBCBodies(to, tb, 'centers', dim)
+        to = X_IBM.blankByIBCBodies(to, tb, 'centers', dim, masks=masks)
         C._initVars(to, '{centers:cellNBody}={centers:cellN}')
         nob = 0
         C._initVars(to, 'centers:indicator', 0.)
@@ -755,6 +800,7 @@ def addRefinementZones(o, tb, tbox, snearsf, vmin, dim):
             to[2][1][2] = [o]
             G._getVolumeMap(to)
             volminloc = C.getMinValue(to, 'centers:vol')
+    if masks is not None: X_IBM.deleteIBCBodyMasks(masks)
     return Internal.getNodeFromType2(to, 'Zone_t')
 
 # only in generateIBMMeshPara and generateCartMesh__
@@ -1183,6 +1183,10 @@ def _densify(z, h):
 def TFI(a):
     """Generate a transfinite interpolation mesh from boundaries.
     Usage: TFI(a)"""
+    if len(a) > 0 and isinstance(a[0], list) and len(a[0]) > 0 and isinstance(a[0][0], list): # lots
+        m = [C.getFields(Internal.__GridCoordinates__, ai) for ai in a]
+        r = Generator.TFI(m)
+        return [C.convertArrays2ZoneNode('tfi%d'%c, [ri]) for c, ri in enumerate(r)]
     m = []
     for ai in a:
         m.append(C.getFields(Internal.__GridCoordinates__, ai)[0])
@@ -1254,11 +1258,11 @@ def TFIStar2(a):
         out.append(C.convertArrays2ZoneNode('tfi%d'%c, [r]))
     return out
 
-def TTM(a, niter=100):
+def TTM(a, niter=100, eps=1.e-13):
     """Smooth a mesh using Thomson-Mastin elliptic generator.
-    Usage: TTM(a, niter)"""
+    Usage: TTM(a, niter, eps)"""
     m = C.getFields(Internal.__GridCoordinates__,a)[0]
-    m = Generator.TTM(m, niter)
+    m = Generator.TTM(m, niter, eps)
     return C.convertArrays2ZoneNode('ttm', [m])
 
 def hyper2D(t, distrib, type, 
@@ -1744,9 +1748,36 @@ def getMeshFieldInfo(m, field, critValue, verbose):
 
     return fmin, fmax, fsum/float(size), fcrit
 
+# Qualite des zones structurees en une seule passe (cf. Generator.getMeshQuality)
+# Si fields=True, les cartes sont ajoutees en centres aux zones de t
+def getMeshQuality(t, crits=[0.,15.,0.1,15.], edges=None, fields=False):
+    """Return quality statistics of structured zones, computed in one pass.
+    Usage: getMeshQuality(t, crits, edges, fields)"""
+    zones = Internal.getZones(t)
+    arrays = C.getFields(Internal.__GridCoordinates__, zones, api=1)
+    stats = Generator.getMeshQuality(arrays, crits, edges, fields)
+    if fields:
+        C.setFields(stats['fields'], zones, 'centers', writeDim=False)
+        del stats['fields']
+    return stats
+
 def checkMesh(m, critVol=0., critOrtho=15., critReg=0.1, critAngReg=15., addGC=False, verbose=0):
     """Return information on mesh quality."""
 
+    # zones structurees sans cellules fictives : une seule passe pour les 4 indicateurs
+    zones = Internal.getZones(m)
+    if not addGC and all(Internal.getZoneType(z) == 1 for z in zones):
+        stats = getMeshQuality(zones, [critVol, critOrtho, critReg, critAngReg])
+        names = [z[0] for z in zones]
+        vmin,vmax,vmean,vcrit = Generator.printMeshQualityInfo__(stats, 'vol', critVol, verbose, names)
+        omin,omax,omean,ocrit = Generator.printMeshQualityInfo__(stats, 'orthogonality', critOrtho, verbose, names)
+        rmin,rmax,rmean,rcrit = Generator.printMeshQualityInfo__(stats, 'regularity', critReg, verbose, names)
+        amin,amax,amean,acrit = Generator.printMeshQualityInfo__(stats, 'regularityAngle', critAngReg, verbose, names)
+        return {'vmin':vmin,'vmax':vmax,'vmean':vmean,'vcrit':vcrit,
+                'rmin':rmin,'rmax':rmax,'rmean':rmean,'rcrit':rcrit,
+                'amin':amin,'amax':amax,'amean':amean,'acrit':acrit,
+                'omin':omin,'omax':omax,'omean':omean,'ocrit':ocrit}
+
     _getVolumeMap(m)
     vmin,vmax,vmean,vcrit = getMeshFieldInfo(m, 'vol', critVol, verbose)
     Internal._rmNodesFromName(m, 'vol')
@@ -41,6 +41,15 @@ PyObject* K_GENERATOR::TFIMesh(PyObject* self, PyObject* args)
   
   E_Int size = PyList_Size(arrays);
 
+  // liste de listes de frontieres : TFI par lots
+  if (size > 0)
+  {
+    PyObject* set = PyList_GetItem(arrays, 0);
+    if (PyList_Check(set) && PyList_Size(set) > 0 &&
+        PyList_Check(PyList_GetItem(set, 0)))
+      return TFIBlocks(arrays);
+  }
+
   switch (size) 
   {
     case 6:
@@ -69,3 +78,97 @@ PyObject* K_GENERATOR::TFIMesh(PyObject* self, PyObject* args)
       return NULL;
   }
 }
+
+// ============================================================================
+/* TFI par lots : une liste de frontieres par bloc.
+   Les frontieres sont lues et les blocs structures alloues sequentiellement
+   (API python), puis tous les blocs structures sont evalues en parallele.
+   Les blocs non structures sont traites directement. */
+// ============================================================================
+PyObject* K_GENERATOR::TFIBlocks(PyObject* arrays)
+{
+  E_Int nb = PyList_Size(arrays);
+  PyObject* out = PyList_New(nb);
+  vector<TFIBlock*> blocks(nb, NULL);
+
+  for (E_Int b = 0; b < nb; b++)
+  {
+    PyObject* set = PyList_GetItem(arrays, b);
+    PyObject* tpl = NULL;
+    if (PyList_Check(set) == 0)
+      PyErr_SetString(PyExc_TypeError,
+                      "TFI: argument must be a list of lists of arrays.");
+    else
+    {
+      E_Int size = PyList_Size(set);
+      E_Bool isStruct = (size == 6);
+      if (size == 4)
+      {
+        isStruct = true;
+        for (E_Int i = 0; i < size; i++)
+        {
+          if (PyList_Size(PyList_GetItem(set, i)) != 5) isStruct = false;
+        }
+      }
+      if (isStruct)
+      {
+        TFIBlock* block = new TFIBlock;
+        if (size == 4) tpl = TFI2D(set, block);
+        else tpl = TFI3D(set, block);
+        if (tpl == NULL) delete block;
+        else blocks[b] = block;
+      }
+      else
+      {
+        PyObject* args = Py_BuildValue("(O)", set);
+        tpl = TFIMesh(NULL, args);
+        Py_DECREF(args);
+      }
+    }
+
+    if (tpl == NULL) // echec : les blocs deja prepares sont liberes
+    {
+      for (E_Int c = 0; c < b; c++)
+      {
+        TFIBlock* block = blocks[c];
+        if (block == NULL) continue;
+        for (size_t nos = 0; nos < block->fields.size(); nos++)
+          RELEASESHAREDS(block->objs[nos], block->fields[nos]);
+        delete block;
+      }
+      Py_DECREF(out);
+      return NULL;
+    }
+    PyList_SET_ITEM(out, b, tpl);
+  }
+
+  // evaluation des blocs structures
+#pragma omp parallel for schedule(dynamic)
+  for (E_Int b = 0; b < nb; b++)
+  {
+    TFIBlock* block = blocks[b];
+    if (block == NULL) continue;
+    FldArrayF coord(block->ni*block->nj*block->nk, block->nfld,
+                    block->coordp, true);
+    if (block->kmin < 0)
+      TFIstruct2D2(block->ni, block->nj, block->nfld,
+                   block->posx, block->posy, block->posz,
+                   block->imin, block->imax, block->jmin, block->jmax,
+                   block->fields, coord);
+    else
+      TFIstruct3D2(block->ni, block->nj, block->nk, block->nfld,
+                   block->posx, block->posy, block->posz,
+                   block->imin, block->imax, block->jmin, block->jmax,
+                   block->kmin, block->kmax, block->fields, coord);
+  }
+
+  for (E_Int b = 0; b < nb; b++)
+  {
+    TFIBlock* block = blocks[b];
+    if (block == NULL) continue;
+    for (size_t nos = 0; nos < block->fields.size(); nos++)
+      RELEASESHAREDS(block->objs[nos], block->fields[nos]);
+    delete block;
+  }
+  return out;
+}
@@ -27,7 +27,7 @@ using namespace K_FLD;
 //===========================================================================
 /* TFI 2D : structure 2D */
 //===========================================================================
-PyObject* K_GENERATOR::TFI2D(PyObject* arrays)
+PyObject* K_GENERATOR::TFI2D(PyObject* arrays, TFIBlock* block)
 {
   // Extract infos from arrays
   vector<E_Int> res;
@@ -91,35 +91,64 @@ PyObject* K_GENERATOR::TFI2D(PyObject* arrays)
   }
   E_Int imin = newOrder[0]; E_Int imax = newOrder[2];
   E_Int jmin = newOrder[3]; E_Int jmax = newOrder[1];
+  const char* err = NULL;
+  if (fields[imin]->getSize() != fields[imax]->getSize())
+    err = "TFI: imin and imax borders are not of same size ni.";
+  else if (fields[jmin]->getSize() != fields[jmax]->getSize())
+    err = "TFI: jmin and jmax borders are not of same size nj.";
+  if (err != NULL)
+  {
+    for (E_Int nos = 0; nos < nzones; nos++)
+      RELEASESHAREDS(objs[nos], fields[nos]);
+    PyErr_SetString(PyExc_TypeError, err);
+    return NULL;
+  }
   E_Int nj = fields[imin]->getSize();
   E_Int ni = fields[jmin]->getSize();
   E_Int nk = 1;
   E_Int npts = ni*nj*nk;
   PyObject* tpl = K_ARRAY::buildArray(nfld, varString, ni, nj, nk);
   E_Float* coordp = K_ARRAY::getFieldPtr(tpl);
-  FldArrayF coord(npts, nfld, coordp, true);
-  //short isok = TFIstruct2D(ni, nj, nfld, imin, imax, jmin, jmax, fields, coord);
-  short isok = TFIstruct2D2(ni, nj, nfld, posx, posy, posz, imin, imax, jmin, jmax, fields, coord);
 
-  if (isok < 1) //echec
+  if (block != NULL) // evaluation differee
   {
-    for (E_Int nos = 0; nos < nzones; nos++)
-      RELEASESHAREDS(objs[nos], fields[nos]);
-    if ( isok == -1)
-      PyErr_SetString(PyExc_TypeError,
-                      "TFI: imin and imax borders are not of same size ni.");
-    else if ( isok == -2 )
-            PyErr_SetString(PyExc_TypeError,
-                      "TFI: jmin and jmax borders are not of same size nj.");
-    else       
-      PyErr_SetString(PyExc_TypeError,
-                      "TFI: input arrays are not valid.");
-    return NULL;
+    block->ni = ni; block->nj = nj; block->nk = nk; block->nfld = nfld;
+    block->posx = posx; block->posy = posy; block->posz = posz;
+    block->imin = imin; block->imax = imax;
+    block->jmin = jmin; block->jmax = jmax;
+    block->kmin = -1; block->kmax = -1;
+    block->fields = fields; block->objs = objs;
+    block->coordp = coordp;
+    return tpl;
   }
+
+  FldArrayF coord(npts, nfld, coordp, true);
+  //TFIstruct2D(ni, nj, nfld, imin, imax, jmin, jmax, fields, coord);
+  TFIstruct2D2(ni, nj, nfld, posx, posy, posz, imin, imax, jmin, jmax, fields, coord);
+
   for (E_Int nos = 0; nos < nzones; nos++)
     RELEASESHAREDS(objs[nos], fields[nos]);
   return tpl;
 }
+
+//===========================================================================
+/* Rapport distance au premier point / distance entre extremites pour les
+   n points d'une courbe, stockes avec un pas s */
+//===========================================================================
+void K_GENERATOR::chordRatioTFI(E_Int n, E_Int s,
+                                E_Float* x, E_Float* y, E_Float* z,
+                                E_Float* r)
+{
+  E_Int l = (n-1)*s;
+  E_Float dx = x[l]-x[0]; E_Float dy = y[l]-y[0]; E_Float dz = z[l]-z[0];
+  E_Float invdist = 1.0 / sqrt(dx*dx+dy*dy+dz*dz);
+  for (E_Int p = 0; p < n; p++)
+  {
+    l = p*s;
+    dx = x[l]-x[0]; dy = y[l]-y[0]; dz = z[l]-z[0];
+    r[l] = sqrt(dx*dx+dy*dy+dz*dz) * invdist;
+  }
+}
  
 //===========================================================================
 /* TFI 2D structure.  */
@@ -166,70 +195,54 @@ short K_GENERATOR::TFIstruct2D2(E_Int ni, E_Int nj, E_Int nfld,
                                 vector<FldArrayF*>& fields,
                                 FldArrayF& coords)
 {
-  E_Int ni1 = ni-1;
   E_Int nj1 = nj-1;
-  E_Int i, j, ind;
 
   if (fields[imin]->getSize() != fields[imax]->getSize()) return -1;
   if (fields[jmin]->getSize() != fields[jmax]->getSize()) return -2;
 
-  E_Float* pondximin = fields[imin]->begin(posx);
-  E_Float* pondximax = fields[imax]->begin(posx);
-  E_Float* pondxjmin = fields[jmin]->begin(posx);
-  E_Float* pondxjmax = fields[jmax]->begin(posx);
-  E_Float* pondyimin = fields[imin]->begin(posy);
-  E_Float* pondyimax = fields[imax]->begin(posy);
-  E_Float* pondyjmin = fields[jmin]->begin(posy);
-  E_Float* pondyjmax = fields[jmax]->begin(posy);
-  E_Float* pondzimin = fields[imin]->begin(posz);
-  E_Float* pondzimax = fields[imax]->begin(posz);
-  E_Float* pondzjmin = fields[jmin]->begin(posz);
-  E_Float* pondzjmax = fields[jmax]->begin(posz);
-
-  E_Float pondximindist = pow( pow((pondximin[nj1] - pondximin[0]), 2.0) + pow((pondyimin[nj1] - pondyimin[0]), 2.0) + pow((pondzimin[nj1] - pondzimin[0]) , 2.0) , 0.5);
-  E_Float pondximaxdist = pow( pow((pondximax[nj1] - pondximax[0]), 2.0) + pow((pondyimax[nj1] - pondyimax[0]), 2.0) + pow((pondzimax[nj1] - pondzimax[0]) , 2.0) , 0.5);
-  E_Float pondxjmindist = pow( pow((pondxjmin[ni1] - pondxjmin[0]), 2.0) + pow((pondyjmin[ni1] - pondyjmin[0]), 2.0) + pow((pondzjmin[ni1] - pondzjmin[0]) , 2.0) , 0.5);
-  E_Float pondxjmaxdist = pow( pow((pondxjmax[ni1] - pondxjmax[0]), 2.0) + pow((pondyjmax[ni1] - pondyjmax[0]), 2.0) + pow((pondzjmax[ni1] - pondzjmax[0]) , 2.0) , 0.5);
-
-  E_Float invpondximindist = 1.0 / pondximindist;
-  E_Float invpondximaxdist = 1.0 / pondximaxdist;
-  E_Float invpondxjmindist = 1.0 / pondxjmindist;
-  E_Float invpondxjmaxdist = 1.0 / pondxjmaxdist;
+  // Ponderations : abscisses normalisees le long des frontieres, ne
+  // dependent que de j (frontieres imin/imax) ou de i (jmin/jmax)
+  FldArrayF pond(nj+ni, 2);
+  E_Float* pondimin = pond.begin(1); E_Float* pondimax = pond.begin(2);
+  E_Float* pondjmin = pondimin+nj; E_Float* pondjmax = pondimax+nj;
+  chordRatioTFI(nj, 1, fields[imin]->begin(posx), fields[imin]->begin(posy),
+                fields[imin]->begin(posz), pondimin);
+  chordRatioTFI(nj, 1, fields[imax]->begin(posx), fields[imax]->begin(posy),
+                fields[imax]->begin(posz), pondimax);
+  chordRatioTFI(ni, 1, fields[jmin]->begin(posx), fields[jmin]->begin(posy),
+                fields[jmin]->begin(posz), pondjmin);
+  chordRatioTFI(ni, 1, fields[jmax]->begin(posx), fields[jmax]->begin(posy),
+                fields[jmax]->begin(posz), pondjmax);
+  E_Float* pondi = pondimin; // ponderation en j
+  for (E_Int j = 0; j < nj; j++) pondi[j] = (pondimin[j] + pondimax[j])*0.5;
+  E_Float* pondj = pondjmin; // ponderation en i
+  for (E_Int i = 0; i < ni; i++) pondj[i] = (pondjmin[i] + pondjmax[i])*0.5;
 
-  for (E_Int eq = 1; eq <= nfld; eq++)
+#pragma omp parallel for if (ni*nj > __MIN_SIZE_MEAN__)
+  for (E_Int j = 0; j < nj; j++)
   {
-    E_Float* ximin = fields[imin]->begin(eq);
-    E_Float* ximax = fields[imax]->begin(eq);
-    E_Float* xjmin = fields[jmin]->begin(eq);
-    E_Float* xjmax = fields[jmax]->begin(eq);
-    E_Float* xt = coords.begin(eq);
-    for (j = 0; j < nj; j++)
-      for (i = 0; i < ni; i++)
+    E_Float pi = pondi[j]; E_Float pi1 = 1.0 - pi;
+    for (E_Int eq = 1; eq <= nfld; eq++)
+    {
+      E_Float* ximin = fields[imin]->begin(eq);
+      E_Float* ximax = fields[imax]->begin(eq);
+      E_Float* xjmin = fields[jmin]->begin(eq);
+      E_Float* xjmax = fields[jmax]->begin(eq);
+      E_Float* xt = coords.begin(eq)+j*ni;
+      E_Float ximinj = ximin[j]; E_Float ximaxj = ximax[j];
+      E_Float ximin0 = ximin[0]; E_Float ximinn = ximin[nj1];
+      E_Float ximax0 = ximax[0]; E_Float ximaxn = ximax[nj1];
+      for (E_Int i = 0; i < ni; i++)
       {
-        ind = i+ j*ni;
-        E_Float pondximindistpartial = pow( pow((pondximin[j] - pondximin[0]), 2.0) + pow((pondyimin[j] - pondyimin[0]), 2.0) + pow((pondzimin[j] - pondzimin[0]), 2.0) , 0.5);
-        E_Float pondximaxdistpartial = pow( pow((pondximax[j] - pondximax[0]), 2.0) + pow((pondyimax[j] - pondyimax[0]), 2.0) + pow((pondzimax[j] - pondzimax[0]), 2.0) , 0.5);
-        E_Float pondxjmindistpartial = pow( pow((pondxjmin[i] - pondxjmin[0]), 2.0) + pow((pondyjmin[i] - pondyjmin[0]), 2.0) + pow((pondzjmin[i] - pondzjmin[0]), 2.0) , 0.5);
-        E_Float pondxjmaxdistpartial = pow( pow((pondxjmax[i] - pondxjmax[0]), 2.0) + pow((pondyjmax[i] - pondyjmax[0]), 2.0) + pow((pondzjmax[i] - pondzjmax[0]), 2.0) , 0.5);
-
-        E_Float pondximindistratio = pondximindistpartial * invpondximindist;
-        E_Float pondximaxdistratio = pondximaxdistpartial * invpondximaxdist;
-        E_Float pondxjmindistratio = pondxjmindistpartial * invpondxjmindist;
-        E_Float pondxjmaxdistratio = pondxjmaxdistpartial * invpondxjmaxdist;
-
-        E_Float pondxidistratio = (pondximindistratio + pondximaxdistratio)*0.5;
-        E_Float pondxjdistratio = (pondxjmindistratio + pondxjmaxdistratio)*0.5;
-
-        E_Float pondxidistratio1 = 1.0 - pondxidistratio;
-        E_Float pondxjdistratio1 = 1.0 - pondxjdistratio;
-
-        xt[ind] = pondxidistratio1 * xjmin[i] + pondxidistratio * xjmax[i]
-                + pondxjdistratio1 * ximin[j] + pondxjdistratio * ximax[j]
-                - pondxjdistratio1* pondxidistratio1 * ximin[0]
-                - pondxjdistratio1* pondxidistratio* ximin[nj1]
-                - pondxjdistratio * pondxidistratio1 * ximax[0]
-                - pondxjdistratio * pondxidistratio * ximax[nj1];
+        E_Float pj = pondj[i]; E_Float pj1 = 1.0 - pj;
+        xt[i] = pi1 * xjmin[i] + pi * xjmax[i]
+              + pj1 * ximinj + pj * ximaxj
+              - pj1 * pi1 * ximin0
+              - pj1 * pi * ximinn
+              - pj * pi1 * ximax0
+              - pj * pi * ximaxn;
       }
+    }
   }
   return 1;
 }
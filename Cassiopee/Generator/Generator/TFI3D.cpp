@@ -26,7 +26,7 @@ using namespace K_FLD;
 //===========================================================================
 /* TFI 3D: structure 3D */
 //===========================================================================
-PyObject* K_GENERATOR::TFI3D(PyObject* arrays) 
+PyObject* K_GENERATOR::TFI3D(PyObject* arrays, TFIBlock* block)
 {
   // Extract infos from arrays
   vector<E_Int> res;
@@ -98,36 +98,44 @@ PyObject* K_GENERATOR::TFI3D(PyObject* arrays)
   E_Int imin = newOrder[0]; E_Int imax = newOrder[5];
   E_Int jmin = newOrder[1]; E_Int jmax = newOrder[2];
   E_Int kmin = newOrder[3]; E_Int kmax = newOrder[4];
+  const char* err = NULL;
+  if (fields[imin]->getSize() != fields[imax]->getSize())
+    err = "TFI: imin and imax borders are not of same size ni.";
+  else if (fields[jmin]->getSize() != fields[jmax]->getSize())
+    err = "TFI: jmin and jmax borders are not of same size nj.";
+  else if (fields[kmin]->getSize() != fields[kmax]->getSize())
+    err = "TFI: kmin and kmax borders are not of same size nk.";
+  if (err != NULL)
+  {
+    for (E_Int nos = 0; nos < nzones; nos++)
+      RELEASESHAREDS(objs[nos], fields[nos]);
+    PyErr_SetString(PyExc_TypeError, err);
+    return NULL;
+  }
   E_Int ni = nit[jmin]; E_Int nj = nit[imin]; E_Int nk = njt[jmin]; 
   E_Int npts = ni*nj*nk;
   PyObject* tpl = K_ARRAY::buildArray(nfld, varString, ni, nj, nk);
   E_Float* coordp = K_ARRAY::getFieldPtr(tpl);
-  FldArrayF coord(npts, nfld, coordp, true);
 
-  //short isok = TFIstruct3D(ni, nj, nk, nfld, imin, imax, jmin, jmax, kmin, kmax,
-  //                         fields, coord);
-  short isok = TFIstruct3D2(ni, nj, nk, nfld, posx, posy, posz, 
-                            imin, imax, jmin, jmax, kmin, kmax,
-                            fields, coord);
-  
-  if (isok == 0) //echec
+  if (block != NULL) // evaluation differee
   {
-    for (E_Int nos = 0; nos < nzones; nos++)
-      RELEASESHAREDS(objs[nos], fields[nos]);
-    if ( isok == -1)
-      PyErr_SetString(PyExc_TypeError,
-                      "TFI: imin and imax borders are not of same size ni.");
-    else if ( isok == -2)
-      PyErr_SetString(PyExc_TypeError,
-                      "TFI: jmin and jmax borders are not of same size nj.");
-    else if ( isok == -3)
-      PyErr_SetString(PyExc_TypeError,
-                      "TFI: kmin and kmax borders are not of same size nk.");    
-    else    
-      PyErr_SetString(PyExc_TypeError,
-                      "TFI: input arrays are not valid.");
-    return NULL;
+    block->ni = ni; block->nj = nj; block->nk = nk; block->nfld = nfld;
+    block->posx = posx; block->posy = posy; block->posz = posz;
+    block->imin = imin; block->imax = imax;
+    block->jmin = jmin; block->jmax = jmax;
+    block->kmin = kmin; block->kmax = kmax;
+    block->fields = fields; block->objs = objs;
+    block->coordp = coordp;
+    return tpl;
   }
+
+  FldArrayF coord(npts, nfld, coordp, true);
+  //TFIstruct3D(ni, nj, nk, nfld, imin, imax, jmin, jmax, kmin, kmax,
+  //            fields, coord);
+  TFIstruct3D2(ni, nj, nk, nfld, posx, posy, posz, 
+               imin, imax, jmin, jmax, kmin, kmax,
+               fields, coord);
+  
   for (E_Int nos = 0; nos < nzones; nos++)
     RELEASESHAREDS(objs[nos], fields[nos]);
   return tpl;
@@ -201,215 +209,150 @@ short K_GENERATOR::TFIstruct3D2(
   E_Int imin, E_Int imax, E_Int jmin, E_Int jmax, E_Int kmin, E_Int kmax,
   std::vector<FldArrayF*>& fields, FldArrayF& coords)
 {
-  E_Int ni1 = ni-1;
   E_Int nj1 = nj-1;
   E_Int nk1 = nk-1;
-  E_Int ind, indij, indjk, indik;
-  E_Float t1x, t3x, t2x12, t2x13, t2x23;
   E_Int ninj = ni*nj;
+  E_Int njnk = nj*nk;
+  E_Int nink = ni*nk;
   if ( fields[imin]->getSize() != fields[imax]->getSize()) return -1;
   if ( fields[jmin]->getSize() != fields[jmax]->getSize()) return -2;
   if ( fields[kmin]->getSize() != fields[kmax]->getSize()) return -3;
 
-  //  x,y,z pour 6 faces
-  E_Float* pondximin = fields[imin]->begin(posx);
-  E_Float* pondximax = fields[imax]->begin(posx);
-  E_Float* pondxjmin = fields[jmin]->begin(posx);
-  E_Float* pondxjmax = fields[jmax]->begin(posx);
-  E_Float* pondxkmin = fields[kmin]->begin(posx);
-  E_Float* pondxkmax = fields[kmax]->begin(posx);
-
-  E_Float* pondyimin = fields[imin]->begin(posy);
-  E_Float* pondyimax = fields[imax]->begin(posy);
-  E_Float* pondyjmin = fields[jmin]->begin(posy);
-  E_Float* pondyjmax = fields[jmax]->begin(posy);
-  E_Float* pondykmin = fields[kmin]->begin(posy);
-  E_Float* pondykmax = fields[kmax]->begin(posy);
-
-  E_Float* pondzimin = fields[imin]->begin(posz);
-  E_Float* pondzimax = fields[imax]->begin(posz);
-  E_Float* pondzjmin = fields[jmin]->begin(posz);
-  E_Float* pondzjmax = fields[jmax]->begin(posz);
-  E_Float* pondzkmin = fields[kmin]->begin(posz);
-  E_Float* pondzkmax = fields[kmax]->begin(posz);
-
-  //  permutations min/max pour 3 couple d'indices
-  //E_Int indiceiminjmin = 0+0*ni;
+  //  2 ponderations par face donc 12 ponderations, calculees une fois pour
+  //  toutes : ratio[2*f] dans la 1ere direction de la face f,
+  //  ratio[2*f+1] dans la 2eme (faces imin, imax, jmin, jmax, kmin, kmax)
+  E_Int face[6] = {imin, imax, jmin, jmax, kmin, kmax};
+  E_Int n1[6] = {nj, nj, ni, ni, ni, ni};
+  E_Int n2[6] = {nk, nk, nk, nk, nj, nj};
+  FldArrayF ratios(4*(njnk+nink+ninj));
+  E_Float* ratio[12];
+  ratio[0] = ratios.begin();
+  for (E_Int r = 1; r < 12; r++) ratio[r] = ratio[r-1] + n1[(r-1)/2]*n2[(r-1)/2];
+
+#pragma omp parallel for
+  for (E_Int f = 0; f < 6; f++)
+  {
+    E_Float* x = fields[face[f]]->begin(posx);
+    E_Float* y = fields[face[f]]->begin(posy);
+    E_Float* z = fields[face[f]]->begin(posz);
+    E_Int m1 = n1[f]; E_Int m2 = n2[f];
+    for (E_Int b = 0; b < m2; b++)
+      chordRatioTFI(m1, 1, x+b*m1, y+b*m1, z+b*m1, ratio[2*f]+b*m1);
+    for (E_Int a = 0; a < m1; a++)
+      chordRatioTFI(m2, m1, x+a, y+a, z+a, ratio[2*f+1]+a);
+  }
+  E_Float* pondximindistratioj = ratio[0];
+  E_Float* pondximindistratiok = ratio[1];
+  E_Float* pondximaxdistratioj = ratio[2];
+  E_Float* pondximaxdistratiok = ratio[3];
+  E_Float* pondxjmindistratioi = ratio[4];
+  E_Float* pondxjmindistratiok = ratio[5];
+  E_Float* pondxjmaxdistratioi = ratio[6];
+  E_Float* pondxjmaxdistratiok = ratio[7];
+  E_Float* pondxkmindistratioi = ratio[8];
+  E_Float* pondxkmindistratioj = ratio[9];
+  E_Float* pondxkmaxdistratioi = ratio[10];
+  E_Float* pondxkmaxdistratioj = ratio[11];
+
+  //  coins des faces imin/imax
   E_Int indicejminkmin = 0+0*nj;
-  //E_Int indiceiminkmin = 0+0*ni;
-
-  //E_Int indiceimaxjmin = ni1+0*ni;
   E_Int indicejmaxkmin = nj1+0*nj;
-  //E_Int indiceimaxkmin = ni1+0*ni;
-
-  //E_Int indiceiminjmax = 0+nj1*ni;
   E_Int indicejminkmax = 0+nk1*nj;
-  //E_Int indiceiminkmax = 0+nk1*ni;
-
-  //E_Int indiceimaxjmax = ni1+nj1*ni;
   E_Int indicejmaxkmax = nj1+nk1*nj;
-  //E_Int indiceimaxkmax = ni1+nk1*ni;
 
-  for (E_Int eq = 1; eq <= nfld; eq++)
+  // Une ligne (j,k) par iteration : les ponderations de la ligne sont
+  // calculees une fois pour tous les champs
+#pragma omp parallel if (ninj*nk > __MIN_SIZE_MEAN__)
   {
-    E_Float* ximin = fields[imin]->begin(eq);
-    E_Float* ximax = fields[imax]->begin(eq);
-    E_Float* xjmin = fields[jmin]->begin(eq);
-    E_Float* xjmax = fields[jmax]->begin(eq);
-    E_Float* xkmin = fields[kmin]->begin(eq);
-    E_Float* xkmax = fields[kmax]->begin(eq);
-    E_Float* xt = coords.begin(eq);
-    for (E_Int k = 0; k < nk; k++)
-      for (E_Int j = 0; j < nj; j++)
+    FldArrayF pond(ni, 3);
+    E_Float* pondi = pond.begin(1);
+    E_Float* pondj = pond.begin(2);
+    E_Float* pondk = pond.begin(3);
+
+#pragma omp for
+    for (E_Int jk = 0; jk < njnk; jk++)
+    {
+      E_Int j = jk%nj; E_Int k = jk/nj;
+      E_Int indjk = jk;
+      E_Int indj0 = j*ni; E_Int indk0 = k*ni;
+
+      //  1 ratio moyen par couple de face donc 3 ratio moyen
+      for (E_Int i = 0; i < ni; i++)
+      {
+        pondi[i] = (pondxjmindistratioi[i+indk0] + pondxjmaxdistratioi[i+indk0] +  pondxkmindistratioi[i+indj0] +  pondxkmaxdistratioi[i+indj0]) / 4.0;
+        pondj[i] = (pondximindistratioj[indjk] + pondximaxdistratioj[indjk] +  pondxkmindistratioj[i+indj0] +  pondxkmaxdistratioj[i+indj0]) / 4.0;
+        pondk[i] = (pondximindistratiok[indjk] + pondximaxdistratiok[indjk] +  pondxjmindistratiok[i+indk0] +  pondxjmaxdistratiok[i+indk0]) / 4.0;
+      }
+
+      for (E_Int eq = 1; eq <= nfld; eq++)
+      {
+        E_Float* ximin = fields[imin]->begin(eq);
+        E_Float* ximax = fields[imax]->begin(eq);
+        E_Float* xjmin = fields[jmin]->begin(eq);
+        E_Float* xjmax = fields[jmax]->begin(eq);
+        E_Float* xkmin = fields[kmin]->begin(eq);
+        E_Float* xkmax = fields[kmax]->begin(eq);
+        E_Float* xt = coords.begin(eq) + j*ni + k*ninj;
+
+        // valeurs constantes sur la ligne
+        E_Float ximinjk = ximin[indjk]; E_Float ximaxjk = ximax[indjk];
+        E_Float ximinjmink = ximin[k*nj]; E_Float ximinjmaxk = ximin[nj1+k*nj];
+        E_Float ximaxjmink = ximax[k*nj]; E_Float ximaxjmaxk = ximax[nj1+k*nj];
+        E_Float ximinjkmin = ximin[j]; E_Float ximinjkmax = ximin[j+nk1*nj];
+        E_Float ximaxjkmin = ximax[j]; E_Float ximaxjkmax = ximax[j+nk1*nj];
+        E_Float ximin00 = ximin[indicejminkmin]; E_Float ximin01 = ximin[indicejminkmax];
+        E_Float ximin10 = ximin[indicejmaxkmin]; E_Float ximin11 = ximin[indicejmaxkmax];
+        E_Float ximax00 = ximax[indicejminkmin]; E_Float ximax01 = ximax[indicejminkmax];
+        E_Float ximax10 = ximax[indicejmaxkmin]; E_Float ximax11 = ximax[indicejmaxkmax];
+        E_Float* xjmink = xjmin+indk0; E_Float* xjmaxk = xjmax+indk0;
+        E_Float* xkminj = xkmin+indj0; E_Float* xkmaxj = xkmax+indj0;
+        E_Float* xjmin1 = xjmin+nk1*ni; E_Float* xjmax1 = xjmax+nk1*ni;
+
         for (E_Int i = 0; i < ni; i++)
         {
-          ind = i + j * ni + k * ninj;
-          indij = i+j*ni;
-          indjk = j+k*nj;
-          indik = i+k*ni;
-
-          //  permutations courant/fixe min/max pour 3 couple d'indices
-          E_Int indicei_jmin = i+0*ni;
-          E_Int indicej_kmin = j+0*nj;
-          E_Int indicei_kmin = i+0*ni;
-
-          E_Int indiceimin_j = 0+j*ni;
-          E_Int indicejmin_k = 0+k*nj;
-          E_Int indiceimin_k = 0+k*ni;
-
-          E_Int indiceimax_j = ni1+j*ni;
-          E_Int indicejmax_k = nj1+k*nj;
-          E_Int indiceimax_k = ni1+k*ni;
-
-          E_Int indicei_jmax = i+nj1*ni;
-          E_Int indicej_kmax = j+nk1*nj;
-          E_Int indicei_kmax = i+nk1*ni;
-
-          E_Int indice_i_j = i+j*ni;
-          E_Int indice_j_k = j+k*nj;
-          E_Int indice_i_k = i+k*ni;
-
-          //  2 ponderations par faces donc 12 ponderations
-          E_Float pondximindisttotalj = pow( pow((pondximin[indicejmax_k] - pondximin[indicejmin_k]) , 2.0) + pow((pondyimin[indicejmax_k] - pondyimin[indicejmin_k]) , 2.0) + pow((pondzimin[indicejmax_k] - pondzimin[indicejmin_k]) , 2.0) , 0.5);
-          E_Float pondximindisttotalk = pow( pow((pondximin[indicej_kmax] - pondximin[indicej_kmin]) , 2.0) + pow((pondyimin[indicej_kmax] - pondyimin[indicej_kmin]) , 2.0) + pow((pondzimin[indicej_kmax] - pondzimin[indicej_kmin]) , 2.0) , 0.5);
-          E_Float pondximaxdisttotalj = pow( pow((pondximax[indicejmax_k] - pondximax[indicejmin_k]) , 2.0) + pow((pondyimax[indicejmax_k] - pondyimax[indicejmin_k]) , 2.0) + pow((pondzimax[indicejmax_k] - pondzimax[indicejmin_k]) , 2.0) , 0.5);
-          E_Float pondximaxdisttotalk = pow( pow((pondximax[indicej_kmax] - pondximax[indicej_kmin]) , 2.0) + pow((pondyimax[indicej_kmax] - pondyimax[indicej_kmin]) , 2.0) + pow((pondzimax[indicej_kmax] - pondzimax[indicej_kmin]) , 2.0) , 0.5);
-
-          E_Float pondxjmindisttotali = pow( pow((pondxjmin[indiceimax_k] - pondxjmin[indiceimin_k]) , 2.0) + pow((pondyjmin[indiceimax_k] - pondyjmin[indiceimin_k]) , 2.0) + pow((pondzjmin[indiceimax_k] - pondzjmin[indiceimin_k]) , 2.0) , 0.5);
-          E_Float pondxjmindisttotalk = pow( pow((pondxjmin[indicei_kmax] - pondxjmin[indicei_kmin]) , 2.0) + pow((pondyjmin[indicei_kmax] - pondyjmin[indicei_kmin]) , 2.0) + pow((pondzjmin[indicei_kmax] - pondzjmin[indicei_kmin]) , 2.0) , 0.5);
-          E_Float pondxjmaxdisttotali = pow( pow((pondxjmax[indiceimax_k] - pondxjmax[indiceimin_k]) , 2.0) + pow((pondyjmax[indiceimax_k] - pondyjmax[indiceimin_k]) , 2.0) + pow((pondzjmax[indiceimax_k] - pondzjmax[indiceimin_k]) , 2.0) , 0.5);
-          E_Float pondxjmaxdisttotalk = pow( pow((pondxjmax[indicei_kmax] - pondxjmax[indicei_kmin]) , 2.0) + pow((pondyjmax[indicei_kmax] - pondyjmax[indicei_kmin]) , 2.0) + pow((pondzjmax[indicei_kmax] - pondzjmax[indicei_kmin]) , 2.0) , 0.5);
-
-          E_Float pondxkmindisttotali = pow( pow((pondxkmin[indiceimax_j] - pondxkmin[indiceimin_j]) , 2.0) + pow((pondykmin[indiceimax_j] - pondykmin[indiceimin_j]) , 2.0) + pow((pondzkmin[indiceimax_j] - pondzkmin[indiceimin_j]) , 2.0) , 0.5);
-          E_Float pondxkmindisttotalj = pow( pow((pondxkmin[indicei_jmax] - pondxkmin[indicei_jmin]) , 2.0) + pow((pondykmin[indicei_jmax] - pondykmin[indicei_jmin]) , 2.0) + pow((pondzkmin[indicei_jmax] - pondzkmin[indicei_jmin]) , 2.0) , 0.5);
-          E_Float pondxkmaxdisttotali = pow( pow((pondxkmax[indiceimax_j] - pondxkmax[indiceimin_j]) , 2.0) + pow((pondykmax[indiceimax_j] - pondykmax[indiceimin_j]) , 2.0) + pow((pondzkmax[indiceimax_j] - pondzkmax[indiceimin_j]) , 2.0) , 0.5);
-          E_Float pondxkmaxdisttotalj = pow( pow((pondxkmax[indicei_jmax] - pondxkmax[indicei_jmin]) , 2.0) + pow((pondykmax[indicei_jmax] - pondykmax[indicei_jmin]) , 2.0) + pow((pondzkmax[indicei_jmax] - pondzkmax[indicei_jmin]) , 2.0) , 0.5);
-
-
-          E_Float inv_pondximindisttotalj = 1.0 / pondximindisttotalj ;
-          E_Float inv_pondximindisttotalk = 1.0 / pondximindisttotalk ;
-          E_Float inv_pondximaxdisttotalj = 1.0 / pondximaxdisttotalj ;
-          E_Float inv_pondximaxdisttotalk = 1.0 / pondximaxdisttotalk ;
-          E_Float inv_pondxjmindisttotali = 1.0 / pondxjmindisttotali ;
-          E_Float inv_pondxjmindisttotalk = 1.0 / pondxjmindisttotalk ;
-          E_Float inv_pondxjmaxdisttotali = 1.0 / pondxjmaxdisttotali ;
-          E_Float inv_pondxjmaxdisttotalk = 1.0 / pondxjmaxdisttotalk ;
-          E_Float inv_pondxkmindisttotali = 1.0 / pondxkmindisttotali ;
-          E_Float inv_pondxkmindisttotalj = 1.0 / pondxkmindisttotalj ;
-          E_Float inv_pondxkmaxdisttotali = 1.0 / pondxkmaxdisttotali ;
-          E_Float inv_pondxkmaxdisttotalj = 1.0 / pondxkmaxdisttotalj ;
-
-
-          //  2 ponderations par faces donc 12 ponderations
-          E_Float pondximindistpartialj = pow( pow((pondximin[indice_j_k] - pondximin[indicejmin_k]) , 2.0) + pow((pondyimin[indice_j_k] - pondyimin[indicejmin_k]) , 2.0) + pow((pondzimin[indice_j_k] - pondzimin[indicejmin_k]) , 2.0) , 0.5);
-          E_Float pondximindistpartialk = pow( pow((pondximin[indice_j_k] - pondximin[indicej_kmin]) , 2.0) + pow((pondyimin[indice_j_k] - pondyimin[indicej_kmin]) , 2.0) + pow((pondzimin[indice_j_k] - pondzimin[indicej_kmin]) , 2.0) , 0.5);
-          E_Float pondximaxdistpartialj = pow( pow((pondximax[indice_j_k] - pondximax[indicejmin_k]) , 2.0) + pow((pondyimax[indice_j_k] - pondyimax[indicejmin_k]) , 2.0) + pow((pondzimax[indice_j_k] - pondzimax[indicejmin_k]) , 2.0) , 0.5);
-          E_Float pondximaxdistpartialk = pow( pow((pondximax[indice_j_k] - pondximax[indicej_kmin]) , 2.0) + pow((pondyimax[indice_j_k] - pondyimax[indicej_kmin]) , 2.0) + pow((pondzimax[indice_j_k] - pondzimax[indicej_kmin]) , 2.0) , 0.5);
-
-          E_Float pondxjmindistpartiali = pow( pow((pondxjmin[indice_i_k] - pondxjmin[indiceimin_k]) , 2.0) + pow((pondyjmin[indice_i_k] - pondyjmin[indiceimin_k]) , 2.0) + pow((pondzjmin[indice_i_k] - pondzjmin[indiceimin_k]) , 2.0) , 0.5);
-          E_Float pondxjmindistpartialk = pow( pow((pondxjmin[indice_i_k] - pondxjmin[indicei_kmin]) , 2.0) + pow((pondyjmin[indice_i_k] - pondyjmin[indicei_kmin]) , 2.0) + pow((pondzjmin[indice_i_k] - pondzjmin[indicei_kmin]) , 2.0) , 0.5);
-          E_Float pondxjmaxdistpartiali = pow( pow((pondxjmax[indice_i_k] - pondxjmax[indiceimin_k]) , 2.0) + pow((pondyjmax[indice_i_k] - pondyjmax[indiceimin_k]) , 2.0) + pow((pondzjmax[indice_i_k] - pondzjmax[indiceimin_k]) , 2.0) , 0.5);
-          E_Float pondxjmaxdistpartialk = pow( pow((pondxjmax[indice_i_k] - pondxjmax[indicei_kmin]) , 2.0) + pow((pondyjmax[indice_i_k] - pondyjmax[indicei_kmin]) , 2.0) + pow((pondzjmax[indice_i_k] - pondzjmax[indicei_kmin]) , 2.0) , 0.5);
-
-          E_Float pondxkmindistpartiali = pow( pow((pondxkmin[indice_i_j] - pondxkmin[indiceimin_j]) , 2.0) + pow((pondykmin[indice_i_j] - pondykmin[indiceimin_j]) , 2.0) + pow((pondzkmin[indice_i_j] - pondzkmin[indiceimin_j]) , 2.0) , 0.5);
-          E_Float pondxkmindistpartialj = pow( pow((pondxkmin[indice_i_j] - pondxkmin[indicei_jmin]) , 2.0) + pow((pondykmin[indice_i_j] - pondykmin[indicei_jmin]) , 2.0) + pow((pondzkmin[indice_i_j] - pondzkmin[indicei_jmin]) , 2.0) , 0.5);
-          E_Float pondxkmaxdistpartiali = pow( pow((pondxkmax[indice_i_j] - pondxkmax[indiceimin_j]) , 2.0) + pow((pondykmax[indice_i_j] - pondykmax[indiceimin_j]) , 2.0) + pow((pondzkmax[indice_i_j] - pondzkmax[indiceimin_j]) , 2.0) , 0.5);
-          E_Float pondxkmaxdistpartialj = pow( pow((pondxkmax[indice_i_j] - pondxkmax[indicei_jmin]) , 2.0) + pow((pondykmax[indice_i_j] - pondykmax[indicei_jmin]) , 2.0) + pow((pondzkmax[indice_i_j] - pondzkmax[indicei_jmin]) , 2.0) , 0.5);
-
-          //  2 ratio par couple de face donc 12 ratio
-          E_Float pondximindistratioj =  pondximindistpartialj * inv_pondximindisttotalj ;
-          E_Float pondximindistratiok =  pondximindistpartialk * inv_pondximindisttotalk ;
-          E_Float pondximaxdistratioj =  pondximaxdistpartialj * inv_pondximaxdisttotalj ;
-          E_Float pondximaxdistratiok =  pondximaxdistpartialk * inv_pondximaxdisttotalk ;
-          E_Float pondxjmindistratioi =  pondxjmindistpartiali * inv_pondxjmindisttotali ;
-          E_Float pondxjmindistratiok =  pondxjmindistpartialk * inv_pondxjmindisttotalk ;
-          E_Float pondxjmaxdistratioi =  pondxjmaxdistpartiali * inv_pondxjmaxdisttotali ;
-          E_Float pondxjmaxdistratiok =  pondxjmaxdistpartialk * inv_pondxjmaxdisttotalk ;
-          E_Float pondxkmindistratioi =  pondxkmindistpartiali * inv_pondxkmindisttotali ;
-          E_Float pondxkmindistratioj =  pondxkmindistpartialj * inv_pondxkmindisttotalj ;
-          E_Float pondxkmaxdistratioi =  pondxkmaxdistpartiali * inv_pondxkmaxdisttotali ;
-          E_Float pondxkmaxdistratioj =  pondxkmaxdistpartialj * inv_pondxkmaxdisttotalj ;
-
-          //  1 ratio moyen par couple de face donc 3 ratio moyen
-
-          E_Float pondxdir_i_ratio = (pondxjmindistratioi + pondxjmaxdistratioi +  pondxkmindistratioi +  pondxkmaxdistratioi) / 4.0 ;
-          E_Float pondxdir_j_ratio = (pondximindistratioj + pondximaxdistratioj +  pondxkmindistratioj +  pondxkmaxdistratioj) / 4.0 ;
-          E_Float pondxdir_k_ratio = (pondximindistratiok + pondximaxdistratiok +  pondxjmindistratiok +  pondxjmaxdistratiok) / 4.0 ;
-
-          E_Float pondxdir_i_ratio1 = 1.0 - pondxdir_i_ratio ;
-          E_Float pondxdir_j_ratio1 = 1.0 - pondxdir_j_ratio ;
-          E_Float pondxdir_k_ratio1 = 1.0 - pondxdir_k_ratio ;
-
-          // E_Float pondxdir_i_ratio1 = (pondxjmindistratioi + pondxjmaxdistratioi +  pondxkmindistratioi +  pondxkmaxdistratioi) / 4.0 ;
-          // E_Float pondxdir_j_ratio1 = (pondximindistratioj + pondximaxdistratioj +  pondxkmindistratioj +  pondxkmaxdistratioj) / 4.0 ;
-          // E_Float pondxdir_k_ratio1 = (pondximindistratiok + pondximaxdistratiok +  pondxjmindistratiok +  pondxjmaxdistratiok) / 4.0 ;
-
-          // E_Float pondxdir_i_ratio = 1.0 - pondxdir_i_ratio1 ;
-          // E_Float pondxdir_j_ratio = 1.0 - pondxdir_j_ratio1 ;
-          // E_Float pondxdir_k_ratio = 1.0 - pondxdir_k_ratio1 ;
+          E_Float pi = pondi[i]; E_Float pi1 = 1.0 - pi;
+          E_Float pj = pondj[i]; E_Float pj1 = 1.0 - pj;
+          E_Float pk = pondk[i]; E_Float pk1 = 1.0 - pk;
 
           // U + V + W
-          t1x =
-            pondxdir_i_ratio1 * ximin[indjk] + pondxdir_i_ratio * ximax[indjk] +
-            pondxdir_j_ratio1 * xjmin[indik] + pondxdir_j_ratio * xjmax[indik] +
-            pondxdir_k_ratio1 * xkmin[indij] + pondxdir_k_ratio * xkmax[indij];
+          E_Float t1x =
+            pi1 * ximinjk + pi * ximaxjk +
+            pj1 * xjmink[i] + pj * xjmaxk[i] +
+            pk1 * xkminj[i] + pk * xkmaxj[i];
 
           // UV
-          t2x12 =
-            pondxdir_i_ratio1 * pondxdir_j_ratio1 * ximin[indicejmin_k] +
-            pondxdir_i_ratio1 * pondxdir_j_ratio  * ximin[indicejmax_k] +
-            pondxdir_i_ratio  * pondxdir_j_ratio1 * ximax[indicejmin_k] +
-            pondxdir_i_ratio  * pondxdir_j_ratio  * ximax[indicejmax_k] ;
-
-
-          // UW
-          t2x13 =
-            pondxdir_i_ratio1 * pondxdir_k_ratio1 * ximin[indicej_kmin] +
-            pondxdir_i_ratio1 * pondxdir_k_ratio  * ximin[indicej_kmax] +
-            pondxdir_i_ratio  * pondxdir_k_ratio1 * ximax[indicej_kmin] +
-            pondxdir_i_ratio  * pondxdir_k_ratio  * ximax[indicej_kmax] ;
-
+          E_Float t2x12 =
+            pi1 * pj1 * ximinjmink +
+            pi1 * pj  * ximinjmaxk +
+            pi  * pj1 * ximaxjmink +
+            pi  * pj  * ximaxjmaxk;
 
           // UW
-          t2x23 =
-            pondxdir_j_ratio1 * pondxdir_k_ratio1 * xjmin[indicei_kmin] +
-            pondxdir_j_ratio1 * pondxdir_k_ratio  * xjmin[indicei_kmax] +
-            pondxdir_j_ratio  * pondxdir_k_ratio1 * xjmax[indicei_kmin] +
-            pondxdir_j_ratio  * pondxdir_k_ratio  * xjmax[indicei_kmax] ;
-
+          E_Float t2x13 =
+            pi1 * pk1 * ximinjkmin +
+            pi1 * pk  * ximinjkmax +
+            pi  * pk1 * ximaxjkmin +
+            pi  * pk  * ximaxjkmax;
+
+          // VW
+          E_Float t2x23 =
+            pj1 * pk1 * xjmin[i] +
+            pj1 * pk  * xjmin1[i] +
+            pj  * pk1 * xjmax[i] +
+            pj  * pk  * xjmax1[i];
 
           // UVW
-          t3x =
-            pondxdir_i_ratio1 * pondxdir_j_ratio1 * pondxdir_k_ratio1 * ximin[indicejminkmin] + pondxdir_i_ratio1 * pondxdir_j_ratio1 * pondxdir_k_ratio * ximin[indicejminkmax] +
-            pondxdir_i_ratio1 * pondxdir_j_ratio  * pondxdir_k_ratio1 * ximin[indicejmaxkmin] + pondxdir_i_ratio1 * pondxdir_j_ratio  * pondxdir_k_ratio * ximin[indicejmaxkmax] +
-            pondxdir_i_ratio  * pondxdir_j_ratio1 * pondxdir_k_ratio1 * ximax[indicejminkmin] + pondxdir_i_ratio  * pondxdir_j_ratio1 * pondxdir_k_ratio * ximax[indicejminkmax] +
-            pondxdir_i_ratio  * pondxdir_j_ratio  * pondxdir_k_ratio1 * ximax[indicejmaxkmin] + pondxdir_i_ratio  * pondxdir_j_ratio  * pondxdir_k_ratio * ximax[indicejmaxkmax] ;
-
+          E_Float t3x =
+            pi1 * pj1 * pk1 * ximin00 + pi1 * pj1 * pk * ximin01 +
+            pi1 * pj  * pk1 * ximin10 + pi1 * pj  * pk * ximin11 +
+            pi  * pj1 * pk1 * ximax00 + pi  * pj1 * pk * ximax01 +
+            pi  * pj  * pk1 * ximax10 + pi  * pj  * pk * ximax11;
 
           // U + V + W - UV -UW - VW + UVW
-          xt[ind] = t1x - t2x12 - t2x13 - t2x23 + t3x;
-
+          xt[i] = t1x - t2x12 - t2x13 - t2x23 + t3x;
         }
+      }
+    }
   }
   return 1;
 }
@@ -121,9 +121,7 @@ def TFITri(a1, a2, a3, tol=1.e-6):
     l3 = D.line(CC, P23, N=N1-N+1)
 
     # TFIs
-    m1 = G.TFI([s1,l1,l3,s6])
-    m2 = G.TFI([l1,s2,s3,l2])
-    m3 = G.TFI([l2,s4,s5,l3])
+    [m1,m2,m3] = G.TFI([[s1,l1,l3,s6], [l1,s2,s3,l2], [l2,s4,s5,l3]])
 
     #return [l1,l2,l3,s1,s2,s3,s4,s5,s6]
     #return [s1,l1,l3,s6,m1]
@@ -208,11 +206,8 @@ def TFIO__(a, weight, offset=0):
     s4 = T.subzone(a, (indexPP4+1,1,1), (Nt,1,1))
     
     # TFIs
-    m = G.TFI([l1,l2,l3,l4])
-    m1 = G.TFI([s1, p1, p2, l1])
-    m2 = G.TFI([s2, p2, p3, l2])
-    m3 = G.TFI([s3, p3, p4, l3])
-    m4 = G.TFI([s4, p4, p1, l4])
+    [m,m1,m2,m3,m4] = G.TFI([[l1,l2,l3,l4], [s1, p1, p2, l1], [s2, p2, p3, l2],
+                             [s3, p3, p4, l3], [s4, p4, p1, l4]])
     return [m,m1,m2,m3,m4]
 
 #==============================================================================
@@ -331,11 +326,9 @@ def TFIHalfO__(a1, a2, weight, offset=0, tol=1.e-6):
     #C.convertArrays2File([l1,l2,l3,p1,p2,s1,s2,s3,s4,s5,s6], 'lines.plt')
 
     # TFIs
-    m = G.TFI([l1,l2,l3,s2])
-    m1 = G.TFI([s1, s4, p1, l1])
+    [m,m1,m2,m3] = G.TFI([[l1,l2,l3,s2], [s1, s4, p1, l1], [s5, p1, p2, l2],
+                          [s6, p2, s3, l3]])
     m1 = T.reorder(m1, (1,-2,3))
-    m2 = G.TFI([s5, p1, p2, l2])
-    m3 = G.TFI([s6, p2, s3, l3])
 
     return [m,m1,m2,m3]
 
@@ -418,7 +411,7 @@ def TFIStar2(edges):
     orderEdges(edges, tol=1.e-6)
     
     XG = G.barycenter(edges) # a optimiser
-    out = []
+    sets = []
     for c in range(len(edges)):
         e = edges[c]
         N1 = e[2]//2+1
@@ -432,9 +425,8 @@ def TFIStar2(edges):
         P1 = (e2p[0,-1], e2p[1,-1], e2p[2,-1])
         l1 = D.line(P0,XG,N=N2)
         l2 = D.line(XG,P1,N=N1)
-        ret = G.TFI([e1,e2,l1,l2])
-        #ret = [e1,e2,l1,l2]
-        out += [ret]
-    
+        sets.append([e1,e2,l1,l2])
+    # TFIs evaluees en un seul appel
+    out = G.TFI(sets)
     return out
     
\ No newline at end of file
@@ -18,6 +18,7 @@
 */
 
 # include "generator.h"
+# include "Nuga/include/BbTree.h"
 
 using namespace std;
 
@@ -69,6 +70,15 @@ facet* createFace(E_Int indCell, E_Int noFace, FldArrayI& cn, E_Int* ff,
   face->zmin = K_FUNC::E_min(face->z0, face->z1);
   face->zmin = K_FUNC::E_min(face->zmin, face->z2);
   face->zmin = K_FUNC::E_min(face->zmin, face->z3);
+  face->xmax = K_FUNC::E_max(face->x0, face->x1);
+  face->xmax = K_FUNC::E_max(face->xmax, face->x2);
+  face->xmax = K_FUNC::E_max(face->xmax, face->x3);
+  face->ymax = K_FUNC::E_max(face->y0, face->y1);
+  face->ymax = K_FUNC::E_max(face->ymax, face->y2);
+  face->ymax = K_FUNC::E_max(face->ymax, face->y3);
+  face->zmax = K_FUNC::E_max(face->z0, face->z1);
+  face->zmax = K_FUNC::E_max(face->zmax, face->z2);
+  face->zmax = K_FUNC::E_max(face->zmax, face->z3);
         
   face->cell = indCell;
   return face;
@@ -237,19 +247,58 @@ PyObject* K_GENERATOR::blankSelf(PyObject* self, PyObject* args)
   }
   
   // calcul des intersections des faces deux a deux
-  for (size_t i = 0; i < faces.size(); i++)
+  // seules les faces dont les boites englobantes se recouvrent sont testees
+  E_Int nfaces = faces.size();
+  E_Float eps = 1.e-10; // tolerance de trianglesIntersection
+  typedef K_SEARCH::BoundingBox<3> BBox3DType;
+  vector<BBox3DType*> boxes(nfaces);
+  E_Float minB0[3]; E_Float maxB0[3];
+  for (E_Int i = 0; i < nfaces; i++)
   {
-    face1 = faces[i];
-    for (size_t j = 0; j < faces.size(); j++)
+    face = faces[i];
+    minB0[0] = face->xmin-eps; minB0[1] = face->ymin-eps; minB0[2] = face->zmin-eps;
+    maxB0[0] = face->xmax+eps; maxB0[1] = face->ymax+eps; maxB0[2] = face->zmax+eps;
+    boxes[i] = new BBox3DType(minB0, maxB0);
+  }
+  FldArrayI blanked(ne); blanked.setAllValuesAtNull();
+  E_Int* blankedp = blanked.begin();
+  if (nfaces > 0)
+  {
+    K_SEARCH::BbTree3D bbtree(boxes);
+#pragma omp parallel default(shared) private(face1, face2, ret)
     {
-      face2 = faces[j];
-      if (i != j)
+      E_Float minB[3]; E_Float maxB[3];
+      vector<E_Int> indicesBB;
+      #pragma omp for schedule(dynamic)
+      for (E_Int i = 0; i < nfaces; i++)
       {
-        ret = intersect(face1, face2);
-        if (ret == 1) { cellN[face1->cell] = 0; cellN[face2->cell] = 0; } // disymetrique volontaire
+        face1 = faces[i];
+        minB[0] = face1->xmin-eps; minB[1] = face1->ymin-eps; minB[2] = face1->zmin-eps;
+        maxB[0] = face1->xmax+eps; maxB[1] = face1->ymax+eps; maxB[2] = face1->zmax+eps;
+        indicesBB.clear();
+        bbtree.getOverlappingBoxes(minB, maxB, indicesBB);
+        for (size_t noj = 0; noj < indicesBB.size(); noj++)
+        {
+          E_Int j = indicesBB[noj];
+          if (j == i) continue;
+          face2 = faces[j];
+          ret = intersect(face1, face2);
+          if (ret == 1) // disymetrique volontaire
+          {
+            #pragma omp atomic write
+            blankedp[face1->cell] = 1;
+            #pragma omp atomic write
+            blankedp[face2->cell] = 1;
+          }
+        }
       }
     }
   }
+  for (E_Int i = 0; i < ne; i++)
+  {
+    if (blankedp[i] == 1) cellN[i] = 0;
+  }
+  for (E_Int i = 0; i < nfaces; i++) delete boxes[i];
   
   // nettoyage des facettes
   for (size_t i = 0; i < faces.size(); i++) delete faces[i];
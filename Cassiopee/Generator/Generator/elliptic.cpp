@@ -31,21 +31,85 @@ extern "C"
                    E_Float* a11, E_Float* a12, E_Float* a22, 
                    E_Float* b11, E_Float* b12, E_Float* b22,
                    E_Float* c11, E_Float* c12, E_Float* c22);
-  void k6sor_(E_Float* x, E_Float* y, E_Int& n, E_Int& m,
-              E_Float* a11, E_Float* a12, E_Float*a22,
-              E_Float* b11, E_Float* b12, E_Float* b22,
-              E_Float* c11, E_Float* c12, E_Float* c22,
-              E_Float* rhsx, E_Float* rhsy, E_Float& err);
 }
 
 // ============================================================================
-/* TTM */
+/* Balayages SOR sur le stencil 9 points issu du systeme :
+   a11*x11 + b11*x12 + c11*x22 + a12*y11 + b12*y12 + c12*y22 = rhsx
+   a12*x11 + b12*x12 + c12*x22 + a22*y11 + b22*y12 + c22*y22 = rhsy
+   Les points interieurs sont parcourus par couleur (parite de i et de j) :
+   deux points de meme couleur ne sont jamais voisins, y compris en
+   diagonale, et sont mis a jour en parallele.
+   OUT: err: correction max sur l'ensemble des balayages */
+// ============================================================================
+static void sor9pt(E_Float* x, E_Float* y, E_Int n, E_Int m,
+                   E_Float* a11, E_Float* a12, E_Float* a22,
+                   E_Float* b11, E_Float* b12, E_Float* b22,
+                   E_Float* c11, E_Float* c12, E_Float* c22,
+                   E_Float* rhsx, E_Float* rhsy,
+                   E_Int nsweeps, E_Float omg, E_Float& err)
+{
+  E_Float dx = 1./n;
+  E_Float dy = 1./m;
+  E_Float dxx = dx*dx;
+  E_Float dxy = 4.*dx*dy;
+  E_Float dyy = dy*dy;
+  E_Float xerr = 0.;
+
+  for (E_Int ncnt = 0; ncnt < nsweeps; ncnt++)
+  {
+    for (E_Int color = 0; color < 4; color++)
+    {
+      E_Int si = 2-color%2; E_Int sj = 2-color/2; // premier point de la couleur
+#pragma omp parallel for reduction(max:xerr) if (n*m > __MIN_SIZE_MEAN__)
+      for (E_Int j = sj; j < m-1; j += 2)
+      {
+        for (E_Int i = si; i < n-1; i += 2)
+        {
+          E_Int ind = i+j*n;
+          E_Float cf11 = 2.*(a11[ind]/dxx + c11[ind]/dyy);
+          E_Float cf12 = 2.*(a12[ind]/dxx + c12[ind]/dyy);
+          E_Float cf22 = 2.*(a22[ind]/dxx + c22[ind]/dyy);
+
+          E_Float x12 = (x[ind+1+n] - x[ind+1-n] - x[ind-1+n] + x[ind-1-n])/dxy;
+          E_Float y12 = (y[ind+1+n] - y[ind+1-n] - y[ind-1+n] + y[ind-1-n])/dxy;
+          E_Float x11 = (x[ind+1] + x[ind-1])/dxx;
+          E_Float y11 = (y[ind+1] + y[ind-1])/dxx;
+          E_Float x22 = (x[ind+n] + x[ind-n])/dyy;
+          E_Float y22 = (y[ind+n] + y[ind-n])/dyy;
+
+          E_Float rhs1 = a11[ind]*x11 + a12[ind]*y11 + b11[ind]*x12 +
+            b12[ind]*y12 + c11[ind]*x22 + c12[ind]*y22 - rhsx[ind];
+          E_Float rhs2 = a12[ind]*x11 + a22[ind]*y11 + b12[ind]*x12 +
+            b22[ind]*y12 + c12[ind]*x22 + c22[ind]*y22 - rhsy[ind];
+
+          E_Float den = cf11*cf22-cf12*cf12;
+          if (den == 0.) continue; // point degenere : non modifie
+          E_Float xtmp = (cf22*rhs1-cf12*rhs2)/den;
+          E_Float ytmp = (cf11*rhs2-cf12*rhs1)/den;
+          xtmp = x[ind] + omg*(xtmp - x[ind]);
+          ytmp = y[ind] + omg*(ytmp - y[ind]);
+          xerr = K_FUNC::E_max(xerr, K_FUNC::E_abs(xtmp-x[ind]));
+          xerr = K_FUNC::E_max(xerr, K_FUNC::E_abs(ytmp-y[ind]));
+          x[ind] = xtmp;
+          y[ind] = ytmp;
+        }
+      }
+    }
+  }
+  err = xerr;
+}
+
+// ============================================================================
+/* TTM
+   IN: nit: nombre max d'iterations (calcul des coefficients + 20 balayages)
+   IN: eps: arret quand la correction max d'une iteration est < eps */
 // ============================================================================
 PyObject* K_GENERATOR::TTMMesh(PyObject* self, PyObject* args)
 {
-  E_Int nit;
+  E_Int nit; E_Float eps;
   PyObject* array;
-  if (!PYPARSETUPLE_(args, O_ I_, &array, &nit)) return NULL;
+  if (!PYPARSETUPLE_(args, O_ I_ R_, &array, &nit, &eps)) return NULL;
 
   // Check array
   E_Int im, jm, km;
@@ -101,17 +165,17 @@ PyObject* K_GENERATOR::TTMMesh(PyObject* self, PyObject* args)
   FldArrayF rhsy(ni*nj); rhsy.setAllValuesAtNull();
   E_Float err = 1000.;
 
-  while (it < nit && err > 1.e-13)
+  while (it < nit && err > eps)
   {
     k6coeffttm_(coord->begin(posx), coord->begin(posy), 
                 ni, nj, a11.begin(), a12.begin(), a22.begin(), 
                 b11.begin(), b12.begin(), b22.begin(), 
                 c11.begin(), c12.begin(), c22.begin());
-    k6sor_(coord->begin(posx), coord->begin(posy),
+    sor9pt(coord->begin(posx), coord->begin(posy),
            ni, nj, a11.begin(), a12.begin(), a22.begin(), 
            b11.begin(), b12.begin(), b22.begin(), 
            c11.begin(), c12.begin(), c22.begin(), 
-           rhsx.begin(), rhsy.begin(), err);
+           rhsx.begin(), rhsy.begin(), 20, 0.01, err);
     it++;
   }
  
@@ -283,12 +283,13 @@ PyObject* K_GENERATOR::getLocalStepFactor2(PyObject* self, PyObject* args)
   
   E_Int nvert = cn->getNfld();
   
-//#pragma omp parallel default(shared)
+#pragma omp parallel default(shared)
   {
     E_Int indP1, indP2;
     //E_Float snc0, snc1, snc2, xpm0, xpm1, xpm2;
 
-//#pragma omp for
+    // chaque point n'ecrit que ses propres valeurs de fouth/foute
+    #pragma omp for schedule(dynamic, __MIN_SIZE_MEAN__)
     for (E_Int ind = 0; ind < npts; ind++)
     {
       vector<E_Int>& voisins = cVE[ind];
@@ -459,3 +460,165 @@ PyObject* K_GENERATOR::getLocalStepFactor2(PyObject* self, PyObject* args)
   RELEASESHAREDU(normales, fn, cnn);
   return tpl;
 }
+
+// ============================================================================
+/* Lissage des normales aux noeuds d'une surface TRI ou QUAD (in place)
+   Meme algorithme que la boucle de Generator.getSmoothNormalMap, sans
+   cellN : a chaque iteration, les normales sont moyennees aux centres,
+   renormalisees, ramenees aux noeuds, renormalisees, puis
+   algo=0: n += eps*np, algo=1: n += eps*(np-n), n est renormalisee.
+   IN: array: surface
+   IN: normales: normales aux noeuds (sx,sy,sz), modifiees
+   IN: eps: float ou numpy de taille le nombre de noeuds
+   IN: niter: nombre d'iterations
+*/
+// ============================================================================
+PyObject* K_GENERATOR::smoothNormalMap(PyObject* self, PyObject* args)
+{
+  PyObject *array, *normales, *epsO;
+  E_Int niter, algo;
+  if (!PYPARSETUPLE_(args, OOO_ II_, &array, &normales, &epsO, &niter, &algo)) return NULL;
+
+  E_Int im, jm, km;
+  FldArrayF* f; FldArrayI* cn;
+  char* varString; char* eltType;
+  E_Int res = K_ARRAY::getFromArray(array, varString, f,
+                                    im, jm, km, cn, eltType, true);
+  if (res != 2)
+  {
+    PyErr_SetString(PyExc_TypeError,
+                    "smoothNormalMap: array must be unstructured.");
+    if (res == 1) RELEASESHAREDS(array,f); return NULL;
+  }
+  if (strcmp(eltType, "TRI") != 0 && strcmp(eltType, "QUAD") != 0)
+  {
+    PyErr_SetString(PyExc_TypeError,
+                    "smoothNormalMap: array must be TRI or QUAD.");
+    RELEASESHAREDU(array,f,cn); return NULL;
+  }
+
+  FldArrayF* fn; FldArrayI* cnn;
+  char* varStringn; char* eltTypen;
+  res = K_ARRAY::getFromArray(normales, varStringn, fn,
+                              im, jm, km, cnn, eltTypen, true);
+  if (res != 2)
+  {
+    PyErr_SetString(PyExc_TypeError,
+                    "smoothNormalMap: normals must be unstructured.");
+    RELEASESHAREDU(array, f, cn);
+    if (res == 1) RELEASESHAREDS(normales, fn);
+    return NULL;
+  }
+  E_Int possx = K_ARRAY::isNamePresent("sx",varStringn);
+  E_Int possy = K_ARRAY::isNamePresent("sy",varStringn);
+  E_Int possz = K_ARRAY::isNamePresent("sz",varStringn);
+  E_Int npts = f->getSize();
+  if (possx == -1 || possy == -1 || possz == -1 || fn->getSize() != npts)
+  {
+    PyErr_SetString(PyExc_TypeError,
+                    "smoothNormalMap: normals must contain sx,sy,sz at the nodes of array.");
+    RELEASESHAREDU(array,f,cn); RELEASESHAREDU(normales,fn,cnn);
+    return NULL;
+  }
+  possx++; possy++; possz++;
+
+  // eps constant ou par noeud
+  E_Float epsc = 0.; E_Float* epsp = NULL;
+  if (PyFloat_Check(epsO)) epsc = PyFloat_AsDouble(epsO);
+  else
+  {
+    E_Int size;
+    E_Int ok = K_NUMPY::getFromNumpyArray(epsO, epsp, size, true);
+    if (ok == 0 || size != npts)
+    {
+      PyErr_SetString(PyExc_TypeError,
+                      "smoothNormalMap: eps must be a float or a numpy of size the number of nodes.");
+      if (ok == 1) Py_DECREF(epsO);
+      RELEASESHAREDU(array,f,cn); RELEASESHAREDU(normales,fn,cnn);
+      return NULL;
+    }
+  }
+
+  E_Int nelts = cn->getSize();
+  E_Int nvert = cn->getNfld();
+  E_Float* sx = fn->begin(possx);
+  E_Float* sy = fn->begin(possy);
+  E_Float* sz = fn->begin(possz);
+
+  // connectivite noeuds/elements a plat
+  vector< vector<E_Int> > cVE(npts);
+  K_CONNECT::connectEV2VE(*cn, cVE);
+  FldArrayI posVE(npts+1);
+  E_Int* posVEp = posVE.begin();
+  posVEp[0] = 0;
+  for (E_Int ind = 0; ind < npts; ind++) posVEp[ind+1] = posVEp[ind] + cVE[ind].size();
+  FldArrayI VE(posVEp[npts]);
+  E_Int* VEp = VE.begin();
+  for (E_Int ind = 0; ind < npts; ind++)
+  {
+    for (size_t v = 0; v < cVE[ind].size(); v++) VEp[posVEp[ind]+v] = cVE[ind][v];
+  }
+  cVE.clear();
+
+  FldArrayF nc(nelts, 3);
+  E_Float* ncx = nc.begin(1);
+  E_Float* ncy = nc.begin(2);
+  E_Float* ncz = nc.begin(3);
+  E_Float ninv = 1./nvert;
+
+#pragma omp parallel default(shared)
+  {
+    for (E_Int it = 0; it < niter; it++)
+    {
+      // normales aux centres
+      #pragma omp for
+      for (E_Int et = 0; et < nelts; et++)
+      {
+        E_Float vx = 0.; E_Float vy = 0.; E_Float vz = 0.;
+        for (E_Int nv = 1; nv <= nvert; nv++)
+        {
+          E_Int ind = (*cn)(et,nv)-1;
+          vx += sx[ind]; vy += sy[ind]; vz += sz[ind];
+        }
+        vx *= ninv; vy *= ninv; vz *= ninv;
+        E_Float inv = 1./K_FUNC::E_max(sqrt(vx*vx+vy*vy+vz*vz), 1.e-12);
+        ncx[et] = vx*inv; ncy[et] = vy*inv; ncz[et] = vz*inv;
+      }
+
+      // retour aux noeuds et mise a jour
+      #pragma omp for
+      for (E_Int ind = 0; ind < npts; ind++)
+      {
+        E_Int nv = posVEp[ind+1]-posVEp[ind];
+        E_Float px = 0.; E_Float py = 0.; E_Float pz = 0.;
+        for (E_Int v = posVEp[ind]; v < posVEp[ind+1]; v++)
+        {
+          E_Int et = VEp[v];
+          px += ncx[et]; py += ncy[et]; pz += ncz[et];
+        }
+        if (nv > 0) { E_Float inv = 1./nv; px *= inv; py *= inv; pz *= inv; }
+        E_Float inv = 1./K_FUNC::E_max(sqrt(px*px+py*py+pz*pz), 1.e-12);
+        px *= inv; py *= inv; pz *= inv;
+
+        E_Float eps = (epsp == NULL ? epsc : epsp[ind]);
+        E_Float nx, ny, nz;
+        if (algo == 0)
+        { nx = sx[ind]+eps*px; ny = sy[ind]+eps*py; nz = sz[ind]+eps*pz; }
+        else
+        {
+          nx = sx[ind]+eps*(px-sx[ind]);
+          ny = sy[ind]+eps*(py-sy[ind]);
+          nz = sz[ind]+eps*(pz-sz[ind]);
+        }
+        inv = 1./K_FUNC::E_max(sqrt(nx*nx+ny*ny+nz*nz), 1.e-12);
+        sx[ind] = nx*inv; sy[ind] = ny*inv; sz[ind] = nz*inv;
+      }
+    }
+  }
+
+  if (epsp != NULL) Py_DECREF(epsO);
+  RELEASESHAREDU(array, f, cn);
+  RELEASESHAREDU(normales, fn, cnn);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
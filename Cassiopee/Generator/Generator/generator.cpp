@@ -47,6 +47,7 @@ static PyMethodDef Pygenerator [] =
   {"getOrthogonalityMap", K_GENERATOR::getOrthogonalityMap, METH_VARARGS},
   {"getRegularityMap", K_GENERATOR::getRegularityMap, METH_VARARGS},
   {"getAngleRegularityMap", K_GENERATOR::getAngleRegularityMap, METH_VARARGS},
+  {"getMeshQuality", K_GENERATOR::getMeshQuality, METH_VARARGS},
   {"getNormalMap", K_GENERATOR::getNormalMapOfMesh, METH_VARARGS},
   {"getCircumCircleMap", K_GENERATOR::getCircumCircleMap, METH_VARARGS},
   {"getInCircleMap", K_GENERATOR::getInCircleMap, METH_VARARGS},
@@ -109,6 +110,7 @@ static PyMethodDef Pygenerator [] =
   {"computeEta", K_GENERATOR::computeEta, METH_VARARGS},
   {"getLocalStepFactor", K_GENERATOR::getLocalStepFactor, METH_VARARGS},
   {"getLocalStepFactor2", K_GENERATOR::getLocalStepFactor2, METH_VARARGS},
+  {"smoothNormalMap", K_GENERATOR::smoothNormalMap, METH_VARARGS},
   {"getEdgeRatio", K_GENERATOR::getEdgeRatio, METH_VARARGS},
   {"getMaxLength", K_GENERATOR::getMaxLength, METH_VARARGS},
   {"getTriQualityMap", K_GENERATOR::getTriQualityMap, METH_VARARGS},
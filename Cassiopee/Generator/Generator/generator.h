@@ -61,6 +61,7 @@ namespace K_GENERATOR
   PyObject* getOrthogonalityMap(PyObject* self, PyObject* args);
   PyObject* getRegularityMap(PyObject* self, PyObject* args);
   PyObject* getAngleRegularityMap(PyObject* self, PyObject* args);
+  PyObject* getMeshQuality(PyObject* self, PyObject* args);
   PyObject* getNormalMapOfMesh(PyObject* self, PyObject* args);
   PyObject* getCircumCircleMap(PyObject* self, PyObject* args);
   PyObject* getInCircleMap(PyObject* self, PyObject* args);
@@ -113,6 +114,7 @@ namespace K_GENERATOR
   PyObject* computeEta(PyObject* self, PyObject* args);
   PyObject* getLocalStepFactor(PyObject* self, PyObject* args);
   PyObject* getLocalStepFactor2(PyObject* self, PyObject* args);
+  PyObject* smoothNormalMap(PyObject* self, PyObject* args);
   PyObject* getEdgeRatio(PyObject* self, PyObject* args);
   PyObject* getMaxLength(PyObject* self, PyObject* args);
   PyObject* getTriQualityMap(PyObject* self, PyObject* args);
@@ -197,9 +199,26 @@ namespace K_GENERATOR
   E_Int closeBARMeshElt(E_Int posx, E_Int posy, E_Int posz,
                         FldArrayF& f, FldArrayI& cn, E_Int i);
 
-  PyObject* TFI2D(PyObject* arrays);
+/* Bloc TFI structure dont les frontieres sont lues et reordonnees,
+   evalue plus tard (TFI par lots) */
+  struct TFIBlock
+  {
+    E_Int ni, nj, nk, nfld, posx, posy, posz;
+    E_Int imin, imax, jmin, jmax, kmin, kmax;
+    std::vector<FldArrayF*> fields;
+    std::vector<PyObject*> objs;
+    E_Float* coordp;
+  };
 
-  PyObject* TFI3D(PyObject* arrays);
+/* TFI d'une liste de frontieres. Si block est fourni, le bloc structure
+   est alloue mais pas evalue : son evaluation et la liberation des
+   frontieres sont laissees a l'appelant. */
+  PyObject* TFI2D(PyObject* arrays, TFIBlock* block=NULL);
+
+  PyObject* TFI3D(PyObject* arrays, TFIBlock* block=NULL);
+
+/* TFI d'une liste de listes de frontieres, blocs evalues en parallele */
+  PyObject* TFIBlocks(PyObject* arrays);
 
   PyObject* TFITRI(PyObject* arrays);
 
@@ -227,6 +246,10 @@ namespace K_GENERATOR
                     E_Int posx, E_Int posy, E_Int posz,
                     E_Int imin, E_Int imax, E_Int jmin, E_Int jmax, E_Int kmin, E_Int kmax,
                     std::vector<FldArrayF*>& fields, FldArrayF& coords);
+/* Rapport distance au premier point / distance entre extremites pour les
+   n points (pas s) d'une courbe */
+  void chordRatioTFI(E_Int n, E_Int s, E_Float* x, E_Float* y, E_Float* z,
+                     E_Float* r);
   E_Int reorderTFI2D(E_Int posx, E_Int posy, E_Int posz,
                      std::vector<E_Int>& nit, std::vector<FldArrayF*>& fields, 
                      FldArrayIS& newOrder);
@@ -72,14 +72,13 @@ PyObject* K_GENERATOR::getCircumCircleMap(PyObject* self, PyObject* args)
   E_Int* cn2 = cn->begin(2);
   E_Int* cn3 = cn->begin(3);
   
-  E_Int ind1, ind2, ind3;
-  E_Float p1x, p1y, p1z, p2x, p2y, p2z, p3x, p3y, p3z;
+#pragma omp parallel for if (ncells > __MIN_SIZE_MEAN__)
   for (E_Int et = 0; et < ncells; et++)
   {
-    ind1 = cn1[et]-1; ind2 = cn2[et]-1; ind3 = cn3[et]-1;
-    p1x = xt[ind1]; p1y = yt[ind1]; p1z = zt[ind1];  
-    p2x = xt[ind2]; p2y = yt[ind2]; p2z = zt[ind2];
-    p3x = xt[ind3]; p3y = yt[ind3]; p3z = zt[ind3];
+    E_Int ind1 = cn1[et]-1; E_Int ind2 = cn2[et]-1; E_Int ind3 = cn3[et]-1;
+    E_Float p1x = xt[ind1]; E_Float p1y = yt[ind1]; E_Float p1z = zt[ind1];
+    E_Float p2x = xt[ind2]; E_Float p2y = yt[ind2]; E_Float p2z = zt[ind2];
+    E_Float p3x = xt[ind3]; E_Float p3y = yt[ind3]; E_Float p3z = zt[ind3];
     ccrad[et] = K_COMPGEOM::circumCircleRadius(p1x, p1y, p1z, p2x, p2y, p2z, p3x, p3y, p3z);
   }
   
@@ -68,10 +68,10 @@ PyObject* K_GENERATOR::getInCircleMap(PyObject* self, PyObject* args)
   E_Int* cn2 = cn->begin(2);
   E_Int* cn3 = cn->begin(3);
   
-  E_Float p1[3]; E_Float p2[3]; E_Float p3[3];
+#pragma omp parallel for if (ncells > __MIN_SIZE_MEAN__)
   for (E_Int et = 0; et < ncells; et++)
   {
-    
+    E_Float p1[3]; E_Float p2[3]; E_Float p3[3];
     E_Int ind1 = cn1[et]-1; E_Int ind2 = cn2[et]-1; E_Int ind3 = cn3[et]-1;
     p1[0] = xt[ind1]; p1[1] = yt[ind1]; p1[2] = zt[ind1];  
     p2[0] = xt[ind2]; p2[1] = yt[ind2]; p2[2] = zt[ind2];  
@@ -0,0 +1,453 @@
+/*
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// getMeshQuality
+
+# include "generator.h"
+# include <algorithm>
+
+using namespace K_FLD;
+using namespace K_FUNC;
+using namespace K_CONST;
+using namespace std;
+
+extern "C"
+{
+  void k6structsurft_(
+    const E_Int& ni, const E_Int& nj, const E_Int& nk, const E_Int& ncells,
+    const E_Float* xt, const E_Float* yt, const E_Float* zt,
+    E_Float* length);
+  void k6structsurf1dt_(
+    const E_Int& ni, const E_Int& nj, const E_Int& nk,
+    const E_Float* xt, const E_Float* yt, const E_Float* zt,
+    E_Float* length);
+}
+
+// Indicateurs : volume, orthogonalite, regularite, regularite angulaire
+#define NQUAL 4
+// Statistiques par zone et par indicateur : min, max, somme, nb de cellules critiques
+#define NSTAT 4
+
+//=============================================================================
+// Flux c.S d'une interface quadrangulaire (l1,l2,l3,l4) : centre de
+// l'interface scalaire surface (demi produit vectoriel des diagonales).
+// Memes operations que k6compcenterinterface/k6compintsurf.
+//=============================================================================
+static inline E_Float faceFlux(const E_Float* x, const E_Float* y, const E_Float* z,
+                               E_Int l1, E_Int l2, E_Int l3, E_Int l4)
+{
+  E_Float xc = 0.25*(x[l1]+x[l2]+x[l3]+x[l4]);
+  E_Float yc = 0.25*(y[l1]+y[l2]+y[l3]+y[l4]);
+  E_Float zc = 0.25*(z[l1]+z[l2]+z[l3]+z[l4]);
+  E_Float d13x = x[l3]-x[l1]; E_Float d13y = y[l3]-y[l1]; E_Float d13z = z[l3]-z[l1];
+  E_Float d24x = x[l4]-x[l2]; E_Float d24y = y[l4]-y[l2]; E_Float d24z = z[l4]-z[l2];
+  E_Float nx = 0.5*(d13y*d24z-d13z*d24y);
+  E_Float ny = 0.5*(d13z*d24x-d13x*d24z);
+  E_Float nz = 0.5*(d13x*d24y-d13y*d24x);
+  return xc*nx + yc*ny + zc*nz;
+}
+
+//=============================================================================
+// Ecart a l'angle droit (deg) de l'angle en P0 du triangle (P0, Pa, Pb)
+// (cf. getOrthogonalityMap)
+//=============================================================================
+static inline E_Float orthoAngle(const E_Float* x, const E_Float* y, const E_Float* z,
+                                 E_Int ind1, E_Int ind2, E_Int ind3, E_Float degconst)
+{
+  E_Float a2 = (x[ind2]-x[ind1])*(x[ind2]-x[ind1])+(y[ind2]-y[ind1])*(y[ind2]-y[ind1])+(z[ind2]-z[ind1])*(z[ind2]-z[ind1]);
+  E_Float b2 = (x[ind3]-x[ind1])*(x[ind3]-x[ind1])+(y[ind3]-y[ind1])*(y[ind3]-y[ind1])+(z[ind3]-z[ind1])*(z[ind3]-z[ind1]);
+  E_Float c2 = (x[ind3]-x[ind2])*(x[ind3]-x[ind2])+(y[ind3]-y[ind2])*(y[ind3]-y[ind2])+(z[ind3]-z[ind2])*(z[ind3]-z[ind2]);
+  E_Float a = sqrt(a2);
+  E_Float b = sqrt(b2);
+  return E_abs(acos((a2+b2-c2)/(2.*a*b))*degconst - 90.);
+}
+
+//=============================================================================
+// Ecart a l'alignement (deg) de trois noeuds consecutifs d'une ligne de
+// maillage (cf. getAngleRegularityMap)
+//=============================================================================
+static inline E_Float lineAngle(const E_Float* x, const E_Float* y, const E_Float* z,
+                                E_Int ind1, E_Int ind2, E_Int ind3, E_Float degconst)
+{
+  E_Float a2 = (x[ind2]-x[ind1])*(x[ind2]-x[ind1])+(y[ind2]-y[ind1])*(y[ind2]-y[ind1])+(z[ind2]-z[ind1])*(z[ind2]-z[ind1]);
+  E_Float b2 = (x[ind3]-x[ind2])*(x[ind3]-x[ind2])+(y[ind3]-y[ind2])*(y[ind3]-y[ind2])+(z[ind3]-z[ind2])*(z[ind3]-z[ind2]);
+  E_Float c2 = (x[ind3]-x[ind1])*(x[ind3]-x[ind1])+(y[ind3]-y[ind1])*(y[ind3]-y[ind1])+(z[ind3]-z[ind1])*(z[ind3]-z[ind1]);
+  if (a2 == 0 || b2 == 0 || c2 == 0) return 0.;
+  E_Float a = sqrt(a2);
+  E_Float b = sqrt(b2);
+  E_Float d = E_max(E_min((a2+b2-c2)/(2.*a*b),1.),-1.);
+  return E_abs(acos(d)*degconst - 180.);
+}
+
+//=============================================================================
+// Classe d'une valeur dans un histogramme de bornes edges (nb+1 valeurs
+// croissantes). Les valeurs hors bornes vont dans la premiere/derniere classe.
+//=============================================================================
+static inline E_Int histBin(const E_Float* edges, E_Int nb, E_Float v)
+{
+  if (!(v >= edges[1])) return 0; // NaN dans la premiere classe
+  if (v >= edges[nb-1]) return nb-1;
+  return E_Int(upper_bound(edges+1, edges+nb, v)-edges)-1;
+}
+
+// Accumulateur d'un thread pour une zone
+struct ZoneAcc
+{
+  E_Int zone;
+  E_Float s[NQUAL*NSTAT];
+  void init(E_Int z)
+  {
+    zone = z;
+    for (E_Int q = 0; q < NQUAL; q++)
+    {
+      s[q*NSTAT] = K_CONST::E_MAX_FLOAT; s[q*NSTAT+1] = -K_CONST::E_MAX_FLOAT;
+      s[q*NSTAT+2] = 0.; s[q*NSTAT+3] = 0.;
+    }
+  }
+};
+
+//=============================================================================
+// Verse l'accumulateur d'un thread dans les statistiques de sa zone
+//=============================================================================
+static void flushZoneAcc(ZoneAcc& acc, E_Float* zstats)
+{
+  if (acc.zone < 0) return;
+  E_Float* zs = zstats + acc.zone*NQUAL*NSTAT;
+  #pragma omp critical (meshQualityZone)
+  {
+    for (E_Int q = 0; q < NQUAL; q++)
+    {
+      E_Int p = q*NSTAT;
+      zs[p] = E_min(zs[p], acc.s[p]); zs[p+1] = E_max(zs[p+1], acc.s[p+1]);
+      zs[p+2] += acc.s[p+2]; zs[p+3] += acc.s[p+3];
+    }
+  }
+  acc.zone = -1;
+}
+
+// ============================================================================
+/* Qualite de maillages structures : volume, orthogonalite, regularite et
+   regularite angulaire, calcules ensemble pour toutes les zones.
+   Memes definitions que getVolumeMap, getOrthogonalityMap, getRegularityMap
+   et getAngleRegularityMap.
+   Le volume des zones 3D est calcule cellule par cellule, sans tableaux
+   d'interfaces. Une seconde passe, sur les lignes (zone, j, k) de toutes les
+   zones, calcule les trois autres indicateurs et accumule les statistiques.
+   IN: arrays: liste d'arrays structures (TypeError si un array est non structure)
+   IN: crits: seuils [vol, orthogonality, regularity, regularityAngle]
+   (une cellule est critique si vol < crit ou si indicateur > crit)
+   IN: edges: liste de 4 numpys de bornes d'histogramme (ou liste vide)
+   IN: fields: 1: retourne aussi les champs en centres
+   OUT: [zstats, hists, worst, fields]
+   zstats: numpy (nzones, 16), par indicateur : min, max, somme, nb critique
+   hists: liste de 4 numpys d'entiers
+   worst: liste de 4 [no zone, indice de cellule, valeur] (plus petit volume,
+   plus grande valeur pour les autres indicateurs)
+   fields: liste d'arrays "vol,orthogonality,regularity,regularityAngle" */
+// ============================================================================
+PyObject* K_GENERATOR::getMeshQuality(PyObject* self, PyObject* args)
+{
+  PyObject* arrays; PyObject* critsO; PyObject* edgesO;
+  E_Int buildFields;
+  if (!PYPARSETUPLE_(args, OOO_ I_, &arrays, &critsO, &edgesO, &buildFields)) return NULL;
+
+  if (PyList_Check(critsO) == 0 || PyList_Size(critsO) != NQUAL)
+  {
+    PyErr_SetString(PyExc_TypeError,
+                    "getMeshQuality: crits must be a list of 4 floats.");
+    return NULL;
+  }
+  E_Float crits[NQUAL];
+  for (E_Int q = 0; q < NQUAL; q++) crits[q] = PyFloat_AsDouble(PyList_GetItem(critsO, q));
+
+  // Bornes des histogrammes
+  E_Float* edges[NQUAL]; E_Int nbins[NQUAL];
+  for (E_Int q = 0; q < NQUAL; q++) { edges[q] = NULL; nbins[q] = 0; }
+  if (PyList_Check(edgesO) && PyList_Size(edgesO) == NQUAL)
+  {
+    for (E_Int q = 0; q < NQUAL; q++)
+    {
+      E_Int size;
+      E_Int ok = K_NUMPY::getFromNumpyArray(PyList_GetItem(edgesO, q), edges[q], size, true);
+      if (ok == 0 || size < 2)
+      {
+        PyErr_SetString(PyExc_TypeError,
+                        "getMeshQuality: edges must be numpy arrays of at least 2 values.");
+        for (E_Int p = 0; p < q; p++) Py_DECREF(PyList_GetItem(edgesO, p));
+        if (ok) Py_DECREF(PyList_GetItem(edgesO, q));
+        return NULL;
+      }
+      nbins[q] = size-1;
+    }
+  }
+
+  vector<E_Int> res;
+  vector<char*> structVarString; vector<char*> unstrVarString;
+  vector<FldArrayF*> structF; vector<FldArrayF*> unstrF;
+  vector<E_Int> nit; vector<E_Int> njt; vector<E_Int> nkt;
+  vector<FldArrayI*> cnt; vector<char*> eltType;
+  vector<PyObject*> objs, obju;
+  E_Int isOk = K_ARRAY::getFromArrays(
+    arrays, res, structVarString, unstrVarString,
+    structF, unstrF, nit, njt, nkt, cnt, eltType, objs, obju,
+    false, true, false, true, true);
+  E_Int nzones = structF.size();
+  E_Int nu = unstrF.size();
+  if (isOk == -1 || nu > 0)
+  {
+    if (isOk == -1)
+      PyErr_SetString(PyExc_TypeError,
+                      "getMeshQuality: invalid list of arrays.");
+    else
+      PyErr_SetString(PyExc_TypeError,
+                      "getMeshQuality: arrays must be structured.");
+    for (E_Int nos = 0; nos < nzones; nos++) RELEASESHAREDS(objs[nos], structF[nos]);
+    for (E_Int nou = 0; nou < nu; nou++) RELEASESHAREDU(obju[nou], unstrF[nou], cnt[nou]);
+    if (nbins[0] > 0) for (E_Int q = 0; q < NQUAL; q++) Py_DECREF(PyList_GetItem(edgesO, q));
+    return NULL;
+  }
+
+  // Dimensions, coordonnees et lignes de cellules (j,k) de chaque zone
+  vector<E_Float*> xt(nzones), yt(nzones), zt(nzones), vol(nzones);
+  vector<E_Int> ni1t(nzones), nj1t(nzones), nk1t(nzones);
+  vector<E_Int> rowStart(nzones+1);
+  vector<FldArrayF*> volTmp(nzones, NULL);
+  PyObject* fieldsList = PyList_New(0);
+  rowStart[0] = 0;
+  for (E_Int nz = 0; nz < nzones; nz++)
+  {
+    E_Int posx = K_ARRAY::isCoordinateXPresent(structVarString[nz])+1;
+    E_Int posy = K_ARRAY::isCoordinateYPresent(structVarString[nz])+1;
+    E_Int posz = K_ARRAY::isCoordinateZPresent(structVarString[nz])+1;
+    xt[nz] = structF[nz]->begin(posx);
+    yt[nz] = structF[nz]->begin(posy);
+    zt[nz] = structF[nz]->begin(posz);
+    E_Int im = nit[nz]; E_Int jm = njt[nz]; E_Int km = nkt[nz];
+    E_Int im1 = E_max(im-1, E_Int(1));
+    E_Int jm1 = E_max(jm-1, E_Int(1));
+    E_Int km1 = E_max(km-1, E_Int(1));
+    ni1t[nz] = im1; nj1t[nz] = jm1; nk1t[nz] = km1;
+    rowStart[nz+1] = rowStart[nz] + jm1*km1;
+    E_Int ncells = im1*jm1*km1;
+
+    if (buildFields == 1)
+    {
+      PyObject* tpl = K_ARRAY::buildArray(NQUAL, "vol,orthogonality,regularity,regularityAngle",
+                                          im1, jm1, km1);
+      vol[nz] = K_ARRAY::getFieldPtr(tpl);
+      PyList_Append(fieldsList, tpl); Py_DECREF(tpl);
+    }
+    else
+    {
+      volTmp[nz] = new FldArrayF(ncells);
+      vol[nz] = volTmp[nz]->begin();
+    }
+
+    // Volumes des zones 1D et 2D
+    E_Int dim = 3;
+    if (im == 1 || jm == 1 || km == 1)
+    {
+      if ((im > 1 && (jm > 1 || km > 1)) || (jm > 1 && km > 1)) dim = 2;
+      else dim = 1;
+    }
+    if (dim == 1) k6structsurf1dt_(im, jm, km, xt[nz], yt[nz], zt[nz], vol[nz]);
+    else if (dim == 2) k6structsurft_(im, jm, km, ncells, xt[nz], yt[nz], zt[nz], vol[nz]);
+  }
+  E_Int nrows = rowStart[nzones];
+
+  FldArrayF zstats(nzones, NQUAL*NSTAT);
+  for (E_Int nz = 0; nz < nzones; nz++)
+  {
+    E_Float* zs = zstats.begin()+nz*NQUAL*NSTAT;
+    for (E_Int q = 0; q < NQUAL; q++)
+    {
+      zs[q*NSTAT] = K_CONST::E_MAX_FLOAT; zs[q*NSTAT+1] = -K_CONST::E_MAX_FLOAT;
+      zs[q*NSTAT+2] = 0.; zs[q*NSTAT+3] = 0.;
+    }
+  }
+  vector< vector<E_Int> > hists(NQUAL);
+  for (E_Int q = 0; q < NQUAL; q++) hists[q].assign(nbins[q], 0);
+  // pire cellule : (valeur, zone, indice)
+  E_Float worstVal[NQUAL]; E_Int worstZone[NQUAL], worstInd[NQUAL];
+  for (E_Int q = 0; q < NQUAL; q++) { worstZone[q] = -1; worstInd[q] = -1; worstVal[q] = 0.; }
+
+  E_Float pi = 4*atan(1.);
+  E_Float degconst = 180.0 / pi;
+
+  #pragma omp parallel
+  {
+    // Passe 1 : volumes des zones 3D
+    #pragma omp for schedule(dynamic, __MIN_SIZE_MEAN__)
+    for (E_Int r = 0; r < nrows; r++)
+    {
+      E_Int nz = E_Int(upper_bound(rowStart.begin(), rowStart.end(), r)-rowStart.begin())-1;
+      E_Int im = nit[nz]; E_Int jm = njt[nz]; E_Int km = nkt[nz];
+      if (im < 2 || jm < 2 || km < 2) continue;
+      E_Int ni1 = ni1t[nz]; E_Int nj1 = nj1t[nz];
+      E_Int rl = r-rowStart[nz];
+      E_Int j = rl%nj1; E_Int k = rl/nj1;
+      E_Int imjm = im*jm;
+      E_Float* x = xt[nz]; E_Float* y = yt[nz]; E_Float* z = zt[nz];
+      E_Float* volp = vol[nz];
+      E_Float onethird = 1./3.;
+      for (E_Int i = 0; i < ni1; i++)
+      {
+        E_Int l1 = i + j*im + k*imjm;
+        E_Int lv = i + j*ni1 + k*ni1*nj1;
+        E_Int l2 = l1+1; E_Int l3 = l1+im; E_Int l4 = l1+imjm;
+        E_Float v1 = faceFlux(x, y, z, l1, l1+im, l1+im+imjm, l1+imjm);
+        E_Float v2 = faceFlux(x, y, z, l2, l2+im, l2+im+imjm, l2+imjm);
+        E_Float v3 = faceFlux(x, y, z, l1, l1+imjm, l1+1+imjm, l1+1);
+        E_Float v4 = faceFlux(x, y, z, l3, l3+imjm, l3+1+imjm, l3+1);
+        E_Float v5 = faceFlux(x, y, z, l1, l1+1, l1+1+im, l1+im);
+        E_Float v6 = faceFlux(x, y, z, l4, l4+1, l4+1+im, l4+im);
+        volp[lv] = (v2 - v1 + v4 - v3 + v6 - v5) * onethird;
+      }
+    }
+    // barriere implicite : tous les volumes sont connus
+
+    // Passe 2 : orthogonalite, regularite, regularite angulaire, statistiques
+    ZoneAcc acc; acc.zone = -1;
+    vector< vector<E_Int> > lhists(NQUAL);
+    for (E_Int q = 0; q < NQUAL; q++) lhists[q].assign(nbins[q], 0);
+    E_Float lworstVal[NQUAL]; E_Int lworstZone[NQUAL], lworstInd[NQUAL];
+    for (E_Int q = 0; q < NQUAL; q++) { lworstZone[q] = -1; lworstInd[q] = -1; lworstVal[q] = 0.; }
+    E_Float qv[NQUAL];
+
+    #pragma omp for schedule(dynamic, __MIN_SIZE_MEAN__)
+    for (E_Int r = 0; r < nrows; r++)
+    {
+      E_Int nz = E_Int(upper_bound(rowStart.begin(), rowStart.end(), r)-rowStart.begin())-1;
+      if (acc.zone != nz) { flushZoneAcc(acc, zstats.begin()); acc.init(nz); }
+
+      E_Int im = nit[nz]; E_Int jm = njt[nz]; E_Int km = nkt[nz];
+      E_Int ni1 = ni1t[nz]; E_Int nj1 = nj1t[nz]; E_Int nk1 = nk1t[nz];
+      E_Int rl = r-rowStart[nz];
+      E_Int j = rl%nj1; E_Int k = rl/nj1;
+      E_Float* x = xt[nz]; E_Float* y = yt[nz]; E_Float* z = zt[nz];
+      E_Float* volp = vol[nz];
+      E_Int ncells = ni1*nj1*nk1;
+      E_Float* orthop = NULL; E_Float* regp = NULL; E_Float* angp = NULL;
+      if (buildFields == 1) { orthop = volp+ncells; regp = volp+2*ncells; angp = volp+3*ncells; }
+
+      // directions actives (noeuds) et pas en noeuds/cellules
+      E_Int nn[3] = {im, jm, km};
+      E_Int nc[3] = {ni1, nj1, nk1};
+      E_Int sn[3] = {1, im, im*jm};
+      E_Int sc[3] = {1, ni1, ni1*nj1};
+      E_Int act[3]; E_Int nact = 0;
+      for (E_Int d = 0; d < 3; d++) if (nn[d] > 1) act[nact++] = d;
+
+      for (E_Int i = 0; i < ni1; i++)
+      {
+        E_Int c[3] = {i, j, k};
+        E_Int ind = i + j*ni1 + k*ni1*nj1;
+        E_Int indn = i + j*im + k*im*jm;
+
+        // orthogonalite : angles entre les aretes issues du premier noeud
+        E_Float ortho = 0.;
+        if (nact == 3)
+        {
+          E_Float a1 = orthoAngle(x, y, z, indn, indn+sn[0], indn+sn[1], degconst);
+          E_Float a2 = orthoAngle(x, y, z, indn, indn+sn[0], indn+sn[2], degconst);
+          E_Float a3 = orthoAngle(x, y, z, indn, indn+sn[1], indn+sn[2], degconst);
+          ortho = E_max(E_max(a1, a2), a3);
+        }
+        else if (nact == 2)
+          ortho = orthoAngle(x, y, z, indn, indn+sn[act[0]], indn+sn[act[1]], degconst);
+
+        // regularite : rapport de volume avec les cellules voisines
+        // regularite angulaire : alignement des noeuds le long des lignes
+        E_Float v = volp[ind];
+        E_Float reg = 0.; E_Float ang = 0.;
+        for (E_Int d = 0; d < 3; d++)
+        {
+          if (nc[d] < 2) continue;
+          if (c[d] > 0)
+          {
+            reg = E_max(reg, E_abs(volp[ind-sc[d]]-v)/E_max(v,E_GEOM_CUTOFF));
+            ang = E_max(ang, lineAngle(x, y, z, indn-sn[d], indn, indn+sn[d], degconst));
+          }
+          if (c[d] < nc[d]-1)
+          {
+            reg = E_max(reg, E_abs(volp[ind+sc[d]]-v)/E_max(v,E_GEOM_CUTOFF));
+            ang = E_max(ang, lineAngle(x, y, z, indn, indn+sn[d], indn+2*sn[d], degconst));
+          }
+        }
+
+        if (orthop != NULL) { orthop[ind] = ortho; regp[ind] = reg; angp[ind] = ang; }
+
+        qv[0] = v; qv[1] = ortho; qv[2] = reg; qv[3] = ang;
+        for (E_Int q = 0; q < NQUAL; q++)
+        {
+          E_Float val = qv[q];
+          E_Float* s = acc.s+q*NSTAT;
+          s[0] = E_min(s[0], val); s[1] = E_max(s[1], val); s[2] += val;
+          if (q == 0) { if (val < crits[q]) s[3] += 1.; }
+          else if (val > crits[q]) s[3] += 1.;
+          if (nbins[q] > 0) lhists[q][histBin(edges[q], nbins[q], val)]++;
+          E_Bool worse = (lworstZone[q] < 0) || (q == 0 ? val < lworstVal[q] : val > lworstVal[q]);
+          if (worse) { lworstVal[q] = val; lworstZone[q] = nz; lworstInd[q] = ind; }
+        }
+      }
+    }
+    flushZoneAcc(acc, zstats.begin());
+
+    #pragma omp critical (meshQualityMerge)
+    {
+      for (E_Int q = 0; q < NQUAL; q++)
+      {
+        for (E_Int b = 0; b < nbins[q]; b++) hists[q][b] += lhists[q][b];
+        if (lworstZone[q] < 0) continue;
+        E_Bool worse = (worstZone[q] < 0) ||
+          (q == 0 ? lworstVal[q] < worstVal[q] : lworstVal[q] > worstVal[q]) ||
+          (lworstVal[q] == worstVal[q] &&
+           (lworstZone[q] < worstZone[q] || (lworstZone[q] == worstZone[q] && lworstInd[q] < worstInd[q])));
+        if (worse) { worstVal[q] = lworstVal[q]; worstZone[q] = lworstZone[q]; worstInd[q] = lworstInd[q]; }
+      }
+    }
+  }
+
+  for (E_Int nz = 0; nz < nzones; nz++)
+  {
+    delete volTmp[nz];
+    RELEASESHAREDS(objs[nz], structF[nz]);
+  }
+  if (nbins[0] > 0) for (E_Int q = 0; q < NQUAL; q++) Py_DECREF(PyList_GetItem(edgesO, q));
+
+  PyObject* zstatsO = K_NUMPY::buildNumpyArray(zstats, 1);
+  PyObject* histsO = PyList_New(0);
+  PyObject* worstO = PyList_New(0);
+  for (E_Int q = 0; q < NQUAL; q++)
+  {
+    if (nbins[q] > 0)
+    {
+      FldArrayI h(nbins[q]);
+      for (E_Int b = 0; b < nbins[q]; b++) h[b] = hists[q][b];
+      PyObject* hO = K_NUMPY::buildNumpyArray(h, 1);
+      PyList_Append(histsO, hO); Py_DECREF(hO);
+    }
+    PyObject* wO = Py_BuildValue("[lld]", long(worstZone[q]), long(worstInd[q]), worstVal[q]);
+    PyList_Append(worstO, wO); Py_DECREF(wO);
+  }
+
+  PyObject* tpl = Py_BuildValue("[OOOO]", zstatsO, histsO, worstO, fieldsList);
+  Py_DECREF(zstatsO); Py_DECREF(histsO); Py_DECREF(worstO); Py_DECREF(fieldsList);
+  return tpl;
+}
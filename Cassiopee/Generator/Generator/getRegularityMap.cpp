@@ -598,7 +598,6 @@ PyObject* K_GENERATOR::getRegularityMap(PyObject* self, PyObject* args)
     E_Int nelts = cn->getSize();
     E_Int nnodes = cn->getNfld(); // nb de noeuds ds 1 element
     E_Int npts = f->getSize();
-    E_Float etVol; E_Int eti; E_Int indi;
 
     // Construction du tableau numpy stockant le ratio max de volumes entre elements voisins, 
     // definissant la regularite
@@ -615,7 +614,6 @@ PyObject* K_GENERATOR::getRegularityMap(PyObject* self, PyObject* args)
     // Rapport MAX de volumes entre un element et ses voisins. Resultat au "centre"
     if (strcmp(eltType, "TRI") == 0)
     {
-      E_Float maxratio;
       // Calcul du volume des elements
       FldArrayF snx(nelts);
       FldArrayF sny(nelts);
@@ -635,18 +633,19 @@ PyObject* K_GENERATOR::getRegularityMap(PyObject* self, PyObject* args)
       
       // Calcul du ratio maximum 
       // entre les volumes des elements voisins et celui de l'element courant
+#pragma omp parallel for if (nelts > __MIN_SIZE_MEAN__)
       for (E_Int et = 0; et < nelts; et++)
       {
-        etVol = vol[et];
-        maxratio = 0;
+        E_Float etVol = vol[et];
+        E_Float maxratio = 0;
         for (E_Int i = 0; i < nedges; i++)
         {
           E_Int* cni = cn->begin(i+1);
-          indi = cni[et]-1;
+          E_Int indi = cni[et]-1;
           vector<E_Int>& cVEi = cVE[indi]; E_Int sizei = cVEi.size();
           for (E_Int noeti = 0; noeti < sizei; noeti++)
           {
-            eti = cVEi[noeti];
+            E_Int eti = cVEi[noeti];
             maxratio = E_max(maxratio,E_abs(vol[eti]-etVol)/E_max(etVol,E_GEOM_CUTOFF));
           }
         }
@@ -655,7 +654,6 @@ PyObject* K_GENERATOR::getRegularityMap(PyObject* self, PyObject* args)
     }
     else if (strcmp(eltType, "QUAD") == 0)
     {
-      E_Float maxratio;
       // Calcul du volume des elements
       FldArrayF snx(nelts);
       FldArrayF sny(nelts);
@@ -676,18 +674,19 @@ PyObject* K_GENERATOR::getRegularityMap(PyObject* self, PyObject* args)
 
       // Calcul du ratio maximum 
       // entre les volumes des elements voisins et celui de l'element courant
+#pragma omp parallel for if (nelts > __MIN_SIZE_MEAN__)
       for (E_Int et = 0; et < nelts; et++)
       {
-        etVol = vol[et];
-        maxratio = 0;
+        E_Float etVol = vol[et];
+        E_Float maxratio = 0;
         for (E_Int i = 0; i < nedges; i++)
         {
           E_Int* cni = cn->begin(i+1);
-          indi = cni[et]-1;
+          E_Int indi = cni[et]-1;
           vector<E_Int>& cVEi = cVE[indi]; E_Int sizei = cVEi.size();
           for (E_Int noeti = 0; noeti < sizei; noeti++)
           {
-            eti = cVEi[noeti];
+            E_Int eti = cVEi[noeti];
             maxratio = E_max(maxratio,E_abs(vol[eti]-etVol)/E_max(etVol,E_GEOM_CUTOFF));
           }
         }
@@ -697,7 +696,6 @@ PyObject* K_GENERATOR::getRegularityMap(PyObject* self, PyObject* args)
     else if (strcmp(eltType, "TETRA") == 0)
     {
       E_Int nedges = 4;
-      E_Float maxratio;
       // Calcul du volume des elements
       FldArrayF snx(nelts, nedges);
       FldArrayF sny(nelts, nedges);
@@ -717,18 +715,19 @@ PyObject* K_GENERATOR::getRegularityMap(PyObject* self, PyObject* args)
       
       // Calcul du ratio maximum 
       // entre les volumes des elements voisins et celui de l'element courant
+#pragma omp parallel for if (nelts > __MIN_SIZE_MEAN__)
       for (E_Int et = 0; et < nelts; et++)
       {
-        etVol = vol[et];
-        maxratio = 0;
+        E_Float etVol = vol[et];
+        E_Float maxratio = 0;
         for (E_Int i = 0; i < nedges; i++)
         {
           E_Int* cni = cn->begin(i+1);
-          indi = cni[et]-1;
+          E_Int indi = cni[et]-1;
           vector<E_Int>& cVEi = cVE[indi]; E_Int sizei = cVEi.size();
           for (E_Int noeti = 0; noeti < sizei; noeti++)
           {
-            eti = cVEi[noeti];
+            E_Int eti = cVEi[noeti];
             maxratio = E_max(maxratio,E_abs(vol[eti]-etVol)/E_max(etVol,E_GEOM_CUTOFF));
           }
         }
@@ -745,7 +744,6 @@ PyObject* K_GENERATOR::getRegularityMap(PyObject* self, PyObject* args)
     else if (strcmp(eltType, "PENTA") == 0)
     {
       E_Int nedges = 5;
-      E_Float maxratio;
 
       // Calcul du volume des elements
       FldArrayF snx(nelts, nedges);
@@ -766,18 +764,19 @@ PyObject* K_GENERATOR::getRegularityMap(PyObject* self, PyObject* args)
 
       // Calcul du ratio maximum 
       // entre les volumes des elements voisins et celui de l'element courant
+#pragma omp parallel for if (nelts > __MIN_SIZE_MEAN__)
       for (E_Int et = 0; et < nelts; et++)
       {
-        etVol = vol[et];
-        maxratio = 0;
+        E_Float etVol = vol[et];
+        E_Float maxratio = 0;
         for (E_Int i = 0; i < nedges; i++)
         {
           E_Int* cni = cn->begin(i+1);
-          indi = cni[et]-1;
+          E_Int indi = cni[et]-1;
           vector<E_Int>& cVEi = cVE[indi]; E_Int sizei = cVEi.size();
           for (E_Int noeti = 0; noeti < sizei; noeti++)
           {
-            eti = cVEi[noeti];
+            E_Int eti = cVEi[noeti];
             maxratio = E_max(maxratio,E_abs(vol[eti]-etVol)/E_max(etVol,E_GEOM_CUTOFF));
           }
         }
@@ -787,7 +786,6 @@ PyObject* K_GENERATOR::getRegularityMap(PyObject* self, PyObject* args)
     else if (strcmp(eltType, "HEXA") == 0)
     {
       E_Int nedges = 6;
-      E_Float maxratio;
       // Calcul du volume des elements
       FldArrayF snx(nelts, nedges);
       FldArrayF sny(nelts, nedges);
@@ -807,18 +805,19 @@ PyObject* K_GENERATOR::getRegularityMap(PyObject* self, PyObject* args)
       
       // Calcul du ratio maximum 
       // entre les volumes des elements voisins et celui de l'element courant
+#pragma omp parallel for if (nelts > __MIN_SIZE_MEAN__)
       for (E_Int et = 0; et < nelts; et++)
       {
-        etVol = vol[et];
-        maxratio = 0;
+        E_Float etVol = vol[et];
+        E_Float maxratio = 0;
         for (E_Int i = 0; i < nedges; i++)
         {
           E_Int* cni = cn->begin(i+1);
-          indi = cni[et]-1;
+          E_Int indi = cni[et]-1;
           vector<E_Int>& cVEi = cVE[indi]; E_Int sizei = cVEi.size();
           for (E_Int noeti = 0; noeti < sizei; noeti++)
           {
-            eti = cVEi[noeti];
+            E_Int eti = cVEi[noeti];
             maxratio = E_max(maxratio,E_abs(vol[eti]-etVol)/E_max(etVol,E_GEOM_CUTOFF));
           }
         }
@@ -87,14 +87,14 @@ PyObject* K_GENERATOR::getTriQualityMap(PyObject* self, PyObject* args)
   }
 
   E_Int* cn1 = cn->begin(1); E_Int* cn2 = cn->begin(2); E_Int* cn3 = cn->begin(3);
-  E_Int ind1, ind2, ind3;
-  E_Float P0[3], P1[3], P2[3];
   //
+#pragma omp parallel for if (nelts > __MIN_SIZE_MEAN__)
   for (E_Int et = 0; et < nelts; et++)
   {
-    ind1 = cn1[et]-1;
-    ind2 = cn2[et]-1;
-    ind3 = cn3[et]-1;
+    E_Float P0[3], P1[3], P2[3];
+    E_Int ind1 = cn1[et]-1;
+    E_Int ind2 = cn2[et]-1;
+    E_Int ind3 = cn3[et]-1;
     
     P0[0] = x[ind1]; P0[1] = y[ind1]; P0[2] = z[ind1];
     P1[0] = x[ind2]; P1[1] = y[ind2]; P1[2] = z[ind2];
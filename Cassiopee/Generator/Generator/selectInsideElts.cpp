@@ -155,59 +155,72 @@ PyObject* K_GENERATOR::selectInsideElts(PyObject* self, PyObject* args)
   // liberation de la memoire
   for (E_Int i = 0; i < ncurves; i++) delete unstrF[i];
 
-  // Calcul des centres des elements
+  // Boites englobantes des courbes (xmin,ymin,xmax,ymax) : test rapide
+  FldArrayF bbox(ncurves, 4);
+  for (E_Int i = 0; i < ncurves; i++)
+  {
+    E_Int np = curves[i]->getSize();
+    E_Float* xt = curves[i]->begin(1); E_Float* yt = curves[i]->begin(2);
+    E_Float xmin = K_CONST::E_MAX_FLOAT, ymin = K_CONST::E_MAX_FLOAT;
+    E_Float xmax = -K_CONST::E_MAX_FLOAT, ymax = -K_CONST::E_MAX_FLOAT;
+    for (E_Int n = 0; n < np; n++)
+    {
+      xmin = K_FUNC::E_min(xmin, xt[n]); xmax = K_FUNC::E_max(xmax, xt[n]);
+      ymin = K_FUNC::E_min(ymin, yt[n]); ymax = K_FUNC::E_max(ymax, yt[n]);
+    }
+    bbox(i,1) = xmin; bbox(i,2) = ymin; bbox(i,3) = xmax; bbox(i,4) = ymax;
+  }
+
+  // Test des centres des elements pour chaque courbe
   FldArrayF& fp = *f;
   FldArrayI& cnp = *cn;
-  FldArrayF centers(cnp.getSize(), 3);
+  E_Int nelts = cnp.getSize();
   E_Int sizeElt = cnp.getNfld();
   E_Float iElt = 1./sizeElt;
-  E_Float xc, yc, zc;
-  E_Int ind;
-  for (E_Int i = 0; i < cnp.getSize(); i++)
+  FldArrayI inside(nelts);
+  E_Int* insidep = inside.begin();
+
+#pragma omp parallel
   {
-    xc = 0.; yc = 0.; zc = 0.;
-    for (E_Int j = 1; j <= sizeElt; j++)
+    E_Float p[3], BB[4];
+    E_Int ind, test;
+#pragma omp for
+    for (E_Int e = 0; e < nelts; e++)
     {
-      ind = cnp(i, j)-1;
-      xc = xc + fp(ind,posx);
-      yc = yc + fp(ind,posy);
-      zc = zc + fp(ind,posz);
+      p[0] = 0.; p[1] = 0.; p[2] = 0.;
+      for (E_Int j = 1; j <= sizeElt; j++)
+      {
+        ind = cnp(e, j)-1;
+        p[0] += fp(ind,posx); p[1] += fp(ind,posy); p[2] += fp(ind,posz);
+      }
+      p[0] *= iElt; p[1] *= iElt; p[2] *= iElt;
+      test = 0;
+      for (E_Int i = 0; i < ncurves; i++)
+      {
+        BB[0] = bbox(i,1); BB[1] = bbox(i,2); BB[2] = bbox(i,3); BB[3] = bbox(i,4);
+        test += K_COMPGEOM::pointInPolygon2D(curves[i]->begin(1), curves[i]->begin(2), curves[i]->begin(3),
+                                             *cnt[i], p, NULL, BB);
+      }
+      insidep[e] = test%2; // dedans si nombre impair
     }
-    xc = xc*iElt; yc = yc*iElt; zc = zc*iElt;
-    centers(i, 1) = xc; centers(i, 2) = yc; centers(i, 3) = zc;
   }
 
-  // Test des centres des elements pour chaque courbe
-  FldArrayI* connect = new FldArrayI(cn->getSize(), cn->getNfld());
+  // Compactage des elements interieurs
+  FldArrayI* connect = new FldArrayI(nelts, sizeElt);
   FldArrayI& connectp = *connect;
-  
-  E_Int test, ne;
-  E_Float p[3];
-  
-  ne = 0;
-  for (E_Int ind = 0; ind < cnp.getSize(); ind++)
+  E_Int ne = 0;
+  for (E_Int e = 0; e < nelts; e++)
   {
-    p[0] = centers(ind,1); p[1] = centers(ind,2); p[2] = centers(ind,3);
-    test = 0;
-    for (E_Int i = 0; i < ncurves; i++)
-    {
-      test = test + K_COMPGEOM::pointInPolygon2D(curves[i]->begin(1), curves[i]->begin(2), curves[i]->begin(3),
-                                                 *cnt[i],
-                                                 p,
-                                                 NULL, NULL);
-    }
-    if (test - (test/2)*2. != 0) // dedans
-    {
-      for (E_Int i = 1; i <= sizeElt; i++)
-        connectp(ne,i) = cnp(ind,i);
-      ne++;
-    }
+    if (insidep[e] == 0) continue;
+    for (E_Int i = 1; i <= sizeElt; i++) connectp(ne,i) = cnp(e,i);
+    ne++;
   }
   connectp.reAllocMat(ne, sizeElt);
+  for (E_Int i = 0; i < ncurves; i++) { delete curves[i]; delete cnt[i]; }
 
   // sortie
   PyObject* tpl;
   tpl = K_ARRAY::buildArray(*f, varString, connectp, -1, eltType);
-  delete f; delete &connectp;
+  delete f; delete cn; delete &connectp;
   return tpl;
 }
@@ -16,6 +16,7 @@ cpp_srcs = ["Generator/cart.cpp",
             "Generator/getOrthogonalityMap.cpp",
             "Generator/getRegularityMap.cpp",
             "Generator/getAngleRegularityMap.cpp",
+            "Generator/getMeshQuality.cpp",
             "Generator/getCircumCircleMap.cpp",
             "Generator/getInCircleMap.cpp",
             "Generator/barycenter.cpp",
@@ -207,5 +208,4 @@ for_srcs = ['Generator/Fortran/MeshqualF.for',
             'Generator/Fortran/GelgF.for',
             'Generator/Fortran/StretchF.for',
             'Generator/Fortran/MetsF.for',
-            'Generator/Fortran/CoeffttmF.for',
-            'Generator/Fortran/Sor9ptF.for']
+            'Generator/Fortran/CoeffttmF.for']
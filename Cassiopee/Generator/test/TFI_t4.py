@@ -0,0 +1,36 @@
+# - TFI par lots (array) -
+import Generator as G
+import Geom as D
+import Transform as T
+import KCore.test as test
+
+# blocs 2D
+P0 = (0,0,0); P1 = (5,0,0); P2 = (0,7,0); P3 = (5,7,0)
+r1 = D.line(P0, P1, 20); r2 = D.line(P2, P3, 20)
+r3 = D.line(P0, P2, 10); r4 = D.line(P1, P3, 10)
+b1 = D.circle((0,0,0), 1., 0., 90., 15)
+b2 = D.circle((0,0,0), 2., 0., 90., 15)
+b3 = D.line((1,0,0), (2,0,0), 8); b4 = D.line((0,1,0), (0,2,0), 8)
+
+# bloc 3D
+nx = 11; ny = 9; nz = 7
+hx = 1./(nx-1); hy = 1./(ny-1); hz = 1./(nz-1)
+fzmin = G.cart((0,0,0), (hx,hy,1.), (nx,ny,1))
+fzmax = T.translate(fzmin, (0.,0.,1.))
+fxmin = G.cart((0,0,0), (1,hy,hz), (1,ny,nz))
+fxmin = T.reorder(fxmin, (3,1,2))
+fxmax = T.translate(fxmin, (1.,0.,0.))
+fymin = G.cart((0,0,0), (hx,1.,hz), (nx,1,nz))
+fymin = T.reorder(fymin, (1,3,2))
+fymax = T.translate(fymin, (0.,1.,0.))
+
+# bloc TRI
+l1 = D.line((0,0,0),(0,1,0), 15)
+l2 = D.line((0,0,0),(1,0,0), 15)
+l3 = D.line((1,0,0),(0,1,0), 15)
+
+sets = [[r1,r2,r3,r4], [b1,b2,b3,b4],
+        [fxmin,fxmax,fymin,fymax,fzmin,fzmax], [l1,l2,l3]]
+m = G.TFI(sets)
+test.testA(m, 1)
+
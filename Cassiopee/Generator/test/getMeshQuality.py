@@ -0,0 +1,8 @@
+# - getMeshQuality (array) -
+import Generator as G
+
+a = G.cylinder((0.,0.,0.), 0.5, 1., 360., 0., 10., (50,50,10))
+b = G.cart((0,0,0), (1,1,1), (10,10,10))
+stats = G.getMeshQuality([a,b], crits=[0.,15.,0.1,15.],
+                         edges=[[0.,0.1,1.],[0.,5.,15.,90.],[0.,0.1,1.],[0.,5.,15.,180.]])
+print(stats['regularity']['max'], stats['regularity']['worst'], stats['regularity']['hist'])
@@ -0,0 +1,29 @@
+# - getMeshQuality (array) -
+import Generator as G
+import KCore.test as test
+
+# Test 3D structure
+a = G.cylinder((0.,0.,0.), 0.5, 1., 360., 0., 10., (50,50,10))
+stats = G.getMeshQuality(a, fields=True)
+test.testA(stats['fields'], 1)
+
+# Test multi-zones 3D et 2D, statistiques et histogrammes
+b = G.cart((0,0,0), (1,1,1), (10,10,10))
+c = G.cart((0,0,0), (0.1,0.2,1), (20,10,1))
+stats = G.getMeshQuality([a,b,c], edges=[[-1.,0.,1.e-3,1.],[0.,5.,15.,90.],[0.,0.1,1.],[0.,5.,15.,180.]])
+res = []
+for name in ['vol', 'orthogonality', 'regularity', 'regularityAngle']:
+    s = stats[name]
+    res += [s['min'], s['max'], s['mean'], s['crit'], s['worst'][2]]
+    res += list(s['hist'])
+test.testO(res, 2)
+
+# checkMesh (passe unique sur grilles structurees)
+infos = G.checkMesh([a,b,c])
+test.testO(infos, 3)
+
+# Les arrays non structures sont rejetes
+d = G.cartHexa((0,0,0), (1,1,1), (5,5,5))
+try: G.getMeshQuality([b,d]); ok = 0
+except TypeError: ok = 1
+test.testO(ok, 4)
@@ -166,6 +166,62 @@ def P1ConservativeInterpolation(aR, aD, fldD):
 def P1ConservativeChimeraCoeffs(aR, cellnR, aD):
     return intersector.P1ConservativeChimeraCoeffs(aR, cellnR, aD)
 
+#==============================================================================
+# createP1ConservativeTransfer : computes the receiver/donor supermesh once
+# IN: aR: receiver mesh
+# IN: aD: donor mesh
+# IN: rtol: relative tolerance for the candidates search
+# OUT: returns a transfer hook
+#==============================================================================
+def createP1ConservativeTransfer(aR, aD, rtol=1.e-12):
+    """Computes the supermesh between aR and aD and stores its weights for later transfers.
+    Usage: createP1ConservativeTransfer(aR, aD, rtol)"""
+    return intersector.createP1ConservativeTransfer(aR, aD, rtol)
+
+#==============================================================================
+# updateP1ConservativeTransfer : updates a transfer after a motion
+# IN: hook: transfer hook
+# IN: aR: receiver mesh with new coordinates (None if it did not move)
+# IN: aD: donor mesh with new coordinates (None if it did not move)
+# IN: tol: nodes moving less than tol are considered as fixed
+# OUT: returns the number of receiver cells recomputed
+#==============================================================================
+def updateP1ConservativeTransfer(hook, aR=None, aD=None, tol=0.):
+    """Recomputes the weights of the receiver cells whose donor candidates changed or moved.
+    Usage: updateP1ConservativeTransfer(hook, aR, aD, tol)"""
+    return intersector.updateP1ConservativeTransfer(hook, aR, aD, tol)
+
+#==============================================================================
+# P1ConservativeTransfer : transfers donor center fields with the stored weights
+# IN: aR: receiver mesh (the one of the hook)
+# IN: aD: donor mesh (the one of the hook)
+# IN: fldD: donor center fields
+# IN: hook: transfer hook
+# OUT: returns the receiver center fields
+#==============================================================================
+def P1ConservativeTransfer(aR, aD, fldD, hook):
+    """Does conservative interpolations of fldD from aD to aR with a transfer hook.
+    Usage: P1ConservativeTransfer(aR, aD, fldD, hook)"""
+    return intersector.P1ConservativeTransfer(hook, fldD)
+
+#==============================================================================
+# getP1ConservativeTransferCoeffs
+# IN: hook: transfer hook
+# OUT: (delimiter, donor indices, coeffs) in CSR form
+#==============================================================================
+def getP1ConservativeTransferCoeffs(hook):
+    """Returns the weights of a transfer hook.
+    Usage: getP1ConservativeTransferCoeffs(hook)"""
+    return intersector.getP1ConservativeTransferCoeffs(hook)
+
+#==============================================================================
+# deleteP1ConservativeTransfer : releases a transfer hook
+#==============================================================================
+def deleteP1ConservativeTransfer(hook):
+    """Releases a transfer hook.
+    Usage: deleteP1ConservativeTransfer(hook)"""
+    return intersector.deleteP1ConservativeTransfer(hook)
+
 #==============================================================================
 # superMesh
 # IN: surfz: 3D NGON surface mesh to clip
@@ -368,6 +424,20 @@ def agglomerateCellsWithSpecifiedFaces(a, pgs):
     Usage: agglomerateCellsWithSpecifiedFaces(a)"""
     return intersector.agglomerateCellsWithSpecifiedFaces(a, pgs)
 
+#==============================================================================
+# agglomerateMultiLevel : Builds a hierarchy of coarse agglomerated meshes
+# IN: a: 3D NGON mesh
+# IN: nlevels : number of coarse levels
+# IN: npasses : number of pairwise matching passes per level
+# OUT: returns for each level [mesh, parent, R, P] where parent gives the
+# coarse cell of each cell of the previous level and R (restriction) and
+# P (prolongation) are CSR matrices given as [indptr, indices, data]
+#==============================================================================
+def agglomerateMultiLevel(a, nlevels=3, npasses=3):
+    """Builds a hierarchy of coarse agglomerated meshes.
+    Usage: agglomerateMultiLevel(a, nlevels, npasses)"""
+    return intersector.agglomerateMultiLevel(a, nlevels, npasses)
+
 #==============================================================================
 # agglomerateNonStarCells : Agglomerates non-centroid-star-shaped cells
 # IN: a: 3D NGON mesh
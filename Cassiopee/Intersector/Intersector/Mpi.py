@@ -349,3 +349,247 @@ def _closeCells(t, procDict, zidDict, com = MPI.COMM_WORLD):
       C.setFields([m], z, 'nodes')
 
     return t
+
+#==============================================================================
+# booleanUnionMZ : Distributed union of two multi-zone volume meshes
+# The overlap region of the operands is split into one slab per rank (balanced
+# on the cells count), each rank computes the union on its slab extended with
+# a ghost band and keeps the cells coming from its own slab. The parts are
+# then stitched with BCMatch joins by reconciling their boundary faces.
+# IN: t1, t2 : 3D NGON meshes distributed over the ranks
+# IN: xtol, jtol, agg_mode, improve_qual, simplify_pgs, hard_mode : see Intersector.PyTree.booleanUnionMZ
+# IN: ghost : width of the ghost band in largest overlap cell size unit
+# OUT: returns the list of zones held by the rank
+#==============================================================================
+def booleanUnionMZ(t1, t2, xtol=0., jtol=0., agg_mode=1, improve_qual=False, simplify_pgs=True, hard_mode=0, ghost=2., com=MPI.COMM_WORLD):
+    """Computes the union between two distributed volume meshes.
+    Usage: booleanUnionMZ(t1, t2, xtol, jtol, agg_mode, improve_qual, simplify_pgs, hard_mode, ghost, com)"""
+    import Transform.PyTree as T
+    rank = com.Get_rank(); size = com.Get_size()
+
+    ops = [Internal.getZones(Internal.copyRef(t1)), Internal.getZones(Internal.copyRef(t2))]
+
+    # zone names made unique over the operands (as in XOR.booleanUnionMZ)
+    for iop, zs in enumerate(ops):
+      for z in zs:
+        for j in Internal.getNodesFromType(z, 'GridConnectivity_t'):
+          Internal.setValue(j, 'dom%d_%s'%(iop+1, Internal.getValue(j)))
+        z[0] = 'dom%d_%s'%(iop+1, z[0])
+
+    meshes = [[C.getFields(Internal.__GridCoordinates__, z)[0] for z in zs] for zs in ops]
+
+    # 1. overlap box of the global operands boxes
+    gbox = []
+    for ms in meshes:
+      loc = numpy.array([1.e300]*3 + [1.e300]*3, numpy.float64) # min, -max
+      for m in ms:
+        xyz = m[1][0:3,:]
+        loc[0:3] = numpy.minimum(loc[0:3], xyz.min(axis=1))
+        loc[3:6] = numpy.minimum(loc[3:6], -xyz.max(axis=1))
+      glob = numpy.empty(6, numpy.float64)
+      com.Allreduce(loc, glob, op=MPI.MIN)
+      gbox.append((glob[0:3], -glob[3:6]))
+
+    omin = numpy.maximum(gbox[0][0], gbox[1][0]) - xtol
+    omax = numpy.minimum(gbox[0][1], gbox[1][1]) + xtol
+    if (omax < omin).any(): return ops[0] + ops[1] # no overlap
+
+    # 2. active cells : cells whose centroid falls in the overlap box extended by the largest cell size in it
+    cents = [[intersector.centroids(m)[1][0:3,:] for m in ms] for ms in meshes]
+    hs = [[numpy.cbrt(numpy.abs(intersector.volumes(m, 1, False)[1].ravel())) for m in ms] for ms in meshes]
+    hloc = numpy.zeros(1, numpy.float64)
+    for iop in range(2):
+      for c, h in zip(cents[iop], hs[iop]):
+        inside = ((c >= omin[:,None] - h[None,:]) & (c <= omax[:,None] + h[None,:])).all(axis=0)
+        if inside.any(): hloc[0] = max(hloc[0], h[inside].max())
+    hmax = numpy.empty(1, numpy.float64)
+    com.Allreduce(hloc, hmax, op=MPI.MAX)
+    hmax = hmax[0]; gw = ghost*hmax
+    amin = omin - hmax; amax = omax + hmax
+
+    actives = [[((c >= amin[:,None]) & (c <= amax[:,None])).all(axis=0) for c in cs] for cs in cents]
+
+    # 3. slabs along the longest axis of the active box, balanced on the active cells
+    axis = int(numpy.argmax(amax - amin))
+    nbins = 64*size
+    hloc = numpy.zeros(nbins, numpy.float64)
+    for iop in range(2):
+      for c, act in zip(cents[iop], actives[iop]):
+        hloc += numpy.histogram(c[axis, act], bins=nbins, range=(amin[axis], amax[axis]))[0]
+    hist = numpy.empty(nbins, numpy.float64)
+    com.Allreduce(hloc, hist, op=MPI.SUM)
+    cdf = numpy.cumsum(hist); edges = numpy.linspace(amin[axis], amax[axis], nbins+1)
+    cuts = numpy.empty(size+1, numpy.float64)
+    cuts[0] = amin[axis]; cuts[size] = amax[axis]
+    for k in range(1, size):
+      cuts[k] = edges[min(nbins, numpy.searchsorted(cdf, k*cdf[-1]/size)+1)]
+
+    # 4. send the active cells to their slab owner and to the slabs whose ghost band contains them
+    sends = [[] for r in range(size)]
+    locz = [] # zones remaining on this rank
+    bcs = {}
+    created = set() # zones built here : no join inherited from the input
+    for iop in range(2):
+      for iz, z in enumerate(ops[iop]):
+        act = actives[iop][iz]
+        if not act.any(): locz.append(z); continue
+
+        bcs[z[0]] = C.getBCs(z)
+        zc = Internal.copyRef(z)
+        Internal._rmNodesByType(zc, 'ZoneBC_t')
+        Internal._rmNodesByType(zc, 'ZoneGridConnectivity_t')
+
+        x = cents[iop][iz][axis]
+        owner = numpy.clip(numpy.searchsorted(cuts, x, side='right')-1, 0, size-1)
+        for r in range(size):
+          ids = numpy.nonzero(act & (x >= cuts[r]-gw) & (x <= cuts[r+1]+gw))[0]
+          if ids.size == 0: continue
+          piece = T.subzone(zc, ids, type='elements')
+          C._initVars(piece, 'centers:__own__', 0.)
+          own = Internal.getNodeFromName2(piece, '__own__')
+          own[1] = (owner[ids] == r).astype(numpy.float64)
+          piece[0] = '%s_r%d'%(z[0], r)
+          sends[r].append((iop, piece, bcs[z[0]]))
+
+        nids = numpy.nonzero(~act)[0]
+        if nids.size > 0:
+          zu = T.subzone(zc, nids, type='elements'); zu[0] = '%s_u'%z[0]
+          created.add(zu[0])
+          if bcs[z[0]][0] != []: C._recoverBCs(zu, bcs[z[0]])
+          locz.append(zu)
+
+    recvs = com.alltoall(sends)
+
+    # 5. union on the slab and extraction of the owned cells
+    # each piece carries its index in pieces[iop] (booleanUnionMZ renames the zones)
+    pieces = [[], []]; pbcs = [[], []]; pnames = [[], []]
+    for l in recvs:
+      for (iop, piece, bc) in l:
+        n = Internal.newIntegralData(name='__pid__', parent=piece); n[1] = len(pieces[iop])
+        pieces[iop].append(piece); pbcs[iop].append(bc); pnames[iop].append(piece[0])
+
+    if pieces[0] != [] and pieces[1] != []:
+      res = XOR.booleanUnionMZ(pieces[0], pieces[1], xtol, jtol, agg_mode, improve_qual, simplify_pgs, hard_mode)
+      res = Internal.getZones(res)
+    else: res = pieces[0] + pieces[1]
+
+    for z in res:
+      iop = 0 if z[0].startswith('dom1_') else 1
+      pid = CD.getProperty(z, '__pid__')
+      own = Internal.getNodeFromName2(z, '__own__')
+      ids = numpy.nonzero(own[1].ravel() > 0.5)[0]
+      if ids.size == 0: continue
+      Internal._rmNodesByType(z, 'ZoneBC_t')
+      Internal._rmNodesByType(z, 'ZoneGridConnectivity_t')
+      zo = T.subzone(z, ids, type='elements'); zo[0] = pnames[iop][pid]
+      created.add(zo[0])
+      Internal._rmNodesByName(zo, '__own__')
+      Internal._rmNodesByName(zo, '__pid__')
+      if pbcs[iop][pid][0] != []: C._recoverBCs(zo, pbcs[iop][pid])
+      locz.append(zo)
+
+    # 6. stitching : the exterior faces are matched on their centroid (tolerance tol) over the ranks.
+    # A face is sent to the slab holding its centroid, and also to the neighbour slab when it is
+    # within tol of the cut ; a pair is kept by the lowest home slab of its two faces.
+    # Untouched zones keep their joins between themselves.
+    modified = set()
+    for znames in com.allgather(list(bcs.keys())): modified.update(znames)
+    znames = com.allgather([z[0] for z in locz])
+
+    tol = max(jtol, 1.e-10*numpy.linalg.norm(amax-amin))
+    fc = []; fz = []; ff = []
+    for iz, z in enumerate(locz):
+      keep = []
+      if z[0] in created: Internal._rmNodesByType(z, 'ZoneGridConnectivity_t')
+      else:
+        for j in Internal.getNodesFromType(z, 'GridConnectivity_t'):
+          if Internal.getValue(j) in modified:
+            (p, c) = Internal.getParentOfNode(z, j); del p[2][c]
+          else:
+            pl = Internal.getNodeFromName1(j, 'PointList')
+            if pl is not None: keep.append(pl[1].ravel())
+
+      m = C.getFields(Internal.__GridCoordinates__, z, api=3)[0]
+      xyz = numpy.vstack(m[1][0:3])
+      ngon = m[2][0]; nface = m[2][1]; indPG = m[2][2]
+      nfaces = indPG.size-1
+      used = numpy.bincount(numpy.abs(nface)-1, minlength=nfaces)
+      ext = numpy.nonzero(used == 1)[0]
+      if keep != []: ext = ext[~numpy.isin(ext+1, numpy.concatenate(keep))]
+      if ext.size == 0: continue
+      nn = numpy.diff(indPG)
+      cent = numpy.add.reduceat(xyz[:, ngon-1], indPG[:-1], axis=1)
+      fc.append(cent[:, ext]/nn[ext]); fz.append(numpy.full(ext.size, iz, numpy.int64)); ff.append(ext+1)
+
+    fsends = [None]*size
+    if fc != []:
+      fc = numpy.hstack(fc); fz = numpy.concatenate(fz); ff = numpy.concatenate(ff)
+      x = fc[axis]
+      home = numpy.clip(numpy.searchsorted(cuts, x, side='right')-1, 0, size-1)
+      for r in range(size):
+        sel = (home == r) | ((home == r+1) & (x < cuts[r+1]+tol)) | ((home == r-1) & (x > cuts[r]-tol))
+        if sel.any(): fsends[r] = (fc[:,sel], home[sel], fz[sel], ff[sel])
+
+    frecvs = com.alltoall(fsends)
+
+    src = [(rk, d) for rk, d in enumerate(frecvs) if d is not None]
+    pairs = numpy.empty((0, 2), numpy.int64)
+    if src != []:
+      fc = numpy.hstack([d[0] for (rk, d) in src])
+      home = numpy.concatenate([d[1] for (rk, d) in src])
+      fr = numpy.concatenate([numpy.full(d[2].size, rk, numpy.int64) for (rk, d) in src])
+      fz = numpy.concatenate([d[2] for (rk, d) in src])
+      ff = numpy.concatenate([d[3] for (rk, d) in src])
+      pairs = matchPoints__(fc, tol)
+      i = pairs[:,0]; j = pairs[:,1]
+      ok = ((fr[i] != fr[j]) | (fz[i] != fz[j])) & (numpy.minimum(home[i], home[j]) == rank)
+      pairs = pairs[ok]
+
+    msends = [None]*size
+    if pairs.size > 0:
+      # chaque rang recoit (zone, face, rang donneur, zone donneuse, face donneuse) pour ses zones
+      a = numpy.vstack([fr[pairs[:,0]], fz[pairs[:,0]], ff[pairs[:,0]], fr[pairs[:,1]], fz[pairs[:,1]], ff[pairs[:,1]]])
+      a = numpy.hstack([a, a[[3,4,5,0,1,2]]])
+      for r in range(size):
+        sel = (a[0] == r)
+        if sel.any(): msends[r] = a[1:, sel]
+
+    mrecvs = [d for d in com.alltoall(msends) if d is not None]
+    if mrecvs != []:
+      a = numpy.hstack(mrecvs) # zone, face, rang donneur, zone donneuse, face donneuse
+      a = a[:, numpy.lexsort((a[1], a[3], a[2], a[0]))]
+      cut = numpy.nonzero((numpy.diff(a[[0,2,3]], axis=1) != 0).any(axis=0))[0]+1
+      for g in numpy.split(numpy.arange(a.shape[1]), cut):
+        z = locz[a[0,g[0]]]; zd = znames[a[2,g[0]]][a[3,g[0]]]
+        C._addBC2Zone(z, 'match_%s'%zd, 'BCMatch', faceList=a[1,g].astype(Internal.E_NpyInt), zoneDonor=zd, faceListDonor=a[4,g].astype(Internal.E_NpyInt))
+
+    return locz
+
+#==============================================================================
+# matchPoints__ : pairs of points closer than tol (vectorized)
+# Two points closer than tol fall in the same cell of at least one of the 8
+# grids of step 4*tol shifted by 0 or half a step along each axis. A pair is
+# kept only when it is the unique candidate of both points.
+# IN: c : (3,n) coordinates
+# OUT: (npairs,2) indices
+#==============================================================================
+def matchPoints__(c, tol):
+    step = 4.*tol
+    n = c.shape[1]
+    if n < 2: return numpy.empty((0, 2), numpy.int64)
+    cands = []
+    for s in range(8):
+      sh = numpy.array([(s>>k)&1 for k in range(3)], numpy.float64)*0.5
+      q = numpy.floor(c/step + sh[:,None]).astype(numpy.int64)
+      o = numpy.lexsort(q[::-1])
+      same = (q[:,o[1:]] == q[:,o[:-1]]).all(axis=0)
+      # cellules contenant exactement deux points
+      prev = numpy.concatenate(([False], same[:-1])); nxt = numpy.concatenate((same[1:], [False]))
+      k = numpy.nonzero(same & ~prev & ~nxt)[0]
+      cands.append(numpy.sort(numpy.vstack([o[k], o[k+1]]), axis=0))
+    cands = numpy.unique(numpy.hstack(cands), axis=1)
+    d = numpy.linalg.norm(c[:,cands[0]] - c[:,cands[1]], axis=0)
+    cands = cands[:, d < tol]
+    cnt = numpy.bincount(cands.ravel(), minlength=n)
+    cands = cands[:, (cnt[cands[0]] == 1) & (cnt[cands[1]] == 1)]
+    return cands.T
@@ -21,6 +21,7 @@
 #include "Nuga/include/conservative_chimera.h"
 #include <memory>
 #include "Nuga/include/mesh_t.hxx"
+#include "Nuga/include/supermesh.hxx"
 
 
 using namespace std;
@@ -253,3 +254,254 @@ PyObject* K_INTERSECTOR::P1ConservativeChimeraCoeffs(PyObject* self, PyObject* a
  
   return l;
 }
+
+//============================================================================
+/* Persistent conservative transfer : supermesh weights stored in CSR form */
+//============================================================================
+using transfer_t = NUGA::conservative_transfer<ph_mesh_t>;
+
+struct p1_transfer_t
+{
+  p1_transfer_t(const ph_mesh_t& mR, const ph_mesh_t& mD, const K_FLD::IntArray& cR, E_Float rtol) :tr(mR, mD, rtol), cntR(cR) {}
+  transfer_t      tr;
+  K_FLD::IntArray cntR; // to build the output arrays
+};
+
+// The capsule context is set once the transfer is released : a released hook
+// is rejected instead of being used (or freed again by the destructor)
+#define P1TRANSFER_RELEASED ((void*)1)
+
+static p1_transfer_t* unpackP1Transfer(PyObject* hook)
+{
+  void* ptr{ nullptr };
+#if (PY_MAJOR_VERSION == 2 && PY_MINOR_VERSION < 7) || (PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION < 1)
+  ptr = PyCObject_AsVoidPtr(hook);
+#else
+  if (!PyCapsule_IsValid(hook, NULL))
+  {
+    PyErr_SetString(PyExc_TypeError, "P1ConservativeTransfer: invalid hook.");
+    return nullptr;
+  }
+  if (PyCapsule_GetContext(hook) == P1TRANSFER_RELEASED)
+  {
+    PyErr_SetString(PyExc_ValueError, "P1ConservativeTransfer: the hook has been deleted.");
+    return nullptr;
+  }
+  ptr = PyCapsule_GetPointer(hook, NULL);
+#endif
+  if (ptr == nullptr)
+    PyErr_SetString(PyExc_TypeError, "P1ConservativeTransfer: invalid hook.");
+  return (p1_transfer_t*)ptr;
+}
+
+#if !((PY_MAJOR_VERSION == 2 && PY_MINOR_VERSION < 7) || (PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION < 1))
+static void p1TransferDestructor(PyObject* hook)
+{
+  if (PyCapsule_GetContext(hook) == P1TRANSFER_RELEASED) return;
+  delete (p1_transfer_t*)PyCapsule_GetPointer(hook, NULL);
+}
+#endif
+
+static E_Int getNGONCoords(PyObject* mesh, K_FLD::FloatArray& crd, K_FLD::IntArray& cnt, const char* fname)
+{
+  char* varString, *eltType;
+  E_Int ni, nj, nk;
+  E_Int res = K_ARRAY::getFromArray(mesh, varString, crd, ni, nj, nk, cnt, eltType);
+
+  if (res != 2 || strcmp(eltType, "NGON") != 0)
+  {
+    PyErr_Format(PyExc_ValueError, "%s: the zones must be NGON.", fname);
+    return 1;
+  }
+  return 0;
+}
+
+//============================================================================
+/* Computes the receiver/donor supermesh and returns it as a hook */
+//============================================================================
+PyObject* K_INTERSECTOR::createP1ConservativeTransfer(PyObject* self, PyObject* args)
+{
+  PyObject *meshR, *meshD;
+  E_Float RTOL{1.e-12};
+
+  if (!PYPARSETUPLE_(args, OO_ R_, &meshR, &meshD, &RTOL)) return NULL;
+
+  K_FLD::FloatArray crdR, crdD;
+  K_FLD::IntArray cntR, cntD;
+  if (getNGONCoords(meshR, crdR, cntR, "createP1ConservativeTransfer")) return NULL;
+  if (getNGONCoords(meshD, crdD, cntD, "createP1ConservativeTransfer")) return NULL;
+
+  ph_mesh_t mR(crdR, cntR), mD(crdD, cntD);
+
+  p1_transfer_t* p1tr = new p1_transfer_t(mR, mD, cntR, RTOL);
+  p1tr->tr.build(true/*do_omp*/);
+
+  PyObject* hook;
+#if (PY_MAJOR_VERSION == 2 && PY_MINOR_VERSION < 7) || (PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION < 1)
+  hook = PyCObject_FromVoidPtr(p1tr, NULL);
+#else
+  hook = PyCapsule_New(p1tr, NULL, p1TransferDestructor);
+#endif
+  return hook;
+}
+
+//============================================================================
+/* Updates the supermesh after a motion (same topologies) : returns the
+   number of receiver cells recomputed */
+//============================================================================
+PyObject* K_INTERSECTOR::updateP1ConservativeTransfer(PyObject* self, PyObject* args)
+{
+  PyObject *hook, *meshR, *meshD;
+  E_Float tol{0.};
+
+  if (!PYPARSETUPLE_(args, OOO_ R_, &hook, &meshR, &meshD, &tol)) return NULL;
+
+  p1_transfer_t* p1tr = unpackP1Transfer(hook);
+  if (p1tr == nullptr) return NULL;
+
+  K_FLD::FloatArray crdR, crdD;
+  K_FLD::IntArray cntR, cntD;
+  K_FLD::FloatArray *pR(nullptr), *pD(nullptr);
+
+  if (meshR != Py_None)
+  {
+    if (getNGONCoords(meshR, crdR, cntR, "updateP1ConservativeTransfer")) return NULL;
+    if (crdR.cols() != p1tr->tr.mrec.crd.cols())
+    {
+      PyErr_SetString(PyExc_ValueError, "updateP1ConservativeTransfer: the receiver topology has changed.");
+      return NULL;
+    }
+    pR = &crdR;
+  }
+  if (meshD != Py_None)
+  {
+    if (getNGONCoords(meshD, crdD, cntD, "updateP1ConservativeTransfer")) return NULL;
+    if (crdD.cols() != p1tr->tr.mdon.crd.cols())
+    {
+      PyErr_SetString(PyExc_ValueError, "updateP1ConservativeTransfer: the donor topology has changed.");
+      return NULL;
+    }
+    pD = &crdD;
+  }
+
+  E_Int nupdated = p1tr->tr.update(pR, pD, tol, true/*do_omp*/);
+
+  return Py_BuildValue(I_, nupdated);
+}
+
+//============================================================================
+/* Transfers donor center fields with the stored weights. A field F is
+   transferred at order 2 when gradxF, gradyF and gradzF are present */
+//============================================================================
+PyObject* K_INTERSECTOR::P1ConservativeTransfer(PyObject* self, PyObject* args)
+{
+  PyObject *hook, *fldD;
+
+  if (!PYPARSETUPLE_(args, OO_, &hook, &fldD)) return NULL;
+
+  p1_transfer_t* p1tr = unpackP1Transfer(hook);
+  if (p1tr == nullptr) return NULL;
+
+  K_FLD::FldArrayF* fldsC(nullptr);
+  K_FLD::FldArrayI* cn(nullptr);
+  char* fvarStringsC, *feltType;
+  E_Int ni, nj, nk;
+  E_Int res = K_ARRAY::getFromArray(fldD, fvarStringsC, fldsC, ni, nj, nk, cn, feltType);
+
+  std::unique_ptr<K_FLD::FldArrayF> afldC(fldsC); // to avoid to call explicit delete at several places in the code.
+  std::unique_ptr<K_FLD::FldArrayI> acn(cn); // to avoid to call explicit delete at several places in the code.
+
+  if (res != 2)
+  {
+    PyErr_SetString(PyExc_TypeError, "P1ConservativeTransfer: invalid donor fields.");
+    return NULL;
+  }
+
+  if (fldsC->getSize() != p1tr->tr.mdon.ncells())
+  {
+    PyErr_SetString(PyExc_ValueError, "P1ConservativeTransfer: donor fields must be at centers.");
+    return NULL;
+  }
+
+  std::vector<char*> vars;
+  K_ARRAY::extractVars(fvarStringsC, vars);
+
+  E_Int nfields = fldsC->getNfld();
+  std::vector<field> don_fields(nfields);
+
+  for (E_Int j = 0; j < nfields; ++j)
+  {
+    don_fields[j].f = fldsC->begin(j+1);
+
+    char gname[3][K_ARRAY::VARSTRINGLENGTH];
+    snprintf(gname[0], K_ARRAY::VARSTRINGLENGTH, "gradx%s", vars[j]);
+    snprintf(gname[1], K_ARRAY::VARSTRINGLENGTH, "grady%s", vars[j]);
+    snprintf(gname[2], K_ARRAY::VARSTRINGLENGTH, "gradz%s", vars[j]);
+    E_Int posg[3];
+    for (E_Int k = 0; k < 3; ++k) posg[k] = K_ARRAY::isNamePresent(gname[k], fvarStringsC);
+    if (posg[0] == -1 || posg[1] == -1 || posg[2] == -1) continue;
+    for (E_Int k = 0; k < 3; ++k) don_fields[j].gradf[k] = fldsC->begin(posg[k]+1);
+  }
+  for (size_t v = 0; v < vars.size(); ++v) delete [] vars[v];
+
+  std::vector<std::vector<E_Float>> rec_fields;
+  p1tr->tr.apply(don_fields, rec_fields, true/*do_omp*/);
+
+  K_FLD::FloatArray farr(nfields, p1tr->tr.mrec.ncells());
+  for (E_Int i = 0; i < nfields; ++i)
+  {
+    std::vector<E_Float>& fld = rec_fields[i];
+    for (size_t j = 0; j < fld.size(); ++j) farr(i, j) = fld[j];
+  }
+
+  PyObject* tpl = K_ARRAY::buildArray(farr, fvarStringsC, p1tr->cntR, -1, feltType, false);
+  return tpl;
+}
+
+//============================================================================
+/* Returns the stored weights : [xr, donor ids, coeffs] (CSR, 0-based) */
+//============================================================================
+PyObject* K_INTERSECTOR::getP1ConservativeTransferCoeffs(PyObject* self, PyObject* args)
+{
+  PyObject *hook;
+  if (!PYPARSETUPLE_(args, O_, &hook)) return NULL;
+
+  p1_transfer_t* p1tr = unpackP1Transfer(hook);
+  if (p1tr == nullptr) return NULL;
+
+  transfer_t& tr = p1tr->tr;
+  PyObject *l(PyList_New(0)), *tpl;
+
+  tpl = K_NUMPY::buildNumpyArray(tr.xr.data(), tr.xr.size(), 1, 0);
+  PyList_Append(l, tpl);
+  Py_DECREF(tpl);
+
+  tpl = K_NUMPY::buildNumpyArray(tr.dids.data(), tr.dids.size(), 1, 0);
+  PyList_Append(l, tpl);
+  Py_DECREF(tpl);
+
+  tpl = K_NUMPY::buildNumpyArray(tr.coeffs.data(), tr.coeffs.size(), 1, 0);
+  PyList_Append(l, tpl);
+  Py_DECREF(tpl);
+
+  return l;
+}
+
+//============================================================================
+/* Releases a transfer hook */
+//============================================================================
+PyObject* K_INTERSECTOR::deleteP1ConservativeTransfer(PyObject* self, PyObject* args)
+{
+  PyObject *hook;
+  if (!PYPARSETUPLE_(args, O_, &hook)) return NULL;
+
+  p1_transfer_t* p1tr = unpackP1Transfer(hook);
+  if (p1tr == nullptr) return NULL;
+  delete p1tr;
+#if !((PY_MAJOR_VERSION == 2 && PY_MINOR_VERSION < 7) || (PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION < 1))
+  PyCapsule_SetContext(hook, P1TRANSFER_RELEASED);
+#endif
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
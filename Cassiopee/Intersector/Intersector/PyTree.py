@@ -1482,6 +1482,57 @@ def _P1ConservativeInterpolation(tR, tD):
       fldR = intersector.P1ConservativeInterpolation(mR, mD, fldD)
       C.setFields([fldR], zr, 'centers', False)
 
+#==============================================================================
+# createP1ConservativeTransfer : computes the supermesh between two zones once
+# IN: zR: receiver zone
+# IN: zD: donor zone
+# OUT: returns a transfer hook
+#==============================================================================
+def createP1ConservativeTransfer(zR, zD, rtol=1.e-12):
+  """Computes the supermesh between zR and zD and stores its weights for later transfers.
+  Usage: createP1ConservativeTransfer(zR, zD, rtol)"""
+  mR = C.getFields(Internal.__GridCoordinates__, zR)[0]
+  mD = C.getFields(Internal.__GridCoordinates__, zD)[0]
+  return intersector.createP1ConservativeTransfer(mR, mD, rtol)
+
+#==============================================================================
+# updateP1ConservativeTransfer : updates a transfer after a motion of zR and/or zD
+# IN: zR, zD: moved zones (None if not moved)
+# IN: tol: nodes moving less than tol are considered as fixed
+# OUT: returns the number of receiver cells recomputed
+#==============================================================================
+def updateP1ConservativeTransfer(hook, zR=None, zD=None, tol=0.):
+  """Recomputes the weights of the receiver cells whose donor candidates changed or moved.
+  Usage: updateP1ConservativeTransfer(hook, zR, zD, tol)"""
+  mR = None; mD = None
+  if zR is not None: mR = C.getFields(Internal.__GridCoordinates__, zR)[0]
+  if zD is not None: mD = C.getFields(Internal.__GridCoordinates__, zD)[0]
+  return intersector.updateP1ConservativeTransfer(hook, mR, mD, tol)
+
+#==============================================================================
+# P1ConservativeTransfer : transfers zD center fields to zR with a transfer hook
+#==============================================================================
+def P1ConservativeTransfer(zR, zD, hook):
+  """Does conservative interpolations from zD center fields to zR with a transfer hook.
+  Usage: P1ConservativeTransfer(zR, zD, hook)"""
+  zp = Internal.copyRef(zR)
+  _P1ConservativeTransfer(zp, zD, hook)
+  return zp
+
+def _P1ConservativeTransfer(zR, zD, hook):
+  fldD = C.getFields(Internal.__FlowSolutionCenters__, zD)[0]
+  fldR = intersector.P1ConservativeTransfer(hook, fldD)
+  C.setFields([fldR], zR, 'centers', False)
+  return None
+
+#==============================================================================
+# deleteP1ConservativeTransfer : releases a transfer hook
+#==============================================================================
+def deleteP1ConservativeTransfer(hook):
+  """Releases a transfer hook.
+  Usage: deleteP1ConservativeTransfer(hook)"""
+  return intersector.deleteP1ConservativeTransfer(hook)
+
 #==============================================================================
 # superMesh
 # IN: surfz: 3D NGON surface mesh to clip
@@ -2183,6 +2234,24 @@ def agglomerateNonStarCells(t, angular_threshold=1.e-12):
 
     return z
 
+#==============================================================================
+# agglomerateMultiLevel : Builds a hierarchy of coarse agglomerated meshes
+# IN: t: 3D NGON mesh
+# IN: nlevels : number of coarse levels
+# IN: npasses : number of pairwise matching passes per level
+# OUT: returns for each level [zone, parent, R, P] (see Intersector.agglomerateMultiLevel)
+#==============================================================================
+def agglomerateMultiLevel(t, nlevels=3, npasses=3):
+    """Builds a hierarchy of coarse agglomerated meshes.
+    Usage: agglomerateMultiLevel(t, nlevels, npasses)"""
+    m = C.getFields(Internal.__GridCoordinates__, t)[0]
+    res = XOR.agglomerateMultiLevel(m, nlevels, npasses)
+    out = []
+    for l, r in enumerate(res):
+        z = C.convertArrays2ZoneNode('level%d'%(l+1), [r[0]])
+        out.append([z, r[1], r[2], r[3]])
+    return out
+
 #==============================================================================
 # agglomerateCellsWithSpecifiedFaces : Agglomerates cells sharing specified polygons
 # IN: a: 3D NGON mesh
@@ -47,6 +47,11 @@ static PyMethodDef Pyintersector [] =
   
   {"P1ConservativeInterpolation", K_INTERSECTOR::P1ConservativeInterpolation, METH_VARARGS},
   {"P1ConservativeChimeraCoeffs", K_INTERSECTOR::P1ConservativeChimeraCoeffs, METH_VARARGS},
+  {"createP1ConservativeTransfer", K_INTERSECTOR::createP1ConservativeTransfer, METH_VARARGS},
+  {"updateP1ConservativeTransfer", K_INTERSECTOR::updateP1ConservativeTransfer, METH_VARARGS},
+  {"P1ConservativeTransfer", K_INTERSECTOR::P1ConservativeTransfer, METH_VARARGS},
+  {"getP1ConservativeTransferCoeffs", K_INTERSECTOR::getP1ConservativeTransferCoeffs, METH_VARARGS},
+  {"deleteP1ConservativeTransfer", K_INTERSECTOR::deleteP1ConservativeTransfer, METH_VARARGS},
   
   {"selfX", K_INTERSECTOR::selfX, METH_VARARGS},
   {"triangulateExteriorFaces", K_INTERSECTOR::triangulateExteriorFaces, METH_VARARGS},
@@ -69,6 +74,7 @@ static PyMethodDef Pyintersector [] =
   //{"agglomerateUncomputableCells", K_INTERSECTOR::agglomerateUncomputableCells, METH_VARARGS},
   {"immerseNodes", K_INTERSECTOR::immerseNodes, METH_VARARGS},
   {"agglomerateCellsWithSpecifiedFaces", K_INTERSECTOR::agglomerateCellsWithSpecifiedFaces, METH_VARARGS},
+  {"agglomerateMultiLevel", K_INTERSECTOR::agglomerateMultiLevel, METH_VARARGS},
   
   {"adaptCells", K_INTERSECTOR::adaptCells, METH_VARARGS},
   {"adaptCells_mpi", K_INTERSECTOR::adaptCells_mpi, METH_VARARGS},
@@ -41,6 +41,11 @@ namespace K_INTERSECTOR
   
   PyObject* P1ConservativeInterpolation(PyObject* self, PyObject* args);
   PyObject* P1ConservativeChimeraCoeffs(PyObject* self, PyObject* args);
+  PyObject* createP1ConservativeTransfer(PyObject* self, PyObject* args);
+  PyObject* updateP1ConservativeTransfer(PyObject* self, PyObject* args);
+  PyObject* P1ConservativeTransfer(PyObject* self, PyObject* args);
+  PyObject* getP1ConservativeTransferCoeffs(PyObject* self, PyObject* args);
+  PyObject* deleteP1ConservativeTransfer(PyObject* self, PyObject* args);
 
   PyObject* selfX(PyObject* self, PyObject* args);
   PyObject* triangulateExteriorFaces(PyObject* self, PyObject* args);
@@ -71,6 +76,7 @@ namespace K_INTERSECTOR
   PyObject* agglomerateNonStarCells(PyObject* self, PyObject* args);
   //PyObject* agglomerateUncomputableCells(PyObject* self, PyObject* args);
   PyObject* agglomerateCellsWithSpecifiedFaces(PyObject* self, PyObject* args);
+  PyObject* agglomerateMultiLevel(PyObject* self, PyObject* args);
 
   PyObject* immerseNodes(PyObject* self, PyObject* args);
 
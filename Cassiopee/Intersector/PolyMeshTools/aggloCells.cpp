@@ -248,4 +248,103 @@ PyObject* K_INTERSECTOR::agglomerateCellsWithSpecifiedFaces(PyObject* self, PyOb
   return l;
 
 }
+//=============================================================================
+/* Multigrid hierarchy of coarse NGON levels by greedy pairwise matching.
+   For each level : [mesh, parent, R, P] where parent gives the coarse cell of
+   each fine cell, R (volume-weighted restriction) and P (piecewise-constant
+   prolongation) are CSR sparse matrices given as (indptr, indices, data) */
+//=============================================================================
+PyObject* K_INTERSECTOR::agglomerateMultiLevel(PyObject* self, PyObject* args)
+{
+  PyObject *arr;
+  E_Int nb_levels(3), nb_passes(3);
+
+  if (!PYPARSETUPLE_(args, O_ II_, &arr, &nb_levels, &nb_passes)) return NULL;
+
+  K_FLD::FloatArray* f(0);
+  K_FLD::IntArray* cn(0);
+  char* varString, *eltType;
+  // Check array # 1
+  E_Int err = check_is_NGON(arr, f, cn, varString, eltType);
+  if (err) return NULL;
+
+  K_FLD::FloatArray & crd = *f;
+  K_FLD::IntArray & cnt = *cn;
+
+  typedef ngon_t<K_FLD::IntArray> ngon_type;
+  ngon_type ngi(cnt);
+
+  std::vector<ngon_type> levels;
+  std::vector<std::vector<E_Int> > parents;
+  NUGA::Agglomerator::build_coarse_levels(crd, ngi, nb_levels, nb_passes, levels, parents);
+
+  // fine volumes, summed level by level
+  std::vector<E_Float> vols;
+  ngon_type::volumes<DELAUNAY::Triangulator>(crd, ngi, vols, false/*not all cvx*/, true/*new algo*/);
+
+  PyObject *l(PyList_New(0)), *tpl;
+
+  for (size_t lvl = 0; lvl < levels.size(); ++lvl)
+  {
+    const std::vector<E_Int>& parent = parents[lvl];
+    E_Int nf = parent.size();
+    E_Int nc = levels[lvl].PHs.size();
+
+    std::vector<E_Float> cvols(nc, 0.);
+    for (E_Int i = 0; i < nf; ++i) cvols[parent[i]] += vols[i];
+
+    // R : nc x nf, row I = fine cells of I weighted by their volume fraction
+    std::vector<E_Int> rptr(nc+1, 0), rind(nf);
+    std::vector<E_Float> rval(nf);
+    for (E_Int i = 0; i < nf; ++i) ++rptr[parent[i]+1];
+    for (E_Int I = 0; I < nc; ++I) rptr[I+1] += rptr[I];
+    {
+      std::vector<E_Int> pos(rptr.begin(), rptr.end()-1);
+      for (E_Int i = 0; i < nf; ++i)
+      {
+        E_Int I = parent[i];
+        rind[pos[I]] = i;
+        rval[pos[I]++] = (cvols[I] > 0.) ? vols[i] / cvols[I] : 0.;
+      }
+    }
+
+    // P : nf x nc, one unit entry per row
+    std::vector<E_Int> pptr(nf+1);
+    std::vector<E_Float> pval(nf, 1.);
+    for (E_Int i = 0; i <= nf; ++i) pptr[i] = i;
+
+    PyObject* lvlist = PyList_New(0);
+
+    K_FLD::FloatArray crdl(crd);
+    ngon_type& ngo = levels[lvl];
+    ngon_type::compact_to_used_nodes(ngo.PGs, crdl);
+    K_FLD::IntArray cnto;
+    ngo.export_to_array(cnto);
+    tpl = K_ARRAY::buildArray(crdl, varString, cnto, -1, "NGON", false);
+    PyList_Append(lvlist, tpl); Py_DECREF(tpl);
+
+    tpl = K_NUMPY::buildNumpyArray(const_cast<E_Int*>(&parent[0]), nf, 1, 0);
+    PyList_Append(lvlist, tpl); Py_DECREF(tpl);
+
+    PyObject* R = PyList_New(0);
+    tpl = K_NUMPY::buildNumpyArray(&rptr[0], nc+1, 1, 0); PyList_Append(R, tpl); Py_DECREF(tpl);
+    tpl = K_NUMPY::buildNumpyArray(&rind[0], nf, 1, 0); PyList_Append(R, tpl); Py_DECREF(tpl);
+    tpl = K_NUMPY::buildNumpyArray(&rval[0], nf, 1, 0); PyList_Append(R, tpl); Py_DECREF(tpl);
+    PyList_Append(lvlist, R); Py_DECREF(R);
+
+    PyObject* P = PyList_New(0);
+    tpl = K_NUMPY::buildNumpyArray(&pptr[0], nf+1, 1, 0); PyList_Append(P, tpl); Py_DECREF(tpl);
+    tpl = K_NUMPY::buildNumpyArray(const_cast<E_Int*>(&parent[0]), nf, 1, 0); PyList_Append(P, tpl); Py_DECREF(tpl);
+    tpl = K_NUMPY::buildNumpyArray(&pval[0], nf, 1, 0); PyList_Append(P, tpl); Py_DECREF(tpl);
+    PyList_Append(lvlist, P); Py_DECREF(P);
+
+    PyList_Append(l, lvlist); Py_DECREF(lvlist);
+
+    vols.swap(cvols);
+  }
+
+  delete f; delete cn;
+  return l;
+}
+
 //=======================  Intersector/PolyMeshTools/aggloFaces.cpp ====================
@@ -0,0 +1,52 @@
+# - P1ConservativeTransfer (pyTree) -
+import Converter.PyTree   as C
+import Converter.Internal as Internal
+import Intersector.PyTree as XOR
+import Generator.PyTree   as G
+import numpy
+import KCore.test as test
+
+N = 12
+
+aD = G.cartHexa((0.,0.,0.), (0.1,0.1,0.2), (N,N,N))
+aD = C.convertArray2NGon(aD); aD = G.close(aD)
+aD = C.initVars(aD, '{centers:Density} = {centers:CoordinateX} + {centers:CoordinateY}')
+
+aR = G.cartHexa((0.,0.,0.), (0.1,0.1,0.2), (N+1,N+1,N+1))
+aR = C.convertArray2NGon(aR); aR = G.close(aR)
+
+def density(z):
+    return Internal.getNodeFromName2(z, 'Density')[1].ravel('k')
+
+hook = XOR.createP1ConservativeTransfer(aR, aD)
+
+# same weights as P1ConservativeInterpolation
+bR = XOR.P1ConservativeTransfer(aR, aD, hook)
+test.testT(bR, 1)
+cR = XOR.P1ConservativeInterpolation(aR, aD)
+test.testO(numpy.max(numpy.abs(density(bR)-density(cR))) < 1.e-12, 2)
+
+# moving donor : only the nodes with x < 0.3 move, so only the receiver
+# cells around them are recomputed
+C._initVars(aD, '{CoordinateX} = {CoordinateX} + 0.02*({CoordinateX}<0.3)*(0.3-{CoordinateX})')
+C._initVars(aD, '{centers:Density} = {centers:CoordinateX} + {centers:CoordinateY}')
+n = XOR.updateP1ConservativeTransfer(hook, zD=aD)
+test.testO(n > 0 and n < C.getNCells(aR), 3)
+bR = XOR.P1ConservativeTransfer(aR, aD, hook)
+test.testT(bR, 4)
+
+# incremental update gives the from-scratch transfer
+hook2 = XOR.createP1ConservativeTransfer(aR, aD)
+dR = XOR.P1ConservativeTransfer(aR, aD, hook2)
+test.testO(numpy.max(numpy.abs(density(bR)-density(dR))) == 0., 5)
+cR = XOR.P1ConservativeInterpolation(aR, aD)
+test.testO(numpy.max(numpy.abs(density(bR)-density(cR))) < 1.e-12, 6)
+
+XOR.deleteP1ConservativeTransfer(hook2)
+XOR.deleteP1ConservativeTransfer(hook)
+
+# a deleted hook is rejected
+try:
+    XOR.deleteP1ConservativeTransfer(hook); ok = 0
+except ValueError: ok = 1
+test.testO(ok, 7)
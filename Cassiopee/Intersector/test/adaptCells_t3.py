@@ -0,0 +1,38 @@
+# - adaptCells (array) -
+# uniform refinement of zones big enough to go through the threaded split
+import Intersector as XOR
+import Converter as C
+import Converter.Internal as I
+import Generator as G
+import numpy
+import KCore.test as test
+
+def refine(a, level):
+    n = C.getNCells(a)
+    vals = numpy.empty((n,), dtype=I.E_NpyInt)
+    vals[:] = level
+    m = XOR.adaptCells(a, vals, sensor_type=3, smoothing_type=1)
+    return XOR.closeCells(m[0])
+
+def volume(a):
+    v = G.getVolumeMap(a)
+    return numpy.sum(v[1])
+
+# HEXA : 729 cells refined twice (each pass > threshold of the threaded loop)
+a = G.cartHexa((0.,0.,0.), (0.1,0.1,0.1), (10,10,10))
+a = C.convertArray2NGon(a); a = G.close(a)
+m = refine(a, 2)
+if C.getNCells(m) != 64*C.getNCells(a): print('FAILED: wrong number of cells (HEXA)')
+if XOR.checkCellsClosure(m) != 0: print('FAILED: open cells (HEXA)')
+if abs(volume(m)-volume(a)) > 1.e-10: print('FAILED: volume not preserved (HEXA)')
+test.testA(m,1)
+
+# TETRA : same mesh split with barycenters
+a = G.cartHexa((0.,0.,0.), (0.1,0.1,0.1), (6,6,6))
+a = C.convertArray2Tetra(a, split='withBarycenters')
+a = C.convertArray2NGon(a); a = G.close(a)
+m = refine(a, 2)
+if C.getNCells(m) != 64*C.getNCells(a): print('FAILED: wrong number of cells (TETRA)')
+if XOR.checkCellsClosure(m) != 0: print('FAILED: open cells (TETRA)')
+if abs(volume(m)-volume(a)) > 1.e-10: print('FAILED: volume not preserved (TETRA)')
+test.testA(m,2)
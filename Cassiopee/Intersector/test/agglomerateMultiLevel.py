@@ -0,0 +1,9 @@
+# - agglomerateMultiLevel (array) -
+import Generator as G
+import Converter as C
+import Intersector as XOR
+
+a = G.cartNGon((0,0,0), (1,1,1), (17,17,17))
+levels = XOR.agglomerateMultiLevel(a, nlevels=3, npasses=3)
+for l, (m, parent, R, P) in enumerate(levels):
+    C.convertArrays2File([m], 'level%d.plt'%(l+1))
@@ -0,0 +1,10 @@
+# - agglomerateMultiLevel (pyTree) -
+import Generator.PyTree as G
+import Converter.PyTree as C
+import Intersector.PyTree as XOR
+
+a = G.cartNGon((0,0,0), (1,1,1), (17,17,17))
+levels = XOR.agglomerateMultiLevel(a, nlevels=3, npasses=3)
+t = C.newPyTree(['Base'])
+for (z, parent, R, P) in levels: t[2][1][2].append(z)
+C.convertPyTree2File(t, 'out.cgns')
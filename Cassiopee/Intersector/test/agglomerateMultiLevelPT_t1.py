@@ -0,0 +1,12 @@
+# - agglomerateMultiLevel (pyTree) -
+import Generator.PyTree as G
+import Converter.PyTree as C
+import Intersector.PyTree as XOR
+import KCore.test as test
+
+a = G.cartNGon((0,0,0), (1,1,1), (9,9,9))
+levels = XOR.agglomerateMultiLevel(a, nlevels=3, npasses=3)
+
+t = C.newPyTree(['Base'])
+for (z, parent, R, P) in levels: t[2][1][2].append(z)
+test.testT(t, 1)
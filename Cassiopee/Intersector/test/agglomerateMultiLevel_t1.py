@@ -0,0 +1,19 @@
+# - agglomerateMultiLevel (array) -
+import Generator as G
+import Intersector as XOR
+import KCore.test as test
+import numpy
+
+a = G.cartNGon((0,0,0), (1,1,1), (9,9,9))
+levels = XOR.agglomerateMultiLevel(a, nlevels=3, npasses=3)
+
+out = []; nc = []
+for (m, parent, R, P) in levels:
+    out.append(m)
+    nc.append(parent.max()+1)
+    # each row of R sums to 1
+    indptr, indices, data = R
+    s = numpy.add.reduceat(data, indptr[:-1])
+    test.testO(numpy.allclose(s, 1.), 1)
+test.testO(nc, 2)
+test.testA(out, 3)
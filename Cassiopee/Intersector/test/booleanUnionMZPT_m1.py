@@ -0,0 +1,85 @@
+# - booleanUnionMZ (pyTree) -
+import Intersector.Mpi as XORMPI
+
+import Converter.Internal as I
+import Converter.Mpi as Cmpi
+import Converter.PyTree as C
+import Connector.PyTree as X
+import Transform.PyTree as T
+import Generator.PyTree as G
+import Distributor2.PyTree as D2
+import Post.PyTree as P
+import numpy
+
+import KCore.test as test
+
+# exterior faces with no join must lie on the boundary of the union of the boxes
+def checkWatertight(t, boxes, tol=1.e-8):
+    nholes = 0
+    for z in I.getZones(t):
+        ind = []
+        P.exteriorFaces(z, indices=ind)
+        ind = ind[0].ravel()
+        pls = [I.getNodeFromName1(j, 'PointList')[1].ravel() for j in I.getNodesFromType2(z, 'GridConnectivity_t')+I.getNodesFromType2(z, 'GridConnectivity1to1_t')]
+        if pls != []: ind = ind[~numpy.isin(ind, numpy.concatenate(pls))]
+        if ind.size == 0: continue
+        f = C.node2Center(T.subzone(z, ind, type='faces'))
+        xc = [I.getNodeFromName2(f, v)[1].ravel() for v in ['CoordinateX', 'CoordinateY', 'CoordinateZ']]
+        onb = numpy.zeros(ind.size, bool)
+        for ib, (bmin, bmax) in enumerate(boxes):
+            (omin, omax) = boxes[1-ib]
+            on = numpy.zeros(ind.size, bool); inb = numpy.ones(ind.size, bool); ino = numpy.ones(ind.size, bool)
+            for d in range(3):
+                on |= (abs(xc[d]-bmin[d]) < tol) | (abs(xc[d]-bmax[d]) < tol)
+                inb &= (xc[d] > bmin[d]-tol) & (xc[d] < bmax[d]+tol)
+                ino &= (xc[d] > omin[d]+tol) & (xc[d] < omax[d]-tol)
+            onb |= on & inb & ~ino
+        nholes += numpy.count_nonzero(~onb)
+    return nholes
+
+LOCAL = test.getLocal()
+
+Nprocs = Cmpi.size
+ifname1 = LOCAL + '/case1_' + str(Nprocs) + '.cgns'
+ifname2 = LOCAL + '/case2_' + str(Nprocs) + '.cgns'
+ofname = LOCAL + '/out_' + str(Nprocs) + '.cgns'
+
+if Cmpi.rank == 0:
+    # Build case : two overlapping boxes, each split over the procs
+    N = 9
+    a = G.cartNGon((0.,0.,0.), (0.125,0.125,0.125), (N,N,N))
+    a = T.splitNParts(a, Nprocs)
+    a = X.connectMatch(C.newPyTree(['Base', a]))
+    C._fillEmptyBCWith(a, 'wall', 'BCWall')
+    D2._distribute(a, Nprocs)
+    C.convertPyTree2File(a, ifname1)
+
+    b = G.cartNGon((0.51,0.53,0.57), (0.1,0.1,0.1), (N,N,N))
+    b = T.splitNParts(b, Nprocs)
+    b = X.connectMatch(C.newPyTree(['Base', b]))
+    C._fillEmptyBCWith(b, 'wall', 'BCWall')
+    D2._distribute(b, Nprocs)
+    C.convertPyTree2File(b, ifname2)
+
+Cmpi.barrier()
+
+t1 = Cmpi.convertFile2SkeletonTree(ifname1)
+t1 = Cmpi.readZones(t1, ifname1, rank=Cmpi.rank)
+Cmpi._convert2PartialTree(t1)
+
+t2 = Cmpi.convertFile2SkeletonTree(ifname2)
+t2 = Cmpi.readZones(t2, ifname2, rank=Cmpi.rank)
+Cmpi._convert2PartialTree(t2)
+
+zs = XORMPI.booleanUnionMZ(t1, t2, jtol=1.e-6)
+
+t = C.newPyTree(['Base'])
+I._addChild(I.getBases(t)[0], zs)
+Cmpi.convertPyTree2File(t, ofname)
+
+if Cmpi.rank == 0:
+    r = C.convertFile2PyTree(ofname)
+    boxes = [((0.,0.,0.), (1.,1.,1.)), ((0.51,0.53,0.57), (1.31,1.33,1.37))]
+    nholes = checkWatertight(r, boxes)
+    test.testO(nholes, 2)
+    test.testT(r, 1)
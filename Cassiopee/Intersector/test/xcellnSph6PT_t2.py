@@ -0,0 +1,30 @@
+# - XcellN (pyTree) -
+# multi-zone component : zones sharing the mask cache must get the same
+# xcelln as when they are processed one at a time
+import Geom.PyTree as D
+import Converter.PyTree as C
+import Converter.Internal as Internal
+import Intersector.PyTree as XOR
+import KCore.test as test
+
+a = D.sphere6((0,0,0), 1, N=20)
+b = a[0]
+a = C.convertArray2NGon(a)
+
+t0 = C.newPyTree(['Base1',a,'Base2',b])
+
+for n, prio in enumerate([(0,1), (1,0)]):
+    # all zones at once
+    t = Internal.copyTree(t0)
+    XOR._XcellN(t, [prio], output_type=1)
+    test.testT(t, n+1)
+
+    # one zone at a time, Base2 is taken from the previous computation
+    bases = Internal.getBases(t0)
+    zones = []
+    for z in Internal.getZones(bases[0]):
+        tz = C.newPyTree(['Base1',Internal.copyTree(z),'Base2',Internal.copyTree(b)])
+        XOR._XcellN(tz, [prio], output_type=1)
+        zones.append(Internal.getZones(tz)[0])
+    tz = C.newPyTree(['Base1',zones,'Base2',Internal.getZones(Internal.getBases(t)[1])])
+    test.testT(tz, n+1)
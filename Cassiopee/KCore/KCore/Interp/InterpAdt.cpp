@@ -19,6 +19,7 @@
 # include <stack>
 # include "CompGeom/compGeom.h"
 # include "Interp/InterpAdt.h"
+# include "Profiler/profiler.h"
 #include "Loc/loc.h"
 
 using namespace std;
@@ -284,6 +285,7 @@ void K_INTERP::InterpAdt::cart2Cyl(E_Float& x, E_Float& y, E_Float& z)
 E_Int K_INTERP::InterpAdt::buildStructAdt(E_Int ni, E_Int nj, E_Int nk,
                                           E_Float* x, E_Float* y, E_Float* z)
 {  
+  K_PROFILE("InterpAdt::buildStructAdt");
   _tree = NULL;
  
   K_COMPGEOM::boundingBox(ni*nj*nk, x, y, z, 
@@ -435,6 +437,7 @@ E_Int K_INTERP::InterpAdt::buildStructAdt(E_Int ni, E_Int nj, E_Int nk,
 E_Int K_INTERP::InterpAdt::buildUnstrAdt(E_Int npts, FldArrayI& connect, 
                                          E_Float* x, E_Float* y, E_Float* z)
 {  
+  K_PROFILE("InterpAdt::buildUnstrAdt");
   _tree = NULL;
   K_COMPGEOM::boundingBox(npts, x, y, z, 
                           _xmin, _ymin, _zmin, 
@@ -0,0 +1,246 @@
+/*
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "linear.h"
+#include <cmath>
+
+// Batched small dense kernels. Each lane of the vectorized loops is one
+// system (one cell), all coefficients are SoA: component k of system i is
+// stored at k*n+i. Symmetric matrices are stored as their row-major upper
+// triangle (a00 a01 a02 a11 a12 a22 for 3x3).
+
+// Index of (r,c), r <= c, in the packed upper triangle of a PxP matrix
+#define SYMIDX(P, r, c) ((r)*(P) - ((r)*((r)-1))/2 + (c) - (r))
+
+//=============================================================================
+// tA.A and tA.b of the per-cell least-squares systems
+//=============================================================================
+template <int P>
+static void lsq_normal_batch_P(E_Int n, const E_Int *xadj, const E_Int *cnt,
+  const E_Float *Arows, const E_Float *brows, E_Float *AtA, E_Float *Atb)
+{
+  #pragma omp parallel for
+  for (E_Int i = 0; i < n; i++) {
+    const E_Float *pA = &Arows[P*xadj[i]];
+    E_Float S[P*(P+1)/2] = {0.};
+    E_Float B[P] = {0.};
+
+    for (E_Int l = 0; l < cnt[i]; l++) {
+      const E_Float *row = &pA[P*l];
+      for (int r = 0; r < P; r++) {
+        for (int c = r; c < P; c++) S[SYMIDX(P, r, c)] += row[r]*row[c];
+      }
+    }
+
+    if (AtA) {
+      for (int k = 0; k < P*(P+1)/2; k++) AtA[k*n+i] = S[k];
+    }
+
+    if (Atb) {
+      const E_Float *pb = &brows[xadj[i]];
+      for (E_Int l = 0; l < cnt[i]; l++) {
+        const E_Float *row = &pA[P*l];
+        for (int r = 0; r < P; r++) B[r] += pb[l]*row[r];
+      }
+      for (int r = 0; r < P; r++) Atb[r*n+i] = B[r];
+    }
+  }
+}
+
+void K_LINEAR::lsq_normal_batch(E_Int n, E_Int p, const E_Int *xadj,
+  const E_Int *cnt, const E_Float *Arows, const E_Float *brows,
+  E_Float *AtA, E_Float *Atb)
+{
+  if (p == 3) lsq_normal_batch_P<3>(n, xadj, cnt, Arows, brows, AtA, Atb);
+  else if (p == 6) lsq_normal_batch_P<6>(n, xadj, cnt, Arows, brows, AtA, Atb);
+}
+
+//=============================================================================
+// Cholesky A = tR.R, the diagonal of R is stored inverted. A pivot below
+// tol*max(diag(A)) is dropped (inverse set to 0): the matching unknown is
+// set to 0, which keeps a solution of consistent semi-definite systems
+// (e.g. the missing direction of 2D least-squares stencils).
+//=============================================================================
+template <int P>
+static E_Int spd_solve_batch(E_Int n, const E_Float *A, const E_Float *b,
+  E_Float *x, E_Float tol)
+{
+  E_Int ndef = 0;
+
+  #pragma omp parallel for simd reduction(+:ndef)
+  for (E_Int i = 0; i < n; i++) {
+    E_Float R[P*(P+1)/2];
+    E_Float y[P];
+
+    E_Float dmax = 0.;
+    for (int r = 0; r < P; r++) {
+      E_Float d = A[SYMIDX(P, r, r)*n+i];
+      dmax = d > dmax ? d : dmax;
+    }
+    E_Float eps = tol*dmax;
+
+    E_Int def = 0;
+    for (int r = 0; r < P; r++) {
+      E_Float d = A[SYMIDX(P, r, r)*n+i];
+      for (int k = 0; k < r; k++) d -= R[SYMIDX(P, k, r)]*R[SYMIDX(P, k, r)];
+      def += (d <= eps);
+      E_Float rinv = d > eps ? 1./sqrt(d) : 0.;
+      R[SYMIDX(P, r, r)] = rinv;
+      for (int c = r+1; c < P; c++) {
+        E_Float s = A[SYMIDX(P, r, c)*n+i];
+        for (int k = 0; k < r; k++) s -= R[SYMIDX(P, k, r)]*R[SYMIDX(P, k, c)];
+        R[SYMIDX(P, r, c)] = s*rinv;
+      }
+    }
+
+    // tR.y = b
+    for (int r = 0; r < P; r++) {
+      E_Float s = b[r*n+i];
+      for (int k = 0; k < r; k++) s -= R[SYMIDX(P, k, r)]*y[k];
+      y[r] = s*R[SYMIDX(P, r, r)];
+    }
+
+    // R.x = y, in place
+    for (int r = P-1; r >= 0; r--) {
+      E_Float s = y[r];
+      for (int c = r+1; c < P; c++) s -= R[SYMIDX(P, r, c)]*y[c];
+      y[r] = s*R[SYMIDX(P, r, r)];
+    }
+
+    for (int r = 0; r < P; r++) x[r*n+i] = y[r];
+
+    ndef += (def > 0);
+  }
+
+  return ndef;
+}
+
+E_Int K_LINEAR::spd3_solve_batch(E_Int n, const E_Float *A, const E_Float *b,
+  E_Float *x, const E_Float tol)
+{
+  return spd_solve_batch<3>(n, A, b, x, tol);
+}
+
+E_Int K_LINEAR::spd6_solve_batch(E_Int n, const E_Float *A, const E_Float *b,
+  E_Float *x, const E_Float tol)
+{
+  return spd_solve_batch<6>(n, A, b, x, tol);
+}
+
+//=============================================================================
+// Closed-form eigen decomposition of symmetric 3x3 matrices.
+// Same scheme as sym3mat_eigen: the most separated eigenvalue of the
+// deviator is found with the trigonometric formula, its eigenvector from the
+// largest cross product of two rows of (A - L0.I), the two others by a
+// Jacobi rotation of A reduced to the orthogonal plane. Written without
+// branches so that lanes vectorize; null and diagonal matrices are blended
+// at the end.
+//=============================================================================
+void K_LINEAR::sym3mat_eigen_batch(E_Int n, const E_Float *A, E_Float *L,
+  E_Float *V)
+{
+  const E_Float *m00 = A, *m01 = A+n, *m02 = A+2*n;
+  const E_Float *m11 = A+3*n, *m12 = A+4*n, *m22 = A+5*n;
+  const E_Float pi = K_CONST::E_PI;
+
+  #pragma omp parallel for simd
+  for (E_Int i = 0; i < n; i++) {
+    // Normalize
+    E_Float maxm = fabs(m00[i]);
+    maxm = fmax(maxm, fabs(m01[i])); maxm = fmax(maxm, fabs(m02[i]));
+    maxm = fmax(maxm, fabs(m11[i])); maxm = fmax(maxm, fabs(m12[i]));
+    maxm = fmax(maxm, fabs(m22[i]));
+    E_Int isnull = maxm < 5e-6;
+    E_Float dd = isnull ? 1. : 1./maxm;
+
+    E_Float a00 = m00[i]*dd, a01 = m01[i]*dd, a02 = m02[i]*dd;
+    E_Float a11 = m11[i]*dd, a12 = m12[i]*dd, a22 = m22[i]*dd;
+
+    E_Float maxd = fmax(fabs(a01), fmax(fabs(a02), fabs(a12)));
+    E_Int isdiag = isnull | (maxd < 1e-13);
+
+    // Deviator and its invariants
+    E_Float q = (a00 + a11 + a22)/3.;
+    E_Float b00 = a00 - q, b11 = a11 - q, b22 = a22 - q;
+    E_Float J2 = 0.5*(b00*b00 + b11*b11 + b22*b22)
+      + a01*a01 + a02*a02 + a12*a12;
+    E_Float J3 = b00*(b11*b22 - a12*a12) - a01*(a01*b22 - a12*a02)
+      + a02*(a01*a12 - b11*a02);
+    J2 = J2 > 1e-300 ? J2 : 1e-300;
+    E_Float t = 0.5*J3*pow(3./J2, 1.5);
+    t = t > 1. ? 1. : (t < -1. ? -1. : t);
+    E_Float alpha = acos(t)/3.;
+    alpha = alpha < pi/6. ? alpha : alpha + 4.*pi/3.;
+    E_Float l0 = 2.*sqrt(J2/3.)*cos(alpha);
+
+    // Eigenvector of l0
+    E_Float r00 = b00 - l0, r11 = b11 - l0, r22 = b22 - l0;
+    E_Float c0x = a01*a12 - a02*r11, c0y = a02*a01 - r00*a12, c0z = r00*r11 - a01*a01;
+    E_Float c1x = a01*r22 - a02*a12, c1y = a02*a02 - r00*r22, c1z = r00*a12 - a01*a02;
+    E_Float c2x = r11*r22 - a12*a12, c2y = a12*a02 - a01*r22, c2z = a01*a12 - r11*a02;
+    E_Float n0 = c0x*c0x + c0y*c0y + c0z*c0z;
+    E_Float n1 = c1x*c1x + c1y*c1y + c1z*c1z;
+    E_Float n2 = c2x*c2x + c2y*c2y + c2z*c2z;
+    E_Int s1 = n1 > n0;
+    E_Float vx = s1 ? c1x : c0x, vy = s1 ? c1y : c0y, vz = s1 ? c1z : c0z;
+    E_Float nv = s1 ? n1 : n0;
+    E_Int s2 = n2 > nv;
+    vx = s2 ? c2x : vx; vy = s2 ? c2y : vy; vz = s2 ? c2z : vz;
+    nv = s2 ? n2 : nv;
+    nv = nv > 0. ? 1./sqrt(nv) : 0.;
+    vx *= nv; vy *= nv; vz *= nv;
+
+    // Orthonormal basis (u,w) of the plane orthogonal to v
+    E_Int sx = fabs(vx) > fabs(vy);
+    E_Float ux = sx ? -vz : 0., uy = sx ? 0. : vz, uz = sx ? vx : -vy;
+    E_Float nu = ux*ux + uy*uy + uz*uz;
+    nu = nu > 0. ? 1./sqrt(nu) : 0.;
+    ux *= nu; uy *= nu; uz *= nu;
+    E_Float wx = vy*uz - vz*uy, wy = vz*ux - vx*uz, wz = vx*uy - vy*ux;
+
+    // Reduced 2x2 matrix and its Jacobi rotation
+    E_Float Aux = b00*ux + a01*uy + a02*uz;
+    E_Float Auy = a01*ux + b11*uy + a12*uz;
+    E_Float Auz = a02*ux + a12*uy + b22*uz;
+    E_Float Awx = b00*wx + a01*wy + a02*wz;
+    E_Float Awy = a01*wx + b11*wy + a12*wz;
+    E_Float Awz = a02*wx + a12*wy + b22*wz;
+    E_Float p = ux*Aux + uy*Auy + uz*Auz;
+    E_Float r = ux*Awx + uy*Awy + uz*Awz;
+    E_Float s = wx*Awx + wy*Awy + wz*Awz;
+    E_Float theta = 0.5*atan2(2.*r, p - s);
+    E_Float c = cos(theta), sn = sin(theta);
+    E_Float l1 = p*c*c + 2.*r*c*sn + s*sn*sn;
+    E_Float l2 = p*sn*sn - 2.*r*c*sn + s*c*c;
+
+    E_Float scale = 1./dd;
+    L[i]     = isdiag ? m00[i] : (l0 + q)*scale;
+    L[n+i]   = isdiag ? m11[i] : (l1 + q)*scale;
+    L[2*n+i] = isdiag ? m22[i] : (l2 + q)*scale;
+
+    V[i]     = isdiag ? 1. : vx;
+    V[n+i]   = isdiag ? 0. : vy;
+    V[2*n+i] = isdiag ? 0. : vz;
+    V[3*n+i] = isdiag ? 0. : c*ux + sn*wx;
+    V[4*n+i] = isdiag ? 1. : c*uy + sn*wy;
+    V[5*n+i] = isdiag ? 0. : c*uz + sn*wz;
+    V[6*n+i] = isdiag ? 0. : -sn*ux + c*wx;
+    V[7*n+i] = isdiag ? 0. : -sn*uy + c*wy;
+    V[8*n+i] = isdiag ? 1. : -sn*uz + c*wz;
+  }
+}
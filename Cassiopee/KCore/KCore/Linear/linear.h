@@ -144,5 +144,38 @@ namespace K_LINEAR
   */
   void sym3mat_eigen(const E_Float [6], E_Float L[3], E_Float v1[3],
     E_Float v2[3], E_Float v3[3], const E_Float tol = 1e-12);
+
+  /* Batched kernels: n systems (one per cell) stored SoA, component k of
+     system i at k*n+i. Symmetric matrices are stored as their row-major
+     upper triangle (a00 a01 a02 a11 a12 a22 for 3x3, 21 coefs for 6x6). */
+
+  /* Least-squares normal equations of n cells
+     IN: p: number of unknowns (3 or 6)
+     IN: xadj, cnt: rows of cell i are xadj[i] ... xadj[i]+cnt[i]-1
+     IN: Arows: p coefficients per row (row-major)
+     IN: brows: one right-hand side per row (used if Atb)
+     OUT: AtA: tA.A, p(p+1)/2 x n (may be NULL)
+     OUT: Atb: tA.b, p x n (may be NULL)
+  */
+  void lsq_normal_batch(E_Int n, E_Int p, const E_Int *xadj, const E_Int *cnt,
+    const E_Float *Arows, const E_Float *brows, E_Float *AtA, E_Float *Atb);
+
+  /* Solve n symmetric positive (semi-)definite systems by Cholesky
+     IN: A: 6 x n (3x3) or 21 x n (6x6) packed matrices
+     IN: b: 3 x n or 6 x n right-hand sides
+     OUT: x: 3 x n or 6 x n solutions
+     Retourne le nombre de systemes singuliers (pivots < tol, inconnues
+     correspondantes mises a 0) */
+  E_Int spd3_solve_batch(E_Int n, const E_Float *A, const E_Float *b,
+    E_Float *x, const E_Float tol = 1e-12);
+  E_Int spd6_solve_batch(E_Int n, const E_Float *A, const E_Float *b,
+    E_Float *x, const E_Float tol = 1e-12);
+
+  /* Eigenvalues and eigenvectors of n 3x3 symmetric matrices
+     IN: A: 6 x n packed matrices
+     OUT: L: 3 x n eigenvalues
+     OUT: V: 9 x n eigenvectors, component c of vector j at (3*j+c)*n+i
+  */
+  void sym3mat_eigen_batch(E_Int n, const E_Float *A, E_Float *L, E_Float *V);
 }
 #endif
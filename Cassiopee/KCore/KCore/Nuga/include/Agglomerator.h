@@ -71,6 +71,16 @@ namespace NUGA
     inline static E_Int collapse_pgs(K_FLD::FloatArray& crd, ngon_type& ng, const Vector_t<E_Int>& pgids);
     inline static E_Int collapse_pgs2(K_FLD::FloatArray& crd, ngon_type& ng, const Vector_t<E_Int>& pgids);
 
+    /// MULTIGRID : nb_levels successive coarse levels of ngi, each made of nb_passes greedy pairwise matchings.
+    /// parents[l][i] is the cell of levels[l] containing the cell i of the previous level (ngi for l=0).
+    inline static void build_coarse_levels(const K_FLD::FloatArray& crd, const ngon_type& ngi, E_Int nb_levels, E_Int nb_passes,
+                                           std::vector<ngon_type>& levels, std::vector<ivec_t>& parents);
+    /// one matching pass on a cell graph (xadj/adj) with cell bounding boxes and weights (nb of fine cells) : agg[i] = aggregate of i.
+    /// returns the nb of aggregates
+    inline static E_Int match_cells(const ivec_t& xadj, const ivec_t& adj, const std::vector<E_Float>& boxes, const ivec_t& weights, ivec_t& agg);
+    /// coarse ngon made of the aggregates agg of ngi cells (inner faces are removed)
+    inline static void agglomerate_phs_by_map(const ngon_type& ngi, const ivec_t& agg, E_Int nb_aggs, ngon_type& ngo);
+
     // PROTO
     template<typename TriangulatorType>
     inline static E_Int collapse_small_tetras(K_FLD::FloatArray& crd, ngon_type& ngio, double vmin, double vratio);
@@ -116,6 +126,245 @@ namespace NUGA
 
   };
 
+  /// matching score of two cells : aspect ratio of the union of their bounding boxes times its weight
+  /// (lower is better, favours compact and balanced aggregates)
+  inline static E_Float __match_score(const E_Float* b1, const E_Float* b2, E_Int w)
+  {
+    E_Float emin = NUGA::FLOAT_MAX, emax = 0.;
+    for (E_Int k = 0; k < 3; ++k)
+    {
+      E_Float e = std::max(b1[k+3], b2[k+3]) - std::min(b1[k], b2[k]);
+      emin = std::min(emin, e); emax = std::max(emax, e);
+    }
+    return (emin > ZERO_M) ? w * emax / emin : NUGA::FLOAT_MAX;
+  }
+
+  ///
+  E_Int NUGA::Agglomerator::match_cells(const ivec_t& xadj, const ivec_t& adj, const std::vector<E_Float>& boxes, const ivec_t& weights, ivec_t& agg)
+  {
+    E_Int nb_cells = xadj.size() - 1;
+    ivec_t mate(nb_cells, IDX_NONE), best(nb_cells, IDX_NONE);
+
+    // handshake matching : each free cell points to its best free neighbour (lowest score),
+    // mutual choices are matched. Rounds go on while new pairs are found.
+    while (true)
+    {
+#pragma omp parallel for
+      for (E_Int i = 0; i < nb_cells; ++i)
+      {
+        best[i] = IDX_NONE;
+        if (mate[i] != IDX_NONE) continue;
+        E_Float qbest = NUGA::FLOAT_MAX;
+        for (E_Int k = xadj[i]; k < xadj[i+1]; ++k)
+        {
+          E_Int j = adj[k];
+          if (mate[j] != IDX_NONE) continue;
+          E_Float q = __match_score(&boxes[6*i], &boxes[6*j], weights[i]+weights[j]);
+          if (q < qbest || (q == qbest && j < best[i])) { qbest = q; best[i] = j; }
+        }
+      }
+
+      E_Int nb_matched(0);
+#pragma omp parallel for reduction(+:nb_matched)
+      for (E_Int i = 0; i < nb_cells; ++i)
+      {
+        E_Int j = best[i];
+        if (j != IDX_NONE && best[j] == i) { mate[i] = j; ++nb_matched; }
+      }
+      if (nb_matched == 0) break;
+    }
+
+    // number the pairs in cell order
+    agg.clear();
+    agg.resize(nb_cells, IDX_NONE);
+    E_Int nb_aggs(0);
+    for (E_Int i = 0; i < nb_cells; ++i)
+    {
+      if (mate[i] == IDX_NONE || agg[i] != IDX_NONE) continue;
+      agg[i] = agg[mate[i]] = nb_aggs++;
+    }
+
+    // left-over cells join the neighbouring pair giving the lowest score
+#pragma omp parallel for
+    for (E_Int i = 0; i < nb_cells; ++i)
+    {
+      if (mate[i] != IDX_NONE) continue;
+      E_Float qbest = NUGA::FLOAT_MAX;
+      for (E_Int k = xadj[i]; k < xadj[i+1]; ++k)
+      {
+        E_Int j = adj[k];
+        if (mate[j] == IDX_NONE) continue;
+        E_Float q = __match_score(&boxes[6*i], &boxes[6*j], weights[i]+weights[j]+weights[mate[j]]);
+        if (q < qbest) { qbest = q; agg[i] = agg[j]; }
+      }
+    }
+
+    // isolated cells stay alone
+    for (E_Int i = 0; i < nb_cells; ++i)
+      if (agg[i] == IDX_NONE) agg[i] = nb_aggs++;
+
+    return nb_aggs;
+  }
+
+  ///
+  void NUGA::Agglomerator::agglomerate_phs_by_map(const ngon_type& ngi, const ivec_t& agg, E_Int nb_aggs, ngon_type& ngo)
+  {
+    ngi.PHs.updateFacets();
+    E_Int nb_phs = ngi.PHs.size();
+    E_Int nb_pgs = ngi.PGs.size();
+
+    // inner faces : shared by two cells of the same aggregate
+    ivec_t owner(nb_pgs, IDX_NONE);
+    std::vector<bool> inner(nb_pgs, false);
+    for (E_Int i = 0; i < nb_phs; ++i)
+    {
+      const E_Int* pgs = ngi.PHs.get_facets_ptr(i);
+      for (E_Int j = 0; j < ngi.PHs.stride(i); ++j)
+      {
+        E_Int PGi = pgs[j] - 1;
+        if (owner[PGi] == agg[i]) inner[PGi] = true;
+        else owner[PGi] = agg[i];
+      }
+    }
+
+    // cells sorted by aggregate
+    ivec_t xagg(nb_aggs+1, 0), cells(nb_phs);
+    for (E_Int i = 0; i < nb_phs; ++i) ++xagg[agg[i]+1];
+    for (E_Int a = 0; a < nb_aggs; ++a) xagg[a+1] += xagg[a];
+    {
+      ivec_t pos(xagg.begin(), xagg.end()-1);
+      for (E_Int i = 0; i < nb_phs; ++i) cells[pos[agg[i]]++] = i;
+    }
+
+    ngo.PGs = ngi.PGs;
+    ngo.PHs.clear();
+    ivec_t molec;
+    for (E_Int a = 0; a < nb_aggs; ++a)
+    {
+      molec.clear();
+      for (E_Int k = xagg[a]; k < xagg[a+1]; ++k)
+      {
+        E_Int i = cells[k];
+        const E_Int* pgs = ngi.PHs.get_facets_ptr(i);
+        for (E_Int j = 0; j < ngi.PHs.stride(i); ++j)
+          if (!inner[pgs[j]-1]) molec.push_back(pgs[j]);
+      }
+      ngo.PHs.add(molec.size(), molec.data());
+    }
+    ngo.PHs.updateFacets();
+
+    Vector_t<E_Int> pgnids, phnids;
+    ngo.remove_unreferenced_pgs(pgnids, phnids);
+  }
+
+  ///
+  void NUGA::Agglomerator::build_coarse_levels
+  (const K_FLD::FloatArray& crd, const ngon_type& ngi, E_Int nb_levels, E_Int nb_passes,
+   std::vector<ngon_type>& levels, std::vector<ivec_t>& parents)
+  {
+    levels.clear(); parents.clear();
+    levels.reserve(nb_levels); parents.reserve(nb_levels);
+
+    const ngon_type* fine = &ngi;
+    for (E_Int l = 0; l < nb_levels; ++l)
+    {
+      ngon_unit neighbors;
+      fine->build_ph_neighborhood(neighbors);
+      fine->PGs.updateFacets();
+      E_Int nb_phs = fine->PHs.size();
+
+      // cell graph
+      ivec_t xadj(nb_phs+1, 0), adj;
+      for (E_Int i = 0; i < nb_phs; ++i)
+      {
+        const E_Int* neis = neighbors.get_facets_ptr(i);
+        E_Int first = adj.size();
+        for (E_Int j = 0; j < neighbors.stride(i); ++j)
+          if (neis[j] != IDX_NONE && neis[j] != i) adj.push_back(neis[j]);
+        std::sort(adj.begin()+first, adj.end());
+        adj.erase(std::unique(adj.begin()+first, adj.end()), adj.end());
+        xadj[i+1] = adj.size();
+      }
+
+      // cell bounding boxes
+      std::vector<E_Float> boxes(6*nb_phs);
+#pragma omp parallel for
+      for (E_Int i = 0; i < nb_phs; ++i)
+      {
+        E_Float* b = &boxes[6*i];
+        b[0] = b[1] = b[2] = NUGA::FLOAT_MAX;
+        b[3] = b[4] = b[5] = -NUGA::FLOAT_MAX;
+        const E_Int* pgs = fine->PHs.get_facets_ptr(i);
+        for (E_Int j = 0; j < fine->PHs.stride(i); ++j)
+        {
+          E_Int PGi = pgs[j] - 1;
+          const E_Int* nodes = fine->PGs.get_facets_ptr(PGi);
+          for (E_Int n = 0; n < fine->PGs.stride(PGi); ++n)
+          {
+            const E_Float* P = crd.col(nodes[n]-1);
+            for (E_Int k = 0; k < 3; ++k)
+            {
+              b[k] = std::min(b[k], P[k]); b[k+3] = std::max(b[k+3], P[k]);
+            }
+          }
+        }
+      }
+
+      // successive matchings on the aggregate graph
+      ivec_t parent(nb_phs), weights(nb_phs, 1);
+      for (E_Int i = 0; i < nb_phs; ++i) parent[i] = i;
+      E_Int nb_aggs = nb_phs;
+
+      for (E_Int p = 0; p < nb_passes; ++p)
+      {
+        ivec_t agg;
+        E_Int nb = match_cells(xadj, adj, boxes, weights, agg);
+        if (nb == nb_aggs) break;
+
+        for (E_Int i = 0; i < nb_phs; ++i) parent[i] = agg[parent[i]];
+
+        // coarser graph and boxes
+        std::vector<E_Float> cboxes(6*nb);
+        for (E_Int a = 0; a < nb; ++a)
+        {
+          for (E_Int k = 0; k < 3; ++k) { cboxes[6*a+k] = NUGA::FLOAT_MAX; cboxes[6*a+k+3] = -NUGA::FLOAT_MAX; }
+        }
+        std::vector<std::vector<E_Int>> cadj(nb);
+        ivec_t cweights(nb, 0);
+        for (E_Int i = 0; i < nb_aggs; ++i)
+        {
+          E_Int a = agg[i];
+          cweights[a] += weights[i];
+          for (E_Int k = 0; k < 3; ++k)
+          {
+            cboxes[6*a+k] = std::min(cboxes[6*a+k], boxes[6*i+k]);
+            cboxes[6*a+k+3] = std::max(cboxes[6*a+k+3], boxes[6*i+k+3]);
+          }
+          for (E_Int k = xadj[i]; k < xadj[i+1]; ++k)
+            if (agg[adj[k]] != a) cadj[a].push_back(agg[adj[k]]);
+        }
+        xadj.assign(nb+1, 0); adj.clear();
+        for (E_Int a = 0; a < nb; ++a)
+        {
+          std::sort(cadj[a].begin(), cadj[a].end());
+          cadj[a].erase(std::unique(cadj[a].begin(), cadj[a].end()), cadj[a].end());
+          adj.insert(adj.end(), cadj[a].begin(), cadj[a].end());
+          xadj[a+1] = adj.size();
+        }
+        boxes.swap(cboxes);
+        weights.swap(cweights);
+        nb_aggs = nb;
+      }
+
+      if (nb_aggs == nb_phs) break; // no more coarsening
+
+      levels.push_back(ngon_type());
+      agglomerate_phs_by_map(*fine, parent, nb_aggs, levels.back());
+      parents.push_back(parent);
+      fine = &levels.back();
+    }
+  }
+
   ///
   void NUGA::Agglomerator::simplify_phs
   (const K_FLD::FloatArray& crd, const ngon_type& ngi, const ngon_unit& orienti, const ngon_unit& phneighborsi, E_Float angular_max, bool process_externals,
@@ -749,22 +749,12 @@ E_Int
 Conformizer<DIM, Element_t>::__compute_intersections_w_localizer
 (K_FLD::FloatArray& pos, const K_FLD::IntArray& connect, NUGA::bool_vector_type& xc, E_Float tolerance)
 {
-  E_Int i, j, nb_boxes, nb_elts(xc.size()), nbX(0)/*, v1(-1), v2(-1), nbO(0)*/;
-  std::vector<E_Int> bs;
+  E_Int nb_elts(xc.size()), nbX(0)/*, v1(-1), v2(-1), nbO(0)*/;
   E_Int x;
-  std::set<K_MESH::NO_Edge> processed;
   NUGA::bool_vector_type new_xc(xc.size(), false);
   
   typedef typename Struc<Element_t>::Type DS_Type;
   
-#ifdef DEBUG_TRI_CONFORMIZER
-  /*E_Int counter(0);
-  E_Int Ti = TRI_debug::get_T3_index(connect, 17911, 17912, 18156);
-  std::cout << "Ti : " << Ti << std::endl;
-  E_Int Ti2 = TRI_debug::get_T3_index(connect,17882, 17911, 17849);
-  std::cout << "Ti2 : " << Ti2 << std::endl;*/
-#endif
-  
 #ifdef DEBUG_CONFORMIZER
   std::vector<DS_Type> xelts, aelts;
   E_Int iTi=0;
@@ -772,40 +762,63 @@ Conformizer<DIM, Element_t>::__compute_intersections_w_localizer
   E_Int count=0;
 #endif
 
-  //
-  for (i = 0; i < nb_elts; ++i)
-  {
-    if (!xc[i])
-      continue;
+  // 1. Candidate pairs : localizer queries and fast discard run concurrently.
+  // A pair is kept by its first visitor only (the smallest index when both are flagged and both are in the tree)
+  // and the static schedule makes the per-thread lists ordered, so their concatenation gives the sequential order.
+  E_Int nb_in_tree = (_iter == 1 && _X0 > 0) ? _X0 : nb_elts;
+  std::vector<std::vector<std::pair<E_Int, E_Int> > > pairs_thrd(__NUMTHREADS__);
 
-    DS_Type& e1 = _elements[i];
+#pragma omp parallel default(shared)
+  {
+    E_Int id = __CURRENT_THREAD__;
+    std::vector<E_Int> bs;
 
-    // Get surface2's boxes that are overlapping e1.
-    bs.clear();
-    _tree->getOverlappingBoxes(_boxes[i]->minB, _boxes[i]->maxB, bs);
-    nb_boxes = bs.size();
-    // Loop through the caught triangles and do the intersection test.
-    for (j = 0; j < nb_boxes; ++j)
+#pragma omp for schedule(static)
+    for (E_Int i = 0; i < nb_elts; ++i)
     {
-      if (bs[j] == i)
+      if (!xc[i])
         continue;
-      
-      if (!processed.insert(K_MESH::NO_Edge(i, bs[j])).second)
-        continue;
-      
-      DS_Type& e2 = _elements[bs[j]];
+
+      // Get surface2's boxes that are overlapping e1.
+      bs.clear();
+      _tree->getOverlappingBoxes(_boxes[i]->minB, _boxes[i]->maxB, bs);
+
+      for (size_t j = 0; j < bs.size(); ++j)
+      {
+        E_Int k = bs[j];
+        if (k == i)
+          continue;
+        if (k < i && xc[k] && i < nb_in_tree) // already visited from k
+          continue;
+        if (this->__fast_discard_pair(pos, connect, i, k, tolerance))
+          continue;
+
+        pairs_thrd[id].push_back(std::make_pair(i, k));
+      }
+    }
+  }
+
+  // 2. Intersection tests and trace storage : appends nodes and shares edges between elements, so done in order.
+  for (size_t t = 0; t < pairs_thrd.size(); ++t)
+  {
+    const std::vector<std::pair<E_Int, E_Int> >& pairs = pairs_thrd[t];
+    
+    for (size_t p = 0; p < pairs.size(); ++p)
+    {
+      E_Int i = pairs[p].first;
+      E_Int k = pairs[p].second;
+      DS_Type& e1 = _elements[i];
+      DS_Type& e2 = _elements[k];
       
 #ifdef DEBUG_CONFORMIZER
       if (e1.id == zTi)iTi=i;
-      else if (e2.id == zTi)iTi=bs[j];
-      E_Int jj = bs[j];
+      else if (e2.id == zTi)iTi=k;
       
       if (e1.id == zTi)
         aelts.push_back(e2);
       else if (e2.id == zTi)
         aelts.push_back(e1);
       
-      //if ((i == Ti && j == 11) || (i == 82624 && j == 25))
       if (e1.id == zTi || e2.id == zTi)
       {
         std::vector<DS_Type> selec;
@@ -816,36 +829,31 @@ Conformizer<DIM, Element_t>::__compute_intersections_w_localizer
         this->drawElements(o.str().c_str(), "fmt_mesh", pos, connect, selec, false);
       }
       
+      NUGA::ConformizerRoot::xtest_counter++;
 #endif
 
-#ifdef DEBUG_CONFORMIZER
-    NUGA::ConformizerRoot::xtest_counter++;
-#endif
-
-    x = this->__intersect(pos, connect, e1, e2, tolerance); // intersection test and trace storage
+      x = this->__intersect(pos, connect, e1, e2, tolerance); // intersection test and trace storage
 
-    if (x)
-    {
-      ++nbX;
-      new_xc[i] = new_xc[bs[j]] = true;
-      //      v1 = e1.id;
-      //      v2 = e2.id;
+      if (x)
+      {
+        ++nbX;
+        new_xc[i] = new_xc[k] = true;
 
 #ifdef DEBUG_CONFORMIZER
-      if (e1.id == zTi || e2.id == zTi)
-      {
-        if (e1.id != zTi) xelts.push_back(e1);
-        if (e2.id != zTi) xelts.push_back(e2);
-      }
+        if (e1.id == zTi || e2.id == zTi)
+        {
+          if (e1.id != zTi) xelts.push_back(e1);
+          if (e2.id != zTi) xelts.push_back(e2);
+        }
 #endif
 
-      if (x == 2)
-      {
-        if (!_one_pass_mode)_needs_another_iter = true; // overlap might require a second pass as each triangle split is done separtely so triangulation can be different.
-        if (_one_pass_mode && _iter == 1)_xpairs.insert(K_MESH::NO_Edge(i, bs[j]));
+        if (x == 2)
+        {
+          if (!_one_pass_mode)_needs_another_iter = true; // overlap might require a second pass as each triangle split is done separtely so triangulation can be different.
+          if (_one_pass_mode && _iter == 1)_xpairs.insert(K_MESH::NO_Edge(i, k));
+        }
       }
     }
-    }
   }
 
   xc = new_xc;
@@ -131,6 +131,8 @@ public:
   ///
   virtual E_Int __intersect(K_FLD::FloatArray& pos, const K_FLD::IntArray& connect,
                              typename Struc<Element_t>::Type& t1, typename Struc<Element_t>::Type& t2, E_Float tol) = 0;
+  /// Cheap rejection test of the pair (i,j) called concurrently before __intersect : must not modify any member.
+  virtual bool __fast_discard_pair(const K_FLD::FloatArray& pos, const K_FLD::IntArray& connect, E_Int i, E_Int j, E_Float tol) const {return false;}
   ///
   virtual void __update_data(const K_FLD::FloatArray& pos, const K_FLD::IntArray& connect, const std::vector<E_Int>& newIDs) = 0;
   ///
@@ -313,19 +313,14 @@ namespace NUGA
   E_Int NUGA::Splitter::triangulate_pgs
     (const ngon_unit& PGs, const K_FLD::FloatArray& crd, ngon_unit& tri_pgs, Vector_t<E_Int>& oids, const transfo_t& qual_param, const Vector_t<bool>* to_process)
   {
-    tri_pgs.clear();
-    oids.clear();
-
-    // triangulate specified PGs
-    TriangulatorType dt;
-    K_FLD::IntArray connectT3;
-
+    // triangulate specified PGs (in parallel, straight into the CSR buffers)
+    NUGA::tri_batch_t tb;
     bool shuffle = true;//qual_param.improve_qual ? true : false;
     bool imp_qual = qual_param.improve_qual ? true : false;
 
-    E_Int err = ngon_type::triangulate_pgs<TriangulatorType>(PGs, crd, connectT3, oids, shuffle, imp_qual, to_process);
+    E_Int err = NUGA::triangulate_pgs_batch<TriangulatorType>(PGs, crd, to_process, shuffle, imp_qual, tb);
     // convert triangulation to ngon_unit
-    ngon_unit::convert_fixed_stride_to_ngon_unit(connectT3, 1/*shift : convert to 1-based*/, tri_pgs);
+    tb.export_to_ngon_unit(tri_pgs, oids);
     //update history
     if (PGs._ancEs.cols())
     {
@@ -348,56 +343,87 @@ namespace NUGA
     typedef K_FLD::ArrayAccessor<K_FLD::FloatArray> acrd_t;
     acrd_t acrd(crd);
 
-    K_FLD::IntArray connectT3;
-    ngon_unit cvx_pgs;
-    E_Float normal[3];
-    TriangulatorType dt;
-
     oids.clear();
 
     PGs.updateFacets();
 
     E_Int sz = PGs.size(), err(0);
+
+    // triangulate all the non-triangle PGs at once
+    Vector_t<bool> totri(sz, false);
     for (E_Int i = 0; (i<sz); ++i)
-    {
-      if (process && (*process)[i] == false)
-        continue;
+      totri[i] = (!process || (*process)[i]) && (PGs.stride(i) != 3);
 
-      const E_Int* nodes = PGs.get_facets_ptr(i);
-      E_Int nb_nodes = PGs.stride(i);
-      
-      if (nb_nodes == 3) continue;
+    NUGA::tri_batch_t tb;
+    NUGA::triangulate_pgs_batch<TriangulatorType>(PGs, crd, &totri, false, true, tb);
 
-      connectT3.clear();
-      err = K_MESH::Polygon::triangulate(dt, crd, nodes, nb_nodes, 1/*index start*/, connectT3, false, true);
+    // aggregate each triangulation : contiguous blocks per thread so that concatenating them keeps the PG order
+    E_Int nb = tb.size();
+    E_Int nb_chunks = __NUMTHREADS__;
+    std::vector<ngon_unit> cvx_chunks(nb_chunks);
+    std::vector<Vector_t<E_Int>> oid_chunks(nb_chunks);
+    Vector_t<E_Int> errs(nb, 0);
 
-      if (err) //pass this PG as it is
+#pragma omp parallel
+    {
+      E_Int c = __CURRENT_THREAD__;
+      ngon_unit& cvx = cvx_chunks[c];
+      Vector_t<E_Int>& coids = oid_chunks[c];
+
+      K_FLD::IntArray connectT3;
+      ngon_unit cvx_pgs;
+      E_Float normal[3];
+
+#pragma omp for schedule(static)
+      for (E_Int k = 0; k < nb; ++k)
       {
-        convex_pgs.add(nb_nodes, nodes);
-        oids.push_back(i);
-        continue;
-      }
+        E_Int i = tb.pgids[k];
+        const E_Int* nodes = PGs.get_facets_ptr(i);
+        E_Int nb_nodes = PGs.stride(i);
 
-      K_MESH::Polygon::normal<acrd_t, 3>(acrd, nodes, nb_nodes, 1, normal);
+        if (tb.errs[k]) //pass this PG as it is
+        {
+          errs[k] = tb.errs[k];
+          cvx.add(nb_nodes, nodes);
+          coids.push_back(i);
+          continue;
+        }
 
-      cvx_pgs.clear();
-      err = NUGA::MeshTool::aggregate_convex(crd, connectT3, normal, cvx_pgs, params.convexity_tol);
+        E_Int nt = tb.xtri[k + 1] - tb.xtri[k];
+        connectT3.clear();
+        connectT3.resize(3, nt);
+        std::copy(&tb.tris[3 * tb.xtri[k]], &tb.tris[3 * tb.xtri[k + 1]], connectT3.begin());
 
-      if (!err)
-      {
-        convex_pgs.append(cvx_pgs);
-        oids.resize(convex_pgs.size(), i);
-      }
-      else
-      {
-        //std::cout << "WARNING : failed on aggregate_convex for polygon : " << i << std::endl;
-        ngon_unit& ngu = cvx_pgs;
-        ngon_unit::convert_fixed_stride_to_ngon_unit(connectT3, 1, ngu);
-        convex_pgs.append(ngu);
-        oids.resize(convex_pgs.size(), i);
+        K_MESH::Polygon::normal<acrd_t, 3>(acrd, nodes, nb_nodes, 1, normal);
+
+        cvx_pgs.clear();
+        errs[k] = NUGA::MeshTool::aggregate_convex(crd, connectT3, normal, cvx_pgs, params.convexity_tol);
+
+        if (!errs[k])
+        {
+          cvx.append(cvx_pgs);
+          coids.resize(cvx.size(), i);
+        }
+        else
+        {
+          //std::cout << "WARNING : failed on aggregate_convex for polygon : " << i << std::endl;
+          ngon_unit& ngu = cvx_pgs;
+          ngon_unit::convert_fixed_stride_to_ngon_unit(connectT3, 1, ngu);
+          cvx.append(ngu);
+          coids.resize(cvx.size(), i);
+        }
       }
     }
 
+    for (E_Int c = 0; c < nb_chunks; ++c)
+    {
+      convex_pgs.append(cvx_chunks[c]);
+      oids.insert(oids.end(), ALL(oid_chunks[c]));
+    }
+
+    // as in the serial loop, the returned error is the one of the last processed PG
+    if (nb) err = errs[nb - 1];
+
     convex_pgs.spread_attributes(PGs, oids);
 
     return err;
@@ -66,8 +66,6 @@ namespace NUGA
 template<short DIM>
 TRI_Conformizer<DIM>::TRI_Conformizer(bool wnh) : Conformizer<DIM, K_MESH::Triangle>(wnh)
 {
-  _P.resize(3,3);
-  _iP.resize(3,3);
   parent_type::_tolerance = 0.;
   parent_type::_iter = 0;
 }
@@ -128,340 +126,91 @@ TRI_Conformizer<DIM>::__split_Elements
   colors.clear();
   xr.resize(connect.cols()+1, 0);
 
-  DELAUNAY::MeshData data;
   DELAUNAY::MesherMode mode;
   mode.mesh_mode = mode.TRIANGULATION_MODE;
   mode.remove_holes = false;  // option to speed up.
   mode.ignore_coincident_nodes = true;
   
-  DELAUNAY::T3Mesher<E_Float> mesher(mode);
-  
-  NUGA::int_vector_type gnids, lnids;
+  NUGA::int_vector_type gnids;
   if (mode.ignore_coincident_nodes) K_CONNECT::IdTool::init_inc(gnids, pos.cols());
   
-#ifdef DEBUG_TRI_CONFORMIZER
-  int err_count(0);
-#endif
-#ifdef DEBUG_EXTRACT
-  std::ostringstream xfname;
-  xfname << /*MIO::wdir*/"./" << "_extract_boxes.txt" ;
-  std::ofstream extract_file (xfname.str().c_str());
-#endif
-
 #ifdef FLAG_STEP
   NUGA::chrono c;
+  c.start();
 #endif
   
 #ifdef DEBUG_TRI_CONFORMIZER
   drawT3(pos, connect, zTi, true);
 #endif
 
-  K_FLD::IntArray ci, ci2;
-  K_FLD::FloatArray pi;
-  std::set<K_MESH::Edge> sci;
-  std::vector<E_Int> revIDs;
-
-  NUGA::int_vector_type hnodes;
-  E_Int x[2], err;
-  E_Int ret;
-  // for swapping
-  K_MESH::NO_Edge E;
-  std::set<K_MESH::NO_Edge> origE;
-  std::vector<std::pair<E_Int, E_Int> > swapE;
+  // Elements are triangulated by chunks : each element is processed independently (thread-local mesher
+  // seeded with the element index) and the results are appended in element order, so the output
+  // does not depend on the number of threads.
+  E_Int nb_elts = connectIn.cols();
+  E_Int chunk = 1024 * __NUMTHREADS__;
+  std::vector<split_t> splits(std::min(nb_elts, chunk));
 
-  for (E_Int i = 0; i < connectIn.cols(); ++i)
+  for (E_Int c0 = 0; c0 < nb_elts; c0 += chunk)
   {
-    pS = connectIn.col(i);
-    xr[i] = connectOut.cols();
-    T3& tri = parent_type::_elements[i];
+    E_Int c1 = std::min(nb_elts, c0 + chunk);
 
-#ifdef DEBUG_TRI_CONFORMIZER
-//    if (ancestors[i] == zTi)
-//      drawT3(pos, connect, i);
-#endif
-    
-#ifdef FLAG_STEP
-    c.start();  
-#endif
-
-#ifdef OLD_STYLE
-    ret = __get_connectB2(pos, connectIn, tri, _edges, sci, hnodes);
-#else
-    ret = __get_mesh_data(pos, connectIn, tri, _edges, pi, ci2, revIDs);
-#endif
-
-#ifdef FLAG_STEP
-    tcon += c.elapsed();
-    c.start();  
-#endif
-
-#ifdef OLD_STYLE
-    if ((ret == 2) || ((ret == 0) && (sci.size() == 3) && hnodes.size() == 3)) // new nodes/edges are matching exactly the initial triangle.
-#else
-    if (ret == 2)
-#endif
+#pragma omp parallel default(shared)
     {
-      connectOut.pushBack(pS, pS+3);
-      ancOut.push_back(ancestors[i]);
-      xcOut.push_back(false);
-      colors.push_back(Ci++);
-      
-#ifdef DEBUG_CONFORMIZER
-      NUGA::ConformizerRoot::split_fastdiscard_counter++;
-#endif
+      split_ws_t ws(mode);
 
-#ifdef FLAG_STEP
-      tnot += c.elapsed();
-#endif
-    }
-    else if (ret == 1) // degenerated
-    {
-#ifdef DEBUG_TRI_CONFORMIZER
-      //drawT3(pos, connectIn, i);
-      NUGA::ConformizerRoot::degen_counter++;    
-//      {
-//          K_FLD::FloatArray coord1(pos);
-//          K_FLD::IntArray tmp;
-//          tmp.pushBack(connectIn.col(i), connectIn.col(i)+3);
-//          std::vector<E_Int> newIDs;
-//          DELAUNAY::MeshTool::compact_to_mesh(coord1, tmp, newIDs);   
-//          std::ostringstream o;
-//          o << "TRI_degen_compact_" <<parent_type::_iter << "_" << i << ".mesh";
-//          medith::write(o.str().c_str(), coord1, tmp, "TRI");
-//        }
-#endif
-      //return ret;
+#pragma omp for schedule(dynamic)
+      for (E_Int i = c0; i < c1; ++i)
+        splits[i-c0].err = __split_Element(i, pos, connectIn, ws, splits[i-c0]);
     }
-    else // need a split.
-    {
-#ifdef DEBUG_TRI_CONFORMIZER
-      
-      NUGA::ConformizerRoot::split_counter++;
-      
-      //if (parent_type::_iter == 10)
-        //drawT3(pos, connect, tri.Si);
-#endif
 
-#ifdef OLD_STYLE
-#ifdef FLAG_STEP
-      c.start();  
-#endif
-      ci.clear();
+    for (E_Int i = c0; i < c1; ++i)
+    {
+      split_t& s = splits[i-c0];
+      pS = connectIn.col(i);
+      xr[i] = connectOut.cols();
 
-      // connectivity.
-      for (std::set<K_MESH::Edge>::iterator it = sci.begin(); it != sci.end(); ++it)
+      if (s.err != 0)
       {
-        x[0] = (*it).node(0);
-        x[1] = (*it).node(1);
-        if (x[0] == x[1]) continue;
-        ci.pushBack(x, x+2);
-      }
-      
-#ifdef DEBUG_TRI_CONFORMIZER
-    //if (ancestors[i]==401)//parent_type::_iter == 10 || xtest
-      //medith::write("conto.mesh", pos, ci, "BAR");
-#endif
-
-      // coordinates
-      // compact
-      if (hnodes.empty())
-        __compact_to_mesh(pos, ci, pi, ci2, revIDs);
-      else
-        __compact_to_mesh(pos, ci, pi, ci2, revIDs, &hnodes);
-      
 #ifdef DEBUG_TRI_CONFORMIZER
-    //if (ancestors[i]==401) //parent_type::_iter == 10 || xtest
-    //{
-    //  medith::write("contoci.mesh", pi, ci2, "BAR");
-    //  std::cout << "hard nodes ? " << hnodes.size() << std::endl;
-    //}
-#endif
-
-#ifdef FLAG_STEP
-      tcomp += c.elapsed();
-      c.start();
-#endif
-
-      // transform (in the coord. sys of the triangle)
-      __transform(pos.col(*pS), pos.col(*(pS+1)), pos.col(*(pS+2)), pi);
-      pi.resize(2, pi.cols());
-
-#ifdef FLAG_STEP
-      ttra += c.elapsed();
-      c.start();
+        drawT3(pos, connectIn, i, true);
 #endif
+        return s.err;
+      }
 
-#endif
-#ifdef DEBUG_MESHER
-      //if (ancestors[i]==1167)//parent_type::_iter == 10 || xtest
-        //medith::write("contot.mesh", pi, ci2, "BAR");
-#endif
-      // Now mesh
-      data.clear(); //reset containers
-      data.pos = &pi;
-      data.connectB = &ci2;
-#ifdef OLD_STYLE
-      data.hardNodes = hnodes;
-#endif
-      
-#ifdef DEBUG_TRI_CONFORMIZER
-#ifdef DEBUG_MESHER
-      mesher.dbg_flag=false;
-      //if (/*parent_type::_iter == 10 || xtest*/ancestors[i]==Ti) DBG_MESHER_FLAG = 1;
-      //if (i==59259) mesher.dbg_flag=true;
-      /*if (i==59259 || i == 59281)
-        {
-        std::ostringstream o;
-        o << "contot_" << i << ".mesh";
-        medith::write(o.str().c_str(), pi, ci2, "toto");
-        //continue;
-      }*/
-#endif
-#endif
-      // iterative for robustness : try shuffling the input data, then try without forcing edges (hasardous)
-      mesher.seed_random(3*i);
-      err = __iterative_run (mesher, pi, ci2, hnodes, data, lnids, false/*i.e. try to force all edge*/, true/*i.e silent also last it*/);
-      if (err != 0)
+      if (s.ret == 2) // new nodes/edges are matching exactly the initial triangle.
       {
-        //try again with a normalized contour
-        K_SEARCH::BBox2D box;
-        box.compute(pi);
-        double dX = box.maxB[0] - box.minB[0];
-        double dY = box.maxB[1] - box.minB[1];
-
-        /*{
-          K_FLD::FloatArray tmp(pi);
-          tmp.resize(3, tmp.cols(), 0.);
-          medith::write("contour_init.mesh", tmp, ci2, "BAR");
-        }*/
-
-        for (int u = 0; u < pi.cols(); ++u)
-        {
-          pi(0, u) = (pi(0, u) - box.minB[0]) / dX;
-          pi(1, u) = (pi(1, u) - box.minB[1]) / dY;
-        }
-
-        /*{
-          K_FLD::FloatArray tmp(pi);
-          tmp.resize(3, tmp.cols(), 0.);
-          medith::write("contour_norma.mesh", tmp, ci2, "BAR");
-        }*/
+        connectOut.pushBack(pS, pS+3);
+        ancOut.push_back(ancestors[i]);
+        xcOut.push_back(false);
+        colors.push_back(Ci++);
 
-        err = __iterative_run(mesher, pi, ci2, hnodes, data, lnids, false/*i.e. try to force all edge*/, true/*i.e silent also last it*/);
-        //if (err == 0)
-        //  std::cout << " found " << std::endl;
+#ifdef DEBUG_CONFORMIZER
+        NUGA::ConformizerRoot::split_fastdiscard_counter++;
+#endif
       }
-      if (err != 0)
-        err = __iterative_run(mesher, pi, ci2, hnodes, data, lnids, true/*i.e. ignore unforceable edges*/, mode.silent_errors/*i.e output last it error eventually*/);
-      
-      if (err != 0)
+      else if (s.ret == 1) // degenerated
       {
-#ifdef DEBUG_LIGHT
-        std::ostringstream o;
-        o << "TRIConformizer_err_" << i << ".mesh";
-        medith::write(o.str().c_str(), pi, ci2, "BAR");
-        o.str("");
-        K_FLD::FloatArray coord1(pos);
-        std::vector<E_Int> newIDs;
-        NUGA::MeshTool::compact_to_mesh(coord1, ci2, newIDs);
-        o << "TRIConformizer_err3D_" << i << ".mesh";
-        medith::write(o.str().c_str(), coord1, ci2, "BAR");
-#endif
-        
 #ifdef DEBUG_TRI_CONFORMIZER
-        drawT3(pos, connectIn, i, true);
-#endif
-        {
-#if (defined DEBUG_TRI_CONFORMIZER) || (defined DEBUG_EXTRACT)
-          K_FLD::FloatArray coord1(pos);
-          std::vector<E_Int> newIDs;
-          NUGA::MeshTool::compact_to_mesh(coord1, ci, newIDs);
+        NUGA::ConformizerRoot::degen_counter++;
 #endif
-#ifdef DEBUG_TRI_CONFORMIZER
-          {
-            std::ostringstream o;
-            o << "TRI_mesher_err_compact_" <<parent_type::_iter << "_" <<  i << ".mesh";
-            medith::write(o.str().c_str(), coord1, ci, "BAR");
-          }
-#endif
-#ifdef DEBUG_EXTRACT
-          K_SEARCH::BBox3D box;
-          box.compute(K_FLD::ArrayAccessor<K_FLD::FloatArray >(coord1));
-
-          extract_file << "boxes.push_back(K_SEARCH::BBox3D());" << std::endl;
-          extract_file << "boxes[boxes.size()-1].minB[0]=" << box.minB[0] << ";"<< std::endl;
-          extract_file << "boxes[boxes.size()-1].minB[1]=" << box.minB[1] << ";"<< std::endl;
-          extract_file << "boxes[boxes.size()-1].minB[2]=" << box.minB[2] << ";"<< std::endl;
-          extract_file << "boxes[boxes.size()-1].maxB[0]=" << box.maxB[0] << ";"<< std::endl;
-          extract_file << "boxes[boxes.size()-1].maxB[1]=" << box.maxB[1] << ";"<< std::endl;
-          extract_file << "boxes[boxes.size()-1].maxB[2]=" << box.maxB[2] << ";"<< std::endl << std::endl;
-#endif
-        }
-#ifdef DEBUG_TRI_CONFORMIZER
-        medith::write("contot.mesh", pi, ci2, "BAR");
-        ++err_count;
-#endif
-
-#ifdef DEBUG_EXTRACT
-        std::cout << "extract box for " << i << std::endl;
-        continue;
-#else
-        return err;
-#endif  
       }
-
-#ifdef FLAG_STEP
-      trun += c.elapsed();
-#endif
-
-#ifdef DEBUG_TRI_CONFORMIZER
-      if (i == zTi)
+      else
       {
-        K_FLD::FloatArray c(*data.pos);
-        c.resize(3, data.pos->cols(), 0.);
-        medith::write("mesh0.mesh", c, data.connectM, "TRI");
-      }
-#endif   
-   
-      // Do some swapping to avoid degen T3s
-      __improve_triangulation_quality(tri, revIDs, swapE, origE, data);
-      
 #ifdef DEBUG_TRI_CONFORMIZER
-      if (i == zTi)
-      {
-        K_FLD::FloatArray c(*data.pos);
-        c.resize(3, data.pos->cols(), 0.);
-        medith::write("meshSwap.mesh", c, data.connectM, "TRI");
+        NUGA::ConformizerRoot::split_counter++;
+#endif
+        // replay the coincident nodes moves in element order (we used gnids in the rhs to propagate the moves)
+        for (size_t n = 0; n < s.moves.size(); ++n)
+          gnids[s.moves[n].first] = gnids[s.moves[n].second];
+
+        // Append upon exit.
+        connectOut.pushBack(s.cnt);
+        ancOut.resize(ancOut.size() + s.cnt.cols(), ancestors[i]);
+        xcOut.resize(xcOut.size() + s.cnt.cols(), true);
+        for (E_Int j = 0; j < s.cnt.cols(); ++j)
+          colors.push_back(s.colors[j] + Ci);
+        Ci += 1 + *std::max_element(s.colors.begin(), s.colors.end());
       }
-#endif  
-     
-      // Get back to initial ids
-      K_FLD::IntArray::changeIndices(data.connectM, revIDs);
-      
-      if (mode.ignore_coincident_nodes && data.unsync_nodes)
-      {
-        for (size_t n = 0; n < lnids.size(); ++n)
-        {
-          if ((size_t)lnids[n] != n) gnids[revIDs[n]] = gnids[revIDs[lnids[n]]]; //we used gnids in the rhs to propagate the moves
-        }
-      }
-
-      // Append upon exit.
-      connectOut.pushBack(data.connectM);
-      ancOut.resize(ancOut.size() + data.connectM.cols(), ancestors[i]);
-      xcOut.resize(xcOut.size() + data.connectM.cols(), true);
-      for (E_Int j = 0; j < data.connectM.cols(); ++j)
-        colors.push_back(data.colors[j] + Ci);
-      Ci += 1 + *std::max_element(data.colors.begin(), data.colors.end());
-      
-//#ifdef DEBUG_CONFORMIZER
-//      if (detect_duplis_and_baffles(connectOut))
-//      {
-//        std::cout << "oddities : after Mesher : FOUND !!!! for element " << tri.Si << std::endl;
-//        return 1;
-//      }
-//#endif
-      
     }
   }
   
@@ -474,52 +223,127 @@ TRI_Conformizer<DIM>::__split_Elements
   ancestors = ancOut;
   xc = xcOut;
   
-#ifdef DEBUG_EXTRACT
-  extract_file.close();
+#ifdef FLAG_STEP
+  std::cout << "split : " << c.elapsed() << std::endl;
+#ifdef DEBUG_CONFORMIZER
+  std::cout << "split : nb of quicly discarded : " << NUGA::ConformizerRoot::split_fastdiscard_counter << std::endl;
+  std::cout << "split : nb of done : " << NUGA::ConformizerRoot::split_counter << std::endl;
+  std::cout << "split : nb of degen discarded : " << NUGA::ConformizerRoot::degen_counter << std::endl;
+  std::cout << "split : nb of resulting bits in more : " << connect.cols() - connectIn.cols() << std::endl;
+#endif
 #endif
   
-#ifdef DEBUG_TRI_CONFORMIZER
-#ifdef FLAG_STEP
-  //if (NUGA::chrono::verbose > 1)
+  return 0;
+}
+
+///
+template <short DIM>
+E_Int
+TRI_Conformizer<DIM>::__split_Element
+(E_Int i, const K_FLD::FloatArray& pos, const K_FLD::IntArray& connect, split_ws_t& ws, split_t& s)
+{
+  s.cnt.clear();
+  s.colors.clear();
+  s.moves.clear();
+
+  const T3& tri = parent_type::_elements[i];
+  DELAUNAY::MeshData& data = ws.data;
+  K_FLD::FloatArray& pi = ws.pi;
+  K_FLD::IntArray& ci = ws.ci;
+  K_FLD::IntArray& ci2 = ws.ci2;
+
+#ifdef OLD_STYLE
+  s.ret = __get_connectB2(pos, connect, tri, _edges, ws.sci, ws.hnodes);
+  if ((s.ret == 0) && (ws.sci.size() == 3) && ws.hnodes.size() == 3) s.ret = 2; // new nodes/edges are matching exactly the initial triangle.
+#else
+  s.ret = __get_mesh_data(pos, connect, tri, _edges, pi, ci2, ws.revIDs);
+#endif
+
+  if (s.ret != 0) return 0; // untouched or degenerated
+
+#ifdef OLD_STYLE
+  ci.clear();
+
+  // connectivity.
+  E_Int x[2];
+  for (std::set<K_MESH::Edge>::iterator it = ws.sci.begin(); it != ws.sci.end(); ++it)
   {
-#ifdef DEBUG_CONFORMIZER
-    std::cout << "split : nb of quicly discarded : " << NUGA::ConformizerRoot::split_fastdiscard_counter << std::endl;
-    std::cout << "split : nb of done : " << NUGA::ConformizerRoot::split_counter << std::endl;
-    std::cout << "split : nb of degen discarded : " << NUGA::ConformizerRoot::degen_counter << std::endl;
+    x[0] = (*it).node(0);
+    x[1] = (*it).node(1);
+    if (x[0] == x[1]) continue;
+    ci.pushBack(x, x+2);
+  }
 
-    std::cout << "split : nb of resulting bits in more : " << connect.cols() - connectIn.cols() << std::endl;
-    std::cout << "split : NB ERRORS : " << err_count << std::endl;
+  // coordinates
+  // compact
+  if (ws.hnodes.empty())
+    __compact_to_mesh(pos, ci, pi, ci2, ws.revIDs);
+  else
+    __compact_to_mesh(pos, ci, pi, ci2, ws.revIDs, &ws.hnodes);
+
+  // transform (in the coord. sys of the triangle)
+  K_FLD::IntArray::const_iterator pS = connect.col(i);
+  __transform(pos.col(*pS), pos.col(*(pS+1)), pos.col(*(pS+2)), pi);
+  pi.resize(2, pi.cols());
 #endif
-    std::cout << "TIMES : "<< std::endl;
-    std::cout << "false X : " << tnot << std::endl;
-    std::cout << "prepare contour : " << tcon << std::endl;
-//    std::cout << "pepare contour (form 0) : " << tcon0 << std::endl;
-//    std::cout << "pepare contour (form 1) : " << tcon1<< std::endl;
-//    std::cout << "pepare contour (form 2) : " << tcon2 << std::endl;
-//    std::cout << "pepare contour (compact) : " << tcomp << std::endl;
-//    std::cout << "pepare contour (transform) : " << ttra << std::endl;
-#ifdef E_TIME
-    typedef DELAUNAY::Mesher<E_Float, DELAUNAY::VarMetric<E_Float> > mesher_t;
-    typedef DELAUNAY::Kernel<E_Float> kernel_t;
-    std::cout << "mesher : init                           : " << mesher_t::tinit << std::endl;
-    std::cout << "mesher : tria : cav time                : " << kernel_t::cavity_time << std::endl;
-    std::cout << "mesher : tria :     init cav time       : " << kernel_t::init_cavity_time << std::endl;
-    std::cout << "mesher : tria :             base time   : " << kernel_t::base_time << std::endl;
-    std::cout << "mesher : tria :             append time : " << kernel_t::append_time << std::endl;
-    std::cout << "mesher : tria :     fix cav time        : " << kernel_t::fix_cavity_time << std::endl;
-    std::cout << "mesher : tria :     sort bound time     : " << kernel_t::sorting_bound_time << std::endl;
-    std::cout << "mesher : tria : remesh cavity           : " << kernel_t::remesh_time << std::endl;
-    std::cout << "mesher : tria : invalidate prev elts    : " << kernel_t::inval_time << std::endl;
-    std::cout << "mesher : tria : TOTAL                   : " << mesher_t::ttria << std::endl;
-    std::cout << "mesher : restore boundaries             : " << mesher_t::tbound << std::endl;
-    std::cout << "mesher : set colors                     : " << mesher_t::tcolors << std::endl;
-    std::cout << "mesher : finalize                       : " << mesher_t::tfinalize << std::endl;
-    std::cout << "mesher : TOTAL                          : " << trun << std::endl;
+
+  // Now mesh
+  data.clear(); //reset containers
+  data.pos = &pi;
+  data.connectB = &ci2;
+#ifdef OLD_STYLE
+  data.hardNodes = ws.hnodes;
 #endif
+
+  // iterative for robustness : try shuffling the input data, then try without forcing edges (hasardous)
+  ws.mesher.seed_random(3*i);
+  E_Int err = __iterative_run (ws.mesher, pi, ci2, ws.hnodes, data, ws.lnids, false/*i.e. try to force all edge*/, true/*i.e silent also last it*/);
+  if (err != 0)
+  {
+    //try again with a normalized contour
+    K_SEARCH::BBox2D box;
+    box.compute(pi);
+    double dX = box.maxB[0] - box.minB[0];
+    double dY = box.maxB[1] - box.minB[1];
+
+    for (int u = 0; u < pi.cols(); ++u)
+    {
+      pi(0, u) = (pi(0, u) - box.minB[0]) / dX;
+      pi(1, u) = (pi(1, u) - box.minB[1]) / dY;
+    }
+
+    err = __iterative_run(ws.mesher, pi, ci2, ws.hnodes, data, ws.lnids, false/*i.e. try to force all edge*/, true/*i.e silent also last it*/);
   }
+  if (err != 0)
+    err = __iterative_run(ws.mesher, pi, ci2, ws.hnodes, data, ws.lnids, true/*i.e. ignore unforceable edges*/, ws.silent_errors/*i.e output last it error eventually*/);
+
+  if (err != 0)
+  {
+#ifdef DEBUG_LIGHT
+    std::ostringstream o;
+    o << "TRIConformizer_err_" << i << ".mesh";
+    medith::write(o.str().c_str(), pi, ci2, "BAR");
 #endif
-#endif
-  
+    return err;
+  }
+
+  // Do some swapping to avoid degen T3s
+  __improve_triangulation_quality(tri, ws.revIDs, ws.swapE, ws.origE, data);
+
+  // Get back to initial ids
+  K_FLD::IntArray::changeIndices(data.connectM, ws.revIDs);
+
+  if (ws.mesher.mode.ignore_coincident_nodes && data.unsync_nodes)
+  {
+    for (size_t n = 0; n < ws.lnids.size(); ++n)
+    {
+      if ((size_t)ws.lnids[n] != n) s.moves.push_back(std::make_pair(ws.revIDs[n], ws.revIDs[ws.lnids[n]]));
+    }
+  }
+
+  s.cnt = data.connectM;
+  s.colors = data.colors;
+
   return 0;
 }
 
@@ -962,8 +786,9 @@ inline bool getBoundary(const E_Int* t0, const E_Int* t1, E_Int& i, E_Int& j)
 template <short DIM>
 bool
 TRI_Conformizer<DIM>::__fast_discard
-(const K_FLD::FloatArray& pos, const E_Int* T0, const E_Int* T1, E_Float tol)
+(const K_FLD::FloatArray& pos, const E_Int* T0, const E_Int* T1, E_Float tol) const
 {
+  E_Float U1[3], U2[3], U3[3];
   
   const E_Float* P0 = pos.col(T1[0]);
   const E_Float* P1 = pos.col(T1[1]);
@@ -974,23 +799,23 @@ TRI_Conformizer<DIM>::__fast_discard
   
   // 1. Check if points are on the same side of the t's plane
   
-  NUGA::diff<DIM>(P1, P0, _U1);
-  NUGA::diff<DIM>(P2, P0, _U2);
-  NUGA::crossProduct<DIM>(_U1,_U2,_U3);
-  NUGA::normalize<DIM>(_U3);
+  NUGA::diff<DIM>(P1, P0, U1);
+  NUGA::diff<DIM>(P2, P0, U2);
+  NUGA::crossProduct<DIM>(U1,U2,U3);
+  NUGA::normalize<DIM>(U3);
         
   bool is_far[] = {false,false, false};
   E_Float h0(0.), h1(0.), h2(0.);
-  NUGA::diff<DIM>(Q0, P0, _U1);
-  h0 = NUGA::dot<DIM>(_U3, _U1);
+  NUGA::diff<DIM>(Q0, P0, U1);
+  h0 = NUGA::dot<DIM>(U3, U1);
   is_far[0] = (h0 >= tol) || (h0 <= -tol);
     
-  NUGA::diff<DIM>(Q1, P0, _U1);
-  h1 = NUGA::dot<DIM>(_U3, _U1);
+  NUGA::diff<DIM>(Q1, P0, U1);
+  h1 = NUGA::dot<DIM>(U3, U1);
   is_far[1] = (h1 >= tol) || (h1 <= -tol);
     
-  NUGA::diff<DIM>(Q2, P0, _U1);
-  h2 = NUGA::dot<DIM>(_U3, _U1);
+  NUGA::diff<DIM>(Q2, P0, U1);
+  h2 = NUGA::dot<DIM>(U3, U1);
   is_far[2] = (h2 >= tol) || (h2 <= -tol);
     
   E_Int s[3];
@@ -1039,36 +864,36 @@ TRI_Conformizer<DIM>::__fast_discard
 //        Pplane=pos.col(T0[(shn+2)%3]);
 //      else if (s[(shn+1)%3] == -s[(shn+2)%3])
 //      {
-//        // Compute X between Line E0E1 and Plane (Shared, n)== (T0[shn], _U3)
+//        // Compute X between Line E0E1 and Plane (Shared, n)== (T0[shn], U3)
 //        const E_Float* E0=pos.col(T0[(shn+1)%3]);
 //        const E_Float* E1=pos.col(T0[(shn+2)%3]);
-//        NUGA::diff<DIM>(E1, E0, _U1); // Line
-//        NUGA::diff<DIM>(pos.col(T0[shn]), E0, _U2); // vector : shared node to one edge vertex
+//        NUGA::diff<DIM>(E1, E0, U1); // Line
+//        NUGA::diff<DIM>(pos.col(T0[shn]), E0, U2); // vector : shared node to one edge vertex
 //        
-//        E_Float s=NUGA::dot<DIM>(_U3, _U1);
+//        E_Float s=NUGA::dot<DIM>(U3, U1);
 //        if (SIGN(s)==0)
 //          return false;
 //        s=1./s;
-//        s*=NUGA::dot<DIM>(_U3, _U2);
+//        s*=NUGA::dot<DIM>(U3, U2);
 //        
-//        NUGA::sum<3>(s, _U1, E0, tmp);
+//        NUGA::sum<3>(s, U1, E0, tmp);
 //        Pplane=&tmp[0];
 //      }
 //      
 //      if (Pplane == 0)
 //        return false;
 //      
-//      NUGA::diff<DIM>(pos.col(T1[(shn1+1)%3]), pos.col(T1[shn1]), _U1);
-//      NUGA::diff<DIM>(Pplane, pos.col(T1[shn1]), _U2);
-//      NUGA::crossProduct<DIM>(_U1,_U2,_U3);
+//      NUGA::diff<DIM>(pos.col(T1[(shn1+1)%3]), pos.col(T1[shn1]), U1);
+//      NUGA::diff<DIM>(Pplane, pos.col(T1[shn1]), U2);
+//      NUGA::crossProduct<DIM>(U1,U2,U3);
 //      
-//      if (SIGN(_U3[0]) == -1)
+//      if (SIGN(U3[0]) == -1)
 //        return true;
 //      
-//      NUGA::diff<DIM>(pos.col(T1[(shn1+2)%3]), pos.col(T1[shn1]), _U1);
-//      NUGA::crossProduct<DIM>(_U2,_U1,_U3);
+//      NUGA::diff<DIM>(pos.col(T1[(shn1+2)%3]), pos.col(T1[shn1]), U1);
+//      NUGA::crossProduct<DIM>(U2,U1,U3);
 //      
-//      if (SIGN(_U3[0]) == -1)
+//      if (SIGN(U3[0]) == -1)
 //        return true;  
     }
   }
@@ -1101,6 +926,16 @@ TRI_Conformizer<DIM>::__fast_discard
   return false;
 }
 
+///
+template <short DIM>
+bool
+TRI_Conformizer<DIM>::__fast_discard_pair
+(const K_FLD::FloatArray& pos, const K_FLD::IntArray& connect, E_Int i, E_Int j, E_Float tol) const
+{
+  // same tests (and order) as at the beginning of __intersect
+  return __fast_discard(pos, connect.col(j), connect.col(i), tol) || __fast_discard(pos, connect.col(i), connect.col(j), tol);
+}
+
 ///
 template <short DIM>
 E_Bool
@@ -1440,7 +1275,7 @@ E_Int
 TRI_Conformizer<DIM>::__get_connectB2
 (const K_FLD::FloatArray & pos,
  const K_FLD::IntArray & connect,
- const T3& t, edge_container_type& Edges,
+ const T3& t, const edge_container_type& Edges,
  std::set<K_MESH::Edge>& hBO, std::vector<E_Int>& hNodes)
 {
   size_t nb_edges = t.edges.size();
@@ -1453,7 +1288,7 @@ TRI_Conformizer<DIM>::__get_connectB2
 
   hNodes.clear();
   hBO.clear();
-  _wnodes_set.clear();
+  std::set<E_Int> wnodes; // local : called concurrently from __split_Element
 
 #ifdef FLAG_STEP
   NUGA::chrono c;
@@ -1461,7 +1296,7 @@ TRI_Conformizer<DIM>::__get_connectB2
 #endif
 
   // Contour edges.
-  bool degenerated = __get_B0_edges(connect, t, Edges, hBO, _wnodes_set);
+  bool degenerated = __get_B0_edges(connect, t, Edges, hBO, wnodes);
 
 #ifdef FLAG_STEP
   tcon0 += c.elapsed();
@@ -1472,7 +1307,7 @@ TRI_Conformizer<DIM>::__get_connectB2
     return 1;
 
   // Overlapping edges (add only edges bits that are inside the triangle).
-  __get_Inner_edges(pos, connect, t, Edges, hBO, _wnodes_set);
+  __get_Inner_edges(pos, connect, t, Edges, hBO, wnodes);
 
 #ifdef FLAG_STEP
   tcon1 += c.elapsed();
@@ -1480,14 +1315,14 @@ TRI_Conformizer<DIM>::__get_connectB2
 #endif
 
   // Imprinted edges.
-  __get_Imprint_edges(t, hBO, _wnodes_set);
+  __get_Imprint_edges(t, hBO, wnodes);
 
 #ifdef FLAG_STEP
   tcon2 += c.elapsed();
   c.start();
 #endif
 
-  for (std::set<E_Int>::const_iterator it = _wnodes_set.begin(); it != _wnodes_set.end(); ++it)
+  for (std::set<E_Int>::const_iterator it = wnodes.begin(); it != wnodes.end(); ++it)
     hNodes.push_back(*it);
 
   return 0;
@@ -1498,10 +1333,11 @@ template <short DIM>
 inline bool
 TRI_Conformizer<DIM>::__get_B0_edges
 (const K_FLD::IntArray & connect,
- const T3& t, edge_container_type& Edges,
+ const T3& t, const edge_container_type& Edges,
  std::set<K_MESH::Edge>& hBO, std::set<E_Int>& Nodes0)
 {
   E_Int             n, start, sz0, end, s;
+  std::vector<E_Int> rEi; // reversed copy : Edges are shared between elements and must not be modified here
   E_Bool            same_orient(false);
   size_t            e, NB_BOUND(3);
   K_MESH::Triangle  tri(connect.col(t.id));
@@ -1510,29 +1346,33 @@ TRI_Conformizer<DIM>::__get_B0_edges
   
   for (e = 0; e < NB_BOUND; ++e)
   {
-    std::vector<E_Int>& Ei = Edges[t.edges[e]];
+    const std::vector<E_Int>* pEi = &Edges[t.edges[e]];
+    const std::vector<E_Int>& Ei0 = *pEi;
 
     start = 0;
-    sz0 = Ei.size();
+    sz0 = Ei0.size();
     end = sz0-1;
 
-    while ((start < end) && (Ei[start] != tri.node(0) && Ei[start] != tri.node(1) && Ei[start] != tri.node(2)))++start;
-    while ((end > start) && (Ei[end] != tri.node(0) && Ei[end] != tri.node(1) && Ei[end] != tri.node(2)))--end;
+    while ((start < end) && (Ei0[start] != tri.node(0) && Ei0[start] != tri.node(1) && Ei0[start] != tri.node(2)))++start;
+    while ((end > start) && (Ei0[end] != tri.node(0) && Ei0[end] != tri.node(1) && Ei0[end] != tri.node(2)))--end;
 
-    E_Int & N0 = Ei[start];
-    E_Int & N1 = Ei[end];
+    const E_Int & N0 = Ei0[start];
+    const E_Int & N1 = Ei0[end];
 
     K_MESH::Triangle::getOrientation(tri, N0, N1, same_orient);
     //assert (err == 0);//fixme : handle properly the errors.
 
     if (!same_orient)
     {
-      std::reverse(Ei.begin(), Ei.end());
+      rEi.assign(Ei0.rbegin(), Ei0.rend());
+      pEi = &rEi;
       s = start;
       start = sz0 - end - 1;
       end = sz0 - s - 1;
     }
 
+    const std::vector<E_Int>& Ei = *pEi;
+
     for (n = start; n < end; ++n)
     {
       if (Ei[n] != Ei[n+1])
@@ -1560,7 +1400,7 @@ inline void
 TRI_Conformizer<DIM>::__get_Inner_edges
 (const K_FLD::FloatArray & pos,
  const K_FLD::IntArray & connect,
- const T3& t, edge_container_type& Edges,
+ const T3& t, const edge_container_type& Edges,
  std::set<K_MESH::Edge>& hBO, std::set<E_Int>& Nodes0)
 {
   E_Int             n, start, sz0, end;
@@ -1577,9 +1417,9 @@ TRI_Conformizer<DIM>::__get_Inner_edges
     end = sz0-1;
 
     if (!is_inside(connect, t, pos, Ei[start], EPSILON))
-      while ((start < end) && (_wnodes_set.find(Ei[start]) == _wnodes_set.end()))++start;
+      while ((start < end) && (Nodes0.find(Ei[start]) == Nodes0.end()))++start;
     if (!is_inside(connect, t, pos, Ei[end], EPSILON))
-      while ((end > start) && (_wnodes_set.find(Ei[end]) == _wnodes_set.end()))--end;
+      while ((end > start) && (Nodes0.find(Ei[end]) == Nodes0.end()))--end;
 
     for (n = start; n < end; ++n)
     {
@@ -1976,16 +1816,17 @@ TRI_Conformizer<DIM>::__transform
   NUGA::crossProduct<3>(W, U, V);
 
   // Build the transformation matrix.
+  K_FLD::FloatArray P(3,3), iP(3,3);
   for (E_Int i = 0; i < 3; ++i)
   {
-    _P(i, 0) = U[i];
-    _P(i, 1) = V[i];
-    _P(i, 2) = W[i];
+    P(i, 0) = U[i];
+    P(i, 1) = V[i];
+    P(i, 2) = W[i];
   }
 
   // Transform the working coordinates.
-  K_FLD::FloatArray::inverse3(_iP = _P);
-  __transform (pos, _iP);
+  K_FLD::FloatArray::inverse3(iP = P);
+  __transform (pos, iP);
 }
 
 ///
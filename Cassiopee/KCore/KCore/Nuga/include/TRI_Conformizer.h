@@ -64,6 +64,8 @@ public:
   E_Int __intersect(K_FLD::FloatArray& pos, const K_FLD::IntArray& connect,
                      T3& t1, T3& t2, E_Float tol);
   ///
+  bool __fast_discard_pair(const K_FLD::FloatArray& pos, const K_FLD::IntArray& connect, E_Int i, E_Int j, E_Float tol) const;
+  ///
   void __update_data(const K_FLD::FloatArray& pos, const K_FLD::IntArray& connect, const std::vector<E_Int>& newIDs);
   
   /// Splits the triangles by triangulation.
@@ -122,6 +124,30 @@ private:
 public:
 #endif
   
+  /// Split result of one element
+  struct split_t
+  {
+    E_Int ret, err;                              // ret : 0 split, 1 degenerated, 2 untouched
+    K_FLD::IntArray cnt;                         // resulting triangles (global ids)
+    std::vector<E_Int> colors;
+    std::vector<std::pair<E_Int, E_Int> > moves; // coincident nodes moves, replayed in element order
+  };
+  /// Thread-local working set for __split_Element
+  struct split_ws_t
+  {
+    split_ws_t(DELAUNAY::MesherMode& mode):mesher(mode), silent_errors(mode.silent_errors){}
+    DELAUNAY::T3Mesher<E_Float> mesher;
+    DELAUNAY::MeshData data;
+    K_FLD::FloatArray pi;
+    K_FLD::IntArray ci, ci2;
+    std::set<K_MESH::Edge> sci;
+    std::vector<E_Int> revIDs, hnodes, lnids;
+    std::vector<std::pair<E_Int, E_Int> > swapE;
+    std::set<K_MESH::NO_Edge> origE;
+    bool silent_errors;
+  };
+  /// Triangulates the i-th element with its traces : only writes in ws and s so it can run concurrently.
+  E_Int __split_Element(E_Int i, const K_FLD::FloatArray& pos, const K_FLD::IntArray& connect, split_ws_t& ws, split_t& s);
   ///
   E_Int __iterative_run(DELAUNAY::T3Mesher<E_Float>& mesher, K_FLD::FloatArray& crd, K_FLD::IntArray& cB, 
                         NUGA::int_vector_type& hnodes, DELAUNAY::MeshData& data, std::vector<E_Int>& nids,
@@ -139,7 +165,7 @@ public:
                      edge_container_type& edges, E_Int idxE, E_Float tol, std::vector<E_Int>& nodes, E_Int* pidx, E_Bool& coplanar);
   
   ///
-  bool __fast_discard(const K_FLD::FloatArray& pos, const E_Int* T1, const E_Int* T2, E_Float tol);
+  bool __fast_discard(const K_FLD::FloatArray& pos, const E_Int* T1, const E_Int* T2, E_Float tol) const;
   
   ///
   void __tidy_edges(const K_FLD::FloatArray& pos, edge_container_type& edges);
@@ -150,15 +176,15 @@ public:
   
   ///
   E_Int __get_connectB2(const K_FLD::FloatArray & pos, const K_FLD::IntArray & connect,
-                       const T3& t, edge_container_type& edges, std::set<K_MESH::Edge>& hBO,
+                       const T3& t, const edge_container_type& edges, std::set<K_MESH::Edge>& hBO,
                        std::vector<E_Int>& hNodes);
   ///
   inline bool __get_B0_edges(const K_FLD::IntArray & connect,
-                      const T3& t, edge_container_type& Edges,
+                      const T3& t, const edge_container_type& Edges,
                       std::set<K_MESH::Edge>& hBO, std::set<E_Int>& Nodes0);
   ///
   inline void __get_Inner_edges(const K_FLD::FloatArray & pos, const K_FLD::IntArray & connect,
-                         const T3& t, edge_container_type& Edges,
+                         const T3& t, const edge_container_type& Edges,
                          std::set<K_MESH::Edge>& hBO, std::set<E_Int>& Nodes0);
   ///
   inline void __get_Imprint_edges(const T3& t, std::set<K_MESH::Edge>& hBO, std::set<E_Int>& Nodes0);
@@ -219,8 +245,6 @@ private:
   std::vector<E_Int> _wnodes_vec, _wnodes_vecclean;
   std::set<E_Int>    _wnodes_set;
 
-  K_FLD::FloatArray _P,_iP;
-  E_Float _U1[3], _U2[3], _U3[3];
 
 #ifdef FLAG_STEP
   E_Float tcomp, ttra, trun, tcon, tcon0, tcon1, tcon2, tnot;
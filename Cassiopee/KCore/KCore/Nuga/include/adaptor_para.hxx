@@ -104,7 +104,7 @@ namespace NUGA
 
       using join_sensor_t = NUGA::join_sensor<hmesh_t>;
 
-      ePara PARA = COARSE_OMP;
+      ePara PARA = (NBZ >= __NUMTHREADS__) ? COARSE_OMP : FINE_OMP;
  
 #pragma omp parallel for reduction ( || : has_omp_changes) if(PARA == COARSE_OMP)         
       for (E_Int i = 0; i < NBZ; ++i)
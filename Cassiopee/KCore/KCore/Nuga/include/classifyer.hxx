@@ -106,20 +106,25 @@ namespace NUGA
     using outdata_t = typename data_trait<POLICY, zmesh_t>::outdata_t;
 
   public:
-    classifyer(double RTOL):_RTOL(RTOL) {}
+    classifyer(double RTOL):_RTOL(RTOL), _omp_cells(false) {}
 
+    // mask_cache (optional) : per component mask meshes with their localizer already built, shared read-only between zones
     void prepare(zmesh_t & z_mesh,
                  const std::vector<K_FLD::FloatArray> &mask_crds,
                  const std::vector<K_FLD::IntArray>& mask_cnts,
                  std::vector< std::vector<E_Int> > &mask_wall_ids,
                  const std::vector<K_SEARCH::BBox3D>& comp_boxes,
                  const std::vector<E_Int>& z_priorities, E_Int rank_wnp,
-                 std::vector< bmesh_t*> & mask_bits, bmesh_t& WP, bmesh_t& WNP);
+                 std::vector< bmesh_t*> & mask_bits, bmesh_t& WP, bmesh_t& WNP,
+                 const std::vector< bmesh_t*>* mask_cache = nullptr);
 
     E_Int compute(zmesh_t const & z_mesh, std::vector< bmesh_t*> const & mask_bits, bmesh_t& WP, bmesh_t& WNP, outdata_t& outdata);
 
     void finalize(zmesh_t const & z_mesh, outdata_t& outdata);
 
+    // loop over the zone cells with OpenMP (big zones processed one at a time)
+    void set_omp_cells(bool b) { _omp_cells = b; }
+
   protected:
 
     virtual outdata_t __process_X_cells(zmesh_t const & z_mesh, std::vector< bmesh_t*> const & mask_bits, wdata_t & wdata) = 0;
@@ -139,7 +144,11 @@ namespace NUGA
                             std::vector< std::vector<E_Int> > &mask_wall_ids,
                             const std::vector<E_Int>& z_priorities, E_Int rank_wnp,
                             std::vector< bmesh_t*> & mask_bits,
-                            bmesh_t& WP, bmesh_t& WNP);
+                            bmesh_t& WP, bmesh_t& WNP,
+                            const std::vector< bmesh_t*>* mask_cache);
+
+    bmesh_t* __extract_mask_bit(bmesh_t const & cmask, K_SEARCH::BBox3D const & box,
+                                std::vector<E_Int> const & wall_ids, std::vector<E_Int>& sub_wall_ids);
 
     void __process_overlapping_boundaries(zmesh_t & z_mesh, std::vector< bmesh_t*> & mask_bits, E_Int rank_wnp, E_Float RTOL);
 
@@ -151,6 +160,7 @@ namespace NUGA
     double _RTOL;
     std::vector<K_SEARCH::BBox3D> _comp_boxes;
     std::vector<E_Int> _z_priorities;
+    bool _omp_cells;
 
   };
 
@@ -448,7 +458,8 @@ namespace NUGA
    std::vector< std::vector<E_Int> > &mask_wall_ids,
    const std::vector<K_SEARCH::BBox3D>& comp_boxes,
    const std::vector<E_Int>& z_priorities, E_Int rank_wnp,
-   std::vector< bound_mesh_t*> & mask_bits, bound_mesh_t& WP, bound_mesh_t& WNP)
+   std::vector< bound_mesh_t*> & mask_bits, bound_mesh_t& WP, bound_mesh_t& WNP,
+   const std::vector< bound_mesh_t*>* mask_cache)
   {
 #ifdef CLASSIFYER_DBG
     static int znb = 0;
@@ -462,7 +473,7 @@ namespace NUGA
     
     // build mask data structures (mesh object) : WP are discarded. Putting first decreasing OP, then remaining WNP
     //__build_mask_bits(mask_crds, mask_cnts, mask_wall_ids, z_priorities, rank_wnp, mask_bits);
-    __build_mask_bits2(z_mesh, -0.1, NUGA::ISO_MAX, 2.*NUGA::PI*15./360, mask_crds, mask_cnts, mask_wall_ids, z_priorities, rank_wnp, mask_bits, WP, WNP);
+    __build_mask_bits2(z_mesh, -0.1, NUGA::ISO_MAX, 2.*NUGA::PI*15./360, mask_crds, mask_cnts, mask_wall_ids, z_priorities, rank_wnp, mask_bits, WP, WNP, mask_cache);
 
 #ifdef CLASSIFYER_DBG
     for (size_t m = 0; m < mask_bits.size(); ++m) {
@@ -741,7 +752,8 @@ namespace NUGA
   (zmesh_t & z_mesh, double ARTOL, eMetricType mtype, double AMAX, // these parameters to deal with overlapping
    const std::vector<K_FLD::FloatArray> &mask_crds, const std::vector<K_FLD::IntArray>& mask_cnts,
    std::vector< std::vector<E_Int> > &mask_wall_ids,
-   const std::vector<E_Int>& z_priorities, E_Int rank_wnp, std::vector< bound_mesh_t*> & mask_bits, bound_mesh_t& WP, bound_mesh_t& WNP)
+   const std::vector<E_Int>& z_priorities, E_Int rank_wnp, std::vector< bound_mesh_t*> & mask_bits, bound_mesh_t& WP, bound_mesh_t& WNP,
+   const std::vector< bound_mesh_t*>* mask_cache)
   {
     mask_bits.clear();
     //int nb_comps = mask_crds.size();
@@ -749,6 +761,25 @@ namespace NUGA
     bound_mesh_t zbound;
     z_mesh.get_boundary(zbound);
 
+    // coarse box for the extraction from the cached masks, exact reduction is done afterwards by __compact_to_box.
+    // the margin must keep any mask cell that move_double_walls may bring inside the zone box : only nodes closer
+    // to a zone wall than ARTOL are moved, ARTOL being relative to the wall face size (if negative) which is bounded
+    // by the zone box diagonal. The 2D enlargement of __compact_to_box (< 0.01 * diagonal) is added.
+    K_SEARCH::BBox3D z_box;
+    if (mask_cache != nullptr)
+    {
+      z_mesh.bbox(z_box);
+      double diag = ::sqrt(NUGA::sqrDistance(z_box.minB, z_box.maxB, 3));
+      double margin = (ARTOL < 0.) ? -ARTOL * diag : ARTOL;
+      margin += 0.01 * diag;
+      for (int k = 0; k < 3; ++k)
+      {
+        z_box.minB[k] -= margin;
+        z_box.maxB[k] += margin;
+      }
+    }
+    std::vector<E_Int> sub_wall_ids;
+
     // separating WP/WNP and OVLP
     for (size_t i = 0; i <z_priorities.size(); ++i)
     {
@@ -764,7 +795,16 @@ namespace NUGA
 
       //std::cout << "__build_mask_bits : nb walls : " << mask_wall_ids[compi].size() << std::endl;
 
-      bound_mesh_t* bit = new bound_mesh_t(mask_crds[compi], mask_cnts[compi], 1/* ASSUME DIRECT UPEN ENTRY*/);
+      bool from_cache = (mask_cache != nullptr && compi < (int)mask_cache->size() && (*mask_cache)[compi] != nullptr);
+
+      bound_mesh_t* bit = nullptr;
+      if (from_cache)
+        bit = __extract_mask_bit(*(*mask_cache)[compi], z_box, mask_wall_ids[compi], sub_wall_ids);
+      else
+        bit = new bound_mesh_t(mask_crds[compi], mask_cnts[compi], 1/* ASSUME DIRECT UPEN ENTRY*/);
+
+      // mask walls in bit numbering
+      const std::vector<E_Int>& wall_ids = from_cache ? sub_wall_ids : mask_wall_ids[compi];
 
       E_Int nbcells = bit->ncells();
 
@@ -789,7 +829,7 @@ namespace NUGA
       }
 #endif
       std::vector<bool> is_dw;
-      NUGA::move_double_walls(bit, zbound, ARTOL, mtype, AMAX, mask_wall_ids[compi], is_dw);
+      NUGA::move_double_walls(bit, zbound, ARTOL, mtype, AMAX, wall_ids, is_dw);
 
 #ifdef CLASSIFYER_DBG
       {
@@ -811,8 +851,8 @@ namespace NUGA
         // remove WALL from OVLP
         keep.clear();
         keep.resize(nbcells, true);
-        for (size_t u = 0; u < mask_wall_ids[compi].size(); ++u)
-          keep[mask_wall_ids[compi][u]] = false;
+        for (size_t u = 0; u < wall_ids.size(); ++u)
+          keep[wall_ids[u]] = false;
 
         OVLP.compress(keep);
       }
@@ -820,9 +860,9 @@ namespace NUGA
       // remove OVLP and DW from WALL
       keep.clear();
       keep.resize(nbcells, false);
-      for (size_t u = 0; u < mask_wall_ids[compi].size(); ++u)
+      for (size_t u = 0; u < wall_ids.size(); ++u)
       {
-        E_Int wid = mask_wall_ids[compi][u];
+        E_Int wid = wall_ids[u];
         keep[wid] = (!is_dw.empty()) ? !is_dw[wid] : true; // is_dw is empty either in surface mode or no walls in volume mode for the current zone.
       }
 
@@ -893,6 +933,45 @@ namespace NUGA
     //std::cout << "__build_mask_bits : exit" << std::endl;
   }
 
+  ///
+  TEMPLATE_TYPES
+  bound_mesh_t* TEMPLATE_CLASS::__extract_mask_bit
+  (bound_mesh_t const & cmask, K_SEARCH::BBox3D const & box, std::vector<E_Int> const & wall_ids, std::vector<E_Int>& sub_wall_ids)
+  {
+    // cmask is shared between zones : only its (already built) localizer is queried
+    E_Int nbcells = cmask.ncells();
+    std::vector<bool> keep(nbcells, false);
+
+    const auto* loc = cmask.get_localizer();
+    if (loc != nullptr)
+    {
+      std::vector<E_Int> cands;
+      loc->get_tree()->getOverlappingBoxes(box.minB, box.maxB, cands);
+      for (size_t i = 0; i < cands.size(); ++i) keep[cands[i]] = true;
+    }
+
+    // kept ids in increasing order and their new ids
+    std::vector<E_Int> kids, nids(nbcells, IDX_NONE);
+    for (E_Int i = 0; i < nbcells; ++i)
+    {
+      if (!keep[i]) continue;
+      nids[i] = kids.size();
+      kids.push_back(i);
+    }
+
+    sub_wall_ids.clear();
+    for (size_t u = 0; u < wall_ids.size(); ++u)
+      if (nids[wall_ids[u]] != IDX_NONE) sub_wall_ids.push_back(nids[wall_ids[u]]);
+
+    // only the kept cells (and their nodes) are copied
+    bound_mesh_t* bit = new bound_mesh_t(cmask, kids, 0);
+    if ((E_Int)cmask.e_type.size() == nbcells)
+      for (size_t k = 0; k < kids.size(); ++k) bit->e_type.push_back(cmask.e_type[kids[k]]);
+    if ((E_Int)cmask.flag.size() == nbcells)
+      for (size_t k = 0; k < kids.size(); ++k) bit->flag.push_back(cmask.flag[kids[k]]);
+    return bit;
+  }
+
   ///
   TEMPLATE_TYPES
   void TEMPLATE_CLASS::__process_overlapping_boundaries
@@ -1051,10 +1130,12 @@ namespace NUGA
   
     std::vector<E_Int> cands;
     
-    for (size_t i = 0; i < (size_t)nbcells; ++i)
+    // cells are independent : data[i] is the only written slot
+#pragma omp parallel for private(cands) reduction(||:has_X) schedule(dynamic, __MIN_SIZE_MEAN__) if(_omp_cells)
+    for (E_Int i = 0; i < nbcells; ++i)
     {
       //std::cout << i << " over " << nbcells << std::endl;
-      assert (i < data.size());
+      assert ((size_t)i < data.size());
       // in any POLICY, X must be re-processed to avoid missing element in current X-front being computed
       if (data[i] == (E_Int)IN) continue;
 
@@ -28,6 +28,7 @@
 #include "V1_smoother.hxx"
 #include "shell_smoother.hxx"
 #include "Nuga/include/BbTree.h"
+#include "Nuga/include/openMP.h"
 
 #include <limits.h>
 #ifdef DEBUG_2019
@@ -152,7 +153,8 @@ bool geom_sensor<mesh_t, sensor_input_t>::fill_adap_incr(output_t& adap_incr, bo
 
   if (maxnbpercell > _max_pts_per_cell)
   {
-    for (int i = 0; i < _cur_nphs; ++i)
+#pragma omp parallel for reduction(||:filled) if (_cur_nphs > __MIN_SIZE_LIGHT__)
+    for (E_Int i = 0; i < _cur_nphs; ++i)
     {
       const E_Int* faces = parent_t::_hmesh._ng.PHs.get_facets_ptr(i);
       E_Int nb_faces = parent_t::_hmesh._ng.PHs.stride(i);
@@ -209,34 +211,39 @@ void geom_sensor<mesh_t, sensor_input_t>::locate_points()
   // for each source points, give the highest cell containing it if there is one, otherwise IDX_NONE
   _points_to_cell.resize(nb_src_pts, IDX_NONE);
   
-  Vector_t<E_Int> ids;
-
   bool found=false;
-  E_Float minB[3];
-  E_Float maxB[3];
-  //
-  for (int i = 0; i < nb_src_pts; i++)
+
+  // points are independent : one thread-private candidate list
+#pragma omp parallel reduction(||:found) if (nb_src_pts > __MIN_SIZE_HEAVY__)
   {
-    const E_Float* p =parent_t::_data.get(i);
-    
-    for (int j = 0; j < 3;j++)
+    Vector_t<E_Int> ids;
+    E_Float minB[3];
+    E_Float maxB[3];
+    //
+#pragma omp for schedule(dynamic, 64)
+    for (E_Int i = 0; i < nb_src_pts; i++)
     {
-      minB[j] = p[j]-EPSILON; // small box over the source point
-      maxB[j] = p[j]+EPSILON;
-    }  
-    ids.clear();
-    _bbtree->getOverlappingBoxes(minB,maxB,ids); // ids contains the list of PH index partially containing the small box around the source point
+      const E_Float* p =parent_t::_data.get(i);
     
-    if (ids.empty()) continue; // exterior point : IDX_NONE
+      for (int j = 0; j < 3;j++)
+      {
+        minB[j] = p[j]-EPSILON; // small box over the source point
+        maxB[j] = p[j]+EPSILON;
+      }  
+      ids.clear();
+      _bbtree->getOverlappingBoxes(minB,maxB,ids); // ids contains the list of PH index partially containing the small box around the source point
     
-    for (size_t j = 0; j < ids.size(); j++) // which of these boxes has the source point ?
-    {
-      
-      if (K_MESH::Polyhedron<UNKNOWN>::pt_is_inside(ids[j], parent_t::_hmesh._ng.PGs, parent_t::_hmesh._ng.PHs.get_facets_ptr(ids[j]), parent_t::_hmesh._ng.PHs.stride(ids[j]), parent_t::_hmesh._crd, parent_t::_hmesh._F2E, p, tol))
+      if (ids.empty()) continue; // exterior point : IDX_NONE
+    
+      for (size_t j = 0; j < ids.size(); j++) // which of these boxes has the source point ?
       {
-        _points_to_cell[i] = get_highest_lvl_cell(p, ids[j]);
-        found = true;
-        break;
+      
+        if (K_MESH::Polyhedron<UNKNOWN>::pt_is_inside(ids[j], parent_t::_hmesh._ng.PGs, parent_t::_hmesh._ng.PHs.get_facets_ptr(ids[j]), parent_t::_hmesh._ng.PHs.stride(ids[j]), parent_t::_hmesh._crd, parent_t::_hmesh._F2E, p, tol))
+        {
+          _points_to_cell[i] = get_highest_lvl_cell(p, ids[j]);
+          found = true;
+          break;
+        }
       }
     }
   }
@@ -342,7 +349,8 @@ bool geom_sensor<mesh_t, sensor_input_t>::update()
   
   E_Int nb_pts = _points_to_cell.size();
 
-  for (int i = 0; i < nb_pts; ++i)
+#pragma omp parallel for schedule(dynamic, 64) if (nb_pts > __MIN_SIZE_HEAVY__)
+  for (E_Int i = 0; i < nb_pts; ++i)
   {
     E_Int PHi = _points_to_cell[i];
 
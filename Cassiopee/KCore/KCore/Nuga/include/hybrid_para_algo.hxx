@@ -97,7 +97,7 @@ namespace NUGA
     int NBZ{ int(meshes.size()) };
 
     //1. autonomous runs
-    ePara PARA = COARSE_OMP;
+    ePara PARA = (NBZ >= __NUMTHREADS__) ? COARSE_OMP : FINE_OMP;
 #pragma omp parallel for if(PARA == COARSE_OMP)
     for (int i = 0; i < NBZ; ++i)
       this->autonomous_run(meshes, i);
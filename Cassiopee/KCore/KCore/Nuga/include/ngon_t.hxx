@@ -38,6 +38,7 @@
 #include "Nuga/include/FittingBox.h"
 #include "Nuga/include/macros.h"
 #include "Nuga/include/BbTree.h"
+#include "Nuga/include/tri_batch.hxx"
 #include <limits.h>
 #include <unordered_map>
 
@@ -1386,43 +1387,19 @@ struct ngon_t
   {
     connectT3.clear();
     colors.clear();
-    
-    TriangulatorType dt;
 
-    PGs.updateFacets();
+    NUGA::tri_batch_t tb;
+    E_Int err = NUGA::triangulate_pgs_batch<TriangulatorType>(PGs, coord, process, do_not_shuffle, improve_quality, tb);
 
-    E_Int sz = PGs.size(), err(0);
-    E_Int i=0;
-    for (; (i<sz) && !err ; ++i)
-    {
-      if (process && (*process)[i] == false)
-        continue;
+    E_Int ntris = tb.ntris();
+    if (ntris == 0) return err;
 
-#ifdef DEBUG_TRIANGULATOR
-      if (i == 15138)
-        dt.dbg_enabled=true;
-      else
-        dt.dbg_enabled=false;
-#endif
+    connectT3.resize(3, ntris);
+    std::copy(ALL(tb.tris), connectT3.begin());
 
-      err = K_MESH::Polygon::triangulate(dt, coord, PGs.get_facets_ptr(i), PGs.stride(i), 1/*index start*/, connectT3, do_not_shuffle, improve_quality);
-      if (err)
-      {
-        K_MESH::Polygon::cvx_triangulate(coord, PGs.get_facets_ptr(i), PGs.stride(i), 0/*ibest*/, 1/*index start*/, connectT3);
-        err = 0;
-      }
-      
-      colors.resize(connectT3.getSize(), i);
-    }
-    
-    if (err) { //i-1 because have been incremented when exiting the loop
-      std::cout << "triangulate_pgs error at PG : " << i - 1 << " (" << PGs.stride(i - 1) << " nodes)" << std::endl;
-#ifdef DEBUG_TRIANGULATOR
-      std::ostringstream o;
-      o << "./pg_" << i - 1 << ".mesh";
-      medith::write(o.str().c_str(), coord, PGs.get_facets_ptr(i - 1), PGs.stride(i - 1), 1);
-#endif
-    }
+    colors.resize(ntris);
+    for (E_Int k = 0; k < tb.size(); ++k)
+      for (E_Int t = tb.xtri[k]; t < tb.xtri[k + 1]; ++t) colors[t] = tb.pgids[k];
 
     return err;
   }
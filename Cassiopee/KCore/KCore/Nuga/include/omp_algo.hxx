@@ -19,6 +19,7 @@
 //Authors : Sam Landier (sam.landier@onera.fr)
 
 #include "Nuga/include/macros.h"
+#include "Nuga/include/openMP.h"
 #include <map>
 #include <vector>
 #include <assert.h>
@@ -108,7 +109,8 @@ namespace NUGA
     int NBZ{ int(meshes.size()) };
 
     //1. autonomous runs
-    NUGA::ePara PARA = COARSE_OMP;
+    // enough zones to feed the threads : one zone per thread, otherwise zones are run in turn and threads go inside the sensor/refiner loops
+    NUGA::ePara PARA = (NBZ >= __NUMTHREADS__) ? COARSE_OMP : FINE_OMP;
 #pragma omp parallel for if(PARA == COARSE_OMP)
     for (int i = 0; i < NBZ; ++i)
       this->autonomous_run(meshes, i);
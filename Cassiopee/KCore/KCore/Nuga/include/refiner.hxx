@@ -23,6 +23,7 @@
 
 #include "Nuga/include/Edge.h"
 #include "Nuga/include/Basic.h"
+#include "Nuga/include/openMP.h"
 #include "T6.hxx"
 #include "Q9.hxx"
 #include "Q6.hxx"
@@ -1063,11 +1064,12 @@ namespace NUGA
     std::vector<E_Int> childpos, crdpos;
     reserve_mem_PGs(crd, ng.PGs, PG_to_ref, PG_directive, PGtree, F2E, childpos, crdpos);
 
-    // Refine them
+    // Refine them : each face writes only in its reserved slots (crd, PGs, F2E and PGtree)
+    E_Int nb_pgs_ref = PG_to_ref.size();
 #ifndef DEBUG_HIERARCHICAL_MESH
-//#pragma omp parallel for
+#pragma omp parallel for if (nb_pgs_ref > __MIN_SIZE_HEAVY__)
 #endif
-    for (size_t i = 0; i < PG_to_ref.size(); ++i)
+    for (E_Int i = 0; i < nb_pgs_ref; ++i)
     {
       E_Int PGi = PG_to_ref[i];
       E_Int firstChild = childpos[i];
@@ -1165,17 +1167,29 @@ namespace NUGA
 
     using spliting_t = splitting_t<ELT_t, XYZ, 1>; // HX27, TH10, PY13 or PR18, HX18
 
+    // each cell writes its centroid, internal faces and children in its reserved slots.
+    // F2E of the outer faces is shared with the neighbours : updated afterwards, sequentially.
+    bool para = (nb_phs_ref > __MIN_SIZE_HEAVY__);
 #ifndef DEBUG_HIERARCHICAL_MESH
-//#pragma omp parallel for
+#pragma omp parallel for if (para)
 #endif
     for (E_Int i = 0; i < nb_phs_ref; ++i)
     {
       E_Int PHi = PH_to_ref[i];
 
       spliting_t elt(crd, ng, PHi, pos + i, F2E, PGtree);
+      elt.defer_outer_F2E = para;
 
       elt.split(ng, PHi, PHtree, PGtree, F2E, intpos[i], childpos[i]);
     }
+
+    if (!para) return;
+
+    for (E_Int i = 0; i < nb_phs_ref; ++i)
+    {
+      E_Int PHi = PH_to_ref[i];
+      splitting_base_t::update_outer_F2E(ng, PHi, PHtree.children(PHi), PHtree.nb_children(PHi), PGtree, F2E);
+    }
   }
 
   ///
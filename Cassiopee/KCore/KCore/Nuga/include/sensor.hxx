@@ -23,6 +23,7 @@
 
 #include<vector>
 #include "Nuga/include/macros.h"
+#include "Nuga/include/openMP.h"
 #include "subdivision.hxx"
 #include "smoother.hxx"
 
@@ -179,8 +180,10 @@ bool sensor<mesh_t, sensor_input_t>::compute(output_t& adap_incr, bool do_agglo)
 template <typename mesh_t, typename sensor_input_t>
 void sensor<mesh_t, sensor_input_t>::append_adap_incr_w_over_connected(output_t& adap_incr)
 {
-  //
-  for (size_t i = 0; i < adap_incr.cell_adap_incr.size(); ++i)
+  // each cell only sets its own flag
+  E_Int nb_phs = adap_incr.cell_adap_incr.size();
+#pragma omp parallel for if (nb_phs > __MIN_SIZE_LIGHT__)
+  for (E_Int i = 0; i < nb_phs; ++i)
   {
     if (!_hmesh._PHtree.is_enabled(i)) continue;
     if (adap_incr.cell_adap_incr[i] != 0) continue;
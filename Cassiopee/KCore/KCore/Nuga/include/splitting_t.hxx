@@ -22,6 +22,7 @@
 #define NUGA_SPLITTING_T_HXX
 
 #include "subdivision.hxx"
+#include <algorithm>
 
 static bool need_a_reorient(E_Int PGi, E_Int PHi, bool oriented_if_R, const K_FLD::IntArray & F2E)
 {
@@ -42,11 +43,19 @@ namespace NUGA
   struct splitting_base_t
   {
     bool ok_for_split;
+    bool defer_outer_F2E; // split en parallele : F2E des faces externes mis a jour apres coup (update_outer_F2E)
 
-    splitting_base_t() : ok_for_split(true) {}
+    splitting_base_t() : ok_for_split(true), defer_outer_F2E(false) {}
 
     template <typename arr_t>
-    static void __update_outer_F2E(const ngon_type& ng, E_Int parentPHi, const E_Int* childrenPHi, E_Int nchildren, const tree<arr_t>& PGtree, K_FLD::IntArray& F2E);
+    void __update_outer_F2E(const ngon_type& ng, E_Int parentPHi, const E_Int* childrenPHi, E_Int nchildren, const tree<arr_t>& PGtree, K_FLD::IntArray& F2E)
+    {
+      if (defer_outer_F2E) return;
+      update_outer_F2E(ng, parentPHi, childrenPHi, nchildren, PGtree, F2E);
+    }
+
+    template <typename arr_t>
+    static void update_outer_F2E(const ngon_type& ng, E_Int parentPHi, const E_Int* childrenPHi, E_Int nchildren, const tree<arr_t>& PGtree, K_FLD::IntArray& F2E);
 
     template <typename arr_t>
     static void __propagate_PH_neighbour_in_PG_descendance(E_Int PGi, E_Int side, E_Int PH, const tree<arr_t>& PGtree, K_FLD::IntArray& F2E);
@@ -57,7 +66,7 @@ namespace NUGA
 
   ///
   template <typename arr_t>
-  void splitting_base_t::__update_outer_F2E
+  void splitting_base_t::update_outer_F2E
   (const ngon_type& ng, E_Int parentPHi, const E_Int* childrenPHi, E_Int nchildren, const tree<arr_t>& PGtree, K_FLD::IntArray& F2E)
   {
     //E_Int count(0);
@@ -77,6 +86,9 @@ namespace NUGA
 
         if (F2E(0, PGi) == IDX_NONE && F2E(1, PGi) == IDX_NONE) // INNER FACE
           continue;
+        if (std::find(childrenPHi, childrenPHi + nchildren, F2E(0, PGi)) != childrenPHi + nchildren ||
+            std::find(childrenPHi, childrenPHi + nchildren, F2E(1, PGi)) != childrenPHi + nchildren) // INNER FACE (deja renseignee)
+          continue;
 
         E_Int side = IS_OUTWARD(F2E, PGi, parentPHi) ? 0 : 1; //child PH is on same side of child PG as parent PH regarding parent PG 
         /*if (side == 1)
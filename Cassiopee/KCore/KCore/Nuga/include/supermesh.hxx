@@ -760,6 +760,301 @@ int interpolate(
   return 0;
 }
 
+///
+template <typename zmesh_t>
+void __supermesh_cell(
+  const zmesh_t& mrec,
+  const zmesh_t& mdon,
+  E_Int i,
+  const std::vector<E_Int>& cands, //1-based
+  std::vector<typename zmesh_t::aelt_t>& bits,
+  std::vector<E_Int>& dids,
+  std::vector<double>& vols,
+  std::vector<double>& gvols)
+{
+  // same clipping/classification as interpolate but the transferred quantities are kept per donor as
+  // a volume and a first moment (Vbit * (Gbit - Gdon)) so the transfer becomes a sparse mat-vec
+  dids.clear();
+  vols.clear();
+  gvols.clear();
+
+  auto ae0 = mrec.aelement(i);
+
+  for (size_t n = 0; n < cands.size(); ++n)
+  {
+    E_Int i2 = cands[n] - 1;
+    auto ae1 = mdon.aelement(i2);
+    const double* Gdon = ae1.get_centroid();
+
+    double V(0.), G[] = { 0., 0., 0. };
+
+    bits.clear();
+    bool just_io = !NUGA::CLIP::compute(ae0, ae1, NUGA::INTERSECT::INTERSECTION, bits);
+    bool fully_in(false);
+
+    if (just_io)
+    {
+      NUGA::eClassify wher = NUGA::CLASSIFY::classify(ae0, ae1, true);
+
+      if (wher == OUT) continue;
+
+      if (wher == IN) // ae0 is fully inside ae1
+      {
+        V = ae0.extent();
+        const double* Gbit = ae0.get_centroid();
+        for (int k = 0; k < 3; ++k) G[k] = V * (Gbit[k] - Gdon[k]);
+        fully_in = true;
+      }
+      else // IN_1 : ae1 is fully inside ae0 => no gradient contribution
+        V = ae1.extent();
+    }
+    else
+    {
+      for (size_t b = 0; b < bits.size(); ++b)
+      {
+        double Vbit = bits[b].extent();
+        const double* Gbit = bits[b].get_centroid();
+        V += Vbit;
+        for (int k = 0; k < 3; ++k) G[k] += Vbit * (Gbit[k] - Gdon[k]);
+      }
+    }
+
+    dids.push_back(i2);
+    vols.push_back(V);
+    gvols.insert(gvols.end(), G, G + 3);
+
+    if (fully_in) break;
+  }
+}
+
+/// Persistent receiver/donor supermesh : the intersection volumes are stored once in CSR form (normalized
+/// by the covered volume) and reapplied to any number of fields. On motion, only the receiver cells whose
+/// candidate donors changed or moved are clipped again.
+template <typename zmesh_t>
+struct conservative_transfer
+{
+  zmesh_t mrec, mdon;
+  double RTOL;
+
+  std::vector<E_Int>  xr, dids;  // donors of receiver i : dids[xr[i]..xr[i+1]-1]
+  std::vector<double> coeffs;    // normalized volumes
+  std::vector<double> gcoeffs;   // normalized first moments (3 per entry)
+  std::vector<double> covered;   // covered volume per receiver cell
+
+  std::vector<E_Int>  xc, cids;  // candidates (bbox neighbors) of each receiver cell, sorted, 1-based
+  K_FLD::FloatArray   crdR0, crdD0; // coordinates the current weights were computed with
+
+  conservative_transfer(const zmesh_t& mR, const zmesh_t& mD, double rtol) :mrec(mR), mdon(mD), RTOL(rtol) {}
+
+  ///
+  void build(bool do_omp = true)
+  {
+    E_Int nrec = mrec.ncells();
+    std::vector<E_Int> all(nrec);
+    for (E_Int i = 0; i < nrec; ++i) all[i] = i;
+
+    xr.assign(1, 0); dids.clear(); coeffs.clear(); gcoeffs.clear(); covered.assign(nrec, 0.);
+    xc.assign(nrec + 1, 0); cids.clear();
+
+    __compute(all, do_omp);
+
+    crdR0 = mrec.crd;
+    crdD0 = mdon.crd;
+  }
+
+  /// new coordinates (same topology) for the receiver and/or the donor (nullptr if unchanged).
+  /// A cell is considered as moved when one of its nodes is further than tol from its reference position.
+  /// Returns the number of receiver cells recomputed.
+  E_Int update(const K_FLD::FloatArray* crdR, const K_FLD::FloatArray* crdD, double tol, bool do_omp = true)
+  {
+    std::vector<bool> movedR, movedD;
+    if (crdR != nullptr) __set_crd(mrec, *crdR, crdR0, tol, movedR);
+    if (crdD != nullptr) __set_crd(mdon, *crdD, crdD0, tol, movedD);
+
+    E_Int nrec = mrec.ncells();
+    auto loc1 = mdon.get_localizer();
+    mrec.get_nodal_metric2();
+    mdon.get_nodal_metric2();
+
+    std::vector<char> redo(nrec, 0);
+
+#pragma omp parallel if(do_omp)
+    {
+      std::vector<E_Int> cands;
+#pragma omp for
+      for (E_Int i = 0; i < nrec; ++i)
+      {
+        if (!movedR.empty() && movedR[i]) { redo[i] = 1; continue; }
+
+        auto ae0 = mrec.aelement(i);
+        cands.clear();
+        if (loc1 != nullptr) loc1->get_candidates(ae0, ae0.m_crd, cands, 1, RTOL);
+        std::sort(ALL(cands));
+
+        E_Int nc = xc[i + 1] - xc[i];
+        if ((E_Int)cands.size() != nc || !std::equal(ALL(cands), &cids[xc[i]])) { redo[i] = 1; continue; }
+
+        if (movedD.empty()) continue;
+        for (size_t n = 0; n < cands.size(); ++n)
+          if (movedD[cands[n] - 1]) { redo[i] = 1; break; }
+      }
+    }
+
+    std::vector<E_Int> ids;
+    for (E_Int i = 0; i < nrec; ++i)
+      if (redo[i]) ids.push_back(i);
+
+    if (!ids.empty()) __compute(ids, do_omp);
+
+    return ids.size();
+  }
+
+  /// rec[f][i] = sum_k coeffs[k] * don[f][dids[k]] (+ first order correction when gradients are given)
+  void apply(const std::vector<field>& don_fields, std::vector<std::vector<double>>& rec_fields, bool do_omp = true) const
+  {
+    E_Int nrec = mrec.ncells();
+    E_Int nfields = don_fields.size();
+
+    rec_fields.resize(nfields);
+    for (E_Int f = 0; f < nfields; ++f) rec_fields[f].resize(nrec);
+
+    const E_Int* pxr = &xr[0];
+    const E_Int* pd = dids.empty() ? nullptr : &dids[0];
+    const double* pc = coeffs.empty() ? nullptr : &coeffs[0];
+    const double* pg = gcoeffs.empty() ? nullptr : &gcoeffs[0];
+
+    for (E_Int f = 0; f < nfields; ++f)
+    {
+      const double* fd = don_fields[f].f;
+      const double* gx = don_fields[f].gradf[0];
+      const double* gy = don_fields[f].gradf[1];
+      const double* gz = don_fields[f].gradf[2];
+      double* fr = &rec_fields[f][0];
+
+      if (gx == nullptr)
+      {
+#pragma omp parallel for if(do_omp)
+        for (E_Int i = 0; i < nrec; ++i)
+        {
+          double s = 0.;
+#pragma omp simd reduction(+:s)
+          for (E_Int k = pxr[i]; k < pxr[i + 1]; ++k)
+            s += pc[k] * fd[pd[k]];
+          fr[i] = s;
+        }
+      }
+      else
+      {
+#pragma omp parallel for if(do_omp)
+        for (E_Int i = 0; i < nrec; ++i)
+        {
+          double s = 0.;
+#pragma omp simd reduction(+:s)
+          for (E_Int k = pxr[i]; k < pxr[i + 1]; ++k)
+          {
+            E_Int d = pd[k];
+            s += pc[k] * fd[d] + pg[3 * k] * gx[d] + pg[3 * k + 1] * gy[d] + pg[3 * k + 2] * gz[d];
+          }
+          fr[i] = s;
+        }
+      }
+    }
+  }
+
+private:
+
+  ///
+  static void __set_crd(zmesh_t& m, const K_FLD::FloatArray& crd, K_FLD::FloatArray& crd0, double tol, std::vector<bool>& moved)
+  {
+    E_Int nnodes = crd.cols();
+    double tol2 = tol * tol;
+
+    std::vector<bool> nmoved(nnodes, false);
+    for (E_Int n = 0; n < nnodes; ++n)
+    {
+      if (NUGA::sqrDistance(crd.col(n), crd0.col(n), 3) <= tol2) continue;
+      nmoved[n] = true;
+      for (E_Int k = 0; k < 3; ++k) crd0(k, n) = crd(k, n);
+    }
+
+    E_Int ncells = m.ncells();
+    std::vector<E_Int> nodes;
+    moved.assign(ncells, false);
+    for (E_Int i = 0; i < ncells; ++i)
+    {
+      K_MESH::Polyhedron<0>::unique_nodes(m.cnt.PGs, m.cnt.PHs.get_facets_ptr(i), m.cnt.PHs.stride(i), nodes); // 1-based
+      for (size_t n = 0; n < nodes.size() && !moved[i]; ++n)
+        moved[i] = nmoved[nodes[n] - 1];
+    }
+
+    m.crd = crd;
+    m.build_localizer();
+    m.nodal_metric2.clear();
+  }
+
+  /// clips the receiver cells ids against their candidates and merges them in the CSR storage
+  void __compute(const std::vector<E_Int>& ids, bool do_omp)
+  {
+    using aelt_t = typename zmesh_t::aelt_t;
+
+    auto loc1 = mdon.get_localizer();
+    mrec.get_nodal_metric2();
+    mdon.get_nodal_metric2();
+
+    E_Int nids = ids.size();
+    std::vector<std::vector<E_Int>>  cands_per_cell(nids), dids_per_cell(nids);
+    std::vector<std::vector<double>> vols_per_cell(nids), gvols_per_cell(nids);
+
+#pragma omp parallel if(do_omp)
+    {
+      std::vector<aelt_t> bits;
+#pragma omp for schedule(dynamic)
+      for (E_Int j = 0; j < nids; ++j)
+      {
+        E_Int i = ids[j];
+        auto ae0 = mrec.aelement(i);
+        if (loc1 != nullptr) loc1->get_candidates(ae0, ae0.m_crd, cands_per_cell[j], 1, RTOL); //return as 1-based
+        std::sort(ALL(cands_per_cell[j]));
+        __supermesh_cell(mrec, mdon, i, cands_per_cell[j], bits, dids_per_cell[j], vols_per_cell[j], gvols_per_cell[j]);
+      }
+    }
+
+    // merge with the untouched rows
+    E_Int nrec = mrec.ncells();
+    std::vector<E_Int>  nxr(1, 0), ndids, nxc(1, 0), ncids;
+    std::vector<double> ncoeffs, ngcoeffs;
+    bool full = (nids == nrec);
+
+    for (E_Int i = 0, j = 0; i < nrec; ++i)
+    {
+      if (j < nids && ids[j] == i)
+      {
+        double stot = 0.;
+        for (size_t k = 0; k < vols_per_cell[j].size(); ++k) stot += vols_per_cell[j][k];
+        covered[i] = stot;
+        double s = (stot != 0.) ? 1. / stot : 0.; // discard non interpolated cells
+
+        ndids.insert(ndids.end(), ALL(dids_per_cell[j]));
+        for (size_t k = 0; k < vols_per_cell[j].size(); ++k) ncoeffs.push_back(vols_per_cell[j][k] * s);
+        for (size_t k = 0; k < gvols_per_cell[j].size(); ++k) ngcoeffs.push_back(gvols_per_cell[j][k] * s);
+        ncids.insert(ncids.end(), ALL(cands_per_cell[j]));
+        ++j;
+      }
+      else if (!full)
+      {
+        ndids.insert(ndids.end(), dids.begin() + xr[i], dids.begin() + xr[i + 1]);
+        ncoeffs.insert(ncoeffs.end(), coeffs.begin() + xr[i], coeffs.begin() + xr[i + 1]);
+        ngcoeffs.insert(ngcoeffs.end(), gcoeffs.begin() + 3 * xr[i], gcoeffs.begin() + 3 * xr[i + 1]);
+        ncids.insert(ncids.end(), cids.begin() + xc[i], cids.begin() + xc[i + 1]);
+      }
+      nxr.push_back(ndids.size());
+      nxc.push_back(ncids.size());
+    }
+
+    xr = std::move(nxr); dids = std::move(ndids); coeffs = std::move(ncoeffs); gcoeffs = std::move(ngcoeffs);
+    xc = std::move(nxc); cids = std::move(ncids);
+  }
+};
 
 }
 
@@ -0,0 +1,252 @@
+/*    
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NUGA_TRI_BATCH_HXX
+#define NUGA_TRI_BATCH_HXX
+
+#include "Nuga/include/ngon_unit.h"
+#include "Nuga/include/Polygon.h"
+#include "Nuga/include/openMP.h"
+#include <vector>
+#include <cmath>
+
+namespace NUGA
+{
+  /// Triangulation of a set of polygons in CSR form. A polygon of n nodes always gives n-2 triangles
+  /// (no Steiner point in triangulation mode), so the offsets are known before triangulating and each
+  /// polygon is written in place. Buffers keep their capacity between calls.
+  struct tri_batch_t
+  {
+    std::vector<E_Int> pgids;  // processed polygons
+    std::vector<E_Int> xtri;   // triangles of pgids[k] are [xtri[k], xtri[k+1])
+    std::vector<E_Int> tris;   // 3 nodes per triangle, 0-based
+    std::vector<E_Int> errs;   // 0 if pgids[k] is triangulated, triangulator error otherwise (its triangles are a fan)
+    E_Int nb_hard;             // polygons sent to the Delaunay triangulator
+    E_Int nb_fallback;         // Delaunay failures replaced by a fan
+
+    tri_batch_t() :nb_hard(0), nb_fallback(0) {}
+
+    E_Int size() const { return (E_Int)pgids.size(); }
+    E_Int ntris() const { return xtri.empty() ? 0 : xtri.back(); }
+
+    void clear() { pgids.clear(); xtri.clear(); tris.clear(); errs.clear(); nb_hard = nb_fallback = 0; }
+
+    /// triangles as a 1-based ngon_unit, oids[t] is the polygon triangle t comes from
+    void export_to_ngon_unit(ngon_unit& tri_pgs, std::vector<E_Int>& oids) const
+    {
+      E_Int nt = ntris();
+      E_Int nb = size();
+
+      tri_pgs.clear();
+      tri_pgs._NGON.resize(4 * nt + 2);
+      tri_pgs._NGON[0] = nt;
+      tri_pgs._NGON[1] = 4 * nt;
+      oids.resize(nt);
+
+#pragma omp parallel for schedule(dynamic, __MIN_SIZE_LIGHT__)
+      for (E_Int k = 0; k < nb; ++k)
+      {
+        for (E_Int t = xtri[k]; t < xtri[k + 1]; ++t)
+        {
+          E_Int* p = &tri_pgs._NGON[4 * t + 2];
+          p[0] = 3;
+          p[1] = tris[3 * t] + 1;
+          p[2] = tris[3 * t + 1] + 1;
+          p[3] = tris[3 * t + 2] + 1;
+          oids[t] = pgids[k];
+        }
+      }
+
+      tri_pgs.updateFacets();
+    }
+  };
+
+  namespace TRI_BATCH
+  {
+    /// cosine of the angle at Pk in triangle (Pa, Pk, Pb)
+    inline E_Float cos_angle(const E_Float* Pa, const E_Float* Pk, const E_Float* Pb)
+    {
+      E_Float u[3], v[3];
+      NUGA::diff<3>(Pa, Pk, u);
+      NUGA::diff<3>(Pb, Pk, v);
+      E_Float d = ::sqrt(NUGA::sqrNorm<3>(u) * NUGA::sqrNorm<3>(v));
+      return (d > 0.) ? NUGA::dot<3>(u, v) / d : 1.;
+    }
+
+    /// counts strictly convex nodes (sin of the turn > tol), inc is the last other one (reflex or flat)
+    inline void turns(const K_FLD::FloatArray& crd, const E_Int* nodes, E_Int n, E_Int idx_start,
+                      const E_Float* W, E_Float tol, E_Int& nb_cvx, E_Int& inc)
+    {
+      nb_cvx = 0;
+      inc = IDX_NONE;
+
+      E_Float e1[3], e2[3], c[3];
+      for (E_Int i = 0; i < n; ++i)
+      {
+        const E_Float* Pm = crd.col(nodes[(i + n - 1) % n] - idx_start);
+        const E_Float* Pi = crd.col(nodes[i] - idx_start);
+        const E_Float* Pp = crd.col(nodes[(i + 1) % n] - idx_start);
+
+        NUGA::diff<3>(Pi, Pm, e1);
+        NUGA::diff<3>(Pp, Pi, e2);
+        NUGA::crossProduct<3>(e1, e2, c);
+
+        E_Float d = ::sqrt(NUGA::sqrNorm<3>(e1) * NUGA::sqrNorm<3>(e2));
+        E_Float s = (d > 0.) ? NUGA::dot<3>(c, W) / d : 0.;
+
+        if (s > tol) ++nb_cvx;
+        else inc = i;
+      }
+    }
+
+    /// Delaunay triangulation of a strictly convex polygon : the triangle on chord (a,b) takes the node
+    /// of the chain a..b that sees it under the largest angle. Orientation of the polygon is kept.
+    inline void convex_delaunay(const K_FLD::FloatArray& crd, const E_Int* nodes, E_Int n, E_Int idx_start,
+                                std::vector<E_Int>& chords, E_Int* T)
+    {
+      chords.clear();
+      chords.push_back(0); chords.push_back(n - 1);
+
+      while (!chords.empty())
+      {
+        E_Int b = chords.back(); chords.pop_back();
+        E_Int a = chords.back(); chords.pop_back();
+
+        const E_Float* Pa = crd.col(nodes[a] - idx_start);
+        const E_Float* Pb = crd.col(nodes[b] - idx_start);
+
+        E_Int kbest = a + 1;
+        E_Float cmin = 2.;
+        for (E_Int k = a + 1; k < b; ++k)
+        {
+          E_Float c = cos_angle(Pa, crd.col(nodes[k] - idx_start), Pb);
+          if (c < cmin) { cmin = c; kbest = k; }
+        }
+
+        *(T++) = nodes[a] - idx_start;
+        *(T++) = nodes[kbest] - idx_start;
+        *(T++) = nodes[b] - idx_start;
+
+        if (kbest - a > 1) { chords.push_back(a); chords.push_back(kbest); }
+        if (b - kbest > 1) { chords.push_back(kbest); chords.push_back(b); }
+      }
+    }
+
+    /// fan from node i0
+    inline void fan(const E_Int* nodes, E_Int n, E_Int idx_start, E_Int i0, E_Int* T)
+    {
+      for (E_Int t = 0; t < n - 2; ++t)
+      {
+        *(T++) = nodes[i0] - idx_start;
+        *(T++) = nodes[(i0 + t + 1) % n] - idx_start;
+        *(T++) = nodes[(i0 + t + 2) % n] - idx_start;
+      }
+    }
+  }
+
+  /// Triangulates the polygons of PGs flagged in process (all if null) into tb.
+  /// Fast paths : triangles, strictly convex polygons (closed-form Delaunay) and quads with a single reflex
+  /// or flat node (split at it). Other polygons go to the constrained Delaunay triangulator (one per thread),
+  /// its failures are replaced by a fan and flagged in tb.errs.
+  template <typename TriangulatorType>
+  E_Int triangulate_pgs_batch
+  (const ngon_unit& PGs, const K_FLD::FloatArray& crd, const std::vector<bool>* process,
+   bool do_not_shuffle, bool improve_qual, tri_batch_t& tb, E_Float convexity_tol = 1.e-8)
+  {
+    PGs.updateFacets();
+
+    E_Int nb_pgs = PGs.size();
+
+    // offsets
+    tb.clear();
+    tb.xtri.push_back(0);
+    for (E_Int i = 0; i < nb_pgs; ++i)
+    {
+      if (process && (*process)[i] == false) continue;
+      tb.pgids.push_back(i);
+      tb.xtri.push_back(tb.xtri.back() + std::max(PGs.stride(i) - 2, (E_Int)0));
+    }
+
+    tb.tris.resize(3 * tb.ntris());
+    tb.errs.assign(tb.size(), 0);
+
+    E_Int nb = tb.size();
+    E_Int nb_hard(0), nb_fallback(0);
+
+#pragma omp parallel reduction(+:nb_hard, nb_fallback)
+    {
+      TriangulatorType dt;
+      K_FLD::IntArray cM, neighbors;
+      std::vector<E_Int> chords;
+      E_Float W[3];
+
+#pragma omp for schedule(dynamic, __MIN_SIZE_LIGHT__)
+      for (E_Int k = 0; k < nb; ++k)
+      {
+        E_Int PGi = tb.pgids[k];
+        const E_Int* nodes = PGs.get_facets_ptr(PGi);
+        E_Int n = PGs.stride(PGi);
+        E_Int* T = &tb.tris[3 * tb.xtri[k]];
+
+        if (n < 3) continue;
+        if (n == 3)
+        {
+          T[0] = nodes[0] - 1; T[1] = nodes[1] - 1; T[2] = nodes[2] - 1;
+          continue;
+        }
+
+        K_MESH::Polygon::normal<K_FLD::FloatArray, 3>(crd, nodes, n, 1, W);
+
+        E_Int nb_cvx, inc;
+        TRI_BATCH::turns(crd, nodes, n, 1, W, convexity_tol, nb_cvx, inc);
+
+        if (nb_cvx == n)
+        {
+          TRI_BATCH::convex_delaunay(crd, nodes, n, 1, chords, T);
+          continue;
+        }
+        if (n == 4 && nb_cvx == 3)
+        {
+          TRI_BATCH::fan(nodes, n, 1, inc, T);
+          continue;
+        }
+
+        // hard polygon
+        ++nb_hard;
+        cM.clear();
+        E_Int err = K_MESH::Polygon::triangulate(dt, crd, nodes, n, 1/*index start*/, cM, neighbors, do_not_shuffle, improve_qual);
+        if (!err && cM.cols() == n - 2)
+          std::copy(cM.begin(), cM.begin() + 3 * (n - 2), T);
+        else
+        {
+          ++nb_fallback;
+          tb.errs[k] = err ? err : 1;
+          TRI_BATCH::fan(nodes, n, 1, 0, T);
+        }
+      }
+    }
+
+    tb.nb_hard = nb_hard;
+    tb.nb_fallback = nb_fallback;
+
+    return 0;
+  }
+}
+
+#endif
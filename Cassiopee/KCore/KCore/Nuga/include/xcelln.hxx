@@ -52,10 +52,10 @@ namespace NUGA
       outdata_t xcelln(ncells, OUT);
       if (mask_bits.empty()) return xcelln;// completely visible
 
-      std::vector<E_Int> cands;
-      std::vector<aelt_t> bits, tmpbits; // one clip can produce several bits
+      std::vector<aelt_t> bits; // one clip can produce several bits
 
-      for (size_t i = 0; i < ncells; ++i)
+#pragma omp parallel for private(bits) schedule(dynamic) if(parent_t::_omp_cells)
+      for (E_Int i = 0; i < (E_Int)ncells; ++i)
       {
         color_t const & idata = wdata[i];
 
@@ -273,7 +273,8 @@ namespace NUGA
     const std::vector<K_FLD::FloatArray> &mask_crds, const std::vector<K_FLD::IntArray>& mask_cnts,
     std::vector< std::vector<E_Int>> &mask_wall_ids,
     const std::vector<K_SEARCH::BBox3D>& comp_boxes,
-    typename classifyer_t::outdata_t& z_xcelln, E_Float RTOL)
+    typename classifyer_t::outdata_t& z_xcelln, E_Float RTOL,
+    const std::vector<typename classifyer_t::bmesh_t*>* mask_cache = nullptr, bool omp_cells = false)
   {
     //using zmesh_t = typename classifyer_t::zmesh_t;
     using bmesh_t = typename classifyer_t::bmesh_t;
@@ -281,6 +282,7 @@ namespace NUGA
     E_Int err(0);
 
     classifyer_t classs(RTOL);
+    classs.set_omp_cells(omp_cells);
 
 #ifdef DEBUG_XCELLN
     std::cout << "MOVLP_xcelln_1zone : PREPARE " << std::endl;
@@ -288,7 +290,7 @@ namespace NUGA
 
     std::vector<bmesh_t*> mask_meshes;
     bmesh_t WP, WNP;
-    classs.prepare(z_mesh, mask_crds, mask_cnts, mask_wall_ids, comp_boxes, z_priorities, rank_wnp, mask_meshes, WP, WNP);
+    classs.prepare(z_mesh, mask_crds, mask_cnts, mask_wall_ids, comp_boxes, z_priorities, rank_wnp, mask_meshes, WP, WNP, mask_cache);
 
 #ifdef DEBUG_XCELLN
     std::cout << "MOVLP_xcelln_1zone : COMPUTE " << std::endl;
@@ -351,23 +353,47 @@ namespace NUGA
       }
     }
 
+    // mask cache : each component mask and its localizer are built once and shared read-only by all the zones
+    using bmesh_t = typename classifyer_t::bmesh_t;
+    E_Int nb_masks = std::min<E_Int>(nb_comps, mask_crds.size());
+    std::vector<bmesh_t*> mask_cache(nb_comps, nullptr);
+
+#pragma omp parallel for schedule(dynamic)
+    for (E_Int c = 0; c < nb_masks; ++c)
+    {
+      if (mask_cnts[c].cols() == 0) continue;
+      bmesh_t* m = new bmesh_t(mask_crds[c], mask_cnts[c], 1/* ASSUME DIRECT UPEN ENTRY*/);
+      m->build_localizer();
+      mask_cache[c] = m;
+    }
 
-#ifndef NETBEANSZ
-//#pragma omp parallel for
-#endif
+    // big zones (more nodes than a thread's share) are processed one at a time with a parallel loop over their cells,
+    // the others are streamed through the threads, one zone per task
+    E_Int nb_threads = __NUMTHREADS__;
+    E_Int nb_tot_nodes(0);
+    for (E_Int z = 0; z < nb_zones; ++z) nb_tot_nodes += crds[z].cols();
+
+    std::vector<E_Int> big_zones, small_zones;
     for (E_Int z = 0; z < nb_zones; ++z)
     {
+      if (nb_threads > 1 && crds[z].cols() * nb_threads > nb_tot_nodes) big_zones.push_back(z);
+      else small_zones.push_back(z);
+    }
 
+    bool has_err(false);
+
+    auto process_zone = [&](E_Int z, bool omp_cells)
+    {
 #ifdef DEBUG_XCELLN
       //if (z != 29) continue;
       std::cout << "processing zone : " << z << " from comp " << comp_id[z] << std::endl;
 #endif
 
       auto it = sorted_comps_per_comp.find(comp_id[z]);
-      if (it == sorted_comps_per_comp.end()) continue;
+      if (it == sorted_comps_per_comp.end()) return E_Int(0);
 
       E_Int z_rank_wnp = rank_wnps[it->first];
-      IntVec& z_priorities = it->second;
+      const IntVec& z_priorities = it->second;
 
 #ifdef DEBUG_XCELLN
       //NUGA::chrono c;
@@ -387,11 +413,27 @@ namespace NUGA
 
       zm.set_boundary_type(BCWALL, zone_wall_ids[z]);// only implemented for volumes due to double wall management
             
-      E_Int err = MOVLP_xcelln_1zone<classifyer_t>(zm, z_priorities, z_rank_wnp, mask_crds, mask_cnts, mask_wall_ids, comp_boxes, xcelln[z], RTOL);
-      if (err) break;
+      E_Int err = MOVLP_xcelln_1zone<classifyer_t>(zm, z_priorities, z_rank_wnp, mask_crds, mask_cnts, mask_wall_ids, comp_boxes, xcelln[z], RTOL, &mask_cache, omp_cells);
 
       //std::cout << "processed in : " << c.elapsed() << " s." << std::endl;
+      return err;
+    };
+
+    for (size_t i = 0; (i < big_zones.size()) && !has_err; ++i)
+      has_err = (process_zone(big_zones[i], true) != 0);
+
+    // as in the former serial loop, zones are no longer processed once an error occured
+    // (with the reduction, each thread stops at its own first error)
+    E_Int nb_small = has_err ? 0 : small_zones.size();
+#pragma omp parallel for schedule(dynamic) reduction(||:has_err)
+    for (E_Int i = 0; i < nb_small; ++i)
+    {
+      if (has_err) continue;
+      has_err = (process_zone(small_zones[i], false) != 0);
     }
+
+    for (size_t c = 0; c < mask_cache.size(); ++c)
+      delete mask_cache[c];
   }
 
 }
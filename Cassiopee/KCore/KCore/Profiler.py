@@ -0,0 +1,129 @@
+# Profileur de phases (timers imbriques, compteurs, memoire)
+# Les phases ouvertes en python et celles des noyaux C++ (K_PROFILE) sont
+# enregistrees dans la meme trace. Aucune synchronisation entre rangs :
+# chaque rang ecrit son fichier, les fichiers sont fusionnes ensuite.
+#
+# Exemple :
+# import KCore.Profiler as Profiler
+# Profiler.enable(rank=Cmpi.rank)
+# with Profiler.phase('setInterpData'): ...
+# Profiler.dump('trace_%d.json')
+# if Cmpi.rank == 0: Profiler.merge(['trace_%d.json'%i for i in range(Cmpi.size)], 'trace.json')
+import os
+import sys
+import json
+from . import kcore
+
+__RANK__ = 0
+
+#==============================================================================
+# Rang du process : rang MPI s'il est connu par l'environnement, 0 sinon
+#==============================================================================
+def getRank__():
+    for v in ['OMPI_COMM_WORLD_RANK', 'PMI_RANK', 'PMIX_RANK', 'MV2_COMM_WORLD_RANK']:
+        if v in os.environ: return int(os.environ[v])
+    return 0
+
+#==============================================================================
+# Active (ou desactive) l'enregistrement des phases
+# IN: rank: rang du process dans la trace (par defaut lu dans l'environnement)
+#==============================================================================
+def enable(active=True, rank=None):
+    """Enable or disable phase profiling."""
+    global __RANK__
+    if rank is None: rank = getRank__()
+    __RANK__ = rank
+    kcore.profilerEnable(int(active), rank)
+    return None
+
+#==============================================================================
+# Ouvre une phase
+# IN: memory: releve la memoire en fin de phase (toujours fait pour les phases
+# de premier niveau)
+#==============================================================================
+def begin(name, memory=False):
+    """Open a phase."""
+    kcore.profilerBegin(name, int(memory))
+    return None
+
+def end():
+    """Close the last opened phase."""
+    kcore.profilerEnd()
+    return None
+
+def counter(name, value):
+    """Record the value of a counter."""
+    kcore.profilerCounter(name, float(value))
+    return None
+
+def reset():
+    """Clear recorded phases and counters."""
+    kcore.profilerReset()
+    return None
+
+#==============================================================================
+# Phase limitee a un bloc with
+#==============================================================================
+class phase:
+    """Phase context manager."""
+    def __init__(self, name, memory=False):
+        self.name = name
+        self.memory = memory
+    def __enter__(self):
+        kcore.profilerBegin(self.name, int(self.memory))
+        return self
+    def __exit__(self, exc_type, exc_value, traceback):
+        kcore.profilerEnd()
+        return False
+
+#==============================================================================
+# Memoire du process en ko
+#==============================================================================
+def getMemory():
+    """Return process memory (kB): rss, peakRss, heap."""
+    (rss, peakRss, heap) = kcore.profilerGetMemory()
+    return {'rss':rss, 'peakRss':peakRss, 'heap':heap}
+
+#==============================================================================
+# Cumul par phase (et phase englobante) du rang courant
+# OUT: [[nom, nombre d'appels, temps total (s), temps max (s), pic de RSS (ko),
+# phase englobante ('' au premier niveau)]]
+#==============================================================================
+def getSummary():
+    """Return per phase statistics of this rank."""
+    return kcore.profilerGetSummary()
+
+def printSummary():
+    """Print per phase statistics of this rank."""
+    stats = kcore.profilerGetSummary()
+    stats.sort(key=lambda s: -s[2])
+    print('Info: profiler [rank %d]:'%__RANK__)
+    for s in stats:
+        name = s[0] if s[5] == '' else s[5]+' > '+s[0]
+        mem = ', peak RSS {:.1f} MB'.format(s[4]/1000.) if s[4] > 0. else ''
+        print('{:<50} : {:>6} calls, {:10.4f}s (max {:.4f}s){}'.format(name, s[1], s[2], s[3], mem))
+    sys.stdout.flush()
+    return None
+
+#==============================================================================
+# Ecrit la trace du rang courant (format Chrome trace)
+# IN: fileName: nom du fichier, %d est remplace par le rang
+#==============================================================================
+def dump(fileName):
+    """Write the trace of this rank."""
+    if '%d' in fileName: fileName = fileName%__RANK__
+    kcore.profilerDump(fileName)
+    return fileName
+
+#==============================================================================
+# Fusionne des traces de rangs differents en une seule trace
+# Les temps sont ceux de l'horloge systeme de chaque rang.
+#==============================================================================
+def merge(fileNames, fileOut):
+    """Merge several rank traces into one trace file."""
+    events = []
+    for f in fileNames:
+        with open(f, 'r') as fp: events += json.load(fp)['traceEvents']
+    with open(fileOut, 'w') as fp:
+        json.dump({'traceEvents':events, 'displayTimeUnit':'ms'}, fp)
+    return None
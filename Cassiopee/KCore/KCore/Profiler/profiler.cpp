@@ -0,0 +1,270 @@
+/*
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+# include "Profiler/profiler.h"
+# include <chrono>
+# include <mutex>
+# include <map>
+# include <stdio.h>
+# include <string.h>
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+#if defined(__linux__)
+# include <sys/resource.h>
+# include <unistd.h>
+# include <malloc.h>
+#endif
+
+using namespace std;
+
+namespace K_PROFILER
+{
+  E_Bool _active = false;
+
+  // Phase terminee ou compteur (dur < 0)
+  struct Event
+  {
+    string name;
+    string parent; // phase englobante
+    E_Float ts;  // us depuis l'epoque
+    E_Float dur; // us
+    E_Float value; // compteur ou pic de RSS (ko)
+    E_Float rss, heap; // ko, en fin de phase
+    E_Bool mem; // memoire relevee en fin de phase
+  };
+
+  // Donnees propres a un thread : seul ce thread les modifie
+  struct ThreadData
+  {
+    E_Int tid;
+    vector<Event> events;
+    vector<Event> open; // pile des phases ouvertes
+  };
+
+  static mutex _lock; // enregistrement des threads, dump, reset
+  static vector<ThreadData*> _threads;
+  static E_Int _rank = 0;
+  static thread_local ThreadData* _local = NULL;
+
+  //===========================================================================
+  // Temps en us. L'horloge monotone est recalee sur l'horloge systeme une
+  // fois pour toutes : les traces des differents rangs sont ainsi comparables
+  // sans synchronisation.
+  //===========================================================================
+  static E_Float now()
+  {
+    using namespace std::chrono;
+    static const E_Float offset =
+      duration<E_Float, micro>(system_clock::now().time_since_epoch()).count()
+      - duration<E_Float, micro>(steady_clock::now().time_since_epoch()).count();
+    return offset + duration<E_Float, micro>(steady_clock::now().time_since_epoch()).count();
+  }
+
+  static ThreadData* local()
+  {
+    if (_local == NULL)
+    {
+      _local = new ThreadData;
+      lock_guard<mutex> g(_lock);
+      _local->tid = _threads.size();
+      _threads.push_back(_local);
+    }
+    return _local;
+  }
+
+  //===========================================================================
+  // RSS courante, pic de RSS et tas alloue (ko)
+  // Cout non negligeable (lecture de /proc, verrous de malloc) : n'est appele
+  // qu'en fin des phases qui le demandent.
+  //===========================================================================
+  static void processMemory(E_Float& rss, E_Float& peakRss, E_Float& heap)
+  {
+    rss = 0.; peakRss = 0.; heap = 0.;
+#if defined(__linux__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) peakRss = usage.ru_maxrss;
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (f != NULL)
+    {
+      long size, resident;
+      if (fscanf(f, "%ld %ld", &size, &resident) == 2)
+        rss = resident*(sysconf(_SC_PAGESIZE)/1024.);
+      fclose(f);
+    }
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 mi = mallinfo2();
+    heap = (mi.uordblks + mi.hblkhd)/1024.;
+#endif
+#endif
+  }
+}
+
+//=============================================================================
+void K_PROFILER::enable(E_Bool active)
+{
+  now(); // fixe l'origine des temps
+  _active = active;
+}
+
+//=============================================================================
+void K_PROFILER::setRank(E_Int rank)
+{
+  _rank = rank;
+}
+
+//=============================================================================
+void K_PROFILER::begin(const char* name, E_Bool memory)
+{
+  if (!_active) return;
+  ThreadData* td = local();
+  Event e;
+  e.name = name; e.ts = now(); e.dur = 0.; e.value = 0.;
+  e.rss = 0.; e.heap = 0.;
+  // premier niveau : pile vide, hors region parallele
+  E_Bool top = td->open.empty();
+#ifdef _OPENMP
+  if (omp_in_parallel()) top = false;
+#endif
+  if (!td->open.empty()) e.parent = td->open.back().name;
+  e.mem = top || memory;
+  td->open.push_back(e);
+}
+
+//=============================================================================
+// Une phase ouverte avant la desactivation du profileur est quand meme fermee
+//=============================================================================
+void K_PROFILER::end()
+{
+  ThreadData* td = _local;
+  if (td == NULL || td->open.empty()) return;
+  Event e = td->open.back(); td->open.pop_back();
+  e.dur = now()-e.ts;
+  if (e.mem) processMemory(e.rss, e.value, e.heap);
+  td->events.push_back(e);
+}
+
+//=============================================================================
+void K_PROFILER::counter(const char* name, E_Float value)
+{
+  if (!_active) return;
+  ThreadData* td = local();
+  Event e;
+  e.name = name; e.ts = now(); e.dur = -1.; e.value = value;
+  e.rss = 0.; e.heap = 0.; e.mem = false;
+  td->events.push_back(e);
+}
+
+//=============================================================================
+void K_PROFILER::getMemory(E_Float& rss, E_Float& peakRss, E_Float& heap)
+{
+  processMemory(rss, peakRss, heap);
+}
+
+//=============================================================================
+void K_PROFILER::getSummary(vector<PhaseStat>& stats)
+{
+  lock_guard<mutex> g(_lock);
+  map<string, size_t> pos;
+  stats.clear();
+  for (size_t t = 0; t < _threads.size(); t++)
+  {
+    const vector<Event>& events = _threads[t]->events;
+    for (size_t i = 0; i < events.size(); i++)
+    {
+      const Event& e = events[i];
+      if (e.dur < 0.) continue;
+      string key = e.parent + '\n' + e.name;
+      map<string, size_t>::iterator it = pos.find(key);
+      if (it == pos.end())
+      {
+        PhaseStat s;
+        s.name = e.name; s.parent = e.parent;
+        s.count = 0; s.total = 0.; s.max = 0.; s.peakRss = 0.;
+        it = pos.insert(make_pair(key, stats.size())).first;
+        stats.push_back(s);
+      }
+      PhaseStat& s = stats[it->second];
+      E_Float d = e.dur*1.e-6;
+      s.count++; s.total += d;
+      if (d > s.max) s.max = d;
+      if (e.mem && e.value > s.peakRss) s.peakRss = e.value;
+    }
+  }
+}
+
+//=============================================================================
+// Ecrit un nom de phase en echappant les caracteres speciaux JSON
+//=============================================================================
+static void writeName(FILE* f, const string& name)
+{
+  fputc('"', f);
+  for (size_t i = 0; i < name.size(); i++)
+  {
+    char c = name[i];
+    if (c == '"' || c == '\\') { fputc('\\', f); fputc(c, f); }
+    else if ((unsigned char)c < 32) fputc(' ', f);
+    else fputc(c, f);
+  }
+  fputc('"', f);
+}
+
+//=============================================================================
+/* Format Chrome trace : une phase = evenement complet ("X"), un compteur =
+   evenement "C". pid = rang, tid = thread. */
+//=============================================================================
+E_Int K_PROFILER::dump(const char* fileName)
+{
+  FILE* f = fopen(fileName, "w");
+  if (f == NULL) return 1;
+
+  lock_guard<mutex> g(_lock);
+  fprintf(f, "{\"traceEvents\":[\n");
+  fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%ld,\"tid\":0,"
+          "\"args\":{\"name\":\"rank %ld\"}}", long(_rank), long(_rank));
+  for (size_t t = 0; t < _threads.size(); t++)
+  {
+    const ThreadData& td = *_threads[t];
+    for (size_t i = 0; i < td.events.size(); i++)
+    {
+      const Event& e = td.events[i];
+      fprintf(f, ",\n{\"name\":");
+      writeName(f, e.name);
+      if (e.dur >= 0. && e.mem)
+        fprintf(f, ",\"ph\":\"X\",\"pid\":%ld,\"tid\":%ld,\"ts\":%.3f,\"dur\":%.3f,"
+                "\"args\":{\"rss_kB\":%.0f,\"peakRss_kB\":%.0f,\"heap_kB\":%.0f}}",
+                long(_rank), long(td.tid), e.ts, e.dur, e.rss, e.value, e.heap);
+      else if (e.dur >= 0.)
+        fprintf(f, ",\"ph\":\"X\",\"pid\":%ld,\"tid\":%ld,\"ts\":%.3f,\"dur\":%.3f}",
+                long(_rank), long(td.tid), e.ts, e.dur);
+      else
+        fprintf(f, ",\"ph\":\"C\",\"pid\":%ld,\"tid\":%ld,\"ts\":%.3f,"
+                "\"args\":{\"value\":%.17g}}", long(_rank), long(td.tid), e.ts, e.value);
+    }
+  }
+  fprintf(f, "\n],\n\"displayTimeUnit\":\"ms\"}\n");
+  fclose(f);
+  return 0;
+}
+
+//=============================================================================
+void K_PROFILER::reset()
+{
+  lock_guard<mutex> g(_lock);
+  for (size_t t = 0; t < _threads.size(); t++) _threads[t]->events.clear();
+}
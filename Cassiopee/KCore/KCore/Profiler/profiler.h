@@ -0,0 +1,99 @@
+/*
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef _KCORE_PROFILER_H_
+#define _KCORE_PROFILER_H_
+
+# include "Def/DefTypes.h"
+# include <string>
+# include <vector>
+
+//=============================================================================
+/* Profileur de phases : timers imbriques, compteurs et suivi memoire.
+   Inactif par defaut (un seul test par appel). Une fois active, chaque
+   thread empile ses phases dans son propre tampon, sans verrou ni barriere.
+   Chaque rang ecrit son fichier de trace (format Chrome trace / JSON) ;
+   les fichiers des rangs sont fusionnes ensuite (KCore.Profiler.merge).
+
+   Exemple :
+   {
+     K_PROFILE("buildAdt");
+     ...
+     K_PROFILER::counter("nbPts", npts);
+   }
+*/
+//=============================================================================
+namespace K_PROFILER
+{
+  extern E_Bool _active;
+
+  /* Active/desactive l'enregistrement */
+  void enable(E_Bool active);
+  inline E_Bool isEnabled() { return _active; }
+
+  /* Rang utilise comme identifiant de processus dans la trace */
+  void setRank(E_Int rank);
+
+  /* Debut/fin d'une phase du thread courant. La memoire du process n'est
+     relevee en fin de phase que pour les phases de premier niveau ou si
+     memory est vrai : les phases imbriquees ne paient que le chrono. */
+  void begin(const char* name, E_Bool memory=false);
+  void end();
+
+  /* Valeur d'un compteur a l'instant courant */
+  void counter(const char* name, E_Float value);
+
+  /* Memoire du process (en ko) : RSS courante, pic de RSS, tas alloue */
+  void getMemory(E_Float& rss, E_Float& peakRss, E_Float& heap);
+
+  /* Cumul par phase et phase englobante (tous threads) */
+  struct PhaseStat
+  {
+    std::string name;
+    std::string parent; // phase englobante ("" au premier niveau)
+    E_Int count;
+    E_Float total; // s
+    E_Float max;   // s
+    E_Float peakRss; // ko, en fin de phase (0 si non releve)
+  };
+  void getSummary(std::vector<PhaseStat>& stats);
+
+  /* Ecrit la trace du rang courant. Retourne 0 si ok. */
+  E_Int dump(const char* fileName);
+
+  /* Efface les phases et compteurs enregistres */
+  void reset();
+
+  /* Phase limitee a la portee courante */
+  class Scope
+  {
+    public:
+      Scope(const char* name, E_Bool memory=false) : _on(_active) { if (_on) begin(name, memory); }
+      ~Scope() { if (_on) end(); }
+    private:
+      Scope(const Scope&);
+      Scope& operator=(const Scope&);
+      E_Bool _on;
+  };
+}
+
+#define K_PROFILE_CAT2(a, b) a##b
+#define K_PROFILE_CAT(a, b) K_PROFILE_CAT2(a, b)
+#define K_PROFILE(name) K_PROFILER::Scope K_PROFILE_CAT(_kprofScope, __LINE__)(name)
+
+#endif
@@ -35,8 +35,17 @@ static PyMethodDef Pykcore [] =
   {"setOmpMaxThreads", K_KCORE::setOmpMaxThreads, METH_VARARGS},
   {"getOmpMaxThreads", K_KCORE::getOmpMaxThreads, METH_VARARGS},
   {"empty", K_KCORE::empty, METH_VARARGS},
+  {"spdSolveBatch", K_KCORE::spdSolveBatch, METH_VARARGS},
   {"tester", K_KCORE::tester, METH_VARARGS},
   {"testerAcc", K_KCORE::testerAcc, METH_VARARGS},
+  {"profilerEnable", K_KCORE::profilerEnable, METH_VARARGS},
+  {"profilerBegin", K_KCORE::profilerBegin, METH_VARARGS},
+  {"profilerEnd", K_KCORE::profilerEnd, METH_VARARGS},
+  {"profilerCounter", K_KCORE::profilerCounter, METH_VARARGS},
+  {"profilerGetMemory", K_KCORE::profilerGetMemory, METH_VARARGS},
+  {"profilerGetSummary", K_KCORE::profilerGetSummary, METH_VARARGS},
+  {"profilerDump", K_KCORE::profilerDump, METH_VARARGS},
+  {"profilerReset", K_KCORE::profilerReset, METH_VARARGS},
   {NULL, NULL}
 };
 
@@ -34,6 +34,7 @@
 #include "Linear/linear.h"
 #include "Metric/metric.h"
 #include "Math/math.h"
+#include "Profiler/profiler.h"
 #include "Nuga/include/KdTree.h"
 //#include "Memory/unique_ptr.hpp"
 //#include "Memory/shared_ptr.hpp"
@@ -56,9 +57,18 @@ namespace K_KCORE
   PyObject* setOmpMaxThreads(PyObject* self, PyObject* args);
   PyObject* getOmpMaxThreads(PyObject* self, PyObject* args);
   PyObject* empty(PyObject* self, PyObject* args);
+  PyObject* spdSolveBatch(PyObject* self, PyObject* args);
   PyObject* tester(PyObject* self, PyObject* args);
   PyObject* testerAcc(PyObject* self, PyObject* args);
   PyObject* activation(PyObject* self, PyObject* args);
+  PyObject* profilerEnable(PyObject* self, PyObject* args);
+  PyObject* profilerBegin(PyObject* self, PyObject* args);
+  PyObject* profilerEnd(PyObject* self, PyObject* args);
+  PyObject* profilerCounter(PyObject* self, PyObject* args);
+  PyObject* profilerGetMemory(PyObject* self, PyObject* args);
+  PyObject* profilerGetSummary(PyObject* self, PyObject* args);
+  PyObject* profilerDump(PyObject* self, PyObject* args);
+  PyObject* profilerReset(PyObject* self, PyObject* args);
   int activation(const char* name=NULL);
   void memcpy__(E_Int* a, E_Int* b, E_Int s);
   void memcpy__(E_Float* a, E_Float* b, E_Int s);
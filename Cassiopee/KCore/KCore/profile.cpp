@@ -0,0 +1,127 @@
+/*
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+# include "kcore.h"
+
+//=============================================================================
+/* Active/desactive le profileur de phases
+   IN: active: 0 ou 1
+   IN: rank: rang du process (identifiant du process dans la trace) */
+//=============================================================================
+PyObject* K_KCORE::profilerEnable(PyObject* self, PyObject* args)
+{
+  E_Int active, rank;
+  if (!PYPARSETUPLE_(args, II_, &active, &rank)) return NULL;
+  K_PROFILER::setRank(rank);
+  K_PROFILER::enable(active);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+//=============================================================================
+/* Ouvre une phase
+   IN: memory: 1 pour relever la memoire en fin de phase (toujours fait pour
+   les phases de premier niveau) */
+//=============================================================================
+PyObject* K_KCORE::profilerBegin(PyObject* self, PyObject* args)
+{
+  char* name; E_Int memory;
+  if (!PYPARSETUPLE_(args, S_ I_, &name, &memory)) return NULL;
+  K_PROFILER::begin(name, memory != 0);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+//=============================================================================
+/* Ferme la derniere phase ouverte */
+//=============================================================================
+PyObject* K_KCORE::profilerEnd(PyObject* self, PyObject* args)
+{
+  K_PROFILER::end();
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+//=============================================================================
+/* Enregistre la valeur d'un compteur */
+//=============================================================================
+PyObject* K_KCORE::profilerCounter(PyObject* self, PyObject* args)
+{
+  char* name; E_Float value;
+  if (!PYPARSETUPLE_(args, S_ R_, &name, &value)) return NULL;
+  K_PROFILER::counter(name, value);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+//=============================================================================
+/* Retourne la memoire du process en ko : (RSS, pic de RSS, tas alloue) */
+//=============================================================================
+PyObject* K_KCORE::profilerGetMemory(PyObject* self, PyObject* args)
+{
+  E_Float rss, peakRss, heap;
+  K_PROFILER::getMemory(rss, peakRss, heap);
+  return Py_BuildValue("(ddd)", double(rss), double(peakRss), double(heap));
+}
+
+//=============================================================================
+/* Retourne le cumul par phase du rang courant :
+   [[nom, nombre d'appels, temps total (s), temps max (s), pic de RSS (ko),
+     phase englobante], ...] */
+//=============================================================================
+PyObject* K_KCORE::profilerGetSummary(PyObject* self, PyObject* args)
+{
+  std::vector<K_PROFILER::PhaseStat> stats;
+  K_PROFILER::getSummary(stats);
+  PyObject* l = PyList_New(0);
+  for (size_t i = 0; i < stats.size(); i++)
+  {
+    K_PROFILER::PhaseStat& s = stats[i];
+    PyObject* tpl = Py_BuildValue("[slddds]", s.name.c_str(), long(s.count),
+                                  double(s.total), double(s.max), double(s.peakRss),
+                                  s.parent.c_str());
+    PyList_Append(l, tpl); Py_DECREF(tpl);
+  }
+  return l;
+}
+
+//=============================================================================
+/* Ecrit la trace (format Chrome trace) du rang courant */
+//=============================================================================
+PyObject* K_KCORE::profilerDump(PyObject* self, PyObject* args)
+{
+  char* fileName;
+  if (!PYPARSETUPLE_(args, S_, &fileName)) return NULL;
+  if (K_PROFILER::dump(fileName) != 0)
+  {
+    PyErr_SetString(PyExc_IOError, "profilerDump: can not open file.");
+    return NULL;
+  }
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+//=============================================================================
+/* Efface les phases et compteurs enregistres */
+//=============================================================================
+PyObject* K_KCORE::profilerReset(PyObject* self, PyObject* args)
+{
+  K_PROFILER::reset();
+  Py_INCREF(Py_None);
+  return Py_None;
+}
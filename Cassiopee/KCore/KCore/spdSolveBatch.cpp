@@ -0,0 +1,72 @@
+/*    
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "kcore.h"
+
+//=============================================================================
+// Resolution de n systemes symetriques definis positifs 3x3 ou 6x6 par
+// K_LINEAR::spd3_solve_batch / spd6_solve_batch (tests et usage python)
+// IN: A: numpy (6,n) ou (21,n): triangle superieur des matrices (SoA)
+// IN: b: numpy (3,n) ou (6,n): seconds membres (SoA)
+// IN: tol: tolerance relative sur les pivots
+// OUT: (x, nsing): solutions (3,n) ou (6,n) et nombre de systemes singuliers
+//=============================================================================
+PyObject* K_KCORE::spdSolveBatch(PyObject* self, PyObject* args)
+{
+  PyObject* Ao; PyObject* bo; E_Float tol;
+  if (!PYPARSETUPLE_(args, OO_ R_, &Ao, &bo, &tol)) return NULL;
+
+  E_Float* A; E_Int sizeA, nfldA;
+  E_Int ret = K_NUMPY::getFromNumpyArray(Ao, A, sizeA, nfldA, true);
+  if (ret == 0)
+  {
+    PyErr_SetString(PyExc_TypeError, "spdSolveBatch: A must be a numpy array.");
+    return NULL;
+  }
+  E_Float* b; E_Int sizeb, nfldb;
+  ret = K_NUMPY::getFromNumpyArray(bo, b, sizeb, nfldb, true);
+  if (ret == 0)
+  {
+    Py_DECREF(Ao);
+    PyErr_SetString(PyExc_TypeError, "spdSolveBatch: b must be a numpy array.");
+    return NULL;
+  }
+
+  E_Int p = 0;
+  if (nfldA == 6) p = 3;
+  else if (nfldA == 21) p = 6;
+  if (p == 0 || nfldb != p || sizeb != sizeA)
+  {
+    Py_DECREF(Ao); Py_DECREF(bo);
+    PyErr_SetString(PyExc_ValueError,
+                    "spdSolveBatch: A must be (6,n) or (21,n) and b (3,n) or (6,n).");
+    return NULL;
+  }
+
+  PyObject* xo = K_NUMPY::buildNumpyArray(sizeA, p, 0, 0);
+  E_Float* x = K_NUMPY::getNumpyPtrF(xo);
+  E_Int nsing;
+  if (p == 3) nsing = K_LINEAR::spd3_solve_batch(sizeA, A, b, x, tol);
+  else nsing = K_LINEAR::spd6_solve_batch(sizeA, A, b, x, tol);
+
+  Py_DECREF(Ao); Py_DECREF(bo);
+  PyObject* tpl = Py_BuildValue("(Ol)", xo, (long)nsing);
+  Py_DECREF(xo);
+  return tpl;
+}
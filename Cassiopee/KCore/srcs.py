@@ -8,7 +8,9 @@ JPEG = True
 #==============================================================================
 cpp_srcs = ['KCore/isNamePresent.cpp',
             'KCore/OmpMaxThreads.cpp',
+            'KCore/profile.cpp',
             'KCore/empty.cpp',
+            'KCore/spdSolveBatch.cpp',
             'KCore/tester.cpp',
             'KCore/testerAcc.cpp',
             'KCore/Def/DefCplusPlusConst.cpp',
@@ -118,6 +120,7 @@ cpp_srcs = ['KCore/isNamePresent.cpp',
             'KCore/Linear/cholesky.cpp',
             'KCore/Linear/BiCGStab.cpp',
             'KCore/Linear/eigen2.cpp',
+            'KCore/Linear/batch.cpp',
             'KCore/Search/OctreeNode.cpp',
             'KCore/Noise/random.cpp',
             'KCore/Noise/perlin.cpp',
@@ -138,6 +141,7 @@ cpp_srcs = ['KCore/isNamePresent.cpp',
             'KCore/Logger/log_to_std_error.cpp',
             'KCore/Logger/log_to_file.cpp',
             'KCore/Logger/log_from_distributed_file.cpp',
+            'KCore/Profiler/profiler.cpp',
             'KCore/Math/math.cpp'
             ]
 if PNG:
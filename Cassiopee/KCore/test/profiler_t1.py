@@ -0,0 +1,48 @@
+# - Profiler -
+# phases imbriquees, phases C++ (K_PROFILE), fusion des traces de deux rangs
+import KCore.Profiler as Profiler
+import Converter.PyTree as C
+import Generator.PyTree as G
+import tempfile, shutil, os, json
+import KCore.test as test
+
+def run():
+    with Profiler.phase('outer'):
+        for i in range(3):
+            with Profiler.phase('inner'): a = [0.]*1000
+        Profiler.counter('npts', len(a))
+        # phase C++ dans une phase python
+        z = G.cart((0,0,0), (1,1,1), (10,10,10))
+        hook = C.createHook(z, 'adt')
+        C.freeHook(hook)
+
+# Nombre d'appels et phase englobante
+Profiler.enable(rank=0)
+run()
+stats = Profiler.getSummary()
+calls = sorted([[s[0], s[1], s[5]] for s in stats])
+test.testO(calls, 1)
+test.testO(['InterpAdt::buildStructAdt', 1, 'outer'] in calls, 2)
+
+# Memoire relevee seulement en fin de phase de premier niveau
+mem = dict([(s[0], s[4]) for s in stats])
+test.testO(mem['outer'] > 0 and mem['inner'] == 0 and mem['InterpAdt::buildStructAdt'] == 0, 3)
+
+# Fusion des traces de deux rangs
+tmp = tempfile.mkdtemp()
+f0 = Profiler.dump(os.path.join(tmp, 'trace_%d.json'))
+Profiler.reset()
+Profiler.enable(rank=1)
+run()
+f1 = Profiler.dump(os.path.join(tmp, 'trace_%d.json'))
+out = os.path.join(tmp, 'trace.json')
+Profiler.merge([f0, f1], out)
+with open(out, 'r') as fp: events = json.load(fp)['traceEvents']
+shutil.rmtree(tmp)
+Profiler.enable(False)
+
+pids = sorted(set([e['pid'] for e in events]))
+outer = [e['pid'] for e in events if e['ph'] == 'X' and e['name'] == 'outer']
+inner = [e['pid'] for e in events if e['ph'] == 'X' and e['name'] == 'inner']
+test.testO([pids, sorted(outer), len(inner)], 4)
+test.testO([pids, sorted(outer), len(inner)] == [[0, 1], [0, 1], 6], 5)
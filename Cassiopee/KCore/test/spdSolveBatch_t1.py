@@ -0,0 +1,30 @@
+# - spdSolveBatch (numpy) -
+import KCore
+import numpy
+import KCore.test as test
+
+# n systemes SPD 3x3 et 6x6 stockes SoA (triangle superieur)
+def packed(M):
+    p = M.shape[1]
+    return numpy.array([M[:,r,c] for r in range(p) for c in range(r,p)])
+
+numpy.random.seed(1)
+n = 1000
+for c, p in enumerate([3,6]):
+    R = numpy.random.rand(n, 2*p, p)
+    M = numpy.einsum('nki,nkj->nij', R, R) # tR.R
+    b = numpy.random.rand(p, n)
+    x, nsing = KCore.spdSolveBatch(packed(M), b, 1.e-12)
+    xref = numpy.linalg.solve(M, b.T[:,:,None])[:,:,0].T
+    test.testO(nsing, 2*c+1)
+    test.testO(numpy.allclose(x, xref, rtol=1.e-8, atol=1.e-10), 2*c+2)
+
+# systemes semi-definis (direction z absente, comme en 2D) :
+# la composante z est mise a 0
+R = numpy.random.rand(n, 6, 3); R[:,:,2] = 0.
+M = numpy.einsum('nki,nkj->nij', R, R)
+xref = numpy.random.rand(3, n); xref[2,:] = 0.
+b = numpy.einsum('nij,jn->in', M, xref)
+x, nsing = KCore.spdSolveBatch(packed(M), b, 1.e-12)
+test.testO(nsing, 5)
+test.testO(numpy.allclose(x, xref, rtol=1.e-8, atol=1.e-10), 6)
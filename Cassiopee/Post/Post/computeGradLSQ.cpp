@@ -103,28 +103,6 @@ void correct_A_grad_matrices(K_FLD::FldArrayI &cn, E_Int *owner,
   }
 }
 
-static
-void deduce_lsq_grad_matrices(K_FLD::FldArrayI &cn, const E_Int *count_neis,
-  const E_Float *lsqG, E_Float *lsqGG)
-{
-  E_Int ncells = cn.getNElts();
-  E_Int *indPH = cn.getIndPH();
-
-  for (E_Int i = 0; i < ncells; i++) {
-    E_Float *pGG = &lsqGG[9*i];
-    const E_Float *pG = &lsqG[3*indPH[i]];
-    E_Int idx = 0;
-    for (E_Int j = 0; j < 3; j++) {
-      for (E_Int k = 0; k < 3; k++) {
-        pGG[idx] = 0.0;
-        for (E_Int l = 0; l < count_neis[i]; l++)
-          pGG[idx] += pG[l*3+j] * pG[l*3+k];
-        idx++;
-      }
-    }
-  }
-}
-
 static
 void make_RHS_vector(K_FLD::FldArrayI &cn, E_Int *count_neis, E_Int *owner,
   E_Int *neigh, const E_Float *Field, E_Float *b)
@@ -180,46 +158,20 @@ E_Int make_gradient(K_FLD::FldArrayI &cn, E_Int *count_neis, E_Float *b,
 {
   E_Int ncells = cn.getNElts();
   E_Int *indPH = cn.getIndPH();
-  
-  E_Int bad_gradient = 0;
-  E_Float B[3];
-  E_Float G[3];
-
-  for (E_Int i = 0; i < ncells; i++) {
-    // Construct B vector
-    E_Float *pG = &lsqG[3*indPH[i]];
-    E_Float *pb = &b[indPH[i]];
-    for (E_Int j = 0; j < 3; j++) {
-      B[j] = 0.0;
-      for (E_Int k = 0; k < count_neis[i]; k++)
-        B[j] += pb[k] * pG[k*3+j];
-    }
 
-    // Solve
-    E_Int converged = K_LINEAR::BiCGStab(&lsqGG[9*i], B, 3, G);
-
-    // Copy
-    gx[i] = G[0];
-    gy[i] = G[1];
-    gz[i] = G[2];
-
-    bad_gradient |= !converged;
-    if (!converged) {
-      printf("Gradient: BiCGStab not converged\n");
-      printf("Cell: " SF_D_ "\n", i);
-      E_Float *pt = &lsqGG[9*i];
-      for (E_Int j = 0; j < 3; j++) {
-        for (E_Int k = 0; k < 3; k++) {
-          printf("%.3e ", pt[3*j+k]);
-        }
-        puts("");
-      }
-      for (E_Int j = 0; j < 3; j++) {
-        printf("%.3e ", B[j]);
-      }
-      puts("");
-    }
-  }
+  // Construct B vectors and solve, all cells at once (SoA)
+  E_Float *B = (E_Float *)malloc(6*ncells * sizeof(E_Float));
+  E_Float *X = B + 3*ncells;
+
+  K_LINEAR::lsq_normal_batch(ncells, 3, indPH, count_neis, lsqG, b, NULL, B);
+
+  E_Int bad_gradient = K_LINEAR::spd3_solve_batch(ncells, lsqGG, B, X);
+
+  memcpy(gx, X, ncells*sizeof(E_Float));
+  memcpy(gy, X+ncells, ncells*sizeof(E_Float));
+  memcpy(gz, X+2*ncells, ncells*sizeof(E_Float));
+
+  free(B);
 
   return bad_gradient;
 }
@@ -321,8 +273,9 @@ PyObject *K_POST::computeGradLSQ(PyObject *self, PyObject *args)
   }
 
   // Deduce tAA matrices
-  E_Float *lsqGG = (E_Float *)malloc(9*ncells * sizeof(E_Float));
-  deduce_lsq_grad_matrices(*cn, count_neis, lsqG, lsqGG);
+  E_Float *lsqGG = (E_Float *)malloc(6*ncells * sizeof(E_Float));
+  K_LINEAR::lsq_normal_batch(ncells, 3, cn->getIndPH(), count_neis, lsqG, NULL,
+    lsqGG, NULL);
 
   E_Float *b = (E_Float *)malloc(sizeNFace * sizeof(E_Float));
 
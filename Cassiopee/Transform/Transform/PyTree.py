@@ -1787,6 +1787,127 @@ def _reorderAll(t, dir=1):
     zones = C.identifyBC(zones, allBCInfos)
     return None
 
+#=============================================================================
+# Renumber elements, faces and vertices of unstructured zones for memory
+# locality (method='morton', 'hilbert' or 'rcm').
+# Fields, BC/GC/subregion point lists and donor point lists of the zones
+# of t are updated consistently.
+# Faces of BE zones are numbered indElt*nfaces+noFace: they follow their
+# element. There is no such numbering for ME zones: ME zones with
+# FaceCenter point lists or fields are left unchanged.
+#=============================================================================
+def renumber(t, method='hilbert'):
+    tp = Internal.copyRef(t)
+    _renumber(tp, method)
+    return tp
+
+def _renumber(t, method='hilbert'):
+    m = Transform.getRenumberMethod__(method)
+    bases = Internal.getBases(t)
+    if bases != []: zones = [(b[0], z) for b in bases for z in Internal.getZones(b)]
+    else: zones = [('', z) for z in Internal.getZones(t)]
+    perms = {} # 'Base/Zone' -> old2new for cells, faces, vertices
+    for (bname, z) in zones:
+        if Internal.getZoneType(z) != 2: continue
+        a = C.getFields(Internal.__GridCoordinates__, z, api=3)[0]
+        if ',' in a[3] and hasFaceLocation__(z): continue # ME
+        b, cperm, fperm, pperm = transform.renumber(a, m)
+        # les sections frontieres (BE/ME) ne sont pas reecrites par setFields
+        enames = [e[0] for e in Internal.getNodesFromType1(z, 'Elements_t')]
+        bnds = Internal.getElementBoundaryNodes(z)
+        C.setFields([b], z, 'nodes')
+        perm = [invertPerm__(cperm), invertPerm__(fperm), invertPerm__(pperm)]
+        if fperm is None and a[3] in NFACES__:
+            # faces BE : indElt*nf+noFace suivent leur element
+            nf = NFACES__[a[3]]
+            i = numpy.arange(cperm.size*nf, dtype=Internal.E_NpyInt)
+            perm[1] = perm[0][i//nf]*nf + i%nf
+            fperm = invertPerm__(perm[1])
+        for e in bnds:
+            if e[1][0] == 22 or e[1][0] == 23: continue
+            cn = Internal.getNodeFromName1(e, 'ElementConnectivity')
+            cn[1] = perm[2][cn[1]-1]+1
+        if bnds != []:
+            elts = Internal.getNodesFromType1(z, 'Elements_t')
+            for e in elts: z[2].remove(e)
+            elts.sort(key=lambda e: enames.index(e[0]) if e[0] in enames else len(enames))
+            z[2] += elts
+            Internal._updateElementRange(z)
+        # champs de tous les conteneurs, suivant leur localisation
+        for cont in Internal.getNodesFromType1(z, 'FlowSolution_t')+\
+            Internal.getNodesFromType1(z, 'DiscreteData_t'):
+            loc = Internal.getNodeFromType1(cont, 'GridLocation_t')
+            if loc is None: loc = 'Vertex'
+            else: loc = Internal.getValue(loc)
+            if loc == 'CellCenter': p = cperm
+            elif loc == 'FaceCenter': p = fperm
+            elif loc == 'Vertex': p = pperm
+            else: continue
+            if p is None: continue
+            for n in Internal.getNodesFromType1(cont, 'DataArray_t'):
+                if n[1] is None or n[1].size != p.size: continue
+                n[1] = n[1].ravel('k')[p]
+        perms['%s/%s'%(bname, z[0])] = perm
+
+    for (bname, z) in zones:
+        zperm = perms.get('%s/%s'%(bname, z[0]), None)
+        for cont in Internal.getNodesFromType1(z, 'ZoneBC_t')+\
+            Internal.getNodesFromType1(z, 'ZoneGridConnectivity_t'):
+            for bc in cont[2]:
+                donor = None
+                if bc[3] in ['GridConnectivity_t', 'GridConnectivity1to1_t']:
+                    donor = getDonorPerm__(perms, bname, Internal.getValue(bc))
+                _renumberPointLists__(bc, zperm, donor)
+        for zsr in Internal.getNodesFromType1(z, 'ZoneSubRegion_t'):
+            _renumberPointLists__(zsr, zperm, None)
+    return None
+
+# Nombre de faces par element BE
+NFACES__ = {'BAR':2, 'TRI':3, 'QUAD':4, 'TETRA':4, 'PYRA':5, 'PENTA':5, 'HEXA':6}
+
+# True if a BC, a join, a subregion or a field container of z is at faces
+def hasFaceLocation__(z):
+    nodes = Internal.getNodesFromType1(z, 'FlowSolution_t')+\
+        Internal.getNodesFromType1(z, 'DiscreteData_t')+\
+        Internal.getNodesFromType1(z, 'ZoneSubRegion_t')
+    for cont in Internal.getNodesFromType1(z, 'ZoneBC_t')+\
+        Internal.getNodesFromType1(z, 'ZoneGridConnectivity_t'): nodes += cont[2]
+    for n in nodes:
+        loc = Internal.getNodeFromType1(n, 'GridLocation_t')
+        if loc is not None and Internal.getValue(loc) == 'FaceCenter': return True
+    return False
+
+# Permutations of the donor zone : donorName is 'Base/Zone' or a zone name,
+# looked for first in the base of the current zone
+def getDonorPerm__(perms, bname, donorName):
+    if '/' in donorName: return perms.get(donorName, None)
+    p = perms.get('%s/%s'%(bname, donorName), None)
+    if p is not None: return p
+    l = [perms[k] for k in perms if k.rsplit('/', 1)[-1] == donorName]
+    if len(l) == 1: return l[0]
+    return None
+
+def invertPerm__(perm):
+    if perm is None: return None
+    inv = numpy.empty(perm.size, dtype=Internal.E_NpyInt)
+    inv[perm] = numpy.arange(perm.size, dtype=Internal.E_NpyInt)
+    return inv
+
+# Renumber PointList (with perm) and PointListDonor (with donor) of node
+def _renumberPointLists__(node, perm, donor):
+    loc = Internal.getNodeFromType1(node, 'GridLocation_t')
+    if loc is None: loc = 'Vertex'
+    else: loc = Internal.getValue(loc)
+    if loc == 'CellCenter': i = 0
+    elif loc == 'FaceCenter': i = 1
+    else: i = 2
+    for name, p in [('PointList', perm), ('PointListDonor', donor)]:
+        if p is None or p[i] is None: continue
+        pl = Internal.getNodeFromName1(node, name)
+        if pl is None or pl[1] is None: continue
+        pl[1] = p[i][pl[1]-1]+1
+    return None
+
 #=============================================================================
 # Align I,J,K directions of a Cartesian mesh with X,Y,Z axes
 # Order the mesh such that it is direct
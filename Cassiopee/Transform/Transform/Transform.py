@@ -18,7 +18,7 @@ __all__ = ['_translate', 'translate', 'addkplane', 'breakElements', 'cart2Cyl',
     'computeDeformationVector', '_contract', 'contract', 'cyl2Cart', '_cyl2Cart', 'deform', 'deformNormals', 'deformPoint', 
     'dual', '_homothety', 'homothety', 'join', 'makeCartesianXYZ', 'makeDirect', 'merge', 'mergeCart', 
     'mergeCartByRefinementLevel', 'oneovern', 'patch', 'perturbate', 'projectAllDirs', 'projectDir', 
-    'projectOrtho', 'projectOrthoSmooth', 'projectRay', 'reorder', 'reorderAll', 
+    'projectOrtho', 'projectOrthoSmooth', 'projectRay', 'renumber', 'reorder', 'reorderAll', 
     'rotate', '_rotate', '_scale', 'scale', 
     'smooth', 'splitBAR', 'splitConnexity', 'splitCurvatureAngle', 'splitCurvatureRadius', 'splitManifold', 
     'splitMultiplePts', 'splitNParts', 'splitSharpEdges', 'splitSize', 'splitTBranches', 
@@ -901,6 +901,24 @@ def reorderAll(arrays, dir=1):
     elif btype == 4: return transform.reorderAllUnstr(arrays, dir)
     else: raise TypeError("reorderAll: blocks types are not supported.")
 
+# numero des methodes de renumber
+RENUMBER_METHODS = {'morton':0, 'hilbert':1, 'rcm':2}
+
+def getRenumberMethod__(method):
+    if method not in RENUMBER_METHODS:
+        raise ValueError("renumber: method must be 'morton', 'hilbert' or 'rcm'.")
+    return RENUMBER_METHODS[method]
+
+def renumber(a, method='hilbert'):
+    """Renumber elements, faces and vertices of an unstructured mesh to improve memory locality.
+    Usage: renumber(a, method)"""
+    m = getRenumberMethod__(method)
+    if isinstance(a[0], list):
+        b = []
+        for i in a: b.append(transform.renumber(i, m)[0])
+        return b
+    else: return transform.renumber(a, m)[0]
+
 def makeCartesianXYZ(a, tol=1.e-10):
     """Reorder a Cartesian mesh in order to get i,j,k aligned with X,Y,Z."""
     if isinstance(a[0], list):
@@ -0,0 +1,474 @@
+/*
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+# include "transform.h"
+# include "Connect/connect.h"
+# include <algorithm>
+
+using namespace K_FLD;
+using namespace std;
+
+// nbre de bits par direction des cles (3*21 = 63 bits)
+#define RENUMBER_NBITS 21
+
+//=============================================================================
+// Cle de Morton : entrelacement des bits de (x,y,z)
+//=============================================================================
+static inline unsigned long long mortonKey(unsigned int X[3])
+{
+  unsigned long long key = 0;
+  for (E_Int j = RENUMBER_NBITS-1; j >= 0; j--)
+    for (E_Int i = 0; i < 3; i++) key = (key << 1) | ((X[i] >> j) & 1);
+  return key;
+}
+
+//=============================================================================
+// Cle de Hilbert (J. Skilling, Programming the Hilbert curve, 2004) :
+// passage en coordonnees transposees puis entrelacement des bits
+//=============================================================================
+static inline unsigned long long hilbertKey(unsigned int X[3])
+{
+  unsigned int M = 1u << (RENUMBER_NBITS-1), P, Q, t;
+  for (Q = M; Q > 1; Q >>= 1)
+  {
+    P = Q-1;
+    for (E_Int i = 0; i < 3; i++)
+    {
+      if (X[i] & Q) X[0] ^= P;
+      else { t = (X[0]^X[i]) & P; X[0] ^= t; X[i] ^= t; }
+    }
+  }
+  X[1] ^= X[0]; X[2] ^= X[1];
+  t = 0;
+  for (Q = M; Q > 1; Q >>= 1) { if (X[2] & Q) t ^= Q-1; }
+  for (E_Int i = 0; i < 3; i++) X[i] ^= t;
+  return mortonKey(X);
+}
+
+//=============================================================================
+// Ordonne les elements suivant la cle de leur centre (method 0: morton,
+// 1: hilbert). xc, yc, zc: centres des elements.
+// perm(new) = old
+//=============================================================================
+static void sortByCurve(E_Int nelts, E_Float* xc, E_Float* yc, E_Float* zc,
+                        E_Int method, E_Int* perm)
+{
+  E_Float xmin = K_CONST::E_MAX_FLOAT, ymin = K_CONST::E_MAX_FLOAT;
+  E_Float zmin = K_CONST::E_MAX_FLOAT;
+  E_Float xmax = -K_CONST::E_MAX_FLOAT, ymax = -K_CONST::E_MAX_FLOAT;
+  E_Float zmax = -K_CONST::E_MAX_FLOAT;
+
+  #pragma omp parallel for reduction(min:xmin,ymin,zmin) reduction(max:xmax,ymax,zmax)
+  for (E_Int i = 0; i < nelts; i++)
+  {
+    xmin = K_FUNC::E_min(xmin, xc[i]); xmax = K_FUNC::E_max(xmax, xc[i]);
+    ymin = K_FUNC::E_min(ymin, yc[i]); ymax = K_FUNC::E_max(ymax, yc[i]);
+    zmin = K_FUNC::E_min(zmin, zc[i]); zmax = K_FUNC::E_max(zmax, zc[i]);
+  }
+
+  // meme pas dans les trois directions : la courbe suit la geometrie
+  E_Float dmax = K_FUNC::E_max(xmax-xmin, K_FUNC::E_max(ymax-ymin, zmax-zmin));
+  E_Float scale = (dmax > 0.) ? ((1 << RENUMBER_NBITS)-1)/dmax : 0.;
+
+  vector< pair<unsigned long long, E_Int> > keys(nelts);
+
+  #pragma omp parallel for
+  for (E_Int i = 0; i < nelts; i++)
+  {
+    unsigned int X[3];
+    X[0] = (unsigned int)((xc[i]-xmin)*scale);
+    X[1] = (unsigned int)((yc[i]-ymin)*scale);
+    X[2] = (unsigned int)((zc[i]-zmin)*scale);
+    if (method == 0) keys[i].first = mortonKey(X);
+    else keys[i].first = hilbertKey(X);
+    keys[i].second = i;
+  }
+
+  sort(keys.begin(), keys.end());
+
+  #pragma omp parallel for
+  for (E_Int i = 0; i < nelts; i++) perm[i] = keys[i].second;
+}
+
+//=============================================================================
+// Reverse Cuthill-McKee sur le graphe des elements voisins cEEN
+// perm(new) = old
+//=============================================================================
+static void sortByRCM(vector< vector<E_Int> >& cEEN, E_Int* perm)
+{
+  E_Int nelts = cEEN.size();
+  vector<E_Int> deg(nelts);
+  for (E_Int i = 0; i < nelts; i++) deg[i] = cEEN[i].size();
+
+  // elements par degre croissant : germes des composantes connexes
+  vector<E_Int> seeds(nelts);
+  for (E_Int i = 0; i < nelts; i++) seeds[i] = i;
+  stable_sort(seeds.begin(), seeds.end(),
+              [&](E_Int a, E_Int b) { return deg[a] < deg[b]; });
+
+  vector<E_Int> visited(nelts, 0);
+  E_Int n = 0, head = 0;
+  for (E_Int s = 0; s < nelts; s++)
+  {
+    E_Int seed = seeds[s];
+    if (visited[seed]) continue;
+    visited[seed] = 1; perm[n++] = seed;
+    while (head < n)
+    {
+      E_Int e = perm[head++];
+      E_Int first = n;
+      for (size_t k = 0; k < cEEN[e].size(); k++)
+      {
+        E_Int v = cEEN[e][k];
+        if (!visited[v]) { visited[v] = 1; perm[n++] = v; }
+      }
+      stable_sort(perm+first, perm+n,
+                  [&](E_Int a, E_Int b) { return deg[a] < deg[b]; });
+    }
+  }
+  reverse(perm, perm+nelts);
+}
+
+//=============================================================================
+/* Renumerotation des elements, faces et noeuds d'un maillage non structure
+   pour la localite memoire : courbe de Morton (0), de Hilbert (1) ou
+   Reverse Cuthill-McKee (2) sur les elements, puis faces et noeuds par
+   ordre de premiere visite.
+   Retourne [array, cellPerm, facePerm, pointPerm] avec perm(new) = old
+   (facePerm est None pour les maillages par elements) */
+//=============================================================================
+PyObject* K_TRANSFORM::renumber(PyObject* self, PyObject* args)
+{
+  PyObject* array; E_Int method;
+  if (!PYPARSETUPLE_(args, O_ I_, &array, &method)) return NULL;
+
+  if (method < 0 || method > 2)
+  {
+    PyErr_SetString(PyExc_ValueError,
+                    "renumber: unknown method.");
+    return NULL;
+  }
+
+  E_Int ni, nj, nk;
+  FldArrayF* f; FldArrayI* cn;
+  char* varString; char* eltType;
+  E_Int res = K_ARRAY::getFromArray3(array, varString, f, ni, nj, nk,
+                                     cn, eltType);
+  if (res != 1 && res != 2)
+  {
+    PyErr_SetString(PyExc_TypeError,
+                    "renumber: unknown type of array.");
+    return NULL;
+  }
+  if (res == 1)
+  {
+    PyErr_SetString(PyExc_TypeError,
+                    "renumber: can not be used on a structured array.");
+    RELEASESHAREDS(array, f); return NULL;
+  }
+
+  E_Int posx = K_ARRAY::isCoordinateXPresent(varString);
+  E_Int posy = K_ARRAY::isCoordinateYPresent(varString);
+  E_Int posz = K_ARRAY::isCoordinateZPresent(varString);
+  if (posx == -1 || posy == -1 || posz == -1)
+  {
+    PyErr_SetString(PyExc_TypeError,
+                    "renumber: coordinates not found in array.");
+    RELEASESHAREDU(array, f, cn); return NULL;
+  }
+  posx++; posy++; posz++;
+  E_Float* x = f->begin(posx); E_Float* y = f->begin(posy);
+  E_Float* z = f->begin(posz);
+
+  E_Int npts = f->getSize(), nfld = f->getNfld(), api = f->getApi();
+  if (api == 2) api = 3;
+
+  PyObject* tpl = NULL;
+  PyObject* cellPerm = NULL; PyObject* facePerm = NULL;
+  PyObject* pointPerm = NULL;
+  vector<E_Int> indirNodes(npts, -1); // old -> new
+  vector<E_Int> listOfNodes; listOfNodes.reserve(npts); // new -> old
+
+  if (K_STRING::cmp(eltType, "NGON") == 0) // NGON
+  {
+    E_Int shift = 1; if (api == 3) shift = 0;
+    E_Int ngonType = 1; // CGNSv3 compact array1
+    if (api == 2) ngonType = 2; // CGNSv3, array2
+    else if (api == 3) ngonType = 3; // force CGNSv4, array3
+
+    E_Int *ngon = cn->getNGon(), *indPG = cn->getIndPG();
+    E_Int *nface = cn->getNFace(), *indPH = cn->getIndPH();
+    E_Int sizeFN = cn->getSizeNGon(), sizeEF = cn->getSizeNFace();
+    E_Int nfaces = cn->getNFaces(), nelts = cn->getNElts();
+
+    cellPerm = K_NUMPY::buildNumpyArray(nelts, 1, 1, 1);
+    E_Int* cperm = K_NUMPY::getNumpyPtrI(cellPerm);
+
+    // Ordre des elements
+    if (method == 2)
+    {
+      FldArrayI cFE; K_CONNECT::connectNG2FE(*cn, cFE);
+      vector< vector<E_Int> > cEEN(nelts);
+      K_CONNECT::connectFE2EENbrs(cFE, cEEN);
+      sortByRCM(cEEN, cperm);
+    }
+    else
+    {
+      FldArrayF fc(nelts, 3);
+      E_Float* xc = fc.begin(1); E_Float* yc = fc.begin(2);
+      E_Float* zc = fc.begin(3);
+      #pragma omp parallel for
+      for (E_Int i = 0; i < nelts; i++)
+      {
+        E_Int nf, np, nv = 0;
+        E_Float xs = 0., ys = 0., zs = 0.;
+        E_Int* elt = cn->getElt(i, nf, nface, indPH);
+        for (E_Int j = 0; j < nf; j++)
+        {
+          E_Int* face = cn->getFace(std::abs(elt[j])-1, np, ngon, indPG);
+          for (E_Int k = 0; k < np; k++)
+          {
+            E_Int ind = face[k]-1;
+            xs += x[ind]; ys += y[ind]; zs += z[ind];
+          }
+          nv += np;
+        }
+        E_Float inv = (nv > 0) ? 1./nv : 0.;
+        xc[i] = xs*inv; yc[i] = ys*inv; zc[i] = zs*inv;
+      }
+      sortByCurve(nelts, xc, yc, zc, method, cperm);
+    }
+
+    // Faces par ordre de premiere visite
+    facePerm = K_NUMPY::buildNumpyArray(nfaces, 1, 1, 1);
+    E_Int* fperm = K_NUMPY::getNumpyPtrI(facePerm);
+    vector<E_Int> indirFaces(nfaces, -1);
+    E_Int nf, np, nfo = 0;
+    for (E_Int i = 0; i < nelts; i++)
+    {
+      E_Int* elt = cn->getElt(cperm[i], nf, nface, indPH);
+      for (E_Int j = 0; j < nf; j++)
+      {
+        E_Int indf = std::abs(elt[j])-1;
+        if (indirFaces[indf] == -1) { indirFaces[indf] = nfo; fperm[nfo++] = indf; }
+      }
+    }
+    for (E_Int i = 0; i < nfaces; i++) // faces orphelines
+    {
+      if (indirFaces[i] == -1) { indirFaces[i] = nfo; fperm[nfo++] = i; }
+    }
+
+    // Noeuds par ordre de premiere visite
+    for (E_Int i = 0; i < nfaces; i++)
+    {
+      E_Int* face = cn->getFace(fperm[i], np, ngon, indPG);
+      for (E_Int k = 0; k < np; k++)
+      {
+        E_Int ind = face[k]-1;
+        if (indirNodes[ind] == -1)
+        { indirNodes[ind] = listOfNodes.size(); listOfNodes.push_back(ind); }
+      }
+    }
+
+    // noeuds isoles : gardes en fin
+    for (E_Int i = 0; i < npts; i++)
+    {
+      if (indirNodes[i] == -1) { indirNodes[i] = listOfNodes.size(); listOfNodes.push_back(i); }
+    }
+
+    // construit l'array de sortie
+    tpl = K_ARRAY::buildArray3(nfld, varString, npts, nelts, nfaces,
+                               "NGON", sizeFN, sizeEF, ngonType, false, api);
+    FldArrayF* f2; FldArrayI* cn2;
+    K_ARRAY::getFromArray3(tpl, f2, cn2);
+    E_Int *ngon2 = cn2->getNGon(), *nface2 = cn2->getNFace();
+    E_Int *indPG2 = NULL, *indPH2 = NULL;
+    if (api == 3) { indPG2 = cn2->getIndPG(); indPH2 = cn2->getIndPH(); }
+
+    // offsets des faces et elements renumerotes
+    vector<E_Int> posFaces(nfaces+1), posElts(nelts+1);
+    posFaces[0] = 0; posElts[0] = 0;
+    for (E_Int i = 0; i < nfaces; i++)
+    {
+      cn->getFace(fperm[i], np, ngon, indPG);
+      posFaces[i+1] = posFaces[i] + np + shift;
+    }
+    for (E_Int i = 0; i < nelts; i++)
+    {
+      cn->getElt(cperm[i], nf, nface, indPH);
+      posElts[i+1] = posElts[i] + nf + shift;
+    }
+
+    #pragma omp parallel default(shared)
+    {
+      E_Int nf, np;
+      #pragma omp for
+      for (E_Int i = 0; i < nfaces; i++)
+      {
+        E_Int* face = cn->getFace(fperm[i], np, ngon, indPG);
+        E_Int* face2 = ngon2 + posFaces[i];
+        if (shift == 1) face2[0] = np;
+        for (E_Int k = 0; k < np; k++) face2[k+shift] = indirNodes[face[k]-1]+1;
+      }
+      #pragma omp for
+      for (E_Int i = 0; i < nelts; i++)
+      {
+        E_Int* elt = cn->getElt(cperm[i], nf, nface, indPH);
+        E_Int* elt2 = nface2 + posElts[i];
+        if (shift == 1) elt2[0] = nf;
+        // le signe de la face (orientation dans l'element) est conserve
+        for (E_Int j = 0; j < nf; j++)
+        {
+          if (elt[j] > 0) elt2[j+shift] = indirFaces[elt[j]-1]+1;
+          else elt2[j+shift] = -indirFaces[-elt[j]-1]-1;
+        }
+      }
+      if (api == 3)
+      {
+        #pragma omp for nowait
+        for (E_Int i = 0; i <= nfaces; i++) indPG2[i] = posFaces[i];
+        #pragma omp for nowait
+        for (E_Int i = 0; i <= nelts; i++) indPH2[i] = posElts[i];
+      }
+      for (E_Int eq = 1; eq <= nfld; eq++)
+      {
+        E_Float* fp = f->begin(eq);
+        E_Float* f2p = f2->begin(eq);
+        #pragma omp for
+        for (E_Int i = 0; i < npts; i++) f2p[i] = fp[listOfNodes[i]];
+      }
+    }
+    RELEASESHAREDU(tpl, f2, cn2);
+  }
+  else // maillage par elements BE/ME
+  {
+    E_Int nc = cn->getNConnect();
+    if (method == 2 && nc > 1)
+    {
+      PyErr_SetString(PyExc_TypeError,
+                      "renumber: rcm is not available for multi-element arrays.");
+      RELEASESHAREDU(array, f, cn); return NULL;
+    }
+
+    vector<E_Int> neltspc(nc+1); neltspc[0] = 0;
+    for (E_Int ic = 0; ic < nc; ic++)
+      neltspc[ic+1] = neltspc[ic] + cn->getConnect(ic)->getSize();
+    E_Int nelts = neltspc[nc];
+
+    cellPerm = K_NUMPY::buildNumpyArray(nelts, 1, 1, 1);
+    E_Int* cperm = K_NUMPY::getNumpyPtrI(cellPerm);
+
+    // Ordre des elements, par connectivite
+    for (E_Int ic = 0; ic < nc; ic++)
+    {
+      FldArrayI& cm = *(cn->getConnect(ic));
+      E_Int ne = cm.getSize(), nvpe = cm.getNfld();
+      E_Int* cp = cperm + neltspc[ic];
+      if (method == 2)
+      {
+        vector< vector<E_Int> > cEEN(ne);
+        K_CONNECT::connectEV2EENbrs(eltType, npts, cm, cEEN);
+        sortByRCM(cEEN, cp);
+      }
+      else
+      {
+        FldArrayF fc(ne, 3);
+        E_Float* xc = fc.begin(1); E_Float* yc = fc.begin(2);
+        E_Float* zc = fc.begin(3);
+        E_Float inv = 1./nvpe;
+        #pragma omp parallel for
+        for (E_Int i = 0; i < ne; i++)
+        {
+          E_Float xs = 0., ys = 0., zs = 0.;
+          for (E_Int v = 1; v <= nvpe; v++)
+          {
+            E_Int ind = cm(i,v)-1;
+            xs += x[ind]; ys += y[ind]; zs += z[ind];
+          }
+          xc[i] = xs*inv; yc[i] = ys*inv; zc[i] = zs*inv;
+        }
+        sortByCurve(ne, xc, yc, zc, method, cp);
+      }
+      for (E_Int i = 0; i < ne; i++) cp[i] += neltspc[ic];
+    }
+
+    // Noeuds par ordre de premiere visite
+    for (E_Int ic = 0; ic < nc; ic++)
+    {
+      FldArrayI& cm = *(cn->getConnect(ic));
+      E_Int ne = cm.getSize(), nvpe = cm.getNfld();
+      for (E_Int i = 0; i < ne; i++)
+      {
+        E_Int e = cperm[neltspc[ic]+i]-neltspc[ic];
+        for (E_Int v = 1; v <= nvpe; v++)
+        {
+          E_Int ind = cm(e,v)-1;
+          if (indirNodes[ind] == -1)
+          { indirNodes[ind] = listOfNodes.size(); listOfNodes.push_back(ind); }
+        }
+      }
+    }
+
+    // noeuds isoles : gardes en fin
+    for (E_Int i = 0; i < npts; i++)
+    {
+      if (indirNodes[i] == -1) { indirNodes[i] = listOfNodes.size(); listOfNodes.push_back(i); }
+    }
+
+    vector<E_Int> neltspc2(nc);
+    for (E_Int ic = 0; ic < nc; ic++) neltspc2[ic] = neltspc[ic+1]-neltspc[ic];
+    tpl = K_ARRAY::buildArray3(nfld, varString, npts, neltspc2,
+                               eltType, false, api);
+    FldArrayF* f2; FldArrayI* cn2;
+    K_ARRAY::getFromArray3(tpl, f2, cn2);
+
+    #pragma omp parallel default(shared)
+    {
+      for (E_Int ic = 0; ic < nc; ic++)
+      {
+        FldArrayI& cm = *(cn->getConnect(ic));
+        FldArrayI& cm2 = *(cn2->getConnect(ic));
+        E_Int ne = cm.getSize(), nvpe = cm.getNfld();
+        #pragma omp for
+        for (E_Int i = 0; i < ne; i++)
+        {
+          E_Int e = cperm[neltspc[ic]+i]-neltspc[ic];
+          for (E_Int v = 1; v <= nvpe; v++) cm2(i,v) = indirNodes[cm(e,v)-1]+1;
+        }
+      }
+      for (E_Int eq = 1; eq <= nfld; eq++)
+      {
+        E_Float* fp = f->begin(eq);
+        E_Float* f2p = f2->begin(eq);
+        #pragma omp for
+        for (E_Int i = 0; i < npts; i++) f2p[i] = fp[listOfNodes[i]];
+      }
+    }
+    RELEASESHAREDU(tpl, f2, cn2);
+  }
+
+  pointPerm = K_NUMPY::buildNumpyArray(&listOfNodes[0], npts, 1, 1);
+
+  RELEASESHAREDU(array, f, cn);
+
+  if (facePerm == NULL) { Py_INCREF(Py_None); facePerm = Py_None; }
+  PyObject* l = Py_BuildValue("[OOOO]", tpl, cellPerm, facePerm, pointPerm);
+  Py_DECREF(tpl); Py_DECREF(cellPerm); Py_DECREF(facePerm); Py_DECREF(pointPerm);
+  return l;
+}
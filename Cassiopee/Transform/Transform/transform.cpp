@@ -75,6 +75,7 @@ static PyMethodDef PyTransform[] =
   {"reorder", K_TRANSFORM::reorder, METH_VARARGS},
   {"reorderAll", K_TRANSFORM::reorderAll, METH_VARARGS},
   {"reorderAllUnstr", K_TRANSFORM::reorderAllUnstr, METH_VARARGS},
+  {"renumber", K_TRANSFORM::renumber, METH_VARARGS},
   {"addkplane", K_TRANSFORM::addkplane, METH_VARARGS},
   {"addkplaneCenters", K_TRANSFORM::addkplaneCenters, METH_VARARGS},
   {"splitCurvatureAngle", K_TRANSFORM::splitCurvatureAngle, METH_VARARGS},
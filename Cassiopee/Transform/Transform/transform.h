@@ -325,6 +325,7 @@ namespace K_TRANSFORM
   PyObject* reorder(PyObject* self, PyObject* args);
   PyObject* reorderAll(PyObject* self, PyObject* args);
   PyObject* reorderAllUnstr(PyObject* self, PyObject* args);
+  PyObject* renumber(PyObject* self, PyObject* args);
   PyObject* addkplane(PyObject* self, PyObject* args);
   PyObject* addkplaneCenters(PyObject* self, PyObject* args);
 
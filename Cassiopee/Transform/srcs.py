@@ -28,6 +28,7 @@ cpp_srcs = ["Transform/coordTransform.cpp",
             "Transform/addkplane.cpp",
             "Transform/reorderAll.cpp",
             "Transform/reorderAllUnstr.cpp",
+            "Transform/renumber.cpp",
             "Transform/projectDir.cpp",
             "Transform/projectOrtho.cpp",
             "Transform/projectOrthoSmooth.cpp",
@@ -0,0 +1,8 @@
+# - renumber (array) -
+import Generator as G
+import Transform as T
+import Converter as C
+
+a = G.cartNGon((0,0,0), (1,1,1), (10,10,10))
+a = T.renumber(a, method='hilbert')
+C.convertArrays2File(a, 'out.plt')
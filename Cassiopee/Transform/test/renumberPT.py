@@ -0,0 +1,10 @@
+# - renumber (pyTree) -
+import Generator.PyTree as G
+import Transform.PyTree as T
+import Converter.PyTree as C
+
+a = G.cartNGon((0,0,0), (1,1,1), (10,10,10))
+C._initVars(a, '{centers:F}={centers:CoordinateX}')
+a = C.addBC2Zone(a, 'wall', 'BCWall', faceList=[1,2,3])
+a = T.renumber(a, method='hilbert')
+C.convertPyTree2File(a, 'out.cgns')
@@ -0,0 +1,30 @@
+# - renumber (pyTree) -
+import Generator.PyTree as G
+import Transform.PyTree as T
+import Converter.PyTree as C
+import Converter.Internal as Internal
+import Post.PyTree as P
+import KCore.test as test
+
+# NGON with center fields and BCs
+a = G.cartNGon((0,0,0), (1,1,1), (6,7,5))
+C._initVars(a, '{centers:F}={centers:CoordinateX}+2*{centers:CoordinateY}')
+C._initVars(a, '{G}={CoordinateZ}')
+a = C.addBC2Zone(a, 'wall', 'BCWall', faceList=[1,2,3,4])
+b = T.renumber(a, method='hilbert')
+test.testT(b, 1)
+
+# fields must follow the elements
+c = C.node2Center(b, 'CoordinateX'); c = C.node2Center(c, 'CoordinateY')
+C._initVars(c, '{centers:E}=abs({centers:F}-{centers:CoordinateX}-2*{centers:CoordinateY})')
+test.testO(C.getMaxValue(c, 'centers:E') < 1.e-12, 2)
+
+# BC faces must be the same faces
+w1 = C.extractBCOfName(a, 'wall'); w2 = C.extractBCOfName(b, 'wall')
+test.testO(abs(P.integ(w1, 'G')[0]-P.integ(w2, 'G')[0]) < 1.e-12, 3)
+
+# TETRA
+a = G.cartTetra((0,0,0), (1,1,1), (6,7,5))
+C._initVars(a, '{centers:F}={centers:CoordinateX}')
+b = T.renumber(a, method='morton')
+test.testT(b, 4)
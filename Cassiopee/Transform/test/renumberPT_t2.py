@@ -0,0 +1,71 @@
+# - renumber (pyTree) -
+# multi-zone NGON : node fields, BCs, joins and signed NFACE
+import Generator.PyTree as G
+import Transform.PyTree as T
+import Converter.PyTree as C
+import Converter.Internal as Internal
+import Connector.PyTree as X
+import Post.PyTree as P
+import numpy
+import KCore.test as test
+
+a = G.cartNGon((0,0,0), (1,1,1), (6,7,5))
+a = T.splitNParts(a, 2)
+t = C.newPyTree(['Base', a])
+t = X.connectMatch(t)
+C._initVars(t, '{F}={CoordinateX}+2*{CoordinateY}+3*{CoordinateZ}')
+C._initVars(t, '{centers:G}={centers:CoordinateZ}')
+for z in Internal.getZones(t):
+    cont = Internal.newFlowSolution(name='SolVertex', gridLocation='Vertex', parent=z)
+    x = Internal.getNodeFromName2(z, 'CoordinateX')[1]
+    Internal.newDataArray('H', value=numpy.copy(x.ravel('k')), parent=cont)
+C._fillEmptyBCWith(t, 'wall', 'BCWall')
+# donor given by its path
+z1 = Internal.getZones(t)[1]
+j = Internal.getNodeFromType2(z1, 'GridConnectivity_t')
+Internal.setValue(j, 'Base/'+Internal.getValue(j))
+C._signNGonFaces(t)
+
+b = T.renumber(t, method='hilbert')
+test.testT(b, 1)
+
+# node fields of every container follow the vertices
+c = C.initVars(b, '{E}=abs({F}-{CoordinateX}-2*{CoordinateY}-3*{CoordinateZ})')
+test.testO(C.getMaxValue(c, 'E') < 1.e-12, 2)
+err = 0.
+for z in Internal.getZones(b):
+    x = Internal.getNodeFromName2(z, 'CoordinateX')[1].ravel('k')
+    h = Internal.getNodeFromName2(z, 'H')[1].ravel('k')
+    err = max(err, numpy.max(numpy.abs(x-h)))
+test.testO(err < 1.e-12, 3)
+
+# BC faces are the same faces
+w1 = C.extractBCOfType(t, 'BCWall'); w2 = C.extractBCOfType(b, 'BCWall')
+test.testO(abs(P.integ(w1, 'centers:G')[0]-P.integ(w2, 'centers:G')[0]) < 1.e-12, 4)
+
+# joined faces still face each other
+err = 0.
+zones = Internal.getZones(b)
+for z in zones:
+    for j in Internal.getNodesFromType2(z, 'GridConnectivity_t'):
+        zd = Internal.getNodeFromName(zones, Internal.getValue(j).split('/')[-1])
+        pl = Internal.getNodeFromName1(j, 'PointList')[1].ravel()
+        pld = Internal.getNodeFromName1(j, 'PointListDonor')[1].ravel()
+        f1 = C.node2Center(T.subzone(z, pl, type='faces'))
+        f2 = C.node2Center(T.subzone(zd, pld, type='faces'))
+        for v in ['CoordinateX', 'CoordinateY', 'CoordinateZ']:
+            c1 = Internal.getNodeFromName2(f1, v)[1].ravel()
+            c2 = Internal.getNodeFromName2(f2, v)[1].ravel()
+            err = max(err, numpy.max(numpy.abs(c1-c2)))
+test.testO(err < 1.e-12, 5)
+
+# NFACE signs are kept : each interior face once positive, once negative
+ok = True
+for z in Internal.getZones(b):
+    nf = Internal.getNodeFromName1(z, 'NFaceElements')
+    nf = Internal.getNodeFromName1(nf, 'ElementConnectivity')[1]
+    if numpy.count_nonzero(nf < 0) == 0: ok = False
+    s = numpy.bincount(numpy.abs(nf)-1, weights=numpy.sign(nf))
+    n = numpy.bincount(numpy.abs(nf)-1)
+    if numpy.any(s[n == 2] != 0): ok = False
+test.testO(ok, 6)
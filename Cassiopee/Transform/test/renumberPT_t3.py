@@ -0,0 +1,42 @@
+# - renumber (pyTree) -
+# BE and ME zones with FaceCenter BCs
+import Generator.PyTree as G
+import Transform.PyTree as T
+import Converter.PyTree as C
+import Converter.Internal as Internal
+import numpy
+import KCore.test as test
+
+def faceCenters(z, bcname):
+    bc = Internal.getNodeFromName2(z, bcname)
+    pl = Internal.getNodeFromName1(bc, 'PointList')[1].ravel()
+    f = C.node2Center(T.subzone(z, pl, type='faces'))
+    c = [Internal.getNodeFromName2(f, v)[1].ravel() for v in ['CoordinateX', 'CoordinateY', 'CoordinateZ']]
+    c = numpy.vstack(c)
+    return c[:, numpy.lexsort(c[::-1])]
+
+# BE : faces (indElt*6+noFace) follow their element
+ni = 6; nj = 5; nk = 4
+a = G.cartHexa((0,0,0), (1,1,1), (ni,nj,nk))
+bottom = [6*e+1 for e in range((ni-1)*(nj-1))] # 1st face of the 1st layer (z=0)
+a = C.addBC2Zone(a, 'bottom', 'BCWall', faceList=bottom)
+b = T.renumber(a, method='hilbert')
+test.testT(b, 1)
+c1 = faceCenters(a, 'bottom'); c2 = faceCenters(b, 'bottom')
+test.testO(numpy.max(numpy.abs(c1-c2)) < 1.e-12 and numpy.max(numpy.abs(c2[2])) == 0., 2)
+
+# ME with a FaceCenter BC : left unchanged
+h = G.cartHexa((0,0,0), (1,1,1), (ni,nj,nk))
+t = G.cartTetra((0,0,nk-1), (1,1,1), (ni,nj,3))
+m = C.mergeConnectivity(h, t, boundary=0)
+mb = C.addBC2Zone(m, 'wall', 'BCWall', faceList=[1,2,3])
+b = T.renumber(mb, method='hilbert')
+ok = 1
+for v in ['CoordinateX', 'CoordinateY', 'CoordinateZ', 'ElementConnectivity', 'PointList']:
+    for n1, n2 in zip(Internal.getNodesFromName(mb, v), Internal.getNodesFromName(b, v)):
+        if not numpy.array_equal(n1[1], n2[1]): ok = 0
+test.testO(ok, 3)
+
+# ME without face data : renumbered
+b = T.renumber(m, method='hilbert')
+test.testT(b, 4)
@@ -0,0 +1,23 @@
+# - renumber (array) -
+import Generator as G
+import Transform as T
+import Converter as C
+import KCore.test as test
+
+# NGON
+a = G.cartNGon((0,0,0), (1,1,1), (6,7,5))
+a = C.initVars(a, '{F}={x}+2*{y}')
+b = T.renumber(a, method='hilbert')
+test.testA([b], 1)
+b = T.renumber(a, method='morton')
+test.testA([b], 2)
+b = T.renumber(a, method='rcm')
+test.testA([b], 3)
+
+# HEXA
+a = G.cartHexa((0,0,0), (1,1,1), (6,7,5))
+a = C.initVars(a, '{F}={x}+2*{y}')
+b = T.renumber(a, method='hilbert')
+test.testA([b], 4)
+b = T.renumber(a, method='rcm')
+test.testA([b], 5)
@@ -0,0 +1,76 @@
+/*
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// persistent_exchange.hpp
+#ifndef _CMP_PERSISTENT_EXCHANGE_HPP_
+#define _CMP_PERSISTENT_EXCHANGE_HPP_
+#include <cstddef>
+#include <vector>
+#include <mpi.h>
+
+namespace CMP {
+    /** \brief
+         Echanges repetes avec un ensemble fixe de voisins ( un canal = un voisin ).
+         Chaque canal enregistre une fois son buffer d'envoi et son buffer de reception
+         ( MPI_Send_init/MPI_Recv_init ). Les requetes ne sont recreees que si un buffer
+         change d'adresse ou de taille : un tour d'echange ne coute plus que start( ) + wait( ).
+     */
+    class PersistentExchange {
+    public:
+        PersistentExchange( MPI_Datatype type, MPI_Comm comm = MPI_COMM_WORLD );
+        ~PersistentExchange( );
+
+        PersistentExchange( const PersistentExchange& ) = delete;
+        PersistentExchange& operator=( const PersistentExchange& ) = delete;
+
+        /** Enregistre le canal c : envoi de scount elements de sbuf au rang rank ( tag stag ),
+            reception de rcount elements dans rbuf depuis rank ( tag rtag ). */
+        void bind( int c, int rank, const void* sbuf, int scount, int stag,
+                   void* rbuf, int rcount, int rtag );
+        /** Ne garde que les nchan premiers canaux */
+        void resize( int nchan );
+
+        void start( );          // Lance toutes les receptions puis tous les envois
+        bool test( );           // Fait progresser les echanges, vrai si tout est termine
+        int  wait_any_recv( );  // Indice d'un canal dont la reception est finie, -1 s'il n'y en a plus
+        void wait( );           // Attend la fin de tous les echanges
+
+        int  size( ) const { return (int)m_chan.size( ); }
+        bool active( ) const { return m_active; }
+        int  nb_binds( ) const { return m_nb_binds; }  // Nombre de requetes ( re )creees
+
+    private:
+        struct channel {
+            int         rank, scount, stag, rcount, rtag;
+            const void* sbuf;
+            void*       rbuf;
+            channel( ) : rank( -1 ), scount( -1 ), stag( -1 ), rcount( -1 ), rtag( -1 ), sbuf( NULL ), rbuf( NULL ) {}
+        };
+        void free_channel( int c );
+
+        MPI_Datatype             m_type;
+        MPI_Comm                 m_comm;
+        std::vector<channel>     m_chan;
+        std::vector<MPI_Request> m_sreq;
+        std::vector<MPI_Request> m_rreq;
+        bool                     m_active;
+        int                      m_nb_binds;
+    };
+}
+
+#endif
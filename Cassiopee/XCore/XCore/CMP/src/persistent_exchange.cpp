@@ -0,0 +1,106 @@
+/*
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// persistent_exchange.cpp
+#include <cassert>
+#include "CMP/include/persistent_exchange.hpp"
+
+namespace CMP {
+    PersistentExchange::PersistentExchange( MPI_Datatype type, MPI_Comm comm )
+        : m_type( type ), m_comm( comm ), m_chan( ), m_sreq( ), m_rreq( ), m_active( false ), m_nb_binds( 0 ) {}
+    // ------------------------------------------------------------------------------------------------
+    PersistentExchange::~PersistentExchange( ) {
+        if ( m_active ) wait( );
+        resize( 0 );
+    }
+    // ------------------------------------------------------------------------------------------------
+    void PersistentExchange::free_channel( int c ) {
+        if ( m_sreq[c] != MPI_REQUEST_NULL ) MPI_Request_free( &m_sreq[c] );
+        if ( m_rreq[c] != MPI_REQUEST_NULL ) MPI_Request_free( &m_rreq[c] );
+        m_chan[c] = channel( );
+    }
+    // ------------------------------------------------------------------------------------------------
+    void PersistentExchange::bind( int c, int rank, const void* sbuf, int scount, int stag,
+                                   void* rbuf, int rcount, int rtag ) {
+        assert( !m_active );
+        if ( c >= size( ) ) {
+            m_chan.resize( c + 1 );
+            m_sreq.resize( c + 1, MPI_REQUEST_NULL );
+            m_rreq.resize( c + 1, MPI_REQUEST_NULL );
+        }
+        channel& ch = m_chan[c];
+        if ( ch.rank == rank && ch.sbuf == sbuf && ch.scount == scount && ch.stag == stag &&
+             ch.rbuf == rbuf && ch.rcount == rcount && ch.rtag == rtag )
+            return;
+
+        free_channel( c );
+        ch.rank   = rank;
+        ch.sbuf   = sbuf;
+        ch.scount = scount;
+        ch.stag   = stag;
+        ch.rbuf   = rbuf;
+        ch.rcount = rcount;
+        ch.rtag   = rtag;
+        MPI_Send_init( const_cast<void*>( sbuf ), scount, m_type, rank, stag, m_comm, &m_sreq[c] );
+        MPI_Recv_init( rbuf, rcount, m_type, rank, rtag, m_comm, &m_rreq[c] );
+        m_nb_binds++;
+    }
+    // ------------------------------------------------------------------------------------------------
+    void PersistentExchange::resize( int nchan ) {
+        assert( !m_active );
+        for ( int c = nchan; c < size( ); c++ ) free_channel( c );
+        if ( nchan < size( ) ) {
+            m_chan.resize( nchan );
+            m_sreq.resize( nchan );
+            m_rreq.resize( nchan );
+        }
+    }
+    // ------------------------------------------------------------------------------------------------
+    void PersistentExchange::start( ) {
+        assert( !m_active );
+        if ( m_chan.empty( ) ) return;
+        // Receptions postees en premier pour eviter les messages inattendus
+        MPI_Startall( size( ), m_rreq.data( ) );
+        MPI_Startall( size( ), m_sreq.data( ) );
+        m_active = true;
+    }
+    // ------------------------------------------------------------------------------------------------
+    bool PersistentExchange::test( ) {
+        if ( !m_active ) return true;
+        int rdone = 0, sdone = 0;
+        MPI_Testall( size( ), m_rreq.data( ), &rdone, MPI_STATUSES_IGNORE );
+        MPI_Testall( size( ), m_sreq.data( ), &sdone, MPI_STATUSES_IGNORE );
+        if ( rdone && sdone ) m_active = false;
+        return !m_active;
+    }
+    // ------------------------------------------------------------------------------------------------
+    int PersistentExchange::wait_any_recv( ) {
+        if ( !m_active ) return -1;
+        int idx = MPI_UNDEFINED;
+        // Les requetes persistantes deja terminees sont inactives et ignorees par MPI_Waitany
+        MPI_Waitany( size( ), m_rreq.data( ), &idx, MPI_STATUS_IGNORE );
+        return idx == MPI_UNDEFINED ? -1 : idx;
+    }
+    // ------------------------------------------------------------------------------------------------
+    void PersistentExchange::wait( ) {
+        if ( !m_active ) return;
+        MPI_Waitall( size( ), m_rreq.data( ), MPI_STATUSES_IGNORE );
+        MPI_Waitall( size( ), m_sreq.data( ), MPI_STATUSES_IGNORE );
+        m_active = false;
+    }
+}
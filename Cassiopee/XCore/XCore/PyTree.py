@@ -3,6 +3,7 @@ import Converter.Mpi as Cmpi
 import Converter.Internal as I
 import Converter.PyTree as C
 from . import xcore
+import numpy
 
 # Returns for each zone, exchanged fields
 def exchangeFields(t, fldNames):
@@ -31,6 +32,85 @@ def exchangeFields(t, fldNames):
         rfields.append(xcore.exchangeFields(arr, pe[1], flds, comm_list))
     return rfields
 
+# Extends each zone of a partitioned NGON tree (from loadAndSplitNGon)
+# with nlayers of ghost cells taken from the neighbouring procs.
+# Ghost cells are numbered after the owned cells. The halo is described in 
+# the .Halo node. Returns the extended tree and a persistent halo handle per 
+# zone, used to refresh centers fields with _updateHalo.
+def buildHalo(t, nlayers=1):
+    """Build nlayers of ghost cells on a partitioned NGON tree."""
+    tp = I.copyRef(t)
+    handles = []
+    for base in I.getBases(tp):
+        for c, zone in enumerate(base[2]):
+            if zone[3] != 'Zone_t': continue
+            arr = C.getFields(I.__GridCoordinates__, zone, api=3)[0]
+            zgc = I.getNodeFromType1(zone, 'ZoneGridConnectivity_t')
+            if zgc is None: raise ValueError('buildHalo: ZoneGridConnectivity not found.')
+            cglob = I.getNodeFromName1(zgc, 'CellLoc2Glob')
+            fglob = I.getNodeFromName1(zgc, 'FaceLoc2Glob')
+            pglob = I.getNodeFromName1(zgc, 'PointLoc2Glob')
+            if cglob is None or fglob is None or pglob is None:
+                raise ValueError('buildHalo: Loc2Glob nodes not found.')
+            comm_list = []
+            for comm in I.getNodesFromType1(zgc, 'GridConnectivity1to1_t'):
+                nei_proc = int(I.getValue(comm))
+                ptlist = I.getNodeFromName1(comm, 'PointList')[1]
+                comm_list.append([nei_proc, ptlist.ravel()])
+            (h, mesh, cg, fg, pg, layer) = xcore.buildHaloNGon(arr, cglob[1], fglob[1], pglob[1], comm_list, nlayers)
+            ncells = cglob[1].size; nghost = layer.size
+
+            # local faces and points keep their numbering
+            zo = I.createZoneNode(zone[0], mesh)
+            for n in zone[2]:
+                if n[3] in ['ZoneBC_t', 'ZoneGridConnectivity_t', 'UserDefinedData_t', 'FamilyName_t']:
+                    zo[2].append(n)
+            # centers fields are extended then refreshed
+            fldNames = []
+            fsolc = I.getNodeFromName1(zone, I.__FlowSolutionCenters__)
+            if fsolc is not None:
+                cont = I.createUniqueChild(zo, I.__FlowSolutionCenters__, 'FlowSolution_t')
+                I._createUniqueChild(cont, 'GridLocation', 'GridLocation_t', value='CellCenter')
+                for f in I.getNodesFromType1(fsolc, 'DataArray_t'):
+                    fld = numpy.zeros(ncells+nghost, dtype=numpy.float64)
+                    fld[:ncells] = f[1].ravel()
+                    I.newDataArray(f[0], value=fld, parent=cont)
+                    fldNames.append(f[0])
+
+            halo = I.createUniqueChild(zo, '.Halo', 'UserDefinedData_t')
+            I.newDataArray('NCells', value=ncells, parent=halo)
+            I.newDataArray('NGhostCells', value=nghost, parent=halo)
+            I.newDataArray('NLayers', value=nlayers, parent=halo)
+            I.newDataArray('GhostLayer', value=layer, parent=halo)
+            I.newDataArray('CellLoc2Glob', value=cg, parent=halo)
+            I.newDataArray('FaceLoc2Glob', value=fg, parent=halo)
+            I.newDataArray('PointLoc2Glob', value=pg, parent=halo)
+
+            if fldNames != []: _updateHaloZone__(zo, h, fldNames)
+            base[2][c] = zo
+            handles.append(h)
+    return tp, handles
+
+def _updateHaloZone__(zone, h, fldNames):
+    fsolc = I.getNodeFromName1(zone, I.__FlowSolutionCenters__)
+    if fsolc is None: raise ValueError('updateHalo: FlowSolutionCenters not found.')
+    flds = []
+    for fldName in fldNames:
+        fld = I.getNodeFromName1(fsolc, fldName)
+        if fld is None: raise ValueError(fldName, 'not found.')
+        flds.append(fld[1])
+    xcore.updateHaloNGon(h, flds)
+    return None
+
+# Refreshes in place the ghost values of centers fields of a tree 
+# extended by buildHalo
+def _updateHalo(t, handles, fldNames):
+    """Refresh the ghost cell values of centers fields."""
+    if isinstance(fldNames, str): fldNames = [fldNames]
+    for zone, h in zip(I.getZones(t), handles):
+        _updateHaloZone__(zone, h, fldNames)
+    return None
+
 def initAdaptTree(t):
   zones = I.getZones(t)
   adaptTrees = []
@@ -86,7 +166,9 @@ def loadAndSplitElt(fileName):
 
 BCType_l = set(I.KNOWNBCS)
 
-def loadAndSplitNGon(fileName):
+# batchSize: max number of entries exchanged between two procs per
+# redistribution round (None: one round). Bounds the send buffers.
+def loadAndSplitNGon(fileName, batchSize=None):
   dt = Filter2.loadAsChunks(fileName)
   arrays = []
   zones = I.getZones(dt)
@@ -142,7 +224,7 @@ def loadAndSplitNGon(fileName):
 
   arrays.append([cx,cy,cz,ngonc,ngonso,nfacec,nfaceso,solc,soln,bcs])
 
-  RES = xcore.chunk2partNGon(arrays)
+  RES = xcore.chunk2partNGon(arrays, batchSize)
   (mesh, comm_data, solc, sol, bcs, cells, faces, points) = RES
   Cmpi.barrier()
 
@@ -325,7 +407,12 @@ def removeIntersectingKPlanes(master, slave, patch_name):
   t = C.newPyTree(["Base", zo])
   return t
 
-def intersectSurf(master, slave, patch_name):
+def intersectSurf(master, slave, patch_name, ntiles=1):
+  """Overlay of the master patch faces with the tagged faces of the slave (planar patches).
+  The master patch is split in ntiles tiles swept concurrently.
+  Returns [parents, indPG, x, y]: parent master/slave faces of each overlay face (1-based,
+  0 if no slave face), offsets of the face loops in x, y.
+  Usage: intersectSurf(master, slave, patch_name, ntiles)"""
   zm = I.getZones(master)[0]
   zs = I.getZones(slave)[0]
 
@@ -344,6 +431,4 @@ def intersectSurf(master, slave, patch_name):
     raise ValueError("Tag field not found in slave mesh.")
   tag = I.getValue(tag)
 
-  mesh = xcore.intersectSurf(m, s, faces, tag)
-
-  return mesh
+  return xcore.intersectSurf(m, s, faces, tag, ntiles)
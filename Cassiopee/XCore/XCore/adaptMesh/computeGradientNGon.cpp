@@ -58,20 +58,9 @@ void compute_lsq_grad_matrices
 
   // TODO(Imad): boundary faces contribution
 
-  // Compute tA.A
-  for (E_Int i = 0; i < ncells; i++) {
-    E_Float *pGG = &lsqGG[9*i];
-    E_Float *pG = &lsqG[3*indPH[i]];
-    E_Int idx = 0;
-    for (E_Int j = 0; j < 3; j++) {
-      for (E_Int k = 0; k < 3; k++) {
-        pGG[idx] = 0.0;
-        for (E_Int l = 0; l < count_neis[i]; l++)
-          pGG[idx] += pG[l*3+j] * pG[l*3+k];
-        idx++;
-      }
-    }
-  }
+  // Compute tA.A (packed, SoA)
+  K_LINEAR::lsq_normal_batch(ncells, 3, indPH, count_neis, lsqG, NULL, lsqGG,
+    NULL);
 }
 
 static
@@ -99,37 +88,17 @@ E_Int make_gradient
   }
 
   // TODO(Imad): boundary faces contributions
-  
-  E_Int bad_gradient = 0;
 
-  for (E_Int i = 0; i < ncells; i++) {
-    // Construct B vector
-    E_Float *pG = &lsqG[3*indPH[i]];
-    E_Float *pb = &b[indPH[i]];
-    for (E_Int j = 0; j < 3; j++) {
-      B[j] = 0.0;
-      for (E_Int k = 0; k < count_neis[i]; k++)
-        B[j] += pb[k] * pG[k*3+j];
-    }
+  // Construct B vectors and solve, all cells at once (SoA)
+  E_Float *X = B + 3*ncells;
 
-    // Solve
-    E_Int converged = BiCGStab(&lsqGG[9*i], &G[3*i], B, 3);
-    bad_gradient |= !converged;
-    if (!converged) {
-      printf("Gradient: BiCGStab not converged\n");
-      printf("Cell: " SF_D_ "\n", i);
-      E_Float *pt = &lsqGG[9*i];
-      for (E_Int j = 0; j < 3; j++) {
-        for (E_Int k = 0; k < 3; k++) {
-          printf("%.3e ", pt[3*j+k]);
-        }
-        puts("");
-      }
-      for (E_Int j = 0; j < 3; j++) {
-        printf("%.3e ", B[j]);
-      }
-      puts("");
-    }
+  K_LINEAR::lsq_normal_batch(ncells, 3, indPH, count_neis, lsqG, b, NULL, B);
+
+  E_Int bad_gradient = K_LINEAR::spd3_solve_batch(ncells, lsqGG, B, X);
+
+  for (E_Int i = 0; i < ncells; i++) {
+    for (E_Int j = 0; j < 3; j++)
+      G[3*i+j] = X[j*ncells+i];
   }
 
   return bad_gradient;
@@ -147,13 +116,13 @@ E_Int compute_gradients_ngon
   E_Int *indPH = cn.getIndPH();
 
   E_Float *lsqG = (E_Float *)XMALLOC(3*indPH[ncells] * sizeof(E_Float));
-  E_Float *lsqGG = (E_Float *)XMALLOC(9*ncells * sizeof(E_Float));
+  E_Float *lsqGG = (E_Float *)XMALLOC(6*ncells * sizeof(E_Float));
   E_Int *count_neis = (E_Int *)XMALLOC(ncells * sizeof(E_Int));
   
   compute_lsq_grad_matrices(cn, x, y, z, owner, neigh, count_neis,
     centers, lsqG, lsqGG);
 
-  E_Float *B = (E_Float *)XMALLOC(3 * sizeof(E_Float));
+  E_Float *B = (E_Float *)XMALLOC(6*ncells * sizeof(E_Float));
   E_Float *b = (E_Float *)XMALLOC(indPH[ncells] * sizeof(E_Float));
 
   E_Int bad_gradient = 0;
@@ -161,10 +130,17 @@ E_Int compute_gradients_ngon
   for (size_t i = 0; i < flds.size(); i++) {
     const auto &fld = flds[i];
     auto &G = Gs[i];
-    bad_gradient |= make_gradient(cn, owner, neigh, count_neis, centers,
+    bad_gradient += make_gradient(cn, owner, neigh, count_neis, centers,
       fld, b, B, lsqG, lsqGG, G);
   }
 
+  // Singular systems (e.g. 2D stencils): undetermined components set to 0
+  if (bad_gradient > 0) {
+    fprintf(stderr, "Warning: compute_gradients_ngon: " SF_D_ " singular"
+      " least-squares system(s), undetermined components set to 0.\n",
+      bad_gradient);
+  }
+
   XFREE(lsqG);
   XFREE(lsqGG);
   XFREE(B);
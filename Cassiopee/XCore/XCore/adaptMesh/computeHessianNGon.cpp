@@ -68,20 +68,9 @@ void compute_lsq_hess_matrices
 
   // TODO(Imad): boundary faces contribution
 
-  // Compute tA.A
-  for (E_Int i = 0; i < ncells; i++) {
-    E_Float *pHH = &lsqHH[36*i];
-    E_Float *pH = &lsqH[6*indPH[i]];
-    E_Int idx = 0;
-    for (E_Int j = 0; j < 6; j++) {
-      for (E_Int k = 0; k < 6; k++) {
-        pHH[idx] = 0.0;
-        for (E_Int l = 0; l < count_neis[i]; l++)
-          pHH[idx] += pH[l*6+j] * pH[l*6+k];
-        idx++;
-      }
-    }
-  }
+  // Compute tA.A (packed, SoA)
+  K_LINEAR::lsq_normal_batch(ncells, 6, indPH, count_neis, lsqH, NULL, lsqHH,
+    NULL);
 }
 
 static
@@ -123,35 +112,17 @@ E_Int make_hessian
   }
 
   // TODO(Imad): boundary faces contributions
-  E_Int bad_hessian = 0;
+
+  // Construct B vectors and solve, all cells at once (SoA)
+  E_Float *X = B + 6*ncells;
+
+  K_LINEAR::lsq_normal_batch(ncells, 6, indPH, count_neis, lsqH, b, NULL, B);
+
+  E_Int bad_hessian = K_LINEAR::spd6_solve_batch(ncells, lsqHH, B, X);
+
   for (E_Int i = 0; i < ncells; i++) {
-    // construct B vector
-    E_Float *pH = &lsqH[6*indPH[i]];
-    E_Float *pb = &b[indPH[i]];
-    for (E_Int j = 0; j < 6; j++) {
-      B[j] = 0.0;
-      for (E_Int k = 0; k < count_neis[i]; k++)
-        B[j] += pb[k] * pH[k*6+j];
-    }
-
-    // solve
-    E_Int converged = BiCGStab(&lsqHH[36*i], &H[6*i], B, 6);
-    bad_hessian |= !converged;
-    if (!converged) {
-      printf("BiCGStab not converged\n");
-      printf("Cell: " SF_D_ "\n", i);
-      E_Float *pt = &lsqHH[36*i];
-      for (E_Int j = 0; j < 6; j++) {
-        for (E_Int k = 0; k < 6; k++) {
-          printf("%.3e ", pt[6*j+k]);
-        }
-        puts("");
-      }
-      for (E_Int j = 0; j < 6; j++) {
-        printf("%.3e ", B[j]);
-      }
-      puts("");
-    }
+    for (E_Int j = 0; j < 6; j++)
+      H[6*i+j] = X[j*ncells+i];
   }
 
   return bad_hessian;
@@ -170,13 +141,13 @@ E_Int compute_hessians_ngon
   E_Int *indPH = cn.getIndPH();
 
   E_Float *lsqH = (E_Float *)XMALLOC(6*indPH[ncells] * sizeof(E_Float));
-  E_Float *lsqHH = (E_Float *)XMALLOC(36*ncells * sizeof(E_Float));
+  E_Float *lsqHH = (E_Float *)XMALLOC(21*ncells * sizeof(E_Float));
   E_Int *count_neis = (E_Int *)XMALLOC(ncells * sizeof(E_Int));
 
   compute_lsq_hess_matrices(cn, x, y, z, owner, neigh, count_neis, 
     centers, lsqH, lsqHH);
 
-  E_Float *B = (E_Float *)XMALLOC(6 * sizeof(E_Float));
+  E_Float *B = (E_Float *)XMALLOC(12*ncells * sizeof(E_Float));
   E_Float *b = (E_Float *)XMALLOC(indPH[ncells] * sizeof(E_Float));
 
   E_Int bad_hessian = 0;
@@ -185,10 +156,17 @@ E_Int compute_hessians_ngon
     const auto &fld = flds[i];
     const auto &G = Gs[i];
     auto &H = Hs[i];
-    bad_hessian |= make_hessian(cn, owner, neigh, count_neis, centers, G,
+    bad_hessian += make_hessian(cn, owner, neigh, count_neis, centers, G,
       fld, b, B, lsqH, lsqHH, H);
   }
 
+  // Singular systems (e.g. 2D stencils): undetermined components set to 0
+  if (bad_hessian > 0) {
+    fprintf(stderr, "Warning: compute_hessians_ngon: " SF_D_ " singular"
+      " least-squares system(s), undetermined components set to 0.\n",
+      bad_hessian);
+  }
+
   XFREE(lsqH);
   XFREE(lsqHH);
   XFREE(B);
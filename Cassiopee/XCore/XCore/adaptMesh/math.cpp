@@ -156,12 +156,21 @@ E_Int BiCGStab(E_Float *A, E_Float *x, E_Float *b, E_Int n)
 
 #define MAXNEI 6
 
+// Rows of cell i in the lsq matrices start at MAXNEI*i
+static
+E_Int *make_lsq_xadj(E_Int ncells)
+{
+  E_Int *xadj = (E_Int *)XMALLOC(ncells * sizeof(E_Int));
+  for (E_Int i = 0; i < ncells; i++) xadj[i] = MAXNEI*i;
+  return xadj;
+}
+
 void compute_lsq_grad_matrices(mesh *M)
 {
   if (M->lsqG) return;
   E_Int stride = 3*MAXNEI;
   M->lsqG = (E_Float *)XCALLOC(stride*M->ncells, sizeof(E_Float));
-  M->lsqGG = (E_Float *)XCALLOC(9*M->ncells, sizeof(E_Float));
+  M->lsqGG = (E_Float *)XCALLOC(6*M->ncells, sizeof(E_Float));
   E_Int *count_neis = (E_Int *)XCALLOC(M->ncells, sizeof(E_Int));
 
   E_Int *owner = M->owner;
@@ -218,21 +227,12 @@ void compute_lsq_grad_matrices(mesh *M)
     }
   }
 
-  // compute tA.A
-  for (E_Int i = 0; i < M->ncells; i++) {
-    E_Float *pGG = &M->lsqGG[9*i];
-    E_Float *pG = &M->lsqG[stride*i];
-    E_Int idx = 0;
-    for (E_Int j = 0; j < 3; j++) {
-      for (E_Int k = 0; k < 3; k++) {
-        pGG[idx] = 0;
-        for (E_Int l = 0; l < count_neis[i]; l++)
-          pGG[idx] += pG[l*3+j] * pG[l*3+k];
-        idx++;
-      }
-    }
-  }
+  // compute tA.A (packed, SoA)
+  E_Int *xadj = make_lsq_xadj(M->ncells);
+  K_LINEAR::lsq_normal_batch(M->ncells, 3, xadj, count_neis, M->lsqG, NULL,
+    M->lsqGG, NULL);
 
+  XFREE(xadj);
   XFREE(count_neis);
 }
 
@@ -241,7 +241,7 @@ E_Float *compute_grad(mesh *M, E_Float *fld)
   compute_cell_centers(M);
   compute_lsq_grad_matrices(M);
 
-  E_Float *B = (E_Float *)XCALLOC(3, sizeof(E_Float));
+  E_Float *B = (E_Float *)XCALLOC(6*M->ncells, sizeof(E_Float));
   E_Float *G = (E_Float *)XCALLOC(3*M->ncells, sizeof(E_Float));
   E_Float *b = (E_Float *)XCALLOC(MAXNEI*M->ncells, sizeof(E_Float));
 
@@ -276,22 +276,25 @@ E_Float *compute_grad(mesh *M, E_Float *fld)
     }
   }
 
-  // construct B vector
-  E_Int stride = 3*MAXNEI;
-  for (E_Int i = 0; i < M->ncells; i++) {
-    E_Float *pG = &M->lsqG[stride*i];
-    E_Float *pb = &b[MAXNEI*i];
-    for (E_Int j = 0; j < 3; j++) {
-      B[j] = 0;
-      for (E_Int k = 0; k < count_neis[i]; k++)
-        B[j] += pb[k] * pG[3*k+j];
-    }
+  // construct B vectors and solve, all cells at once (SoA)
+  E_Int ncells = M->ncells;
+  E_Float *X = B + 3*ncells;
+  E_Int *xadj = make_lsq_xadj(ncells);
+  K_LINEAR::lsq_normal_batch(ncells, 3, xadj, count_neis, M->lsqG, b, NULL, B);
+
+  E_Int nsing = K_LINEAR::spd3_solve_batch(ncells, M->lsqGG, B, X);
+  if (nsing > 0) {
+    fprintf(stderr, "Warning: compute_grad: proc %d: " SF_D_ " cell(s) with"
+      " a singular least-squares system, undetermined components set"
+      " to 0.\n", M->pid, nsing);
+  }
 
-    // solve
-    E_Int converged = BiCGStab(&M->lsqGG[9*i], &G[3*i], B, 3);
-    assert(converged);
+  for (E_Int i = 0; i < ncells; i++) {
+    for (E_Int j = 0; j < 3; j++)
+      G[3*i+j] = X[j*ncells+i];
   }
 
+  XFREE(xadj);
   XFREE(B);
   XFREE(b);
   XFREE(count_neis);
@@ -304,7 +307,7 @@ void compute_lsq_hess_matrices(mesh *M)
   if (M->lsqH) return;
   E_Int stride = 6*MAXNEI;
   M->lsqH = (E_Float *)XCALLOC(stride*M->ncells, sizeof(E_Float));
-  M->lsqHH = (E_Float *)XCALLOC(36*M->ncells, sizeof(E_Float));
+  M->lsqHH = (E_Float *)XCALLOC(21*M->ncells, sizeof(E_Float));
   E_Int *count_neis = (E_Int *)XCALLOC(M->ncells, sizeof(E_Int));
 
   E_Float *lsqH = M->lsqH;
@@ -385,22 +388,12 @@ void compute_lsq_hess_matrices(mesh *M)
     }
   }
 
-  // compute tA.A
-  E_Float *pH, *pHH;
-  for (E_Int i = 0; i < M->ncells; i++) {
-    pHH = &lsqHH[36*i];
-    pH = &lsqH[stride*i];
-    E_Int idx = 0;
-    for (E_Int j = 0; j < 6; j++) {
-      for (E_Int k = 0; k < 6; k++) {
-        pHH[idx] = 0.;
-        for (E_Int l = 0; l < count_neis[i]; l++)
-          pHH[idx] += pH[l*6+j] * pH[l*6+k];
-        idx++;
-      }
-    }
-  }
+  // compute tA.A (packed, SoA)
+  E_Int *xadj = make_lsq_xadj(M->ncells);
+  K_LINEAR::lsq_normal_batch(M->ncells, 6, xadj, count_neis, lsqH, NULL,
+    lsqHH, NULL);
 
+  XFREE(xadj);
   XFREE(count_neis);
 }
 
@@ -410,7 +403,7 @@ E_Float *compute_hessian(mesh* M, E_Float *fld)
   E_Float *G = compute_grad(M, fld);
   compute_lsq_hess_matrices(M);
   
-  E_Float *B = (E_Float *)XCALLOC(6, sizeof(E_Float));
+  E_Float *B = (E_Float *)XCALLOC(12*M->ncells, sizeof(E_Float));
   E_Float *H = (E_Float *)XCALLOC(6*M->ncells, sizeof(E_Float));
   E_Float *b = (E_Float *)XCALLOC(MAXNEI*M->ncells, sizeof(E_Float));
 
@@ -470,39 +463,26 @@ E_Float *compute_hessian(mesh* M, E_Float *fld)
   }
 
   // TODO(Imad): boundary data
-  
-  E_Int stride = 6*MAXNEI;
-  for (E_Int i = 0; i < M->ncells; i++) {
-    // construct B vector
-    E_Float *pH = &M->lsqH[stride*i];
-    E_Float *pb = &b[MAXNEI*i];
-    for (E_Int j = 0; j < 6; j++) {
-      B[j] = 0.;
-      for (E_Int k = 0; k < count_neis[i]; k++)
-        B[j] += pb[k] * pH[k*6+j];
-    }
 
-    // solve
-    E_Int converged = BiCGStab(&M->lsqHH[36*i], &H[6*i], B, 6);
-    if (!converged) {
-      printf("BiCGStab not converged\n");
-      printf("Cell: " SF_D_ "\n", i);
-      E_Float *pt = &M->lsqHH[36*i];
-      for (E_Int j = 0; j < 6; j++) {
-        for (E_Int k = 0; k < 6; k++) {
-          printf("%.3e ", pt[6*j+k]);
-        }
-        puts("");
-      }
-      for (E_Int j = 0; j < 6; j++) {
-        printf("%.3e ", B[j]);
-      }
-      puts("");
-      exit(1);
-    }
-    //assert(converged);
+  // construct B vectors and solve, all cells at once (SoA)
+  E_Int ncells = M->ncells;
+  E_Float *X = B + 6*ncells;
+  E_Int *xadj = make_lsq_xadj(ncells);
+  K_LINEAR::lsq_normal_batch(ncells, 6, xadj, count_neis, M->lsqH, b, NULL, B);
+
+  E_Int nsing = K_LINEAR::spd6_solve_batch(ncells, M->lsqHH, B, X);
+  if (nsing > 0) {
+    fprintf(stderr, "Warning: compute_hessian: proc %d: " SF_D_ " cell(s) with"
+      " a singular least-squares system, undetermined components set"
+      " to 0.\n", M->pid, nsing);
+  }
+
+  for (E_Int i = 0; i < ncells; i++) {
+    for (E_Int j = 0; j < 6; j++)
+      H[6*i+j] = X[j*ncells+i];
   }
 
+  XFREE(xadj);
   XFREE(B);
   XFREE(b);
   XFREE(count_neis);
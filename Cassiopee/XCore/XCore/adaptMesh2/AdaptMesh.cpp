@@ -18,6 +18,9 @@
 */
 #include "Proto.h"
 
+// Max leaf count over mean leaf count that triggers a repartitioning
+#define IMBALANCE_TOL 1.1
+
 PyObject *K_XCORE::AdaptMesh(PyObject *self, PyObject *args)
 {
   PyObject *AMESH;
@@ -78,6 +81,39 @@ PyObject *K_XCORE::AdaptMesh(PyObject *self, PyObject *args)
 
   update_patch_faces_after_ref(M);
 
+  // Rebalance the leaves when refinement left the partition lopsided.
+  // Needs global numbering, which is only available if it was provided.
+  if (M->npc > 1 && M->gcells && M->gfaces && M->gpoints) {
+    update_global_cells_after_ref(M);
+    update_global_faces_after_ref(M);
+    update_global_points_after_ref(M);
+    update_patch_neighbours_after_ref(M);
+
+    E_Int nc[2] = {M->ncells, -M->ncells};
+    E_Int gnc[2];
+    MPI_Allreduce(nc, gnc, 2, XMPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    E_Int max_cells = gnc[0];
+    E_Int min_cells = -gnc[1];
+
+    E_Int sum_cells;
+    MPI_Allreduce(&M->ncells, &sum_cells, 1, XMPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+    E_Float imbalance = max_cells * M->npc / (E_Float)sum_cells;
+
+    if (M->pid == 0) {
+      printf("Leaves per proc: min " SF_D_ " - max " SF_D_ " (imbalance %.2f)\n",
+        min_cells, max_cells, imbalance);
+    }
+
+    if (imbalance > IMBALANCE_TOL) {
+      AMesh *m = load_balance_mesh(M);
+
+      // Keep the Python hook valid: the new mesh takes M's place
+      std::swap(*M, *m);
+      mesh_drop(m);
+    }
+  }
+
   E_Int gncells;
   MPI_Allreduce(&M->ncells, &gncells, 1, XMPI_INT, MPI_SUM, MPI_COMM_WORLD);
 
@@ -3,54 +3,48 @@
 
 void Comm_interface_data_f(AMesh *M, E_Float *data, E_Int stride, E_Float **rbuf)
 {
+  std::vector<E_Int> count(M->npatches);
+
   for (E_Int i = 0; i < M->npatches; i++) {
     Patch *P = &M->patches[i];
 
     P->sbuf_f = (E_Float *)XRESIZE(P->sbuf_f, stride*P->nf*sizeof(E_Float));
 
-    E_Int l = 0;
     for (E_Int j = 0; j < P->nf; j++) {
-      E_Int own = M->owner[P->pf[j]];
-      E_Float *ptr = &data[stride*own];
+      E_Float *ptr = &data[stride*M->owner[P->pf[j]]];
+      #pragma omp simd
       for (E_Int k = 0; k < stride; k++)
-        P->sbuf_f[l++] = ptr[k];
+        P->sbuf_f[stride*j+k] = ptr[k];
     }
 
-    assert(l == stride*P->nf);
-
-    MPI_Irecv(rbuf[i], stride*P->nf, MPI_DOUBLE, P->nei, 0, MPI_COMM_WORLD, &M->req[M->nrq++]);
-    MPI_Isend(P->sbuf_f, stride*P->nf, MPI_DOUBLE, P->nei, 0, MPI_COMM_WORLD, &M->req[M->nrq++]);
-    
-    assert(M->nrq < 2*M->npc);
+    count[i] = stride*P->nf;
   }
 
-  Comm_waitall(M);
+  Comm_patch_start_f(M, count.data(), rbuf);
+  Comm_patch_wait(M);
 }
 
 void Comm_interface_data_i(AMesh *M, E_Int *data, E_Int stride, E_Int **rbuf)
 {
+  std::vector<E_Int> count(M->npatches);
+
   for (E_Int i = 0; i < M->npatches; i++) {
     Patch *P = &M->patches[i];
 
     P->sbuf_i = (E_Int *)XRESIZE(P->sbuf_i, stride*P->nf*sizeof(E_Int));
 
-    E_Int l = 0;
     for (E_Int j = 0; j < P->nf; j++) {
-      E_Int own = M->owner[P->pf[j]];
-      E_Int *ptr = &data[stride*own];
+      E_Int *ptr = &data[stride*M->owner[P->pf[j]]];
+      #pragma omp simd
       for (E_Int k = 0; k < stride; k++)
-        P->sbuf_i[l++] = ptr[k];
+        P->sbuf_i[stride*j+k] = ptr[k];
     }
 
-    assert(l == stride*P->nf);
-
-    MPI_Irecv(rbuf[i], stride*P->nf, XMPI_INT, P->nei, 0, MPI_COMM_WORLD, &M->req[M->nrq++]);
-    MPI_Isend(P->sbuf_i, stride*P->nf, XMPI_INT, P->nei, 0, MPI_COMM_WORLD, &M->req[M->nrq++]);
-    
-    assert(M->nrq < 2*M->npc);
+    count[i] = stride*P->nf;
   }
 
-  Comm_waitall(M);
+  Comm_patch_start_i(M, count.data(), rbuf);
+  Comm_patch_wait(M);
 }
 
 void Comm_waitall(AMesh *M)
@@ -59,6 +53,136 @@ void Comm_waitall(AMesh *M)
   M->nrq = 0;
 }
 
+// Patch exchanges go through persistent requests: a channel is only rebuilt
+// when its buffers move or its count changes, so repeated rounds (smoothing,
+// id reconciliation) just restart them. Sends are tagged with M->pid and
+// receives with P->nei, as for the plain Isend/Irecv exchanges.
+void Comm_patch_start_i(AMesh *M, const E_Int *count, E_Int **rbuf)
+{
+  for (E_Int i = 0; i < M->npatches; i++) {
+    Patch *P = &M->patches[i];
+    int n = count ? count[i] : P->nf;
+    M->xch_i->bind(i, P->nei, P->sbuf_i, n, M->pid,
+      rbuf ? rbuf[i] : P->rbuf_i, n, P->nei);
+  }
+  M->xch_i->resize(M->npatches);
+  M->xch_i->start();
+}
+
+void Comm_patch_start_f(AMesh *M, const E_Int *count, E_Float **rbuf)
+{
+  for (E_Int i = 0; i < M->npatches; i++) {
+    Patch *P = &M->patches[i];
+    int n = count ? count[i] : P->nf;
+    M->xch_f->bind(i, P->nei, P->sbuf_f, n, M->pid,
+      rbuf ? rbuf[i] : P->rbuf_f, n, P->nei);
+  }
+  M->xch_f->resize(M->npatches);
+  M->xch_f->start();
+}
+
+void Comm_patch_wait(AMesh *M)
+{
+  M->xch_i->wait();
+  M->xch_f->wait();
+}
+
+
+static
+void make_csr(int *scount, int *rcount, int *sdist, int *rdist, E_Int npc)
+{
+  sdist[0] = rdist[0] = 0;
+  for (E_Int i = 0; i < npc; i++) {
+    sdist[i+1] = sdist[i] + scount[i];
+    rdist[i+1] = rdist[i] + rcount[i];
+  }
+}
+
+static
+E_Int global_to_local(const std::unordered_map<E_Int, E_Int> &T, E_Int gid)
+{
+  if (gid == -1) return -1;
+  auto search = T.find(gid);
+  return search == T.end() ? -1 : search->second;
+}
+
+// Tree node record: parent, level, type, state, number of generations, then
+// for each generation the number of children followed by their global ids.
+
+static
+E_Int tree_node_size(Tree *T, E_Int elem)
+{
+  E_Int size = 5;
+  for (Children *cur = T->children(elem); cur; cur = cur->next)
+    size += 1 + cur->n;
+  return size;
+}
+
+static
+E_Int *tree_node_pack(Tree *T, E_Int elem, const E_Int *gids, E_Int *ptr)
+{
+  ptr[0] = gids[T->parent_[elem]];
+  ptr[1] = T->level_[elem];
+  ptr[2] = T->type_[elem];
+  ptr[3] = T->state_[elem];
+  ptr[4] = 0;
+
+  E_Int &ngen = ptr[4];
+  ptr += 5;
+
+  for (Children *cur = T->children(elem); cur; cur = cur->next) {
+    ngen += 1;
+    *ptr++ = cur->n;
+    for (E_Int k = 0; k < cur->n; k++)
+      *ptr++ = gids[cur->pc[k]];
+  }
+
+  return ptr;
+}
+
+// Skips the record if elem is -1. Generations keep their order.
+static
+E_Int *tree_node_unpack(Tree *T, E_Int elem,
+  const std::unordered_map<E_Int, E_Int> &map, E_Int *ptr)
+{
+  E_Int ngen = ptr[4];
+
+  if (elem != -1) {
+    T->parent_[elem] = global_to_local(map, ptr[0]);
+    T->level_[elem] = ptr[1];
+    T->type_[elem] = ptr[2];
+    T->state_[elem] = ptr[3];
+    assert(T->parent_[elem] != -1);
+  }
+
+  ptr += 5;
+
+  Children **link = (elem != -1) ? &T->children_[elem] : NULL;
+
+  for (E_Int k = 0; k < ngen; k++) {
+    E_Int n = *ptr++;
+
+    if (link) {
+      Children *gen = (Children *)XMALLOC(sizeof(Children));
+      gen->n = n;
+      gen->next = NULL;
+      for (E_Int l = 0; l < n; l++) {
+        gen->pc[l] = global_to_local(map, ptr[l]);
+        assert(gen->pc[l] != -1);
+      }
+      *link = gen;
+      link = &gen->next;
+    }
+
+    ptr += n;
+  }
+
+  return ptr;
+}
+
+// Migrates cells to cmap[cell]. Whole refinement trees must go to the same
+// rank. Faces, points, boundaries, comm patches, edge centers and the
+// adaptation trees follow the cells.
 static
 AMesh *reconstruct_mesh(AMesh *M, E_Int *cmap)
 {
@@ -74,94 +198,86 @@ AMesh *reconstruct_mesh(AMesh *M, E_Int *cmap)
   auto &mFT = *(m->FT);
   auto &mPT = *(m->PT);
 
-  auto &MCT = *(M->CT);
-  auto &MFT = *(M->FT);
   auto &MPT = *(M->PT);
 
+  Tree *CT = M->cellTree;
+  Tree *FT = M->faceTree;
+
+  int *scount = (int *)XCALLOC(npc, sizeof(int));
+  int *rcount = (int *)XMALLOC(npc * sizeof(int));
+  int *sdist = (int *)XMALLOC((npc+1) * sizeof(int));
+  int *rdist = (int *)XMALLOC((npc+1) * sizeof(int));
+  int *idx = (int *)XMALLOC(npc * sizeof(int));
+
   /* CELLS */
+
   int *c_scount = (int *)XCALLOC(npc, sizeof(int));
   int *c_rcount = (int *)XMALLOC(npc * sizeof(int));
+  int *c_sdist = (int *)XMALLOC((npc+1) * sizeof(int));
+  int *c_rdist = (int *)XMALLOC((npc+1) * sizeof(int));
 
-  for (E_Int i = 0; i < M->ncells; i++) {
-    E_Int where = cmap[i];
-    c_scount[where] += 1;
-  }
+  for (E_Int i = 0; i < M->ncells; i++)
+    c_scount[cmap[i]] += 1;
 
   MPI_Alltoall(c_scount, 1, MPI_INT, c_rcount, 1, MPI_INT, MPI_COMM_WORLD);
 
-  int *c_sdist = (int *)XMALLOC((npc+1) * sizeof(int));
-  int *c_rdist = (int *)XMALLOC((npc+1) * sizeof(int));
-  c_sdist[0] = c_rdist[0] = 0;
-  for (E_Int i = 0; i < npc; i++) {
-    c_sdist[i+1] = c_sdist[i] + c_scount[i];
-    c_rdist[i+1] = c_rdist[i] + c_rcount[i];
-  }
-
-  m->ncells = c_rdist[npc];
-  m->gcells = (E_Int *)XMALLOC(m->ncells * sizeof(E_Int));
+  make_csr(c_scount, c_rcount, c_sdist, c_rdist, npc);
 
+  // Sent cells, grouped by destination
+  E_Int *lcells = (E_Int *)XMALLOC(c_sdist[npc] * sizeof(E_Int));
   E_Int *scells = (E_Int *)XMALLOC(c_sdist[npc] * sizeof(E_Int));
   E_Int *c_stride = (E_Int *)XMALLOC(c_sdist[npc] * sizeof(E_Int));
 
-  int *idx = (int *)XMALLOC(npc * sizeof(int));
   for (E_Int i = 0; i < npc; i++) idx[i] = c_sdist[i];
 
   for (E_Int i = 0; i < M->ncells; i++) {
-    E_Int where = cmap[i];
-    scells[idx[where]] = M->gcells[i];
-    c_stride[idx[where]] = M->indPH[i+1] - M->indPH[i];
-    idx[where] += 1;
+    E_Int k = idx[cmap[i]]++;
+    lcells[k] = i;
+    scells[k] = M->gcells[i];
+    c_stride[k] = M->indPH[i+1] - M->indPH[i];
   }
 
-  // Global cell indices
-  MPI_Alltoallv(scells, c_scount, c_sdist, XMPI_INT,
+  m->ncells = c_rdist[npc];
+  m->gcells = (E_Int *)XMALLOC(m->ncells * sizeof(E_Int));
+
+  MPI_Alltoallv(scells,    c_scount, c_sdist, XMPI_INT,
                 m->gcells, c_rcount, c_rdist, XMPI_INT,
                 MPI_COMM_WORLD);
-  
+
   for (E_Int i = 0; i < m->ncells; i++)
     mCT[m->gcells[i]] = i;
-  
-  m->indPH = (E_Int *)XMALLOC((m->ncells+1) * sizeof(E_Int));
 
   // indPH
-  MPI_Alltoallv(c_stride, c_scount, c_sdist, XMPI_INT,
+  m->indPH = (E_Int *)XMALLOC((m->ncells+1) * sizeof(E_Int));
+
+  MPI_Alltoallv(c_stride,   c_scount, c_sdist, XMPI_INT,
                 m->indPH+1, c_rcount, c_rdist, XMPI_INT,
                 MPI_COMM_WORLD);
 
-
   m->indPH[0] = 0;
   for (E_Int i = 0; i < m->ncells; i++) m->indPH[i+1] += m->indPH[i];
 
-  // nface
-  int *scount = (int *)XCALLOC(npc, sizeof(int));
-  int *rcount = (int *)XMALLOC(npc * sizeof(int));
-
-  for (E_Int i = 0; i < M->ncells; i++) {
-    E_Int where = cmap[i];
-    scount[where] += M->indPH[i+1] - M->indPH[i];
+  // nface, in global face ids
+  for (E_Int i = 0; i < npc; i++) {
+    scount[i] = 0;
+    for (E_Int j = c_sdist[i]; j < c_sdist[i+1]; j++)
+      scount[i] += c_stride[j];
   }
 
   MPI_Alltoall(scount, 1, MPI_INT, rcount, 1, MPI_INT, MPI_COMM_WORLD);
 
-  int *sdist = (int *)XMALLOC((npc+1) * sizeof(int));
-  int *rdist = (int *)XMALLOC((npc+1) * sizeof(int));
-  sdist[0] = rdist[0] = 0;
-  for (E_Int i = 0; i < npc; i++) {
-    sdist[i+1] = sdist[i] + scount[i];
-    rdist[i+1] = rdist[i] + rcount[i];
-  }
+  make_csr(scount, rcount, sdist, rdist, npc);
 
   E_Int *sdata = (E_Int *)XMALLOC(sdist[npc] * sizeof(E_Int));
-  m->nface = (E_Int *)XCALLOC(rdist[npc], sizeof(E_Int));
+  m->nface = (E_Int *)XMALLOC(rdist[npc] * sizeof(E_Int));
 
   assert(rdist[npc] == m->indPH[m->ncells]);
 
-  for (E_Int i = 0; i < npc; i++) idx[i] = sdist[i];
-
-  for (E_Int i = 0; i < M->ncells; i++) {
-    E_Int where = cmap[i];
-    for (E_Int j = M->indPH[i]; j < M->indPH[i+1]; j++)
-      sdata[idx[where]++] = M->gfaces[M->nface[j]];
+  E_Int *ptr = sdata;
+  for (E_Int k = 0; k < c_sdist[npc]; k++) {
+    E_Int cell = lcells[k];
+    for (E_Int j = M->indPH[cell]; j < M->indPH[cell+1]; j++)
+      *ptr++ = M->gfaces[M->nface[j]];
   }
 
   MPI_Alltoallv(sdata,    scount, sdist, XMPI_INT,
@@ -170,187 +286,280 @@ AMesh *reconstruct_mesh(AMesh *M, E_Int *cmap)
 
   /* FACES */
 
-  // Hash and request faces
-  m->nfaces = 0;
-  int *f_rcount = (int *)XCALLOC(npc, sizeof(int));
-  int *f_scount = (int *)XMALLOC(npc * sizeof(int));
+  // A destination gets the faces of its cells plus their face-tree family,
+  // so that parent and children links resolve on its side.
+  std::vector<E_Int> fstamp(M->nfaces, -1);
+  std::vector<E_Int> stack;
+  std::vector<E_Int> lfaces;
+
+  int *f_scount = (int *)XCALLOC(npc, sizeof(int));
+  int *f_rcount = (int *)XMALLOC(npc * sizeof(int));
+  int *f_sdist = (int *)XMALLOC((npc+1) * sizeof(int));
+  int *f_rdist = (int *)XMALLOC((npc+1) * sizeof(int));
 
   for (E_Int i = 0; i < npc; i++) {
-    E_Int *pc = &m->gcells[c_rdist[i]];
+    for (E_Int j = c_sdist[i]; j < c_sdist[i+1]; j++) {
+      E_Int cell = lcells[j];
+      for (E_Int k = M->indPH[cell]; k < M->indPH[cell+1]; k++) {
+        E_Int face = M->nface[k];
+        if (fstamp[face] == i) continue;
+        fstamp[face] = i;
+        stack.push_back(face);
+      }
+    }
+
+    while (!stack.empty()) {
+      E_Int face = stack.back();
+      stack.pop_back();
 
-    for (int j = 0; j < c_rcount[i]; j++) {
-      E_Int cell = mCT[pc[j]];
-      assert(cell >= 0 && cell < m->ncells);
+      lfaces.push_back(face);
+      f_scount[i]++;
 
-      for (E_Int k = m->indPH[cell]; k < m->indPH[cell+1]; k++) {
-        E_Int face = m->nface[k];
+      E_Int parent = FT->parent_[face];
+      if (fstamp[parent] != i) {
+        fstamp[parent] = i;
+        stack.push_back(parent);
+      }
 
-        if (mFT.find(face) == mFT.end()) {
-          mFT[face] = m->nfaces++;
-          f_rcount[i]++;
+      for (Children *cur = FT->children(face); cur; cur = cur->next) {
+        for (E_Int k = 0; k < cur->n; k++) {
+          E_Int child = cur->pc[k];
+          if (fstamp[child] == i) continue;
+          fstamp[child] = i;
+          stack.push_back(child);
         }
       }
     }
   }
 
-  MPI_Alltoall(f_rcount, 1, MPI_INT, f_scount, 1, MPI_INT, MPI_COMM_WORLD);
-
-  int *f_rdist = (int *)XMALLOC((npc+1) * sizeof(int));
-  int *f_sdist = (int *)XMALLOC((npc+1) * sizeof(int));
-  f_rdist[0] = f_sdist[0] = 0;
-  for (E_Int i = 0; i < npc; i++) {
-    f_rdist[i+1] = f_rdist[i] + f_rcount[i];
-    f_sdist[i+1] = f_sdist[i] + f_scount[i];
-  }
+  MPI_Alltoall(f_scount, 1, MPI_INT, f_rcount, 1, MPI_INT, MPI_COMM_WORLD);
 
-  m->gfaces = (E_Int *)XMALLOC(m->nfaces * sizeof(E_Int));
+  make_csr(f_scount, f_rcount, f_sdist, f_rdist, npc);
 
   E_Int *sfaces = (E_Int *)XMALLOC(f_sdist[npc] * sizeof(E_Int));
+  E_Int *rfaces = (E_Int *)XMALLOC(f_rdist[npc] * sizeof(E_Int));
 
-  for (E_Int i = 0; i < npc; i++) idx[i] = f_rdist[i];
-
-  int *vfaces = (int *)XCALLOC(m->nfaces, sizeof(int));
-  
-  for (E_Int i = 0; i < npc; i++) {
-    E_Int *pc = &m->gcells[c_rdist[i]];
+  for (E_Int k = 0; k < f_sdist[npc]; k++)
+    sfaces[k] = M->gfaces[lfaces[k]];
 
-    for (int j = 0; j < c_rcount[i]; j++) {
-      E_Int cell = mCT[pc[j]];
+  MPI_Alltoallv(sfaces, f_scount, f_sdist, XMPI_INT,
+                rfaces, f_rcount, f_rdist, XMPI_INT,
+                MPI_COMM_WORLD);
 
-      for (E_Int k = m->indPH[cell]; k < m->indPH[cell+1]; k++) {
-        E_Int face = m->nface[k];
+  // A face may come from several ranks: keep the first copy
+  E_Int *fpos = (E_Int *)XMALLOC(f_rdist[npc] * sizeof(E_Int));
 
-        if (!vfaces[mFT[face]]) {
-          vfaces[mFT[face]]++;
-          m->gfaces[idx[i]++] = face;
-        }
-      }
+  m->nfaces = 0;
+  for (E_Int i = 0; i < f_rdist[npc]; i++) {
+    if (mFT.find(rfaces[i]) == mFT.end()) {
+      mFT[rfaces[i]] = m->nfaces;
+      fpos[i] = m->nfaces++;
+    } else {
+      fpos[i] = -1;
     }
   }
 
-  // Global face indices       
-  MPI_Alltoallv(m->gfaces, f_rcount, f_rdist, XMPI_INT,
-                sfaces,    f_scount, f_sdist, XMPI_INT,
-                MPI_COMM_WORLD);
+  m->gfaces = (E_Int *)XMALLOC(m->nfaces * sizeof(E_Int));
 
-  // Send face strides
-  E_Int *f_stride = (E_Int *)XMALLOC(f_sdist[npc] * sizeof(E_Int));
+  for (E_Int i = 0; i < f_rdist[npc]; i++) {
+    if (fpos[i] != -1) m->gfaces[fpos[i]] = rfaces[i];
+  }
 
-  m->indPG = (E_Int *)XMALLOC((m->nfaces+1) * sizeof(E_Int));
+  // Face strides
+  E_Int *f_stride = (E_Int *)XMALLOC(f_sdist[npc] * sizeof(E_Int));
+  E_Int *r_stride = (E_Int *)XMALLOC(f_rdist[npc] * sizeof(E_Int));
 
-  for (E_Int i = 0; i < npc; i++) scount[i] = 0;
-  
   for (E_Int i = 0; i < npc; i++) {
-    E_Int *pf = &sfaces[f_sdist[i]];
-    E_Int *ps = &f_stride[f_sdist[i]];
-
-    for (int j = 0; j < f_scount[i]; j++) {
-      E_Int face = MFT[pf[j]];
-      assert(face < M->nfaces);
-
-      E_Int stride = M->indPG[face+1] - M->indPG[face];
-      ps[j] = stride;
-      scount[i] += stride;
+    scount[i] = 0;
+    for (E_Int k = f_sdist[i]; k < f_sdist[i+1]; k++) {
+      f_stride[k] = get_stride(lfaces[k], M->indPG);
+      scount[i] += f_stride[k];
     }
   }
 
-  MPI_Alltoallv(f_stride,   f_scount, f_sdist, XMPI_INT,
-                m->indPG+1, f_rcount, f_rdist, XMPI_INT,
+  MPI_Alltoallv(f_stride, f_scount, f_sdist, XMPI_INT,
+                r_stride, f_rcount, f_rdist, XMPI_INT,
                 MPI_COMM_WORLD);
 
+  m->indPG = (E_Int *)XMALLOC((m->nfaces+1) * sizeof(E_Int));
   m->indPG[0] = 0;
+  for (E_Int i = 0; i < f_rdist[npc]; i++) {
+    if (fpos[i] != -1) m->indPG[fpos[i]+1] = r_stride[i];
+  }
   for (E_Int i = 0; i < m->nfaces; i++) m->indPG[i+1] += m->indPG[i];
 
+  // ngon, in global point ids
   MPI_Alltoall(scount, 1, MPI_INT, rcount, 1, MPI_INT, MPI_COMM_WORLD);
 
-  // ngon
-  for (E_Int i = 0; i < npc; i++) {
-    sdist[i+1] = sdist[i] + scount[i];
-    rdist[i+1] = rdist[i] + rcount[i];
-  }
-  
+  make_csr(scount, rcount, sdist, rdist, npc);
+
   sdata = (E_Int *)XRESIZE(sdata, sdist[npc] * sizeof(E_Int));
+  E_Int *rdata = (E_Int *)XMALLOC(rdist[npc] * sizeof(E_Int));
 
-  m->ngon = (E_Int *)XMALLOC(rdist[npc] * sizeof(E_Int));
+  ptr = sdata;
+  for (E_Int k = 0; k < f_sdist[npc]; k++) {
+    E_Int face = lfaces[k];
+    for (E_Int j = M->indPG[face]; j < M->indPG[face+1]; j++)
+      *ptr++ = M->gpoints[M->ngon[j]];
+  }
 
-  for (E_Int i = 0; i < npc; i++) {
-    E_Int *pf = &sfaces[f_sdist[i]];
-    E_Int *pn = &sdata[sdist[i]];
-
-    for (int j = 0; j < f_scount[i]; j++) {
-      E_Int face = MFT[pf[j]];
-      assert(face < M->nfaces);
-      
-      for (E_Int k = M->indPG[face]; k < M->indPG[face+1]; k++)
-        *pn++ = M->gpoints[M->ngon[k]];
+  MPI_Alltoallv(sdata, scount, sdist, XMPI_INT,
+                rdata, rcount, rdist, XMPI_INT,
+                MPI_COMM_WORLD);
+
+  m->ngon = (E_Int *)XMALLOC(m->indPG[m->nfaces] * sizeof(E_Int));
+
+  ptr = rdata;
+  for (E_Int i = 0; i < f_rdist[npc]; i++) {
+    if (fpos[i] != -1) {
+      memcpy(&m->ngon[m->indPG[fpos[i]]], ptr, r_stride[i]*sizeof(E_Int));
     }
+    ptr += r_stride[i];
+  }
+
+  // Parent elements, in global cell ids
+  for (E_Int i = 0; i < npc; i++) {
+    scount[i] = 2*f_scount[i];
+    rcount[i] = 2*f_rcount[i];
+  }
+
+  make_csr(scount, rcount, sdist, rdist, npc);
+
+  sdata = (E_Int *)XRESIZE(sdata, sdist[npc] * sizeof(E_Int));
+  rdata = (E_Int *)XRESIZE(rdata, rdist[npc] * sizeof(E_Int));
+
+  for (E_Int k = 0; k < f_sdist[npc]; k++) {
+    E_Int own = M->owner[lfaces[k]];
+    E_Int nei = M->neigh[lfaces[k]];
+    sdata[2*k]   = (own == -1) ? -1 : M->gcells[own];
+    sdata[2*k+1] = (nei == -1) ? -1 : M->gcells[nei];
   }
 
-  MPI_Alltoallv(sdata  , scount, sdist, XMPI_INT,
-                m->ngon, rcount, rdist, XMPI_INT,
+  MPI_Alltoallv(sdata, scount, sdist, XMPI_INT,
+                rdata, rcount, rdist, XMPI_INT,
                 MPI_COMM_WORLD);
 
-  /* POINTS */
+  m->owner = (E_Int *)XMALLOC(m->nfaces * sizeof(E_Int));
+  m->neigh = (E_Int *)XMALLOC(m->nfaces * sizeof(E_Int));
 
-  // Request points
-  m->npoints = 0;
-  
-  int *p_rcount = (int *)XCALLOC(npc, sizeof(int));
-  int *p_scount = (int *)XMALLOC(npc * sizeof(int));
-  
-  for (E_Int i = 0; i < npc; i++) {
-    E_Int *pf = &m->gfaces[f_rdist[i]];
+  // Faces whose owner stayed behind are flipped so that the local cell owns
+  // them. First point is kept in place, as in Orient_boundary.
+  E_Int *fflip = (E_Int *)XCALLOC(m->nfaces, sizeof(E_Int));
 
-    for (int j = 0; j < f_rcount[i]; j++) {
-      E_Int face = mFT[pf[j]];
+  for (E_Int i = 0; i < f_rdist[npc]; i++) {
+    E_Int face = fpos[i];
+    if (face == -1) continue;
 
-      for (E_Int k = m->indPG[face]; k < m->indPG[face+1]; k++) {
-        E_Int point = m->ngon[k];
+    E_Int own = global_to_local(mCT, rdata[2*i]);
+    E_Int nei = global_to_local(mCT, rdata[2*i+1]);
 
-        if (mPT.find(point) == mPT.end()) {
-          mPT[point] = m->npoints++;
-          p_rcount[i]++;
-        }
-      }
+    if (own == -1 && nei != -1) {
+      own = nei;
+      nei = -1;
+      fflip[face] = 1;
+      E_Int np = -1;
+      E_Int *pn = get_face(face, np, m->ngon, m->indPG);
+      std::reverse(pn+1, pn+np);
     }
+
+    m->owner[face] = own;
+    m->neigh[face] = nei;
   }
 
-  MPI_Alltoall(p_rcount, 1, MPI_INT, p_scount, 1, MPI_INT, MPI_COMM_WORLD);
+  /* EDGE CENTERS */
 
-  int *p_sdist = (int *)XMALLOC((npc+1) * sizeof(int));
-  int *p_rdist = (int *)XMALLOC((npc+1) * sizeof(int));
-  p_sdist[0] = p_rdist[0] = 0;
+  // Send edge + center for the edges of sent faces
+  memset(scount, 0, npc*sizeof(int));
+
+  Edge E;
   for (E_Int i = 0; i < npc; i++) {
-    p_sdist[i+1] = p_sdist[i] + p_scount[i];
-    p_rdist[i+1] = p_rdist[i] + p_rcount[i];
+    for (E_Int k = f_sdist[i]; k < f_sdist[i+1]; k++) {
+      E_Int np = -1;
+      E_Int *pn = get_face(lfaces[k], np, M->ngon, M->indPG);
+
+      for (E_Int j = 0; j < np; j++) {
+        E.set(pn[j], pn[(j+1)%np]);
+        if (M->ecenter->find(E) != M->ecenter->end())
+          scount[i] += 3;
+      }
+    }
   }
 
-  E_Int *spoints = (E_Int *)XMALLOC(p_sdist[npc] * sizeof(E_Int));
+  MPI_Alltoall(scount, 1, MPI_INT, rcount, 1, MPI_INT, MPI_COMM_WORLD);
+
+  int *e_rdist = (int *)XMALLOC((npc+1) * sizeof(int));
+
+  make_csr(scount, rcount, sdist, e_rdist, npc);
 
-  m->gpoints = (E_Int *)XMALLOC(p_rdist[npc] * sizeof(E_Int));
+  sdata = (E_Int *)XRESIZE(sdata, sdist[npc] * sizeof(E_Int));
+  E_Int *recenter = (E_Int *)XMALLOC(e_rdist[npc] * sizeof(E_Int));
+
+  ptr = sdata;
+  for (E_Int k = 0; k < f_sdist[npc]; k++) {
+    E_Int np = -1;
+    E_Int *pn = get_face(lfaces[k], np, M->ngon, M->indPG);
+
+    for (E_Int j = 0; j < np; j++) {
+      E.set(pn[j], pn[(j+1)%np]);
+      auto search = M->ecenter->find(E);
+      if (search != M->ecenter->end()) {
+        *ptr++ = M->gpoints[search->first.p0_];
+        *ptr++ = M->gpoints[search->first.p1_];
+        *ptr++ = M->gpoints[search->second];
+      }
+    }
+  }
 
-  int *vpoints = (int *)XCALLOC(m->npoints, sizeof(int));
+  MPI_Alltoallv(sdata,    scount, sdist,   XMPI_INT,
+                recenter, rcount, e_rdist, XMPI_INT,
+                MPI_COMM_WORLD);
 
-  for (E_Int i = 0; i < npc; i++) idx[i] = p_rdist[i];
+  /* POINTS */
 
-  for (E_Int i = 0; i < npc; i++) {
-    E_Int *pf = &m->gfaces[f_rdist[i]];
+  // Request the points of kept faces and edge centers from their sender
+  int *p_scount = (int *)XMALLOC(npc * sizeof(int));
+  int *p_rcount = (int *)XCALLOC(npc, sizeof(int));
+  int *p_sdist = (int *)XMALLOC((npc+1) * sizeof(int));
+  int *p_rdist = (int *)XMALLOC((npc+1) * sizeof(int));
+
+  std::vector<E_Int> rpoints;
 
-    for (int j = 0; j < f_rcount[i]; j++) {
-      E_Int face = mFT[pf[j]];
+  m->npoints = 0;
 
-      for (E_Int k = m->indPG[face]; k < m->indPG[face+1]; k++) {
-        E_Int point = m->ngon[k];
-        assert(mPT.find(point) != mPT.end());
+  for (E_Int i = 0; i < npc; i++) {
+    for (E_Int k = f_rdist[i]; k < f_rdist[i+1]; k++) {
+      E_Int face = fpos[k];
+      if (face == -1) continue;
 
-        if (!vpoints[mPT[point]]) {
-          vpoints[mPT[point]]++;
-          m->gpoints[idx[i]++] = point;
+      for (E_Int j = m->indPG[face]; j < m->indPG[face+1]; j++) {
+        E_Int point = m->ngon[j];
+        if (mPT.find(point) == mPT.end()) {
+          mPT[point] = m->npoints++;
+          rpoints.push_back(point);
+          p_rcount[i]++;
         }
       }
     }
+
+    for (E_Int k = e_rdist[i]; k < e_rdist[i+1]; k++) {
+      E_Int point = recenter[k];
+      if (mPT.find(point) == mPT.end()) {
+        mPT[point] = m->npoints++;
+        rpoints.push_back(point);
+        p_rcount[i]++;
+      }
+    }
   }
 
+  MPI_Alltoall(p_rcount, 1, MPI_INT, p_scount, 1, MPI_INT, MPI_COMM_WORLD);
+
+  make_csr(p_scount, p_rcount, p_sdist, p_rdist, npc);
+
+  m->gpoints = (E_Int *)XMALLOC(m->npoints * sizeof(E_Int));
+  memcpy(m->gpoints, rpoints.data(), m->npoints * sizeof(E_Int));
+
+  E_Int *spoints = (E_Int *)XMALLOC(p_sdist[npc] * sizeof(E_Int));
+
   MPI_Alltoallv(m->gpoints, p_rcount, p_rdist, XMPI_INT,
                 spoints,    p_scount, p_sdist, XMPI_INT,
                 MPI_COMM_WORLD);
@@ -364,18 +573,12 @@ AMesh *reconstruct_mesh(AMesh *M, E_Int *cmap)
   E_Float *sy = (E_Float *)XMALLOC(p_sdist[npc] * sizeof(E_Float));
   E_Float *sz = (E_Float *)XMALLOC(p_sdist[npc] * sizeof(E_Float));
 
-  for (E_Int i = 0; i < npc; i++) {
-    E_Int *pp = &spoints[p_sdist[i]];
-    E_Float *px = &sx[p_sdist[i]];
-    E_Float *py = &sy[p_sdist[i]];
-    E_Float *pz = &sz[p_sdist[i]];
-
-    for (int j = 0; j < p_scount[i]; j++) {
-      E_Int point = MPT[pp[j]];
-      *px++ = M->x[point];
-      *py++ = M->y[point];
-      *pz++ = M->z[point];
-    }
+  for (E_Int k = 0; k < p_sdist[npc]; k++) {
+    E_Int point = global_to_local(MPT, spoints[k]);
+    assert(point != -1);
+    sx[k] = M->x[point];
+    sy[k] = M->y[point];
+    sz[k] = M->z[point];
   }
 
   MPI_Alltoallv(sx,   p_scount, p_sdist, MPI_DOUBLE,
@@ -390,40 +593,27 @@ AMesh *reconstruct_mesh(AMesh *M, E_Int *cmap)
                 m->z, p_rcount, p_rdist, MPI_DOUBLE,
                 MPI_COMM_WORLD);
 
-  
-  for (E_Int i = 0; i < m->ncells; i++) {
-    for (E_Int j = m->indPH[i]; j < m->indPH[i+1]; j++) {
-      m->nface[j] = mFT[m->nface[j]];
-    }
-  }
-
-  for (E_Int i = 0; i < m->nfaces; i++) {
-    for (E_Int j = m->indPG[i]; j < m->indPG[i+1]; j++) {
-      m->ngon[j] = mPT[m->ngon[j]];
-    }
+  // Switch to local indices
+  for (E_Int j = 0; j < m->indPH[m->ncells]; j++) {
+    m->nface[j] = global_to_local(mFT, m->nface[j]);
+    assert(m->nface[j] != -1);
   }
 
-  // Make parent elements
-  m->owner = (E_Int *)XMALLOC(m->nfaces * sizeof(E_Int));
-  m->neigh = (E_Int *)XMALLOC(m->nfaces * sizeof(E_Int));
+  for (E_Int j = 0; j < m->indPG[m->nfaces]; j++)
+    m->ngon[j] = mPT[m->ngon[j]];
 
-  Orient_boundary(m);
-  Build_own_nei(m);
+  for (E_Int k = 0; k < e_rdist[npc]; k += 3) {
+    E.set(mPT[recenter[k]], mPT[recenter[k+1]]);
+    m->ecenter->insert({E, mPT[recenter[k+2]]});
+  }
 
   // Exchange ref_data
   m->ref_data = (E_Int *)XMALLOC(m->ncells * sizeof(E_Int));
 
   E_Int *sref = (E_Int *)XMALLOC(c_sdist[npc] * sizeof(E_Int));
 
-  for (E_Int i = 0; i < npc; i++) {
-    E_Int *pc = &scells[c_sdist[i]];
-    E_Int *pr = &sref[c_sdist[i]];
-
-    for (int j = 0; j < c_scount[i]; j++) {
-      E_Int cell = MCT[pc[j]];
-      *pr++ = M->ref_data[cell];
-    }
-  }
+  for (E_Int k = 0; k < c_sdist[npc]; k++)
+    sref[k] = M->ref_data[lcells[k]];
   
   MPI_Alltoallv(sref,        c_scount, c_sdist, XMPI_INT,
                 m->ref_data, c_rcount, c_rdist, XMPI_INT,
@@ -446,23 +636,17 @@ AMesh *reconstruct_mesh(AMesh *M, E_Int *cmap)
 
     E_Int *ptlist = M->ptlists[i];
 
-    for (E_Int j = 0; j < npc; j++) scount[j] = 0;
+    memset(scount, 0, npc*sizeof(int));
 
     for (E_Int j = 0; j < M->bcsizes[i]; j++) {
       E_Int face = ptlist[j];
       E_Int own = M->owner[face];
-      E_Int where = cmap[own];
-      scount[where] += 1;
+      scount[cmap[own]] += 1;
     }
 
-    MPI_Alltoall(scount, 1, MPI_INT,
-                 rcount, 1, MPI_INT,
-                 MPI_COMM_WORLD);
+    MPI_Alltoall(scount, 1, MPI_INT, rcount, 1, MPI_INT, MPI_COMM_WORLD);
 
-    for (E_Int j = 0; j < npc; j++) {
-      sdist[j+1] = sdist[j] + scount[j];
-      rdist[j+1] = rdist[j] + rcount[j];
-    }
+    make_csr(scount, rcount, sdist, rdist, npc);
 
     m->bcsizes[i] = rdist[npc];
     m->nbf += m->bcsizes[i];
@@ -476,8 +660,7 @@ AMesh *reconstruct_mesh(AMesh *M, E_Int *cmap)
     for (E_Int j = 0; j < M->bcsizes[i]; j++) {
       E_Int face = ptlist[j];
       E_Int own = M->owner[face];
-      E_Int where = cmap[own];
-      sdata[idx[where]++] = M->gfaces[face];
+      sdata[idx[cmap[own]]++] = M->gfaces[face];
     }
 
     MPI_Alltoallv(sdata,         scount, sdist, XMPI_INT,
@@ -488,35 +671,28 @@ AMesh *reconstruct_mesh(AMesh *M, E_Int *cmap)
     ptlist = m->ptlists[i];
 
     for (E_Int j = 0; j < m->bcsizes[i]; j++) {
-      assert(mFT.find(ptlist[j]) != mFT.end());
-      ptlist[j] = mFT[ptlist[j]];
+      ptlist[j] = global_to_local(mFT, ptlist[j]);
+      assert(ptlist[j] != -1);
     }
   }
 
   /* COMM PATCHES */
 
-  // Isolate pfaces
-  memset(vfaces, 0, m->nfaces*sizeof(E_Int));
+  // Isolate pfaces: owned faces with no neighbour that are not boundaries
+  int *vfaces = (int *)XCALLOC(m->nfaces, sizeof(int));
 
   int spcount = 0; // How many pfaces am i requesting
 
-  // Eliminate boundary faces
   for (E_Int i = 0; i < m->nbc; i++) {
     E_Int *ptlist = m->ptlists[i];
-
-    for (E_Int j = 0; j < m->bcsizes[i]; j++) {
-      E_Int face = ptlist[j];
-      assert(face >= 0 && face < m->nfaces);
-      vfaces[face] = 1;
-    }
+    for (E_Int j = 0; j < m->bcsizes[i]; j++)
+      vfaces[ptlist[j]] = 1;
   }
 
-  // Eliminate internal faces
   for (E_Int i = 0; i < m->nfaces; i++) {
-    // Skip boundary faces
     if (vfaces[i] == 1) continue;
 
-    if (m->neigh[i] != -1) { // Skip internal faces
+    if (m->neigh[i] != -1 || m->owner[i] == -1) {
       vfaces[i] = 1;
     } else {
       spcount++;
@@ -535,59 +711,47 @@ AMesh *reconstruct_mesh(AMesh *M, E_Int *cmap)
 
   int *RDIST = (int *)XMALLOC((npc+1) * sizeof(int));
   RDIST[0] = 0;
-  for (E_Int i = 0; i < npc; i++) {
+  for (E_Int i = 0; i < npc; i++)
     RDIST[i+1] = RDIST[i] + RCOUNT[i];
-  }
 
   E_Int *RECV = (E_Int *)XMALLOC(RDIST[npc] * sizeof(E_Int));
   MPI_Allgatherv(pfaces, spcount, XMPI_INT,
                  RECV, RCOUNT, RDIST, XMPI_INT,
                  MPI_COMM_WORLD);
   
-  memset(scount, 0, npc*sizeof(E_Int));
-  
-  // Look for requested faces in global face table
-  for (E_Int i = 0; i < npc; i++) {
-    E_Int *ptr = &RECV[RDIST[i]];
+  // Answer with the owner of the requested pfaces that i hold
+  memset(scount, 0, npc*sizeof(int));
 
+  for (E_Int i = 0; i < npc; i++) {
     if (i == m->pid) continue;
-    
+
+    E_Int *pf = &RECV[RDIST[i]];
+
     for (E_Int j = 0; j < RCOUNT[i]; j++) {
-      E_Int gface = ptr[j];
-      auto search = mFT.find(gface);
-      if (search != mFT.end()) {
-        E_Int lface = search->second;
-        assert(lface >= 0 && lface < m->nfaces);
-        assert(m->neigh[lface] == -1);
+      E_Int lface = global_to_local(mFT, pf[j]);
+      if (lface != -1 && vfaces[lface] == 0)
         scount[i] += 2;
-      }
     }
   }
 
   MPI_Alltoall(scount, 1, MPI_INT, rcount, 1, MPI_INT, MPI_COMM_WORLD);
 
-  for (E_Int i = 0; i < npc; i++) {
-    sdist[i+1] = sdist[i] + scount[i];
-    rdist[i+1] = rdist[i] + rcount[i];
-  }
+  make_csr(scount, rcount, sdist, rdist, npc);
 
   sdata = (E_Int *)XRESIZE(sdata, sdist[npc] * sizeof(E_Int));
-  E_Int *rdata = (E_Int *)XMALLOC(rdist[npc] * sizeof(E_Int));
+  rdata = (E_Int *)XRESIZE(rdata, rdist[npc] * sizeof(E_Int));
 
+  ptr = sdata;
   for (E_Int i = 0; i < npc; i++) {
-    E_Int *ptr = &RECV[RDIST[i]];
-    E_Int *ps = &sdata[sdist[i]];
-
     if (i == m->pid) continue;
-    
+
+    E_Int *pf = &RECV[RDIST[i]];
+
     for (E_Int j = 0; j < RCOUNT[i]; j++) {
-      E_Int gface = ptr[j];
-      auto search = mFT.find(gface);
-      if (search != mFT.end()) {
-        E_Int lface = search->second;
-        assert(lface >= 0 && lface < m->nfaces);
-        *ps++ = gface;
-        *ps++ = m->gcells[m->owner[lface]];
+      E_Int lface = global_to_local(mFT, pf[j]);
+      if (lface != -1 && vfaces[lface] == 0) {
+        *ptr++ = pf[j];
+        *ptr++ = m->gcells[m->owner[lface]];
       }
     }
   }
@@ -600,8 +764,7 @@ AMesh *reconstruct_mesh(AMesh *M, E_Int *cmap)
   m->npatches = 0;
 
   for (E_Int i = 0; i < npc; i++) {
-    if (rcount[i] == 0) continue;
-    m->npatches++;
+    if (rcount[i] > 0) m->npatches++;
   }
 
   m->patches = (Patch *)XCALLOC(m->npatches, sizeof(Patch));
@@ -610,411 +773,100 @@ AMesh *reconstruct_mesh(AMesh *M, E_Int *cmap)
 
   for (E_Int i = 0; i < npc; i++) {
     if (rcount[i] == 0) continue;
-    
-    m->patches[m->npatches].nf = rcount[i]/2;
-    m->patches[m->npatches].pf = (E_Int *)XMALLOC(rcount[i] * sizeof(E_Int));
-    m->patches[m->npatches].pn = (E_Int *)XMALLOC(rcount[i] * sizeof(E_Int));
-    m->patches[m->npatches].nei = i;
-
-    E_Int *ptr = &rdata[rdist[i]];
 
-    Patch *P = &m->patches[m->npatches];
+    Patch *P = &m->patches[m->npatches++];
 
-    E_Int k = 0;
+    P->nei = i;
+    P->nf = rcount[i]/2;
+    P->pf = (E_Int *)XMALLOC(P->nf * sizeof(E_Int));
+    P->pn = (E_Int *)XMALLOC(P->nf * sizeof(E_Int));
 
-    for (E_Int j = 0; j < rcount[i];) {
-      P->pf[k] = ptr[j++];
-      P->pn[k] = ptr[j++];
-      assert(mCT.find(P->pn[k]) == mCT.end());
-      k++;
-    }
-
-    m->npatches++;
-  }
-
-  m->nif = m->nfaces - m->nbf - m->npf;
-
-  for (E_Int i = 0; i < m->npatches; i++) {
-    Patch *P = &m->patches[i];
-
-    std::sort(P->pf, P->pf+P->nf);
-    std::sort(P->pn, P->pn+P->nf, [&] (E_Int i, E_Int j) {
-      return P->pf[i] < P->pf[j];
-    });
-
-    // Replace with local faces
-    for (E_Int j = 0; j < P->nf; j++)
-      P->pf[j] = mFT[P->pf[j]];
-  }
-  
-  /* EDGE CENTER MAP */
-
-  // Send edge+center is face was sent
-
-  memset(scount, 0, npc * sizeof(int));
-
-  Edge E;
-  for (E_Int i = 0; i < npc; i++) {
-    E_Int *pf = &sfaces[f_sdist[i]];
-
-    for (int j = 0; j < f_scount[i]; j++) {
-      E_Int lface = MFT[pf[j]];
-
-      E_Int np = -1;
-      E_Int *pn = get_face(lface, np, M->ngon, M->indPG);
-
-      for (E_Int k = 0; k < np; k++) {
-        E_Int p = pn[k];
-        E_Int q = pn[(k+1)%np];
-
-        E.set(p, q);
-
-        auto search = M->ecenter->find(E);
-
-        if (search != M->ecenter->end())
-          scount[i] += 3;
-      }
+    // Both sides sort their pfaces by global id
+    std::vector<std::pair<E_Int, E_Int>> pairs(P->nf);
+    E_Int *pr = &rdata[rdist[i]];
+    for (E_Int j = 0; j < P->nf; j++) {
+      pairs[j].first = pr[2*j];
+      pairs[j].second = pr[2*j+1];
+      assert(mCT.find(pairs[j].second) == mCT.end());
     }
-  }
-
-  MPI_Alltoall(scount, 1, MPI_INT, rcount, 1, MPI_INT, MPI_COMM_WORLD);
 
-  for (E_Int i = 0; i < npc; i++) {
-    sdist[i+1] = sdist[i] + scount[i];
-    rdist[i+1] = rdist[i] + rcount[i];
-  }
-
-  sdata = (E_Int *)XRESIZE(sdata, sdist[npc] * sizeof(E_Int));
-  rdata = (E_Int *)XRESIZE(rdata, rdist[npc] * sizeof(E_Int));
+    std::sort(pairs.begin(), pairs.end());
 
-  for (E_Int i = 0; i < npc; i++) {
-    E_Int *pf = &sfaces[f_sdist[i]];
-    E_Int *ptr = &sdata[sdist[i]];
-
-    for (int j = 0; j < f_scount[i]; j++) {
-      E_Int lface = MFT[pf[j]];
-
-      E_Int np = -1;
-      E_Int *pn = get_face(lface, np, M->ngon, M->indPG);
-
-      for (E_Int k = 0; k < np; k++) {
-        E_Int p = pn[k];
-        E_Int q = pn[(k+1)%np];
-
-        E.set(p, q);
-
-        auto search = M->ecenter->find(E);
-
-        if (search != M->ecenter->end()) {
-          *ptr++ = M->gpoints[search->first.p0_];
-          *ptr++ = M->gpoints[search->first.p1_];
-          *ptr++ = M->gpoints[search->second];
-        }
-      }
+    for (E_Int j = 0; j < P->nf; j++) {
+      P->pf[j] = mFT[pairs[j].first];
+      P->pn[j] = pairs[j].second;
     }
   }
 
-  MPI_Alltoallv(sdata, scount, sdist, XMPI_INT,
-                rdata, rcount, rdist, XMPI_INT,
-                MPI_COMM_WORLD);
-
-  m->ecenter = new std::map<Edge, E_Int>;
-
-  for (E_Int i = 0; i < npc; i++) {
-    E_Int *pp = &rdata[rdist[i]];
-
-    int j = 0;
-    for (; j < rcount[i];) {
-      E_Int p = mPT[pp[j++]];
-      E_Int q = mPT[pp[j++]];
-      E_Int c = mPT[pp[j++]];
-      
-      E.set(p, q);
-      m->ecenter->insert({E, c});
-    }
-  }
+  m->nif = m->nfaces - m->nbf - m->npf;
 
   /* CELL TREE */
-  Tree *CT = M->cellTree;
-
-  // First, send everything but children
-
-  for (E_Int i = 0; i < npc; i++) {
-    scount[i] = 4*c_scount[i];
-    rcount[i] = 4*c_rcount[i];
-    sdist[i+1] = sdist[i] + scount[i];
-    rdist[i+1] = rdist[i] + rcount[i];
-  }
-
-  sdata = (E_Int *)XRESIZE(sdata, sdist[npc] * sizeof(E_Int));
-  rdata = (E_Int *)XRESIZE(rdata, rdist[npc] * sizeof(E_Int));
-
-  for (E_Int i = 0; i < npc; i++) idx[i] = sdist[i];
-
-  for (E_Int i = 0; i < npc; i++) {
-    E_Int *pc = &scells[c_sdist[i]];
-    E_Int *ptr = &sdata[sdist[i]];
-
-    for (int j = 0; j < c_scount[i]; j++) {
-      E_Int cell = MCT[pc[j]];
-      
-      *ptr++ = M->gcells[CT->parent_[cell]];
-      *ptr++ = CT->level_[cell];
-      *ptr++ = CT->type_[cell];
-      *ptr++ = CT->state_[cell];
-    }
-  }
 
-  MPI_Alltoallv(sdata, scount, sdist, XMPI_INT,
-                rdata, rcount, rdist, XMPI_INT,
-                MPI_COMM_WORLD);
-  
-  m->cellTree = new Tree(m->ncells);
-  Tree *ct = m->cellTree;
-
-  // TODO(Imad): Minimize the ugly copying
-  E_Int *ptr = rdata;
-  for (E_Int i = 0; i < m->ncells; i++) {
-    ct->parent_[i] = mCT[*ptr++];
-    ct->level_[i] = *ptr++;
-    ct->type_[i] = *ptr++;
-    ct->state_[i] = *ptr++;
-  }
-
-  // Count children
   memset(scount, 0, npc*sizeof(int));
 
   for (E_Int i = 0; i < npc; i++) {
-    E_Int *pc = &scells[c_sdist[i]];
-
-    for (int j = 0; j < c_scount[i]; j++) {
-      E_Int cell = MCT[pc[j]];
-
-      Children *cur = CT->children(cell);
-
-      while (cur) {
-        scount[i] += 2 + cur->n; // ngen + nchild per gen + children
-        cur = cur->next;
-      }
-    }
+    for (E_Int k = c_sdist[i]; k < c_sdist[i+1]; k++)
+      scount[i] += tree_node_size(CT, lcells[k]);
   }
 
   MPI_Alltoall(scount, 1, MPI_INT, rcount, 1, MPI_INT, MPI_COMM_WORLD);
 
-  for (E_Int i = 0; i < npc; i++) {
-    sdist[i+1] = sdist[i] + scount[i];
-    rdist[i+1] = rdist[i] + rcount[i];
-  }
+  make_csr(scount, rcount, sdist, rdist, npc);
 
   sdata = (E_Int *)XRESIZE(sdata, sdist[npc] * sizeof(E_Int));
   rdata = (E_Int *)XRESIZE(rdata, rdist[npc] * sizeof(E_Int));
 
-  if (sdist[npc]) {
-    for (E_Int i = 0; i < npc; i++) {
-      E_Int *pc = &scells[c_sdist[i]];
-      E_Int *ptr = &sdata[sdist[i]];
-
-      for (int j = 0; j < c_scount[i]; j++) {
-        E_Int cell = MCT[pc[j]];
-
-        Children *cur = CT->children(cell);
-
-        E_Int &ngen = *ptr++;
-        E_Int &nchild = *ptr++;
-        ngen = 0;
-        nchild = 0;
-
-        while (cur) {
-          ngen += 1;
-          nchild = cur->n;
-
-          for (E_Int k = 0; k < cur->n; k++)
-            *ptr++ = M->gcells[cur->pc[k]];
-
-          cur = cur->next;
-        }
-      }
-    }
-  }
+  ptr = sdata;
+  for (E_Int k = 0; k < c_sdist[npc]; k++)
+    ptr = tree_node_pack(CT, lcells[k], M->gcells, ptr);
 
   MPI_Alltoallv(sdata, scount, sdist, XMPI_INT,
                 rdata, rcount, rdist, XMPI_INT,
                 MPI_COMM_WORLD);
 
-  if (rdist[npc]) {
-    for (E_Int i = 0; i < npc; i++) {
-      E_Int *pc = &m->gcells[c_rdist[i]];
-      E_Int *ptr = &rdata[rdist[i]];
-
-      for (E_Int j = 0; j < rcount[i];) {
-        E_Int cell = MCT[pc[j]];
-
-        E_Int ngen = *ptr++;
-        E_Int nchild = *ptr++;
-
-        if (ngen == 0) continue;
-
-        Children *tmp = (Children *)XMALLOC(sizeof(Children));
-        tmp->next = NULL;
-        Children *cur = tmp->next;
-
-        for (E_Int k = 0; k < ngen; j++) {
-          Children *new_gen = (Children *)XMALLOC(sizeof(Children));
-          new_gen->n = nchild;
-          new_gen->next = NULL;
-
-          for (E_Int l = 0; l < nchild; l++)
-            new_gen->pc[l] = mCT[*ptr++];
-
-          cur = new_gen;
-          cur = cur->next;
-        }
+  m->cellTree = new Tree(m->ncells);
 
-        ct->children_[cell] = tmp->next;
-        XFREE(tmp);
-      }
-    }
-  }
+  ptr = rdata;
+  for (E_Int i = 0; i < m->ncells; i++)
+    ptr = tree_node_unpack(m->cellTree, i, mCT, ptr);
 
   /* FACE TREE */
-  Tree *FT = M->faceTree;
-
-  // First, send everything but children
 
-  for (E_Int i = 0; i < npc; i++) {
-    scount[i] = 4*f_scount[i];
-    rcount[i] = 4*f_rcount[i];
-    sdist[i+1] = sdist[i] + scount[i];
-    rdist[i+1] = rdist[i] + rcount[i];
-  }
-
-  sdata = (E_Int *)XRESIZE(sdata, sdist[npc] * sizeof(E_Int));
-  rdata = (E_Int *)XRESIZE(rdata, rdist[npc] * sizeof(E_Int));
-
-
-  for (E_Int i = 0; i < npc; i++) {
-    E_Int *pf = &sfaces[f_sdist[i]];
-    E_Int *ptr = &sdata[sdist[i]];
-
-    for (int j = 0; j < f_scount[i]; j++) {
-      E_Int face = MFT[pf[j]];
-      assert(face >= 0 && face < M->nfaces);
-      *ptr++ = M->gfaces[FT->parent_[face]];
-      *ptr++ = FT->level_[face];
-      *ptr++ = FT->type_[face];
-      *ptr++ = FT->state_[face];
-    }
-  }
-
-  MPI_Alltoallv(sdata, scount, sdist, XMPI_INT,
-                rdata, rcount, rdist, XMPI_INT,
-                MPI_COMM_WORLD);
-
-  
-  m->faceTree = new Tree(m->nfaces);
-  Tree *ft = m->faceTree;
-
-  // TODO(Imad): again with the ugly copying!
-  ptr = rdata;
-  for (E_Int i = 0; i < m->nfaces; i++) {
-    ft->parent_[i] = mFT[*ptr++];
-    ft->level_[i] = *ptr++;
-    ft->type_[i] = *ptr++;
-    ft->state_[i] = *ptr++;
-  }
-
-  // Count children
   memset(scount, 0, npc*sizeof(int));
 
   for (E_Int i = 0; i < npc; i++) {
-    E_Int *pf = &sfaces[f_sdist[i]];
-
-    for (int j = 0; j < f_scount[i]; j++) {
-      E_Int face = MFT[pf[j]];
-
-      Children *cur = FT->children(face);
-
-      while (cur) {
-        scount[i] += 2 + cur->n; // ngen + nchild per gen + children
-        cur = cur->next;
-      }
-    }
+    for (E_Int k = f_sdist[i]; k < f_sdist[i+1]; k++)
+      scount[i] += tree_node_size(FT, lfaces[k]);
   }
 
   MPI_Alltoall(scount, 1, MPI_INT, rcount, 1, MPI_INT, MPI_COMM_WORLD);
 
-  for (E_Int i = 0; i < npc; i++) {
-    sdist[i+1] = sdist[i] + scount[i];
-    rdist[i+1] = rdist[i] + rcount[i];
-  }
+  make_csr(scount, rcount, sdist, rdist, npc);
 
   sdata = (E_Int *)XRESIZE(sdata, sdist[npc] * sizeof(E_Int));
   rdata = (E_Int *)XRESIZE(rdata, rdist[npc] * sizeof(E_Int));
 
-  if (sdist[npc]) {
-    for (E_Int i = 0; i < npc; i++) {
-      E_Int *pf = &sfaces[f_sdist[i]];
-      E_Int *ptr = &sdata[sdist[i]];
-
-      for (int j = 0; j < f_scount[i]; j++) {
-        E_Int face =  MFT[pf[j]];
-
-        Children *cur = FT->children(face);
-
-        E_Int &ngen = *ptr++;
-        E_Int &nchild = *ptr++;
-        ngen = 0;
-        nchild = 0;
-
-        while (cur) {
-          ngen += 1;
-          nchild = cur->n;
-
-          for (E_Int k = 0; k < cur->n; k++)
-            *ptr++ = M->gfaces[cur->pc[k]];
-
-          cur = cur->next;
-        }
-      }
-    }
-  }
+  ptr = sdata;
+  for (E_Int k = 0; k < f_sdist[npc]; k++)
+    ptr = tree_node_pack(FT, lfaces[k], M->gfaces, ptr);
 
   MPI_Alltoallv(sdata, scount, sdist, XMPI_INT,
                 rdata, rcount, rdist, XMPI_INT,
                 MPI_COMM_WORLD);
 
-  if (rdist[npc]) {
-    for (E_Int i = 0; i < npc; i++) {
-      E_Int *pf = &m->gfaces[f_rdist[i]];
-      E_Int *ptr = &rdata[rdist[i]];
-
-      for (E_Int j = 0; j < rcount[i];) {
-        E_Int face = MFT[pf[j]];
-
-        E_Int ngen = *ptr++;
-        E_Int nchild = *ptr++;
-
-        if (ngen == 0) continue;
-
-        Children *tmp = (Children *)XMALLOC(sizeof(Children));
-        tmp->next = NULL;
-        Children *cur = tmp->next;
-
-        for (E_Int k = 0; k < ngen; j++) {
-          Children *new_gen = (Children *)XMALLOC(sizeof(Children));
-          new_gen->n = nchild;
-          new_gen->next = NULL;
+  m->faceTree = new Tree(m->nfaces);
 
-          for (E_Int l = 0; l < nchild; l++)
-            new_gen->pc[l] = mFT[*ptr++];
+  ptr = rdata;
+  for (E_Int i = 0; i < f_rdist[npc]; i++)
+    ptr = tree_node_unpack(m->faceTree, fpos[i], mFT, ptr);
 
-          cur = new_gen;
-          cur = cur->next;
-        }
+  // Flipping a refined quad mirrors its children: children 1 and 3 swap,
+  // as for the other side of a comm patch
+  for (E_Int i = 0; i < m->nfaces; i++) {
+    if (!fflip[i]) continue;
 
-        ft->children_[face] = tmp->next;
-        XFREE(tmp);
-      }
+    for (Children *cur = m->faceTree->children(i); cur; cur = cur->next) {
+      if (cur->n == 4) std::swap(cur->pc[1], cur->pc[3]);
     }
   }
 
@@ -1030,41 +882,58 @@ AMesh *reconstruct_mesh(AMesh *M, E_Int *cmap)
     memcpy(m->mode_2D, M->mode_2D, 3*sizeof(E_Float));
   }
 
+  m->onc = 0;
+  for (E_Int i = 0; i < m->ncells; i++) {
+    if (m->cellTree->parent(i) == i) m->onc++;
+  }
+  m->onf = m->nfaces;
+  m->onp = m->npoints;
+
+  m->prev_ncells = m->ncells;
+  m->prev_nfaces = m->nfaces;
+  m->prev_npoints = m->npoints;
+
   // Free
+  XFREE(scount);
+  XFREE(rcount);
+  XFREE(sdist);
+  XFREE(rdist);
+  XFREE(idx);
   XFREE(c_scount);
   XFREE(c_rcount);
   XFREE(c_sdist);
   XFREE(c_rdist);
+  XFREE(lcells);
   XFREE(scells);
   XFREE(c_stride);
-  XFREE(idx);
-  XFREE(scount);
-  XFREE(rcount);
-  XFREE(sdist);
-  XFREE(rdist);
   XFREE(sdata);
   XFREE(rdata);
-  XFREE(f_rcount);
   XFREE(f_scount);
-  XFREE(f_rdist);
+  XFREE(f_rcount);
   XFREE(f_sdist);
+  XFREE(f_rdist);
   XFREE(sfaces);
-  XFREE(vfaces);
+  XFREE(rfaces);
+  XFREE(fpos);
   XFREE(f_stride);
-  XFREE(p_rcount);
+  XFREE(r_stride);
+  XFREE(fflip);
+  XFREE(e_rdist);
+  XFREE(recenter);
   XFREE(p_scount);
-  XFREE(p_rdist);
+  XFREE(p_rcount);
   XFREE(p_sdist);
+  XFREE(p_rdist);
   XFREE(spoints);
   XFREE(sx);
   XFREE(sy);
   XFREE(sz);
   XFREE(sref);
+  XFREE(vfaces);
+  XFREE(pfaces);
   XFREE(RCOUNT);
   XFREE(RDIST);
   XFREE(RECV);
-  XFREE(pfaces);
-  mesh_drop(M);
 
   reorder_cells(m);
 
@@ -1075,7 +944,7 @@ AMesh *reconstruct_mesh(AMesh *M, E_Int *cmap)
 }
 
 static
-E_Int *map_graph(AMesh *M, E_Int *CWGT)
+E_Int *map_graph(E_Int nvtx, E_Int *XADJ, E_Int *ADJ, E_Int *VWGT, E_Int npc)
 {
   SCOTCH_Dgraph graph;
   SCOTCH_dgraphInit(&graph, MPI_COMM_WORLD);
@@ -1083,16 +952,16 @@ E_Int *map_graph(AMesh *M, E_Int *CWGT)
   E_Int ret;
   ret = SCOTCH_dgraphBuild(
     &graph,
-    0,             // 0-based
-    M->onc,        // number of local cells
-    M->onc,        // compact graph
-    M->XNEIS,         // local adjacency array
-    NULL,          // compact graph
-    CWGT,          // local cell weights
-    M->gcells,     // local cell labels
-    M->XNEIS[M->onc], // local number of arcs (twice the number of edges)
-    M->XNEIS[M->onc], // compact graph
-    M->CADJ,          // local adjacency array
+    0,          // 0-based
+    nvtx,       // number of local vertices
+    nvtx,       // compact graph
+    XADJ,       // local adjacency array
+    NULL,       // compact graph
+    VWGT,       // local vertex weights
+    NULL,       // vertices are numbered contiguously per rank
+    XADJ[nvtx], // local number of arcs (twice the number of edges)
+    XADJ[nvtx], // compact graph
+    ADJ,        // local adjacency array
     NULL,
     NULL
   );
@@ -1118,9 +987,9 @@ E_Int *map_graph(AMesh *M, E_Int *CWGT)
     exit(1);
   }
 
-  E_Int *map = (E_Int *)XMALLOC(M->onc * sizeof(E_Int));
+  E_Int *map = (E_Int *)XMALLOC(nvtx * sizeof(E_Int));
 
-  ret = SCOTCH_dgraphPart(&graph, M->npc, &strat, map);
+  ret = SCOTCH_dgraphPart(&graph, npc, &strat, map);
 
   if (ret != 0) {
     fprintf(stderr, "AdaptMesh: Failed to map dual graph\n");
@@ -1128,341 +997,102 @@ E_Int *map_graph(AMesh *M, E_Int *CWGT)
     exit(1);
   }
 
-  // TODO(Imad): drop the graph
+  SCOTCH_stratExit(&strat);
+  SCOTCH_dgraphExit(&graph);
 
   return map;
 }
 
-static
-void make_csr(E_Int *scount, E_Int *rcount, E_Int *sdist, E_Int *rdist,
-  E_Int npc)
-{
-  sdist[0] = rdist[0] = 0;
-  for (E_Int i = 0; i < npc; i++) {
-    sdist[i+1] = sdist[i] + scount[i];
-    rdist[i+1] = rdist[i] + rcount[i];
-  }
-}
-
-static
-AMesh *repartition_mesh(AMesh *M, E_Int *cmap)
+// Repartitions the refinement trees: roots are weighted by their number of
+// leaves and connected whenever two of their leaves share a face.
+AMesh *load_balance_mesh(AMesh *M)
 {
-  return (AMesh *)NULL;
-  /*
-  AMesh *m = new AMesh;
-  m->ecenter = new std::map<Edge, E_Int>;
-  m->CT = new std::unordered_map<E_Int, E_Int>;
-  m->FT = new std::unordered_map<E_Int, E_Int>;
-  m->PT = new std::unordered_map<E_Int, E_Int>;
-
-  E_Int npc = M->npc;
-
-  auto &mCT = *(m->CT);
-  auto &mFT = *(m->FT);
-  auto &mPT = *(m->PT);
-
-  auto &MCT = *(M->CT);
-  auto &MFT = *(M->FT);
-  auto &MPT = *(M->PT);
-
-  // CELLS
-
-  // ocells
-
-  int *o_scount = (int *)XCALLOC(npc, sizeof(int));
-  int *o_rcount = (int *)XMALLOC(npc * sizeof(int));
-
-  for (E_Int i = 0; i < M->onc; i++) {
-    assert(M->cellTree->parent(i) == i);
-    E_Int where = cmap[i];
-
-    o_scount[where] += 1;
-  }
-
-  MPI_Alltoall(o_scount, 1, MPI_INT, o_rcount, 1, MPI_INT, MPI_COMM_WORLD);
-
-  int *o_sdist = (E_Int *)XMALLOC((npc+1) * sizeof(int));
-  int *o_rdist = (E_Int *)XMALLOC((npc+1) * sizeof(int));
-
-  make_csr(o_scount, o_rcount, o_sdist, o_rdist, npc);
-
-  m->onc = o_rdist[npc];
-
-  // ncells
-
-  int *n_scount = (int *)XCALLOC(npc, sizeof(int));
-  int *n_rcount = (int *)XMALLOC(npc * sizeof(int));
-
-  for (E_Int i = M->onc; i < M->ncells; i++) {
-    assert(M->cellTree->parent(i) < M->onc);
-    E_Int where = cmap[M->cellTree->parent(i)];
-
-    n_scount[where] += 1;
-  }
-
-  MPI_Alltoall(n_scount, 1, MPI_INT, n_rcount, 1, MPI_INT, MPI_COMM_WORLD);
-
-  int *n_sdist = (E_Int *)XMALLOC((npc+1) * sizeof(int));
-  int *n_rdist = (E_Int *)XMALLOC((npc+1) * sizeof(int));
-
-  make_csr(n_scount, n_rcount, n_sdist, n_rdist, npc);
-
-  m->ncells = m->onc + n_rdist[npc];
-
-  // Send hierarchy of ocells
-
-  int *ngen = (int *)XCALLOC(M->ncells, sizeof(int));
-
-  memset(o_scount, 0, npc*sizeof(int));
-
-  for (E_Int i = 0; i < M->onc; i++) {
-    E_Int where = cmap[i];
-
-    // Count ngen
-    Children *cur = M->cellTree->children(i);
-    while (cur) {
-      ngen[i] += 1;
-      cur = cur->next;
-    }
-
-    E_Int stride = nchild_from_type(M->cellTree->type(i));
+  Tree *CT = M->cellTree;
 
-    // Sending: type + level + state + ngen + ngen*stride children
-    o_scount[where] += 4 + ngen*stride;
+  // Roots are the cells that are their own parent
+  std::vector<E_Int> rid(M->ncells, -1);
+  E_Int nroots = 0;
+  for (E_Int i = 0; i < M->ncells; i++) {
+    if (CT->parent(i) == i) rid[i] = nroots++;
   }
 
-  MPI_Alltoall(o_scount, 1, MPI_INT, o_rcount, 1, MPI_INT, MPI_COMM_WORLD);
-
-  make_csr(o_scount, o_rcount, o_sdist, o_rdist, npc);
-
-  E_Int *o_sdata = (E_Int *)XMALLOC(o_sdist[npc] * sizeof(E_Int));
-  E_Int *o_rdata = (E_Int *)XMALLOC(o_rdist[npc] * sizeof(E_Int));
-
-  int *idx = (E_Int *)XMALLOC(npc * sizeof(int));
-
-  memcpy(idx, o_sdist, npc*sizeof(int));
-
-  for (E_Int i = 0; i < M->onc; i++) {
-    E_Int where = cmap[i];
-
-    // Type
-    o_sdata[idx[where]++] = M->cellTree->type(i);
-
-    // State
-    o_sdata[idx[where]++] = M->cellTree->state(i);
-
-    // Level
-    o_sdata[idx[where]++] = M->cellTree->level(i);
-
-    // Number of generations
-    o_sdata[idx[where]++] = ngen[i];
-
-    // Children
-
-    E_Int stride = nchild_from_type(M->cellTree->type(i));
-
-    Children *cur = M->cellTree->children(i);
-    while (cur) {
-      for (E_Int j = 0; j < cur->n; j++)
-        o_sdata[idx[where]++] = cur->pc[j];
-      
-      cur = cur->next;
-    }
+  std::vector<E_Int> croot(M->ncells);
+  for (E_Int i = 0; i < M->ncells; i++) {
+    E_Int root = i;
+    while (CT->parent(root) != root) root = CT->parent(root);
+    croot[i] = rid[root];
   }
 
-  MPI_Alltoallv(o_sdata, o_scount, o_sdist, XMPI_INT,
-                o_rdata, o_rcount, o_rdist, XMPI_INT,
-                MPI_COMM_WORLD);
- 
-  // Send hierarchy of ncells
-
-  memset(n_scount, 0, npc*sizeof(int));
+  // Scotch wants vertices numbered contiguously across ranks
+  E_Int first_root;
+  MPI_Scan(&nroots, &first_root, 1, XMPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  first_root -= nroots;
 
-  for (E_Int i = M->onc; i < M->ncells; i++) {
-    E_Int where = cmap[M->cellTree->parent(i)];
+  // Root weights
+  E_Int *VWGT = (E_Int *)XCALLOC(nroots, sizeof(E_Int));
+  for (E_Int i = 0; i < M->ncells; i++) VWGT[croot[i]] += 1;
 
-    // Count ngen
-    Children *cur = M->cellTree->children(i);
+  // Root adjacency
+  std::vector<std::pair<E_Int, E_Int>> arcs;
 
-    while (cur) {
-      ngen[i] += 1;
-      cur = cur->next;
-    }
+  for (E_Int i = 0; i < M->nfaces; i++) {
+    E_Int nei = M->neigh[i];
+    if (nei == -1) continue;
 
-    E_Int stride = nchild_from_type(M->cellTree->type(i));
+    E_Int r0 = croot[M->owner[i]];
+    E_Int r1 = croot[nei];
+    if (r0 == r1) continue;
 
-    // Sending: type + level + state + ngen + ngen*stride children
-    n_scount[where] += 4 + ngen*stride;
+    arcs.push_back({r0, first_root + r1});
+    arcs.push_back({r1, first_root + r0});
   }
 
-  MPI_Alltoall(n_scount, 1, MPI_INT, n_rcount, 1, MPI_INT, MPI_COMM_WORLD);
-
-  make_csr(n_scount, n_rcount, n_sdist, n_rdist, npc);
-
-  E_Int *n_sdata = (E_Int *)XMALLOC(n_sdist[npc] * sizeof(E_Int));
-  E_Int *n_rdata = (E_Int *)XMALLOC(n_rdist[npc] * sizeof(E_Int));
-
-  memcpy(idx, n_sdist, npc*sizeof(int));
-
-  for (E_Int i = M->onc; i < M->ncells; i++) {
-    E_Int where = cmap[M->cellTree->parent(i)];
-
-    // Parent
-    n_sdata[idx[where]++] = M->cellTree->parent(i);
-
-    // Type
-    n_sdata[idx[where]++] = M->cellTree->type(i);
-
-    // State
-    n_sdata[idx[where]++] = M->cellTree->state(i);
-
-    // Level
-    n_sdata[idx[where]++] = M->cellTree->level(i);
-
-    // Number of generations
-    n_sdata[idx[where]++] = ngen[i];
-
-    // Children
+  for (E_Int i = 0; i < M->npatches; i++) {
+    Patch *P = &M->patches[i];
 
-    E_Int stride = nchild_from_type(M->cellTree->type(i));
+    P->sbuf_i = (E_Int *)XRESIZE(P->sbuf_i, P->nf * sizeof(E_Int));
+    P->rbuf_i = (E_Int *)XRESIZE(P->rbuf_i, P->nf * sizeof(E_Int));
 
-    Children *cur = M->cellTree->children(i);
-    while (cur) {
-      for (E_Int j = 0; j < cur->n; j++)
-        n_sdata[idx[where]++] = cur->pc[j];
-      
-      cur = cur->next;
-    }
+    #pragma omp simd
+    for (E_Int j = 0; j < P->nf; j++)
+      P->sbuf_i[j] = first_root + croot[M->owner[P->pf[j]]];
   }
 
-  MPI_Alltoallv(n_sdata, n_scount, n_sdist, XMPI_INT,
-                n_rdata, n_rcount, n_rdist, XMPI_INT,
-                MPI_COMM_WORLD);
-
-  // Parse received data
-
-  // Init cell tree
-  m->cellTree = new Tree(m->ncells);
-
-  // First, register ocells
-
-  E_Int cell = 0;
-  for (E_Int i = 0; i < npc; i++) {
-    E_Int *ptr = &o_rdata[o_rdist[i]];
-
-    for (E_Int j = 0; j < o_rcount[i]; ) {
-      m->cellTree->parent_[cell] = cell;
-      m->cellTree->type_  [cell] = ptr[j++];
-      m->cellTree->state_ [cell] = ptr[j++];
-      m->cellTree->level_ [cell] = ptr[j++];
-      E_Int ngen = ptr[j++];
+  Comm_patch_start_i(M, NULL, NULL);
+  Comm_patch_wait(M);
 
-      if (ngen == 0) continue;
-
-      E_Int stride = nchild_from_type(m->cellTree->type(cell));
-
-      m->cellTree->children_[cell] = (Children *)XCALLOC(1, sizeof(Children));
-      m->cellTree->children_[cell]->n = stride;
-      for (E_Int k = 0; k < stride; k++)
-        m->cellTree->children_[cell]->pc[k] = ptr[j++];
-      
-      m->cellTree->children_[cell]->pc[0] = cell;
-
-      for (E_Int k = 0; k < ngen-1; k++) {
-        Children *new_gen = (Children *)XCALLOC(1, sizeof(Children));
-        new_gen->n = stride;
-        for (E_Int l = 0; l < l++)
-          new_gen->pc[l] = ptr[j++];
-        
-        new_gen->pc[0] = cell;
-        
-        Children *tmp = m->cellTree->children_[cell]->next;
-
-        m->cellTree->children_[cell]->next = new_gen;
-        
-        new_gen->next = tmp;
-      }
+  for (E_Int i = 0; i < M->npatches; i++) {
+    Patch *P = &M->patches[i];
 
-      cell++;
-    }
+    for (E_Int j = 0; j < P->nf; j++)
+      arcs.push_back({croot[M->owner[P->pf[j]]], P->rbuf_i[j]});
   }
 
-  assert(cell == m->onc);
-
-  // Register ncells
-
-  for (E_Int i = 0; i < npc; i++) {
-    E_Int *ptr = &n_rdata[n_rdist[i]];
-
-    for (E_Int j = 0; j < n_rcount[i]; ) {
-      m->cellTree->parent_[cell] = ptr[j++];
-      m->cellTree->type_  [cell] = ptr[j++];
-      m->cellTree->state_ [cell] = ptr[j++];
-      m->cellTree->level_ [cell] = ptr[j++];
-      E_Int ngen = ptr[j++];
-
-      if (ngen == 0) continue;
-
-      m->cellTree->children_[cell] = (Children *)XCALLOC(1, sizeof(Children));
-
-      for (E_Int k = 0; k < ngen-1; k++) {
-        Children *new_gen = (Children *)XCALLOC(1, sizeof(Children));
-        
-        Children *tmp = m->cellTree->children_[cell]->next;
+  std::sort(arcs.begin(), arcs.end());
+  arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
 
-        m->cellTree->children_[cell]->next = new_gen;
-        
-        new_gen->next = tmp;
-      }
+  E_Int *XADJ = (E_Int *)XCALLOC(nroots+1, sizeof(E_Int));
+  E_Int *ADJ = (E_Int *)XMALLOC(arcs.size() * sizeof(E_Int));
 
-      cell++;
-    }
+  for (size_t i = 0; i < arcs.size(); i++) {
+    XADJ[arcs[i].first+1] += 1;
+    ADJ[i] = arcs[i].second;
   }
 
+  for (E_Int i = 0; i < nroots; i++) XADJ[i+1] += XADJ[i];
 
-  XFREE(ngen);
-  XFREE(idx);
-  XFREE(o_scount);
-  XFREE(o_rcount);
-  XFREE(o_sdist);
-  XFREE(o_rdist);
-  XFREE(o_sdata);
-  XFREE(o_rdata);
-  XFREE(n_scount);
-  XFREE(n_rcount);
-  XFREE(n_sdist);
-  XFREE(n_rdist);
-  XFREE(n_sdata);
-  XFREE(n_rdata);
-  */
-}
-
-AMesh *load_balance_mesh(AMesh *M)
-{
-  // Cell weights
-  E_Int *CWGT = (E_Int *)XCALLOC(0, M->onc*sizeof(E_Int));
-  for (E_Int i = 0; i < M->onc; i++) {
-    E_Int wgt = M->ref_data[i];
-
-    Children *cur = M->cellTree->children(i);
-
-    while (cur) {
-      for (E_Int j = 1; j < cur->n; j++)
-        wgt += M->ref_data[cur->pc[j]];
-      
-      cur = cur->next;
-    }
-
-    CWGT[i] = 1 << wgt;
-  }
+  // Whole trees follow their root
+  E_Int *rmap = map_graph(nroots, XADJ, ADJ, VWGT, M->npc);
 
-  // Make cell map
-  E_Int *cmap = map_graph(M, CWGT);
+  E_Int *cmap = (E_Int *)XMALLOC(M->ncells * sizeof(E_Int));
+  for (E_Int i = 0; i < M->ncells; i++) cmap[i] = rmap[croot[i]];
 
-  // Produce a new mesh based on cell map
-  AMesh *new_mesh = repartition_mesh(M, cmap);
+  AMesh *new_mesh = reconstruct_mesh(M, cmap);
 
-  XFREE(CWGT);
+  XFREE(VWGT);
+  XFREE(XADJ);
+  XFREE(ADJ);
+  XFREE(rmap);
   XFREE(cmap);
 
   return new_mesh;
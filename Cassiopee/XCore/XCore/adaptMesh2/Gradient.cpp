@@ -51,7 +51,13 @@ void make_A_grad_matrices(AMesh *M, E_Int *indPH, E_Int *count_neis,
       ln[j] = -d[j];
     }
   }
+}
 
+// Proc face rows go after the internal ones, once the patch data arrived
+static
+void make_A_grad_patch_rows(AMesh *M, E_Int *indPH, E_Int *count_neis,
+  E_Int *owner, E_Float *cx, E_Float *cy, E_Float *cz, E_Float *lsqG)
+{
   for (E_Int i = 0; i < M->npatches; i++) {
     Patch *P = &M->patches[i];
 
@@ -76,27 +82,6 @@ void make_A_grad_matrices(AMesh *M, E_Int *indPH, E_Int *count_neis,
   // TODO(Imad): boundary contributions
 }
 
-static
-void deduce_lsq_grad_matrices(AMesh *M, E_Int *indPH, E_Int *count_neis,
-  E_Float *lsqG, E_Float *lsqGG)
-{
-  E_Int ncells = M->ncells;
-
-  for (E_Int i = 0; i < ncells; i++) {
-    E_Float *pGG = &lsqGG[9*i];
-    E_Float *pG = &lsqG[3*indPH[i]];
-    E_Int idx = 0;
-    for (E_Int j = 0; j < 3; j++) {
-      for (E_Int k = 0; k < 3; k++) {
-        pGG[idx] = 0.0;
-        for (E_Int l = 0; l < count_neis[i]; l++)
-          pGG[idx] += pG[l*3+j] * pG[l*3+k];
-        idx++;
-      }
-    }
-  }
-}
-
 static
 void make_grad_RHS_vector(AMesh *M, E_Int *indPH, E_Int *count_neis,
   E_Float *field, E_Float *b, E_Int *owner, E_Int *neigh)
@@ -138,26 +123,29 @@ void make_gradient(AMesh *M, E_Int *indPH, E_Int *count_neis, E_Float *b,
   E_Float *G, E_Float *lsqG, E_Float *lsqGG)
 {
   E_Int ncells = M->ncells;
-  E_Float B[3];
 
-  for (E_Int i = 0; i < ncells; i++) {
-    // Make B vector = tA.b
-    E_Float *pG = &lsqG[3*indPH[i]];
-    E_Float *pb = &b[indPH[i]];
-    for (E_Int j = 0; j < 3; j++) {
-      B[j] = 0.0;
-      for (E_Int k = 0; k < count_neis[i]; k++)
-        B[j] += pb[k] * pG[k*3 + j];
-    }
+  // Make B vectors = tA.b and solve, all cells at once (SoA)
+  E_Float *B = (E_Float *)XMALLOC(6*ncells * sizeof(E_Float));
+  E_Float *X = B + 3*ncells;
 
-    // Solve
-    E_Int converged = K_LINEAR::BiCGStab(&lsqGG[9*i], B, 3, &G[3*i]);
+  K_LINEAR::lsq_normal_batch(ncells, 3, indPH, count_neis, lsqG, b, NULL, B);
 
-    if (!converged) {
-      fprintf(stderr, "make_gradient: cell " SF_D_ " not converged.\n", i);
-      exit(1);
-    }
+  E_Int nsing = K_LINEAR::spd3_solve_batch(ncells, lsqGG, B, X);
+
+  // In 2D, the normal direction is missing from all the stencils : the
+  // matching components are set to 0 by the solver, as expected
+  if (nsing > 0 && M->mode_2D == NULL) {
+    fprintf(stderr, "Warning: computeGradient: proc %d: " SF_D_ " cell(s) with"
+      " a singular least-squares system, undetermined components set"
+      " to 0.\n", M->pid, nsing);
   }
+
+  for (E_Int i = 0; i < ncells; i++) {
+    for (E_Int j = 0; j < 3; j++)
+      G[3*i+j] = X[j*ncells+i];
+  }
+
+  XFREE(B);
 }
 
 PyObject *K_XCORE::computeGradient(PyObject *self, PyObject *args)
@@ -208,9 +196,11 @@ PyObject *K_XCORE::computeGradient(PyObject *self, PyObject *args)
   E_Int *count_neis = (E_Int *)XMALLOC(ncells * sizeof(E_Int));
 
   E_Float *lsqG = (E_Float *)XMALLOC(3*sizeNFace * sizeof(E_Float));
-  E_Float *lsqGG = (E_Float *)XMALLOC(9*ncells * sizeof(E_Float));
+  E_Float *lsqGG = (E_Float *)XMALLOC(6*ncells * sizeof(E_Float));
 
   // Pre-exchange
+  std::vector<E_Int> count(M->npatches);
+
   for (E_Int i = 0; i < M->npatches; i++) {
     Patch *P = &M->patches[i];
 
@@ -231,14 +221,20 @@ PyObject *K_XCORE::computeGradient(PyObject *self, PyObject *args)
       *it++ = field[own];
     }
 
-    MPI_Isend(P->sbuf_f, 4*P->nf, MPI_DOUBLE, P->nei, M->pid, MPI_COMM_WORLD, &M->req[M->nrq++]);
-    MPI_Irecv(P->rbuf_f, 4*P->nf, MPI_DOUBLE, P->nei, P->nei, MPI_COMM_WORLD, &M->req[M->nrq++]);
+    count[i] = 4*P->nf;
   }
-  Comm_waitall(M);
 
+  Comm_patch_start_f(M, count.data(), NULL);
+
+  // Internal rows while the patch data is in flight
   make_A_grad_matrices(M, indPH, count_neis, owner, neigh, cx, cy, cz, lsqG);
+
+  Comm_patch_wait(M);
+
+  make_A_grad_patch_rows(M, indPH, count_neis, owner, cx, cy, cz, lsqG);
   
-  deduce_lsq_grad_matrices(M, indPH, count_neis, lsqG, lsqGG);
+  K_LINEAR::lsq_normal_batch(ncells, 3, indPH, count_neis, lsqG, NULL, lsqGG,
+    NULL);
 
   E_Float *b = (E_Float *)XMALLOC(sizeNFace * sizeof(E_Float));
 
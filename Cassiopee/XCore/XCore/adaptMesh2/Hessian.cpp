@@ -97,27 +97,6 @@ void make_A_hess_matrices(AMesh *M, E_Int *indPH, E_Int *count_neis,
   // TODO(Imad): boundary contributions
 }
 
-static
-void deduce_lsq_hess_matrices(AMesh *M, E_Int *indPH, E_Int *count_neis,
-  E_Float *lsqH, E_Float *lsqHH)
-{
-  E_Int ncells = M->ncells;
-
-  for (E_Int i = 0; i < ncells; i++) {
-    E_Float *pHH = &lsqHH[36*i];
-    E_Float *pH = &lsqH[6*indPH[i]];
-    E_Int idx = 0;
-    for (E_Int j = 0; j < 6; j++) {
-      for (E_Int k = 0; k < 6; k++) {
-        pHH[idx] = 0.0;
-        for (E_Int l = 0; l < count_neis[i]; l++)
-          pHH[idx] += pH[l*6+j] * pH[l*6+k];
-        idx++;
-      }
-    }
-  }
-}
-
 static
 void make_hess_RHS_vector(AMesh *M, E_Int *indPH, E_Int *count_neis,
   E_Float *field, E_Float *G, E_Float *b, E_Int *owner, E_Int *neigh,
@@ -177,26 +156,28 @@ void make_hessian(AMesh *M, E_Int *indPH, E_Int *count_neis,
 {
   E_Int ncells = M->ncells;
 
-  E_Float B[6];
+  // Make B vectors = tA.b and solve, all cells at once (SoA)
+  E_Float *B = (E_Float *)XMALLOC(12*ncells * sizeof(E_Float));
+  E_Float *X = B + 6*ncells;
 
-  for (E_Int i = 0; i < ncells; i++) {
-    // Make B vector = tA.b
-    E_Float *pH = &lsqH[6*indPH[i]];
-    E_Float *pb = &b[indPH[i]];
-    for (E_Int j = 0; j < 6; j++) {
-      B[j] = 0.0;
-      for (E_Int k = 0; k < count_neis[i]; k++)
-        B[j] += pb[k] * pH[k*6 + j];
-    }
+  K_LINEAR::lsq_normal_batch(ncells, 6, indPH, count_neis, lsqH, b, NULL, B);
 
-    // Solve
-    E_Int converged = K_LINEAR::BiCGStab(&lsqHH[36*i], B, 6, &H[6*i]);
+  E_Int nsing = K_LINEAR::spd6_solve_batch(ncells, lsqHH, B, X);
 
-    if (!converged) {
-      fprintf(stderr, "make_hessian: cell " SF_D_ " not converged.\n", i);
-      exit(1);
-    }
+  // In 2D, the normal direction is missing from all the stencils : the
+  // matching components are set to 0 by the solver, as expected
+  if (nsing > 0 && M->mode_2D == NULL) {
+    fprintf(stderr, "Warning: computeHessian: proc %d: " SF_D_ " cell(s) with"
+      " a singular least-squares system, undetermined components set"
+      " to 0.\n", M->pid, nsing);
   }
+
+  for (E_Int i = 0; i < ncells; i++) {
+    for (E_Int j = 0; j < 6; j++)
+      H[6*i+j] = X[j*ncells+i];
+  }
+
+  XFREE(B);
 }
 
 PyObject *K_XCORE::computeHessian(PyObject *self, PyObject *args)
@@ -255,11 +236,12 @@ PyObject *K_XCORE::computeHessian(PyObject *self, PyObject *args)
 
   E_Float *lsqH = (E_Float *)XMALLOC(6*sizeNFace * sizeof(E_Float));
 
-  E_Float *lsqHH = (E_Float *)XMALLOC(36*ncells * sizeof(E_Float));
+  E_Float *lsqHH = (E_Float *)XMALLOC(21*ncells * sizeof(E_Float));
 
   make_A_hess_matrices(M, indPH, count_neis, owner, neigh, cx, cy, cz, lsqH);
 
-  deduce_lsq_hess_matrices(M, indPH, count_neis, lsqH, lsqHH);
+  K_LINEAR::lsq_normal_batch(ncells, 6, indPH, count_neis, lsqH, NULL, lsqHH,
+    NULL);
 
   E_Float *b = (E_Float *)XMALLOC(sizeNFace * sizeof(E_Float));
 
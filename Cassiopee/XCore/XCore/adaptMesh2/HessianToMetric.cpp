@@ -29,29 +29,42 @@ PyObject *K_XCORE::hessianToMetric(PyObject *self, PyObject *args)
   //E_Float lmin = 1.0/(hmax*hmax);
   //E_Float lmax = 1.0/(hmin*hmin);
 
+  // Eigen decomposition of all the cells at once (SoA)
+  E_Float *A = (E_Float *)XMALLOC(18*ncells * sizeof(E_Float));
+  E_Float *L = A + 6*ncells;
+  E_Float *V = L + 3*ncells;
+
   for (E_Int i = 0; i < ncells; i++) {
-    E_Float *pH = &H[6*i];
+    for (E_Int j = 0; j < 6; j++)
+      A[j*ncells+i] = H[6*i+j];
+  }
+
+  K_LINEAR::sym3mat_eigen_batch(ncells, A, L, V);
+
+  const E_Float *v0[3] = {V, V+ncells, V+2*ncells};
+  const E_Float *v1[3] = {V+3*ncells, V+4*ncells, V+5*ncells};
+  const E_Float *v2[3] = {V+6*ncells, V+7*ncells, V+8*ncells};
 
-    E_Float L[3], v0[3], v1[3], v2[3];
-    K_LINEAR::sym3mat_eigen(pH, L, v0, v1, v2);
-    
+  #pragma omp parallel for
+  for (E_Int i = 0; i < ncells; i++) {
     //E_Float L0 = std::min(std::max(cd_by_eps*fabs(L[0]), lmin), lmax);
     //E_Float L1 = std::min(std::max(cd_by_eps*fabs(L[1]), lmin), lmax);
     //E_Float L2 = std::min(std::max(cd_by_eps*fabs(L[2]), lmin), lmax);
-    
-   
-    E_Float L0 = sqrt(fabs(L[0]));
-    E_Float L1 = sqrt(fabs(L[1]));
-    E_Float L2 = sqrt(fabs(L[2]));
+
+    E_Float L0 = sqrt(fabs(L[i]));
+    E_Float L1 = sqrt(fabs(L[ncells+i]));
+    E_Float L2 = sqrt(fabs(L[2*ncells+i]));
 
     E_Float *pM = &M[6*i];
-    pM[0] = L0*v0[0]*v0[0] + L1*v1[0]*v1[0] + L2*v2[0]*v2[0];
-    pM[1] = L0*v0[0]*v0[1] + L1*v1[0]*v1[1] + L2*v2[0]*v2[1];
-    pM[2] = L0*v0[0]*v0[2] + L1*v1[0]*v1[2] + L2*v2[0]*v2[2];
-    pM[3] = L0*v0[1]*v0[1] + L1*v1[1]*v1[1] + L2*v2[1]*v2[1];
-    pM[4] = L0*v0[1]*v0[2] + L1*v1[1]*v1[2] + L2*v2[1]*v2[2];
-    pM[5] = L0*v0[2]*v0[2] + L1*v1[2]*v1[2] + L2*v2[2]*v2[2];
+    pM[0] = L0*v0[0][i]*v0[0][i] + L1*v1[0][i]*v1[0][i] + L2*v2[0][i]*v2[0][i];
+    pM[1] = L0*v0[0][i]*v0[1][i] + L1*v1[0][i]*v1[1][i] + L2*v2[0][i]*v2[1][i];
+    pM[2] = L0*v0[0][i]*v0[2][i] + L1*v1[0][i]*v1[2][i] + L2*v2[0][i]*v2[2][i];
+    pM[3] = L0*v0[1][i]*v0[1][i] + L1*v1[1][i]*v1[1][i] + L2*v2[1][i]*v2[1][i];
+    pM[4] = L0*v0[1][i]*v0[2][i] + L1*v1[1][i]*v1[2][i] + L2*v2[1][i]*v2[2][i];
+    pM[5] = L0*v0[2][i]*v0[2][i] + L1*v1[2][i]*v1[2][i] + L2*v2[2][i]*v2[2][i];
   }
 
+  XFREE(A);
+
   return (PyObject *)METRIC;
 }
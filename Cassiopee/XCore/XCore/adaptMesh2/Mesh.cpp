@@ -178,7 +178,7 @@ AMesh::AMesh() :
   cellTree(NULL), faceTree(NULL),
   prev_ncells(-1), prev_nfaces(-1), prev_npoints(-1),
   onc(-1), onf(-1), onp(-1),
-  pid(-1), npc(-1), nrq(-1), req(NULL),
+  pid(-1), npc(-1), nrq(-1), req(NULL), xch_i(NULL), xch_f(NULL),
   gcells(NULL), gfaces(NULL), gpoints(NULL),
   npatches(-1), patches(NULL),
   PT(NULL), FT(NULL), CT(NULL),
@@ -190,6 +190,8 @@ AMesh::AMesh() :
   MPI_Comm_size(MPI_COMM_WORLD, &npc);
   nrq = 0;
   req = (MPI_Request *)XMALLOC(2*npc * sizeof(MPI_Request));
+  xch_i = new CMP::PersistentExchange(XMPI_INT);
+  xch_f = new CMP::PersistentExchange(MPI_DOUBLE);
 }
 
 void mesh_drop(AMesh *M)
@@ -207,7 +209,7 @@ void mesh_drop(AMesh *M)
   XFREE(M->neigh);
 
   for (E_Int i = 0; i < M->nbc; i++) {
-    delete M->ptlists[i];
+    XFREE(M->ptlists[i]);
     XFREE(M->bcnames[i]);
   }
   XFREE(M->ptlists);
@@ -225,6 +227,8 @@ void mesh_drop(AMesh *M)
   delete M->faceTree;
 
   XFREE(M->req);
+  delete M->xch_i;
+  delete M->xch_f;
   XFREE(M->gcells);
   XFREE(M->gfaces);
   XFREE(M->gpoints);
@@ -400,8 +404,11 @@ void update_global_cells_after_ref(AMesh *M)
   if (nnew_cells > 0) {
     M->gcells = (E_Int *)XRESIZE(M->gcells, M->ncells * sizeof(E_Int));
 
-    for (E_Int i = 0; i < nnew_cells; i++)
-      M->gcells[M->prev_ncells + i] = gncells + first_new_cell - nnew_cells + i;
+    for (E_Int i = 0; i < nnew_cells; i++) {
+      E_Int cell = M->prev_ncells + i;
+      M->gcells[cell] = gncells + first_new_cell - nnew_cells + i;
+      M->CT->insert({M->gcells[cell], cell});
+    }
   }
 }
 
@@ -412,10 +419,12 @@ void update_global_faces_after_ref(AMesh *M)
 
   MPI_Scan(&nnew_faces, &first_new_face, 1, XMPI_INT, MPI_SUM, MPI_COMM_WORLD);
 
-  E_Int gnfaces;
-  MPI_Allreduce(&M->prev_nfaces, &gnfaces, 1, XMPI_INT, MPI_SUM, MPI_COMM_WORLD);
-
-  if (nnew_faces == 0) return;
+  // Start after the largest id in use: proc faces are counted on both sides
+  // and migration changes the local face counts
+  E_Int gnfaces = 0;
+  for (E_Int i = 0; i < M->prev_nfaces; i++)
+    gnfaces = std::max(gnfaces, M->gfaces[i]+1);
+  MPI_Allreduce(MPI_IN_PLACE, &gnfaces, 1, XMPI_INT, MPI_MAX, MPI_COMM_WORLD);
 
   M->gfaces = (E_Int *)XRESIZE(M->gfaces, M->nfaces * sizeof(E_Int));
 
@@ -464,6 +473,198 @@ void update_global_faces_after_ref(AMesh *M)
       }
     }
   }
+
+  // Each side numbered its new proc faces: keep the smallest id.
+  // Children are aligned by update_patch_faces_after_ref.
+  for (E_Int i = 0; i < M->npatches; i++) {
+    Patch *P = &M->patches[i];
+
+    P->sbuf_i = (E_Int *)XRESIZE(P->sbuf_i, P->nf * sizeof(E_Int));
+    P->rbuf_i = (E_Int *)XRESIZE(P->rbuf_i, P->nf * sizeof(E_Int));
+
+    #pragma omp simd
+    for (E_Int j = 0; j < P->nf; j++)
+      P->sbuf_i[j] = M->gfaces[P->pf[j]];
+  }
+
+  Comm_patch_start_i(M, NULL, NULL);
+  Comm_patch_wait(M);
+
+  for (E_Int i = 0; i < M->npatches; i++) {
+    Patch *P = &M->patches[i];
+
+    for (E_Int j = 0; j < P->nf; j++) {
+      E_Int face = P->pf[j];
+      if (face < M->prev_nfaces) continue;
+
+      if (P->rbuf_i[j] < M->gfaces[face]) {
+        M->FT->erase(M->gfaces[face]);
+        M->gfaces[face] = P->rbuf_i[j];
+        M->FT->insert({M->gfaces[face], face});
+      }
+    }
+  }
+}
+
+void update_global_points_after_ref(AMesh *M)
+{
+  E_Int nnew_points = M->npoints - M->prev_npoints;
+  E_Int first_new_point;
+
+  MPI_Scan(&nnew_points, &first_new_point, 1, XMPI_INT, MPI_SUM,
+    MPI_COMM_WORLD);
+
+  // Same as faces: proc points are shared, start after the largest id
+  E_Int gnpoints = 0;
+  for (E_Int i = 0; i < M->prev_npoints; i++)
+    gnpoints = std::max(gnpoints, M->gpoints[i]+1);
+  MPI_Allreduce(MPI_IN_PLACE, &gnpoints, 1, XMPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+  M->gpoints = (E_Int *)XRESIZE(M->gpoints, M->npoints * sizeof(E_Int));
+
+  for (E_Int i = 0; i < nnew_points; i++) {
+    E_Int point = M->prev_npoints + i;
+    M->gpoints[point] = gnpoints + first_new_point - nnew_points + i;
+    M->PT->insert({M->gpoints[point], point});
+  }
+
+  // Proc points were numbered on both sides. Pair them by position within
+  // each proc face, then keep the smallest id until no rank changes any.
+
+  std::vector<std::vector<E_Int>> match(M->npatches);
+  std::vector<E_Int> count(M->npatches);
+
+  for (E_Int i = 0; i < M->npatches; i++) {
+    Patch *P = &M->patches[i];
+
+    E_Int size = 0;
+    for (E_Int j = 0; j < P->nf; j++)
+      size += get_stride(P->pf[j], M->indPG);
+    count[i] = 3*size;
+
+    P->sbuf_f = (E_Float *)XRESIZE(P->sbuf_f, 3*size * sizeof(E_Float));
+    P->rbuf_f = (E_Float *)XRESIZE(P->rbuf_f, 3*size * sizeof(E_Float));
+
+    E_Float *ptr = P->sbuf_f;
+    for (E_Int j = 0; j < P->nf; j++) {
+      E_Int np = -1;
+      E_Int *pn = get_face(P->pf[j], np, M->ngon, M->indPG);
+      for (E_Int k = 0; k < np; k++) {
+        *ptr++ = M->x[pn[k]];
+        *ptr++ = M->y[pn[k]];
+        *ptr++ = M->z[pn[k]];
+      }
+    }
+  }
+
+  Comm_patch_start_f(M, count.data(), NULL);
+  Comm_patch_wait(M);
+
+  for (E_Int i = 0; i < M->npatches; i++) {
+    Patch *P = &M->patches[i];
+    std::vector<E_Int> &pmatch = match[i];
+
+    E_Int off = 0;
+    for (E_Int j = 0; j < P->nf; j++) {
+      E_Int np = -1;
+      E_Int *pn = get_face(P->pf[j], np, M->ngon, M->indPG);
+
+      for (E_Int k = 0; k < np; k++) {
+        E_Int best = -1;
+        E_Float dmin = K_CONST::E_MAX_FLOAT;
+        for (E_Int l = 0; l < np; l++) {
+          E_Float *q = &P->rbuf_f[3*(off+l)];
+          E_Float dx = M->x[pn[k]] - q[0];
+          E_Float dy = M->y[pn[k]] - q[1];
+          E_Float dz = M->z[pn[k]] - q[2];
+          E_Float d = dx*dx + dy*dy + dz*dz;
+          if (d < dmin) {
+            dmin = d;
+            best = off+l;
+          }
+        }
+        pmatch.push_back(best);
+      }
+
+      off += np;
+    }
+  }
+
+  // Buffers are sized once: every round reuses the same persistent requests
+  for (E_Int i = 0; i < M->npatches; i++) {
+    Patch *P = &M->patches[i];
+    count[i] = (E_Int)match[i].size();
+    P->sbuf_i = (E_Int *)XRESIZE(P->sbuf_i, count[i] * sizeof(E_Int));
+    P->rbuf_i = (E_Int *)XRESIZE(P->rbuf_i, count[i] * sizeof(E_Int));
+  }
+
+  E_Int changed = 1;
+
+  while (changed) {
+    for (E_Int i = 0; i < M->npatches; i++) {
+      Patch *P = &M->patches[i];
+
+      E_Int *ptr = P->sbuf_i;
+      for (E_Int j = 0; j < P->nf; j++) {
+        E_Int np = -1;
+        E_Int *pn = get_face(P->pf[j], np, M->ngon, M->indPG);
+        for (E_Int k = 0; k < np; k++)
+          *ptr++ = M->gpoints[pn[k]];
+      }
+    }
+
+    Comm_patch_start_i(M, count.data(), NULL);
+    Comm_patch_wait(M);
+
+    changed = 0;
+
+    for (E_Int i = 0; i < M->npatches; i++) {
+      Patch *P = &M->patches[i];
+      const std::vector<E_Int> &pmatch = match[i];
+
+      E_Int l = 0;
+      for (E_Int j = 0; j < P->nf; j++) {
+        E_Int np = -1;
+        E_Int *pn = get_face(P->pf[j], np, M->ngon, M->indPG);
+
+        for (E_Int k = 0; k < np; k++) {
+          E_Int point = pn[k];
+          E_Int gp = P->rbuf_i[pmatch[l++]];
+
+          if (gp < M->gpoints[point]) {
+            M->PT->erase(M->gpoints[point]);
+            M->gpoints[point] = gp;
+            M->PT->insert({gp, point});
+            changed = 1;
+          }
+        }
+      }
+    }
+
+    MPI_Allreduce(MPI_IN_PLACE, &changed, 1, XMPI_INT, MPI_MAX,
+      MPI_COMM_WORLD);
+  }
+}
+
+void update_patch_neighbours_after_ref(AMesh *M)
+{
+  // Children inherited the neighbour of their parent face
+  std::vector<E_Int *> pn(M->npatches);
+
+  for (E_Int i = 0; i < M->npatches; i++) {
+    Patch *P = &M->patches[i];
+
+    P->sbuf_i = (E_Int *)XRESIZE(P->sbuf_i, P->nf * sizeof(E_Int));
+
+    #pragma omp simd
+    for (E_Int j = 0; j < P->nf; j++)
+      P->sbuf_i[j] = M->gcells[M->owner[P->pf[j]]];
+
+    pn[i] = P->pn;
+  }
+
+  Comm_patch_start_i(M, NULL, pn.data());
+  Comm_patch_wait(M);
 }
 
 void update_patch_faces_after_ref(AMesh *M)
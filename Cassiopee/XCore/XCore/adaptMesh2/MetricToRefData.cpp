@@ -65,8 +65,7 @@ void smooth_ref_data(AMesh *M)
     
     smooth_ref_data_local(M);
 
-    // Exchange proc ref data
-    MPI_Barrier(MPI_COMM_WORLD);
+    // Exchange proc ref data (same buffers every round)
     E_Int lstop = 0; // No more smoothing required locally
 
     for (E_Int i = 0; i < M->npatches; i++) {
@@ -76,14 +75,10 @@ void smooth_ref_data(AMesh *M)
         E_Int own = M->owner[P->pf[j]];
         P->sbuf_i[j] = M->ref_data[own] + M->cellTree->level(own);
       }
-
-      MPI_Isend(P->sbuf_i, P->nf, XMPI_INT, P->nei, M->pid, MPI_COMM_WORLD,
-        &M->req[M->nrq++]); 
-      MPI_Irecv(P->rbuf_i, P->nf, XMPI_INT, P->nei, P->nei, MPI_COMM_WORLD,
-        &M->req[M->nrq++]); 
     }
 
-    Comm_waitall(M);
+    Comm_patch_start_i(M, NULL, NULL);
+    Comm_patch_wait(M);
 
     for (E_Int i = 0; i < M->npatches; i++) {
       Patch *P = &M->patches[i];
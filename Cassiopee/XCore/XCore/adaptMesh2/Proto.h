@@ -50,6 +50,8 @@ void refine_mesh(AMesh *, const std::vector<E_Int> &ref_faces,
 void update_patch_faces_after_ref(AMesh *M);
 void update_global_cells_after_ref(AMesh *M);
 void update_global_faces_after_ref(AMesh *M);
+void update_global_points_after_ref(AMesh *M);
+void update_patch_neighbours_after_ref(AMesh *M);
 
 // Topo
 E_Int Orient_boundary(AMesh *M);
@@ -157,6 +159,9 @@ void Comm_interface_data_i(AMesh *M, E_Int *data, E_Int stride, E_Int **rbuf);
 void Comm_interface_data_f(AMesh *M, E_Float *data, E_Int stride,
   E_Float **rbuf);
 void Comm_waitall(AMesh *M);
+void Comm_patch_start_i(AMesh *M, const E_Int *count, E_Int **rbuf);
+void Comm_patch_start_f(AMesh *M, const E_Int *count, E_Float **rbuf);
+void Comm_patch_wait(AMesh *M);
 AMesh *load_balance_mesh(AMesh *M);
 
 // Gradient
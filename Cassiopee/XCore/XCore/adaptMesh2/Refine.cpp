@@ -95,14 +95,10 @@ void get_ref_faces_and_cells(AMesh *M, std::vector<E_Int> &ref_faces,
       E_Int own = M->owner[face];
       P->sbuf_i[j] = M->ref_data[own] + M->cellTree->level(own);
     }
-
-    MPI_Isend(P->sbuf_i, P->nf, MPI_INT, P->nei, M->pid, MPI_COMM_WORLD,
-      &M->req[M->nrq++]);
-    MPI_Irecv(P->rbuf_i, P->nf, MPI_INT, P->nei, P->nei, MPI_COMM_WORLD,
-      &M->req[M->nrq++]);
   }
 
-  Comm_waitall(M);
+  Comm_patch_start_i(M, NULL, NULL);
+  Comm_patch_wait(M);
 
   for (E_Int i = 0; i < M->npatches; i++) {
     Patch *P = &M->patches[i];
@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include <mpi.h>
 #include "../common/common.h"
+#include "../CMP/include/persistent_exchange.hpp"
 
 #define ISO 0
 #define DIR 1
@@ -203,6 +204,8 @@ struct AMesh {
   int npc;
   int nrq;
   MPI_Request *req;
+  CMP::PersistentExchange *xch_i; // Patch exchanges of sbuf_i/rbuf_i
+  CMP::PersistentExchange *xch_f; // Patch exchanges of sbuf_f/rbuf_f
 
   E_Int *gcells;
   E_Int *gfaces;
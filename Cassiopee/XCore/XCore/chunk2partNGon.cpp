@@ -122,13 +122,80 @@ void paraSort(E_Int *arr, int size, std::vector<E_Int> &plist_out,
     assert(plist_out[rdist[nproc]-1] < pivots[rank+1]);
 }
 
+// Alltoallv split into rounds of at most quota entries per proc pair, so that
+// the send buffer never holds more than 2*nproc*quota entries.
+// Round r+1 is packed while round r is in flight.
+// pack(i, n, buf) writes the next n entries of the stream bound to proc i.
+// quota <= 0: single round (plain Alltoallv).
+template <typename T, typename Packer>
+static
+void stream_alltoallv(Packer &pack, const std::vector<int> &scount,
+  T *rbuf, const std::vector<int> &rcount, const std::vector<int> &rdist,
+  MPI_Datatype type, E_Int quota)
+{
+  int nproc;
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  E_Int nrounds = 1;
+  if (quota > 0) {
+    E_Int lmax = 0, gmax;
+    for (E_Int i = 0; i < nproc; i++) {
+      lmax = std::max(lmax, (E_Int)scount[i]);
+      lmax = std::max(lmax, (E_Int)rcount[i]);
+    }
+    MPI_Allreduce(&lmax, &gmax, 1, XMPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    nrounds = std::max((E_Int)1, (gmax + quota - 1) / quota);
+  } else {
+    quota = E_IDX_NONE;
+  }
+
+  std::vector<T> sbuf[2];
+  std::vector<int> scnt[2], sdsp[2], rcnt[2], rdsp[2];
+  MPI_Request req[2];
+
+  for (E_Int r = 0; r < nrounds; r++) {
+    E_Int b = r & 1;
+    E_Int first = r*quota;
+    scnt[b].resize(nproc); sdsp[b].resize(nproc+1);
+    rcnt[b].resize(nproc); rdsp[b].resize(nproc);
+
+    sdsp[b][0] = 0;
+    for (E_Int i = 0; i < nproc; i++) {
+      scnt[b][i] = (int)std::max((E_Int)0, std::min(quota, scount[i]-first));
+      rcnt[b][i] = (int)std::max((E_Int)0, std::min(quota, rcount[i]-first));
+      sdsp[b][i+1] = sdsp[b][i] + scnt[b][i];
+      rdsp[b][i] = rdist[i] + (int)std::min(first, (E_Int)rcount[i]);
+    }
+
+    // buffer b was released when round r-2 completed
+    sbuf[b].resize(sdsp[b][nproc]);
+    for (E_Int i = 0; i < nproc; i++)
+      pack(i, scnt[b][i], sbuf[b].data() + sdsp[b][i]);
+
+    MPI_Ialltoallv(sbuf[b].data(), &scnt[b][0], &sdsp[b][0], type,
+                   rbuf, &rcnt[b][0], &rdsp[b][0], type,
+                   MPI_COMM_WORLD, &req[b]);
+
+    if (r > 0) MPI_Wait(&req[b^1], MPI_STATUS_IGNORE);
+  }
+
+  MPI_Wait(&req[(nrounds-1) & 1], MPI_STATUS_IGNORE);
+}
+
 PyObject* K_XCORE::chunk2partNGon(PyObject *self, PyObject *args)
 {
-  PyObject *array;
-  if (!PyArg_ParseTuple(args, "O", &array)) {
+  PyObject *array, *BATCH = NULL;
+  if (!PyArg_ParseTuple(args, "O|O", &array, &BATCH)) {
     return NULL;
   }
 
+  // max number of entries exchanged per proc pair and per round
+  E_Int batch = 0;
+  if (BATCH != NULL && BATCH != Py_None) {
+    batch = (E_Int)PyLong_AsLongLong(BATCH);
+    if (PyErr_Occurred()) return NULL;
+  }
+
   MPI_Barrier(MPI_COMM_WORLD);
   clock_t tic = clock();
   
@@ -290,6 +357,10 @@ PyObject* K_XCORE::chunk2partNGon(PyObject *self, PyObject *args)
   MPI_Alltoallv(&sdata[0], &scount[0], &sdist[0], XMPI_INT,
                 &rdata[0], &rcount[0], &rdist[0], XMPI_INT,
                 MPI_COMM_WORLD);
+
+  // exchange buffers only live for one stage: release them so that they do
+  // not stack on the streamed exchanges below
+  std::vector<E_Int>().swap(sdata);
  
   PE.clear();
 
@@ -309,6 +380,8 @@ PyObject* K_XCORE::chunk2partNGon(PyObject *self, PyObject *args)
     }
   }
 
+  std::vector<E_Int>().swap(rdata);
+
   if (rank == 0)
     printf("ParentElements OK\n");
 
@@ -356,6 +429,8 @@ PyObject* K_XCORE::chunk2partNGon(PyObject *self, PyObject *args)
                 &rdata[0], &rcount[0], &rdist[0], XMPI_INT,
                 MPI_COMM_WORLD);
 
+  std::vector<E_Int>().swap(sdata);
+
   E_Int first_cell = cells_dist[rank];
   std::vector<std::vector<E_Int>> cadj(ncells);
   E_Int nedges = 0;
@@ -370,6 +445,8 @@ PyObject* K_XCORE::chunk2partNGon(PyObject *self, PyObject *args)
     }
   }
 
+  std::vector<E_Int>().swap(rdata);
+
   std::vector<E_Int> ADJ;
   ADJ.reserve(nedges);
   std::vector<E_Int> xadj(ncells+1);
@@ -494,33 +571,31 @@ PyObject* K_XCORE::chunk2partNGon(PyObject *self, PyObject *args)
     rdist[i+1] = rdist[i] + rcount[i];
   }
 
-  sdata.resize(sdist[nproc]);
   std::vector<E_Int> NFACE(rdist[nproc]);
 
-  for (E_Int i = 0; i < nproc; i++) idx[i] = sdist[i];
-
-  if (sfaces_exist) {
-    for (E_Int i = 0; i < ncells; i++) {
-      E_Int where = part[i];
-      for (E_Int j = xcells[i]; j < xcells[i+1]; j++) {
+  // stream of proc i: faces of the cells scells[c_sdist[i]:c_sdist[i+1]]
+  std::vector<E_Int> cpos(c_sdist.begin(), c_sdist.end()-1);
+  std::vector<E_Int> kpos(nproc, 0);
+  auto pack_nface = [&](E_Int i, E_Int n, E_Int *buf) {
+    while (n > 0) {
+      E_Int cell = scells[cpos[i]] - cells_dist[rank];
+      E_Int start = xcells[cell] + kpos[i];
+      E_Int m = std::min(n, xcells[cell+1] - start);
+      for (E_Int j = start; j < start+m; j++) {
         E_Int face = cells[j];
-        if (SF.find(face) != SF.end())
-          sdata[idx[where]++] = -face;
+        if (sfaces_exist && SF.find(face) != SF.end())
+          *buf++ = -face;
         else
-          sdata[idx[where]++] = face;
+          *buf++ = face;
       }
+      n -= m;
+      kpos[i] += m;
+      if (start+m == xcells[cell+1]) { cpos[i]++; kpos[i] = 0; }
     }
-  } else {
-    for (E_Int i = 0; i < ncells; i++) {
-      E_Int where = part[i];
-      for (E_Int j = xcells[i]; j < xcells[i+1]; j++)
-        sdata[idx[where]++] = cells[j];
-    }
-  }
+  };
 
-  MPI_Alltoallv(&sdata[0], &scount[0], &sdist[0], XMPI_INT,
-                &NFACE[0], &rcount[0], &rdist[0], XMPI_INT,
-                MPI_COMM_WORLD);
+  stream_alltoallv(pack_nface, scount, NFACE.data(), rcount, rdist,
+    XMPI_INT, batch);
 
   if (rank == 0)
     puts("NFACE OK");
@@ -638,22 +713,26 @@ PyObject* K_XCORE::chunk2partNGon(PyObject *self, PyObject *args)
     rdist[i+1] = rdist[i] + rcount[i];
   }
 
-  sdata.resize(sdist[nproc]);
   std::vector<E_Int> NGON(rdist[nproc]);
 
-  for (E_Int i = 0; i < nproc; i++) {
-    E_Int *pf = &sfaces[f_sdist[i]];
-    E_Int *pn = &sdata[sdist[i]];
-    for (E_Int j = 0; j < f_scount[i]; j++) {
-      E_Int face = pf[j] - 1 - faces_dist[rank];
-      for (E_Int k = xfaces[face]; k < xfaces[face+1]; k++)
-        *pn++ = faces[k];
+  // stream of proc i: points of the faces sfaces[f_sdist[i]:f_sdist[i+1]]
+  std::vector<E_Int> fpos(f_sdist.begin(), f_sdist.end()-1);
+  std::fill(kpos.begin(), kpos.end(), 0);
+  auto pack_ngon = [&](E_Int i, E_Int n, E_Int *buf) {
+    while (n > 0) {
+      E_Int face = sfaces[fpos[i]] - 1 - faces_dist[rank];
+      E_Int start = xfaces[face] + kpos[i];
+      E_Int m = std::min(n, xfaces[face+1] - start);
+      for (E_Int j = start; j < start+m; j++)
+        *buf++ = faces[j];
+      n -= m;
+      kpos[i] += m;
+      if (start+m == xfaces[face+1]) { fpos[i]++; kpos[i] = 0; }
     }
-  }
+  };
 
-  MPI_Alltoallv(&sdata[0], &scount[0], &sdist[0], XMPI_INT,
-                &NGON[0], &rcount[0], &rdist[0], XMPI_INT,
-                MPI_COMM_WORLD);
+  stream_alltoallv(pack_ngon, scount, NGON.data(), rcount, rdist,
+    XMPI_INT, batch);
   
   if (rank == 0)
     puts("NGON OK");
@@ -731,23 +810,21 @@ PyObject* K_XCORE::chunk2partNGon(PyObject *self, PyObject *args)
   assert(sdist[nproc] == 3*p_sdist[nproc]);
   assert(rdist[nproc] == 3*p_rdist[nproc]);
   
-  std::vector<E_Float> sxyz(sdist[nproc]);
   std::vector<E_Float> rxyz(rdist[nproc]);
 
-  for (E_Int i = 0; i < nproc; i++) {
-    E_Int *pp = &spoints[p_sdist[i]];
-    E_Float *px = &sxyz[sdist[i]];
-    for (E_Int j = 0; j < p_scount[i]; j++) {
-      E_Int point = pp[j] - 1 - points_dist[rank];
-      *px++ = X[point];
-      *px++ = Y[point];
-      *px++ = Z[point];
+  // stream of proc i: interlaced xyz of spoints[p_sdist[i]:p_sdist[i+1]]
+  std::vector<E_Int> ppos(nproc, 0);
+  auto pack_xyz = [&](E_Int i, E_Int n, E_Float *buf) {
+    for (E_Int j = ppos[i]; j < ppos[i]+n; j++) {
+      E_Int point = spoints[p_sdist[i] + j/3] - 1 - points_dist[rank];
+      E_Int c = j%3;
+      *buf++ = (c == 0) ? X[point] : ((c == 1) ? Y[point] : Z[point]);
     }
-  }
+    ppos[i] += n;
+  };
 
-  MPI_Alltoallv(&sxyz[0], &scount[0], &sdist[0], MPI_DOUBLE,
-                &rxyz[0], &rcount[0], &rdist[0], MPI_DOUBLE,
-                MPI_COMM_WORLD);
+  stream_alltoallv(pack_xyz, scount, rxyz.data(), rcount, rdist,
+    MPI_DOUBLE, batch);
 
   if (rank == 0)
     puts("Coordinates OK");
@@ -783,6 +860,8 @@ PyObject* K_XCORE::chunk2partNGon(PyObject *self, PyObject *args)
                 &rdata[0], &rcount[0], &rdist[0], XMPI_INT,
                 MPI_COMM_WORLD);
 
+  std::vector<E_Int>().swap(sdata);
+
   std::vector<E_Int> pneis; 
 
   E_Int nif = 0;
@@ -886,6 +965,8 @@ PyObject* K_XCORE::chunk2partNGon(PyObject *self, PyObject *args)
     }
   }
 
+  std::vector<E_Int>().swap(rdata);
+
   MPI_Alltoallv(&rncells[0], &rncount[0], &rndist[0], XMPI_INT,
                 &sncells[0], &sncount[0], &sndist[0], XMPI_INT,
                 MPI_COMM_WORLD);
@@ -1082,26 +1163,21 @@ PyObject* K_XCORE::chunk2partNGon(PyObject *self, PyObject *args)
     dims[1] = 1;
     dims[0] = (npy_intp)nncells;
     
-    std::vector<E_Float> c_sdata(c_sdist[nproc]);
-
     for (E_Int k = 0; k < csize; k++) {
       PyArrayObject *ca = (PyArrayObject *)PyArray_SimpleNew(1, dims, NPY_DOUBLE);
 
       for (E_Int i = 0; i < nproc; i++)
         idx[i] = c_sdist[i];
-      
-      for (E_Int i = 0; i < nproc; i++) {
-        E_Int *ptr = &scells[c_sdist[i]];
-        for (E_Int j = 0; j < c_scount[i]; j++) {
-          E_Int cell = ptr[j] - cells_dist[rank];
-          assert(rank == get_proc(ptr[j], cells_dist, nproc));
-          c_sdata[idx[i]++] = csols[k][cell];
+
+      auto pack_csol = [&](E_Int i, E_Int n, E_Float *buf) {
+        for (E_Int j = 0; j < n; j++) {
+          E_Int cell = scells[idx[i]++] - cells_dist[rank];
+          buf[j] = csols[k][cell];
         }
-      }
+      };
 
-      MPI_Alltoallv(&c_sdata[0], &c_scount[0], &c_sdist[0], MPI_DOUBLE,
-                    PyArray_DATA(ca), &c_rcount[0], &c_rdist[0], MPI_DOUBLE,
-                    MPI_COMM_WORLD);
+      stream_alltoallv(pack_csol, c_scount, (E_Float *)PyArray_DATA(ca),
+        c_rcount, c_rdist, MPI_DOUBLE, batch);
 
       PyList_Append(clist, (PyObject *)ca);
       Py_DECREF(ca);
@@ -1130,26 +1206,21 @@ PyObject* K_XCORE::chunk2partNGon(PyObject *self, PyObject *args)
     dims[1] = 1;
     dims[0] = (npy_intp)nnpoints;
     
-    std::vector<E_Float> p_sdata(p_sdist[nproc]);
-
     for (E_Int k = 0; k < psize; k++) {
       PyArrayObject *pa = (PyArrayObject *)PyArray_SimpleNew(1, dims, NPY_DOUBLE);
 
       for (E_Int i = 0; i < nproc; i++)
         idx[i] = p_sdist[i];
-      
-      for (E_Int i = 0; i < nproc; i++) {
-        E_Int *ptr = &spoints[p_sdist[i]];
-        for (E_Int j = 0; j < p_scount[i]; j++) {
-          E_Int point = ptr[j] - points_dist[rank] - 1;
-          assert(rank == get_proc(ptr[j]-1, points_dist, nproc));
-          p_sdata[idx[i]++] = psols[k][point];
+
+      auto pack_psol = [&](E_Int i, E_Int n, E_Float *buf) {
+        for (E_Int j = 0; j < n; j++) {
+          E_Int point = spoints[idx[i]++] - points_dist[rank] - 1;
+          buf[j] = psols[k][point];
         }
-      }
+      };
 
-      MPI_Alltoallv(&p_sdata[0], &p_scount[0], &p_sdist[0], MPI_DOUBLE,
-                    PyArray_DATA(pa), &p_rcount[0], &p_rdist[0], MPI_DOUBLE,
-                    MPI_COMM_WORLD);
+      stream_alltoallv(pack_psol, p_scount, (E_Float *)PyArray_DATA(pa),
+        p_rcount, p_rdist, MPI_DOUBLE, batch);
 
       PyList_Append(plist, (PyObject *)pa);
       Py_DECREF(pa);
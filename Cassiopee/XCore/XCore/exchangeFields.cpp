@@ -1,5 +1,71 @@
 #include "xcore.h"
 #include <mpi.h>
+#include <vector>
+#include <map>
+#include "CMP/include/persistent_exchange.hpp"
+
+// Persistent exchanges kept from one call to the other, one per communication
+// graph (neighbours, number of faces per neighbour, number of fields): the
+// MPI requests and the buffers are only created the first time a graph is seen.
+// At most MAX_XCH_CACHE graphs are kept, the least recently used one is freed
+// first.
+#define MAX_XCH_CACHE 8
+
+struct FieldExchange {
+  std::vector<E_Float> send_buf;
+  std::vector<E_Float> recv_buf;
+  CMP::PersistentExchange xch;
+  E_Int last_use;
+  FieldExchange() : xch(MPI_DOUBLE), last_use(0) {}
+};
+
+typedef std::map<std::vector<E_Int>, FieldExchange *> FieldExchangeCache;
+static FieldExchangeCache *xch_cache = NULL;
+static E_Int xch_clock = 0;
+
+// Called by MPI_Finalize (attribute of MPI_COMM_SELF): the persistent
+// requests must be freed while MPI is still alive
+static
+int free_xch_cache(MPI_Comm, int, void *, void *)
+{
+  if (xch_cache) {
+    for (auto &it : *xch_cache) delete it.second;
+    delete xch_cache;
+    xch_cache = NULL;
+  }
+  return MPI_SUCCESS;
+}
+
+static
+FieldExchange *get_field_exchange(const std::vector<E_Int> &graph,
+  E_Int buf_size)
+{
+  if (xch_cache == NULL) {
+    xch_cache = new FieldExchangeCache;
+    int keyval;
+    MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, free_xch_cache, &keyval,
+      NULL);
+    MPI_Comm_set_attr(MPI_COMM_SELF, keyval, NULL);
+  }
+
+  auto it = xch_cache->find(graph);
+  if (it == xch_cache->end()) {
+    if (xch_cache->size() >= MAX_XCH_CACHE) {
+      auto lru = xch_cache->begin();
+      for (auto jt = xch_cache->begin(); jt != xch_cache->end(); jt++) {
+        if (jt->second->last_use < lru->second->last_use) lru = jt;
+      }
+      delete lru->second;
+      xch_cache->erase(lru);
+    }
+    FieldExchange *fx = new FieldExchange;
+    fx->send_buf.resize(buf_size);
+    fx->recv_buf.resize(buf_size);
+    it = xch_cache->insert(std::make_pair(graph, fx)).first;
+  }
+  it->second->last_use = ++xch_clock;
+  return it->second;
+}
 
 PyObject *K_XCORE::exchangeFields(PyObject *self, PyObject *args)
 {
@@ -75,58 +141,76 @@ PyObject *K_XCORE::exchangeFields(PyObject *self, PyObject *args)
     ret = K_NUMPY::getFromNumpyArray(list, ptlists[i], npfaces[i], true);
   }
 
-  // Exchange fields one by one
-  E_Float *send_buf = NULL;
+  // Exchange all the fields at once: one message per neighbour, holding
+  // the fields one after the other
   E_Int *owner = PE;
-  E_Int req_size = fsize*psize*2;
-  MPI_Request *reqs = (MPI_Request *)malloc(req_size * sizeof(MPI_Request));
-  E_Int nreq = 0;
+  std::vector<E_Int> offset(psize+1, 0);
+  for (E_Int i = 0; i < psize; i++)
+    offset[i+1] = offset[i] + fsize*npfaces[i];
+
+  std::vector<E_Int> graph(2*psize+1);
+  graph[0] = fsize;
+  for (E_Int i = 0; i < psize; i++) {
+    graph[2*i+1] = procs[i];
+    graph[2*i+2] = npfaces[i];
+  }
+  FieldExchange *fx = get_field_exchange(graph, offset[psize]);
+  E_Float *send_buf = fx->send_buf.data();
+  E_Float *recv_buf = fx->recv_buf.data();
+  CMP::PersistentExchange &xch = fx->xch;
+
+  // Several patches may join the same two ranks: the k-th channel to a given
+  // neighbour is tagged k, on both sides
+  std::map<E_Int, int> nchannels;
 
-  PyObject *out = PyList_New(0);
-  
   for (E_Int i = 0; i < psize; i++) {
     E_Int npf = npfaces[i];
     E_Int *pfaces = ptlists[i];
-    E_Int dest = procs[i];
+
+    for (E_Int j = 0; j < fsize; j++) {
+      const E_Float *data = fields[j];
+      E_Float *ptr = send_buf + offset[i] + j*npf;
+      #pragma omp simd
+      for (E_Int k = 0; k < npf; k++)
+        ptr[k] = data[owner[pfaces[k]-1]-1];
+    }
+
+    int tag = nchannels[procs[i]]++;
+    xch.bind(i, procs[i], send_buf + offset[i], fsize*npf, tag,
+      recv_buf + offset[i], fsize*npf, tag);
+  }
+
+  xch.start();
+
+  // Unpack each neighbour as soon as its data is there
+  std::vector<PyObject *> rdata(psize, NULL);
+  E_Int c;
+  while ((c = xch.wait_any_recv()) != -1) {
+    E_Int npf = npfaces[c];
     npy_intp dims[2];
     dims[0] = npf;
     dims[1] = 1;
 
     PyObject *proc_rdata = PyList_New(0);
-    
-    send_buf = (E_Float *)realloc(send_buf, npf * sizeof(E_Float));
 
     for (E_Int j = 0; j < fsize; j++) {
-      const auto &data = fields[j];
       PyArrayObject *recv = (PyArrayObject *)PyArray_SimpleNew(1, dims, NPY_DOUBLE);
-      
-      for (E_Int k = 0; k < npf; k++) {
-        E_Int face = pfaces[k]-1;
-        E_Int own = owner[face]-1;
-        E_Float val = data[own];
-        send_buf[k] = val;
-      }
-
-      MPI_Irecv(PyArray_DATA(recv), npf, MPI_DOUBLE, dest, 0, MPI_COMM_WORLD,
-        &reqs[nreq++]); 
-      MPI_Isend((void *)send_buf, npf, MPI_DOUBLE, dest, 0, MPI_COMM_WORLD,
-        &reqs[nreq++]);
-      
+      memcpy(PyArray_DATA(recv), recv_buf + offset[c] + j*npf,
+        npf * sizeof(E_Float));
       PyList_Append(proc_rdata, (PyObject *)recv);
       Py_DECREF(recv);
     }
 
-    PyList_Append(out, proc_rdata);
-    Py_DECREF(proc_rdata);
+    rdata[c] = proc_rdata;
   }
 
-  // WARNING(Imad): Where do we put the wait_all?
-  MPI_Waitall(nreq, reqs, MPI_STATUSES_IGNORE);
-  nreq = 0;
+  xch.wait();
 
-  // FREE MPI STUFF
-  free(reqs);
-  free(send_buf);
+  PyObject *out = PyList_New(0);
+  for (E_Int i = 0; i < psize; i++) {
+    PyList_Append(out, rdata[i]);
+    Py_DECREF(rdata[i]);
+  }
 
   // FREE COMM DATA
   free(procs);
@@ -0,0 +1,499 @@
+/*
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "haloNGon.h"
+#include "common/common.h"
+#include <unordered_map>
+
+#define TAG_SIZE 71
+#define TAG_IDATA 72
+#define TAG_FDATA 73
+#define TAG_FIELDS 74
+
+static
+void halo_free_requests(NGonHalo *H)
+{
+  for (auto &req : H->reqs) {
+    if (req != MPI_REQUEST_NULL) MPI_Request_free(&req);
+  }
+  H->reqs.clear();
+  H->nfld = 0;
+}
+
+// Persistent requests for nfld fields: receives first, then sends
+static
+void halo_init_requests(NGonHalo *H, E_Int nfld)
+{
+  halo_free_requests(H);
+  H->nfld = nfld;
+  H->reqs.resize(2*H->patches.size());
+
+  for (size_t i = 0; i < H->patches.size(); i++) {
+    HaloPatch &P = H->patches[i];
+    P.rbuf.resize(nfld*P.rcount);
+    MPI_Recv_init(P.rbuf.data(), (int)P.rbuf.size(), MPI_DOUBLE, P.proc,
+      TAG_FIELDS, MPI_COMM_WORLD, &H->reqs[i]);
+  }
+
+  for (size_t i = 0; i < H->patches.size(); i++) {
+    HaloPatch &P = H->patches[i];
+    P.sbuf.resize(nfld*P.scells.size());
+    MPI_Send_init(P.sbuf.data(), (int)P.sbuf.size(), MPI_DOUBLE, P.proc,
+      TAG_FIELDS, MPI_COMM_WORLD, &H->reqs[H->patches.size()+i]);
+  }
+}
+
+void Halo_free(NGonHalo *H)
+{
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (!finalized) halo_free_requests(H);
+}
+
+void Halo_start(NGonHalo *H, E_Float **flds, E_Int nfld)
+{
+  if (nfld != H->nfld) halo_init_requests(H, nfld);
+
+  for (auto &P : H->patches) {
+    E_Int ns = (E_Int)P.scells.size();
+    const E_Int *sc = P.scells.data();
+
+    // field major packing
+    for (E_Int n = 0; n < nfld; n++) {
+      const E_Float *fld = flds[n];
+      E_Float *ptr = P.sbuf.data() + n*ns;
+#pragma omp simd
+      for (E_Int i = 0; i < ns; i++) ptr[i] = fld[sc[i]];
+    }
+  }
+
+  MPI_Startall((int)H->reqs.size(), H->reqs.data());
+}
+
+void Halo_finish(NGonHalo *H, E_Float **flds, E_Int nfld)
+{
+  assert(nfld == H->nfld);
+  MPI_Waitall((int)H->reqs.size(), H->reqs.data(), MPI_STATUSES_IGNORE);
+
+  for (auto &P : H->patches) {
+    E_Int nr = P.rcount;
+    for (E_Int n = 0; n < nfld; n++) {
+      E_Float *ptr = flds[n] + H->ncells + P.rstart;
+      const E_Float *rbuf = P.rbuf.data() + n*nr;
+#pragma omp simd
+      for (E_Int i = 0; i < nr; i++) ptr[i] = rbuf[i];
+    }
+  }
+}
+
+static
+void halo_capsule_destructor(PyObject *capsule)
+{
+  NGonHalo *H = (NGonHalo *)PyCapsule_GetPointer(capsule, "NGonHalo");
+  Halo_free(H);
+  delete H;
+}
+
+// Owned cells within nlayers face neighbourhood of the interface faces,
+// sorted by layer. layer[i] is the layer of cells[i] (1-based).
+static
+void collect_layers(const std::vector<E_Int> &F2C, E_Int *nface,
+  E_Int *indPH, E_Int *pfaces, E_Int npf, E_Int nlayers,
+  std::vector<E_Int> &mark, E_Int stamp, std::vector<E_Int> &cells,
+  std::vector<E_Int> &layer)
+{
+  cells.clear(); layer.clear();
+
+  for (E_Int i = 0; i < npf; i++) {
+    E_Int face = pfaces[i]-1;
+    E_Int own = F2C[2*face];
+    if (own < 0 || mark[own] == stamp) continue;
+    mark[own] = stamp;
+    cells.push_back(own);
+    layer.push_back(1);
+  }
+
+  size_t start = 0;
+  for (E_Int l = 2; l <= nlayers; l++) {
+    size_t end = cells.size();
+    for (size_t i = start; i < end; i++) {
+      E_Int cell = cells[i];
+      for (E_Int j = indPH[cell]; j < indPH[cell+1]; j++) {
+        E_Int face = std::abs(nface[j])-1;
+        E_Int nei = F2C[2*face];
+        if (nei == cell) nei = F2C[2*face+1];
+        if (nei < 0 || mark[nei] == stamp) continue;
+        mark[nei] = stamp;
+        cells.push_back(nei);
+        layer.push_back(l);
+      }
+    }
+    start = end;
+  }
+}
+
+// ============================================================================
+/* Build nlayers of ghost cells for a partitioned NGON.
+   IN: arr: NGON array (api 3)
+   IN: cglob, fglob, pglob: global cell, face and point numbers
+   IN: comm_list: [[proc, interface faces (1-based)], ...]
+   IN: nlayers: number of ghost cell layers
+   OUT: [halo handle, extended NGON array, extended cglob, fglob, pglob,
+         ghost cell layers] */
+// ============================================================================
+PyObject *K_XCORE::buildHaloNGon(PyObject *self, PyObject *args)
+{
+  PyObject *ARR, *CGLOB, *FGLOB, *PGLOB, *COMM;
+  E_Int nlayers;
+  if (!PYPARSETUPLE_(args, OOOO_ O_ I_, &ARR, &CGLOB, &FGLOB, &PGLOB, &COMM,
+    &nlayers)) {
+    RAISE("Bad input.");
+    return NULL;
+  }
+
+  if (nlayers < 1) {
+    RAISE("buildHaloNGon: nlayers must be >= 1.");
+    return NULL;
+  }
+
+  E_Int ni, nj, nk;
+  K_FLD::FldArrayF *f; K_FLD::FldArrayI *cn;
+  char *varString, *eltType;
+  E_Int ret = K_ARRAY::getFromArray3(ARR, varString, f, ni, nj, nk, cn, eltType);
+
+  if (ret != 2 || strcmp(eltType, "NGON") != 0) {
+    if (ret > 0) RELEASESHAREDB(ret, ARR, f, cn);
+    RAISE("buildHaloNGon: mesh should be an NGON.");
+    return NULL;
+  }
+
+  E_Int posx = K_ARRAY::isCoordinateXPresent(varString);
+  E_Int posy = K_ARRAY::isCoordinateYPresent(varString);
+  E_Int posz = K_ARRAY::isCoordinateZPresent(varString);
+  if (posx == -1 || posy == -1 || posz == -1) {
+    RELEASESHAREDU(ARR, f, cn);
+    RAISE("buildHaloNGon: can't find coordinates in array.");
+    return NULL;
+  }
+  posx++; posy++; posz++;
+
+  E_Float *X = f->begin(posx);
+  E_Float *Y = f->begin(posy);
+  E_Float *Z = f->begin(posz);
+
+  E_Int *ngon = cn->getNGon();
+  E_Int *indPG = cn->getIndPG();
+  E_Int *nface = cn->getNFace();
+  E_Int *indPH = cn->getIndPH();
+  E_Int ncells = cn->getNElts();
+  E_Int nfaces = cn->getNFaces();
+  E_Int npoints = f->getSize();
+
+  E_Int *cglob, *fglob, *pglob;
+  E_Int csize, fsize, psize;
+  ret = K_NUMPY::getFromNumpyArray(CGLOB, cglob, csize, true);
+  ret &= K_NUMPY::getFromNumpyArray(FGLOB, fglob, fsize, true);
+  ret &= K_NUMPY::getFromNumpyArray(PGLOB, pglob, psize, true);
+  if (ret != 1 || csize != ncells || fsize != nfaces || psize != npoints) {
+    RELEASESHAREDU(ARR, f, cn);
+    RAISE("buildHaloNGon: bad global numbering arrays.");
+    return NULL;
+  }
+
+  // Parent cells of faces
+  std::vector<E_Int> F2C(2*nfaces, -1);
+  for (E_Int i = 0; i < ncells; i++) {
+    for (E_Int j = indPH[i]; j < indPH[i+1]; j++) {
+      E_Int face = std::abs(nface[j])-1;
+      if (F2C[2*face] == -1) F2C[2*face] = i;
+      else F2C[2*face+1] = i;
+    }
+  }
+
+  NGonHalo *H = new NGonHalo;
+  H->ncells = ncells;
+  H->nlayers = nlayers;
+  H->nfld = 0;
+
+  E_Int npatches = PyList_Size(COMM);
+  H->patches.resize(npatches);
+
+  // Cells to send and their description
+  std::vector<E_Int> mark(ncells, -1);
+  std::vector<E_Int> layer;
+  std::vector<std::vector<E_Int>> sidata(npatches);
+  std::vector<std::vector<E_Float>> sfdata(npatches);
+  std::vector<E_Int> fmark(nfaces, -1), pmark(npoints, -1);
+
+  for (E_Int i = 0; i < npatches; i++) {
+    PyObject *PROC_AND_LIST = PyList_GetItem(COMM, i);
+    HaloPatch &P = H->patches[i];
+    P.proc = PyLong_AsLong(PyList_GetItem(PROC_AND_LIST, 0));
+    E_Int *pfaces, npf;
+    PyObject *LIST = PyList_GetItem(PROC_AND_LIST, 1);
+    K_NUMPY::getFromNumpyArray(LIST, pfaces, npf, true);
+
+    collect_layers(F2C, nface, indPH, pfaces, npf, nlayers, mark, i,
+      P.scells, layer);
+
+    Py_DECREF(LIST);
+
+    // [ncells, nfaces, npoints]
+    // cells: [cglob, layer, nf, +/-fglob...]
+    // faces: [fglob, np, pglob...]
+    // points: [pglob]
+    auto &idata = sidata[i];
+    auto &fdata = sfdata[i];
+    idata.resize(3);
+    std::vector<E_Int> faces, points;
+    for (size_t j = 0; j < P.scells.size(); j++) {
+      E_Int cell = P.scells[j];
+      idata.push_back(cglob[cell]);
+      idata.push_back(layer[j]);
+      idata.push_back(indPH[cell+1]-indPH[cell]);
+      for (E_Int k = indPH[cell]; k < indPH[cell+1]; k++) {
+        E_Int face = std::abs(nface[k])-1;
+        // signed NFACE: the sign goes with the (1-based) global face
+        idata.push_back(nface[k] < 0 ? -fglob[face] : fglob[face]);
+        if (fmark[face] == i) continue;
+        fmark[face] = i;
+        faces.push_back(face);
+      }
+    }
+    for (E_Int face : faces) {
+      idata.push_back(fglob[face]);
+      idata.push_back(indPG[face+1]-indPG[face]);
+      for (E_Int k = indPG[face]; k < indPG[face+1]; k++) {
+        E_Int point = ngon[k]-1;
+        idata.push_back(pglob[point]);
+        if (pmark[point] == i) continue;
+        pmark[point] = i;
+        points.push_back(point);
+      }
+    }
+    for (E_Int point : points) {
+      idata.push_back(pglob[point]);
+      fdata.push_back(X[point]);
+      fdata.push_back(Y[point]);
+      fdata.push_back(Z[point]);
+    }
+    idata[0] = P.scells.size();
+    idata[1] = faces.size();
+    idata[2] = points.size();
+  }
+
+  // Neighbour only exchange of sizes then data
+  std::vector<MPI_Request> reqs(2*npatches);
+  std::vector<E_Int> ssize(2*npatches), rsize(2*npatches);
+  for (E_Int i = 0; i < npatches; i++) {
+    ssize[2*i] = sidata[i].size();
+    ssize[2*i+1] = sfdata[i].size();
+    MPI_Irecv(&rsize[2*i], 2, XMPI_INT, H->patches[i].proc, TAG_SIZE,
+      MPI_COMM_WORLD, &reqs[2*i]);
+    MPI_Isend(&ssize[2*i], 2, XMPI_INT, H->patches[i].proc, TAG_SIZE,
+      MPI_COMM_WORLD, &reqs[2*i+1]);
+  }
+  MPI_Waitall(2*npatches, reqs.data(), MPI_STATUSES_IGNORE);
+
+  std::vector<std::vector<E_Int>> ridata(npatches);
+  std::vector<std::vector<E_Float>> rfdata(npatches);
+  reqs.resize(4*npatches);
+  for (E_Int i = 0; i < npatches; i++) {
+    E_Int proc = H->patches[i].proc;
+    ridata[i].resize(rsize[2*i]);
+    rfdata[i].resize(rsize[2*i+1]);
+    MPI_Irecv(ridata[i].data(), (int)rsize[2*i], XMPI_INT, proc, TAG_IDATA,
+      MPI_COMM_WORLD, &reqs[4*i]);
+    MPI_Irecv(rfdata[i].data(), (int)rsize[2*i+1], MPI_DOUBLE, proc, TAG_FDATA,
+      MPI_COMM_WORLD, &reqs[4*i+1]);
+    MPI_Isend(sidata[i].data(), (int)ssize[2*i], XMPI_INT, proc, TAG_IDATA,
+      MPI_COMM_WORLD, &reqs[4*i+2]);
+    MPI_Isend(sfdata[i].data(), (int)ssize[2*i+1], MPI_DOUBLE, proc, TAG_FDATA,
+      MPI_COMM_WORLD, &reqs[4*i+3]);
+  }
+  MPI_Waitall(4*npatches, reqs.data(), MPI_STATUSES_IGNORE);
+
+  // Global to local maps
+  std::unordered_map<E_Int, E_Int> g2lf, g2lp;
+  for (E_Int i = 0; i < nfaces; i++) g2lf[fglob[i]] = i;
+  for (E_Int i = 0; i < npoints; i++) g2lp[pglob[i]] = i;
+
+  // Append ghost points, faces and cells
+  std::vector<E_Int> ncglob(cglob, cglob+ncells);
+  std::vector<E_Int> nfglob(fglob, fglob+nfaces);
+  std::vector<E_Int> npglob(pglob, pglob+npoints);
+  std::vector<E_Float> gxyz;
+  std::vector<E_Int> gngon, gindPG(1, 0), gnface, gindPH(1, 0), glayer;
+  E_Int nghost = 0;
+
+  for (E_Int i = 0; i < npatches; i++) {
+    HaloPatch &P = H->patches[i];
+    const E_Int *ptr = ridata[i].data();
+    E_Int rnc = ptr[0], rnf = ptr[1], rnp = ptr[2];
+    ptr += 3;
+
+    // skip cells, read faces and points first
+    const E_Int *pcells = ptr;
+    for (E_Int j = 0; j < rnc; j++) ptr += 3 + ptr[2];
+    const E_Int *pfaces = ptr;
+    for (E_Int j = 0; j < rnf; j++) ptr += 2 + ptr[1];
+    const E_Int *ppoints = ptr;
+
+    for (E_Int j = 0; j < rnp; j++) {
+      E_Int gp = ppoints[j];
+      if (g2lp.find(gp) != g2lp.end()) continue;
+      g2lp[gp] = (E_Int)npglob.size();
+      npglob.push_back(gp);
+      for (E_Int k = 0; k < 3; k++) gxyz.push_back(rfdata[i][3*j+k]);
+    }
+
+    ptr = pfaces;
+    for (E_Int j = 0; j < rnf; j++) {
+      E_Int gf = ptr[0], np = ptr[1];
+      if (g2lf.find(gf) == g2lf.end()) {
+        g2lf[gf] = (E_Int)nfglob.size();
+        nfglob.push_back(gf);
+        for (E_Int k = 0; k < np; k++) gngon.push_back(g2lp[ptr[2+k]]+1);
+        gindPG.push_back(gngon.size());
+      }
+      ptr += 2 + np;
+    }
+
+    P.rstart = nghost;
+    P.rcount = rnc;
+    ptr = pcells;
+    for (E_Int j = 0; j < rnc; j++) {
+      E_Int nf = ptr[2];
+      ncglob.push_back(ptr[0]);
+      glayer.push_back(ptr[1]);
+      for (E_Int k = 0; k < nf; k++) {
+        E_Int gf = ptr[3+k];
+        E_Int lf = g2lf[std::abs(gf)]+1;
+        gnface.push_back(gf < 0 ? -lf : lf);
+      }
+      gindPH.push_back(gnface.size());
+      ptr += 3 + nf;
+    }
+    nghost += rnc;
+  }
+
+  H->nghost = nghost;
+
+  // Build extended mesh
+  E_Int nnpoints = npglob.size();
+  E_Int nnfaces = nfglob.size();
+  E_Int nncells = ncglob.size();
+  E_Int sizeNGon = indPG[nfaces] + gindPG.back();
+  E_Int sizeNFace = indPH[ncells] + gindPH.back();
+
+  PyObject *m = K_ARRAY::buildArray3(3, varString, nnpoints, nncells, nnfaces,
+    "NGON", sizeNGon, sizeNFace, 3, false, 3);
+  K_FLD::FldArrayF *fo; K_FLD::FldArrayI *cno;
+  K_ARRAY::getFromArray3(m, fo, cno);
+
+  E_Float *Xo = fo->begin(posx);
+  E_Float *Yo = fo->begin(posy);
+  E_Float *Zo = fo->begin(posz);
+  for (E_Int i = 0; i < npoints; i++) {
+    Xo[i] = X[i]; Yo[i] = Y[i]; Zo[i] = Z[i];
+  }
+  for (E_Int i = npoints; i < nnpoints; i++) {
+    E_Int j = i - npoints;
+    Xo[i] = gxyz[3*j]; Yo[i] = gxyz[3*j+1]; Zo[i] = gxyz[3*j+2];
+  }
+
+  E_Int *ngono = cno->getNGon();
+  E_Int *indPGo = cno->getIndPG();
+  E_Int *nfaceo = cno->getNFace();
+  E_Int *indPHo = cno->getIndPH();
+
+  for (E_Int i = 0; i <= nfaces; i++) indPGo[i] = indPG[i];
+  for (E_Int i = 0; i < indPG[nfaces]; i++) ngono[i] = ngon[i];
+  for (size_t i = 1; i < gindPG.size(); i++)
+    indPGo[nfaces+i] = indPG[nfaces] + gindPG[i];
+  for (size_t i = 0; i < gngon.size(); i++)
+    ngono[indPG[nfaces]+i] = gngon[i];
+
+  for (E_Int i = 0; i <= ncells; i++) indPHo[i] = indPH[i];
+  for (E_Int i = 0; i < indPH[ncells]; i++) nfaceo[i] = nface[i];
+  for (size_t i = 1; i < gindPH.size(); i++)
+    indPHo[ncells+i] = indPH[ncells] + gindPH[i];
+  for (size_t i = 0; i < gnface.size(); i++)
+    nfaceo[indPH[ncells]+i] = gnface[i];
+
+  RELEASESHAREDU(m, fo, cno);
+  RELEASESHAREDU(ARR, f, cn);
+  Py_DECREF(CGLOB);
+  Py_DECREF(FGLOB);
+  Py_DECREF(PGLOB);
+
+  PyObject *hook = PyCapsule_New((void *)H, "NGonHalo",
+    halo_capsule_destructor);
+
+  PyObject *CG = K_NUMPY::buildNumpyArray(ncglob.data(), nncells, 1, 1);
+  PyObject *FG = K_NUMPY::buildNumpyArray(nfglob.data(), nnfaces, 1, 1);
+  PyObject *PG = K_NUMPY::buildNumpyArray(npglob.data(), nnpoints, 1, 1);
+  PyObject *LA = K_NUMPY::buildNumpyArray(glayer.data(), nghost, 1, 1);
+
+  PyObject *out = Py_BuildValue("[OOOOOO]", hook, m, CG, FG, PG, LA);
+  Py_DECREF(hook); Py_DECREF(m);
+  Py_DECREF(CG); Py_DECREF(FG); Py_DECREF(PG); Py_DECREF(LA);
+  return out;
+}
+
+// ============================================================================
+/* Refresh in place the ghost values of cell fields
+   IN: hook: halo handle
+   IN: flds: list of numpys of size ncells+nghost */
+// ============================================================================
+PyObject *K_XCORE::updateHaloNGon(PyObject *self, PyObject *args)
+{
+  PyObject *HOOK, *FLDS;
+  if (!PYPARSETUPLE_(args, OO_, &HOOK, &FLDS)) {
+    RAISE("Bad input.");
+    return NULL;
+  }
+
+  if (!PyCapsule_IsValid(HOOK, "NGonHalo")) {
+    RAISE("updateHaloNGon: bad halo hook.");
+    return NULL;
+  }
+  NGonHalo *H = (NGonHalo *)PyCapsule_GetPointer(HOOK, "NGonHalo");
+
+  E_Int nfld = PyList_Size(FLDS);
+  std::vector<E_Float *> flds(nfld);
+  for (E_Int i = 0; i < nfld; i++) {
+    PyObject *FLD = PyList_GetItem(FLDS, i);
+    E_Int size;
+    E_Int ret = K_NUMPY::getFromNumpyArray(FLD, flds[i], size, true);
+    if (ret != 1 || size != H->ncells + H->nghost) {
+      for (E_Int j = 0; j < i; j++) Py_DECREF(PyList_GetItem(FLDS, j));
+      if (ret == 1) Py_DECREF(FLD);
+      RAISE("updateHaloNGon: fields must be of size ncells+nghost.");
+      return NULL;
+    }
+  }
+
+  Halo_start(H, flds.data(), nfld);
+  Halo_finish(H, flds.data(), nfld);
+
+  for (E_Int i = 0; i < nfld; i++) Py_DECREF(PyList_GetItem(FLDS, i));
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
@@ -0,0 +1,58 @@
+/*
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef _XCORE_HALONGON_H_
+#define _XCORE_HALONGON_H_
+
+#include "xcore.h"
+#include <mpi.h>
+#include <vector>
+
+// Cells exchanged with one neighbouring proc
+struct HaloPatch {
+  E_Int proc;
+  std::vector<E_Int> scells; // owned cells sent to proc (by layer)
+  E_Int rstart; // first ghost cell received from proc (ghost numbering)
+  E_Int rcount; // number of ghost cells received from proc
+  std::vector<E_Float> sbuf;
+  std::vector<E_Float> rbuf;
+};
+
+// Persistent exchange handle of a k-layer NGON halo.
+// Ghost cells are numbered after the ncells owned cells.
+// The persistent requests (MPI_Send_init/MPI_Recv_init) are built for nfld
+// fields and rebuilt only when an exchange asks for another number of fields.
+struct NGonHalo {
+  E_Int ncells;
+  E_Int nghost;
+  E_Int nlayers;
+  std::vector<HaloPatch> patches;
+  std::vector<MPI_Request> reqs;
+  E_Int nfld; // number of fields of the persistent requests
+};
+
+void Halo_free(NGonHalo *H);
+
+// Non-blocking refresh of the ghost values of nfld cell fields
+// (each of size ncells+nghost). Halo_start packs the owned values and starts
+// the persistent requests, Halo_finish waits for them and fills the ghost
+// values.
+void Halo_start(NGonHalo *H, E_Float **flds, E_Int nfld);
+void Halo_finish(NGonHalo *H, E_Float **flds, E_Int nfld);
+
+#endif
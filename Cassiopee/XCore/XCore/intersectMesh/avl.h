@@ -0,0 +1,66 @@
+#ifndef _INTERSECT_MESH_AVL_H
+#define _INTERSECT_MESH_AVL_H
+
+#include <algorithm>
+
+// AVL rebalancing shared by the event queue and the sweep status.
+// Node must expose left, right and height.
+
+template <typename Node>
+inline int avl_height(Node *n)
+{
+  return n ? n->height : 0;
+}
+
+template <typename Node>
+inline void avl_update(Node *n)
+{
+  n->height = 1 + std::max(avl_height(n->left), avl_height(n->right));
+}
+
+template <typename Node>
+inline Node *avl_rotate_right(Node *n)
+{
+  Node *l = n->left;
+  n->left = l->right;
+  l->right = n;
+  avl_update(n);
+  avl_update(l);
+  return l;
+}
+
+template <typename Node>
+inline Node *avl_rotate_left(Node *n)
+{
+  Node *r = n->right;
+  n->right = r->left;
+  r->left = n;
+  avl_update(n);
+  avl_update(r);
+  return r;
+}
+
+// Rotations only relink nodes: in-order sequence and node identities are kept
+template <typename Node>
+inline Node *avl_balance(Node *n)
+{
+  avl_update(n);
+
+  int bf = avl_height(n->left) - avl_height(n->right);
+
+  if (bf > 1) {
+    if (avl_height(n->left->left) < avl_height(n->left->right))
+      n->left = avl_rotate_left(n->left);
+    return avl_rotate_right(n);
+  }
+
+  if (bf < -1) {
+    if (avl_height(n->right->right) < avl_height(n->right->left))
+      n->right = avl_rotate_right(n->right);
+    return avl_rotate_left(n);
+  }
+
+  return n;
+}
+
+#endif
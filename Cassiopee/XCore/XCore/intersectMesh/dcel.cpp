@@ -82,13 +82,13 @@ void face::print_parents()
 }
 
 void dcel_make_faces_from_connected_components(const std::vector<cycle *> &comps,
-    std::vector<face *> &new_faces)
+    std::vector<face *> &new_faces, arena<face> &FP)
 { 
     assert(new_faces.empty()); 
 
     for (cycle *comp : comps) {
         // Create a face record
-        face *f = new face;
+        face *f = FP.make();
 
         // Set its rep hedge to some edge of comp
         hedge *h = comp->rep;
@@ -160,7 +160,7 @@ void dcel::_init_from_smesh(const smesh &M, int color)
     const auto& E = M.E;
 
     for (size_t i = 0; i < X.size(); i++) {
-        Q.insert(X[i], Y[i], i);
+        Q.insert(X[i], Y[i], i, P.V);
     }
 
     std::unordered_map<vertex *, std::vector<hedge *>> v2h;
@@ -172,8 +172,8 @@ void dcel::_init_from_smesh(const smesh &M, int color)
         vertex *q = Q.locate_v(X[E[i].q], Y[E[i].q]);
         assert(p && q);
 
-        hedge *h = new hedge(p);
-        hedge *t = new hedge(q);
+        hedge *h = P.H.make(p);
+        hedge *t = P.H.make(q);
         h->twin = t;
         t->twin = h;
         h->color = t->color = color;
@@ -213,7 +213,7 @@ void dcel::_init_from_smesh(const smesh &M, int color)
         assert(h->twin == t);
         assert(t->twin == h);
 
-        face *f = new face;
+        face *f = P.F.make();
         f->id = i;
         
         assert(E2F[first_edge][0] == (int)i || E2F[first_edge][1] == (int)i);
@@ -294,7 +294,7 @@ std::vector<hedge *> dcel_get_incident_edges(vertex *v)
 
 void dcel_resolve(vertex *v, std::vector<segment *> &L,
     std::vector<segment *> &C, std::vector<segment *> &U,
-    std::vector<hedge *> &H)
+    std::vector<hedge *> &H, arena<hedge> &HP)
 {
     // The half-edges starting at v
     std::vector<hedge *> leaving;
@@ -314,8 +314,8 @@ void dcel_resolve(vertex *v, std::vector<segment *> &L,
 
     for (segment *s : C) {
         // Create two new half-edge records with v as their origin
-        hedge *e1 = new hedge(v);
-        hedge *e2 = new hedge(v);
+        hedge *e1 = HP.make(v);
+        hedge *e2 = HP.make(v);
 
         e1->color = s->color();
         e2->color = s->color();
@@ -407,7 +407,8 @@ void cycle::print()
     puts("\n");
 }
 
-std::vector<cycle *> dcel_make_cycles(const std::vector<hedge *> &H)
+std::vector<cycle *> dcel_make_cycles(const std::vector<hedge *> &H,
+    arena<cycle> &CP)
 {
     std::vector<cycle *> C;
 
@@ -421,7 +422,7 @@ std::vector<cycle *> dcel_make_cycles(const std::vector<hedge *> &H)
         if (h->cycl)
             continue;
 
-        cycle *c = new cycle(h);
+        cycle *c = CP.make(h);
         C.push_back(c);
 
         h->cycl = c;
@@ -486,7 +487,7 @@ void dcel_set_cycles_inout(std::vector<cycle *> &C)
 }
 
 dcel::dcel()
-: V(), H(), F(), C(), Q()
+: P(), V(), H(), F(), C(), Q()
 {}
 
 void dcel::find_intersections()
@@ -503,12 +504,12 @@ void dcel::find_intersections()
 
     printf("-BIG: %f\n", -BIG);
 
-    vertex *vinf0 = new vertex(-BIG, -BIG, -1);
-    vertex *vinf1 = new vertex( BIG, -BIG, -2);
-    vertex *vinf2 = new vertex(-BIG,  BIG, -3);
-    vertex *vinf3 = new vertex( BIG,  BIG, -4);
-    segment *sinf0 = new segment(vinf0, vinf1, -1);
-    segment *sinf1 = new segment(vinf2, vinf3, -2);
+    vertex *vinf0 = P.V.make(-BIG, -BIG, -1);
+    vertex *vinf1 = P.V.make( BIG, -BIG, -2);
+    vertex *vinf2 = P.V.make(-BIG,  BIG, -3);
+    vertex *vinf3 = P.V.make( BIG,  BIG, -4);
+    segment *sinf0 = P.S.make(vinf0, vinf1, -1);
+    segment *sinf1 = P.S.make(vinf2, vinf3, -2);
 
     status T;
     T.xs = T.ys = -BIG;
@@ -525,7 +526,7 @@ void dcel::find_intersections()
         assert(t->twin = h);
         
         // Does the swap if necessary
-        segment *s = new segment(h, i>>1);
+        segment *s = P.S.make(h, i>>1);
 
         event *it = Q.insert(s->p);
         s->p = it->key;
@@ -540,11 +541,11 @@ void dcel::find_intersections()
 
     std::reverse(S.begin(), S.end());
 
-    sweep(S, V, H, Q, T);
+    sweep(S, V, H, Q, T, P);
 
     assert(dcel_check_hedges_without_faces(H));
     
-    C = dcel_make_cycles(H);
+    C = dcel_make_cycles(H, P.C);
     dcel_set_cycles_inout(C);
 
     //for (cycle *c : C) c->print();
@@ -555,7 +556,8 @@ void dcel::find_intersections()
 
     // Make the new faces
     std::vector<face *> new_faces;
-    dcel_make_faces_from_connected_components(connected_components, new_faces);
+    dcel_make_faces_from_connected_components(connected_components, new_faces,
+        P.F);
     printf("New faces: %zu\n", new_faces.size());
 
     dcel_set_face_labels(new_faces);
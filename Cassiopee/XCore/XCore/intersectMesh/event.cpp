@@ -1,20 +1,13 @@
 #include "proto.h"
+#include "avl.h"
 #include <cstddef>
 #include <cstdio>
 #include <cassert>
 
 event::event(vertex *V)
-: key(V), inf(NULL), left(NULL), right(NULL)
+: key(V), inf(NULL), left(NULL), right(NULL), height(1)
 {}
 
-event::event(double x, double y, int oid)
-{
-    key = new vertex(x, y, oid);
-    inf = NULL;
-    left = NULL;
-    right = NULL;
-}
-
 void event::inorder(std::vector<vertex *> &V)
 {
     if (left) left->inorder(V);
@@ -23,23 +16,39 @@ void event::inorder(std::vector<vertex *> &V)
 }
 
 queue::queue()
-: root(NULL), nelem(0)
+: root(NULL), nelem(0), pool(), freed()
 {}
 
+event *queue::_make(vertex *v)
+{
+    if (freed.empty())
+        return pool.make(v);
+
+    event *E = freed.back();
+    freed.pop_back();
+    return new (E) event(v);
+}
+
+void queue::_release(event *E)
+{
+    freed.push_back(E);
+}
+
 void queue::inorder(std::vector<vertex *> &V)
 {
     root->inorder(V);
 }
 
-event *queue::insert(double x, double y, int oid)
+event *queue::insert(double x, double y, int oid, arena<vertex> &VP)
 {
-    return _insert(root, x, y, oid);
+    return _insert(root, x, y, oid, VP);
 }
 
-event *queue::_insert(event *&root, double x, double y, int oid)
+event *queue::_insert(event *&root, double x, double y, int oid,
+    arena<vertex> &VP)
 {
     if (root == NULL) {
-        root = new event(x, y, oid);
+        root = _make(VP.make(x, y, oid));
         return root;
     }
 
@@ -53,11 +62,10 @@ event *queue::_insert(event *&root, double x, double y, int oid)
         return root;
     }
 
-    else if (cmp < 0)
-        return _insert(root->right, x, y, oid);
-
-    else
-        return _insert(root->left, x, y, oid);
+    event *E = (cmp < 0) ? _insert(root->right, x, y, oid, VP) :
+                           _insert(root->left, x, y, oid, VP);
+    root = avl_balance(root);
+    return E;
 }
 
 event *queue::insert(vertex *v)
@@ -68,7 +76,7 @@ event *queue::insert(vertex *v)
 event *queue::_insert(event *&root, vertex *v)
 {
     if (root == NULL) {
-        root = new event(v);
+        root = _make(v);
         return root;
     }
 
@@ -76,10 +84,10 @@ event *queue::_insert(event *&root, vertex *v)
 
     if (cmp == 0)
         return root;
-    else if (cmp < 0)
-        return _insert(root->right, v);
-    else
-        return _insert(root->left, v);
+
+    event *E = (cmp < 0) ? _insert(root->right, v) : _insert(root->left, v);
+    root = avl_balance(root);
+    return E;
 }
 
 vertex *queue::locate_v(double x, double y)
@@ -159,42 +167,41 @@ event *queue::_erase(event *root, vertex *v)
 
     if (cmp < 0) {
         root->right = _erase(root->right, v);
-        return root;
     } else if (cmp > 0) {
         root->left = _erase(root->left, v);
-        return root;
-    }
-
-    assert(root->key == v);
-
-    if (root->left == NULL) {
-        event *tmp = root->right;
-        delete root;
-        return tmp;
-    } else if (root->right == NULL) {
-        event *tmp = root->left;
-        delete root;
-        return tmp;
     } else {
-        event *succ_parent = root;
+        assert(root->key == v);
 
-        event *succ = root->right;
-        while (succ->left) {
-            succ_parent = succ;
-            succ = succ->left;
+        if (root->left == NULL || root->right == NULL) {
+            event *tmp = root->left ? root->left : root->right;
+            _release(root);
+            return tmp;
         }
 
-        if (succ_parent != root)
-            succ_parent->left = succ->right;
-        else
-            succ_parent->right = succ->left;
+        // Two children: pull up the successor
+        event *succ = root->right;
+        while (succ->left)
+            succ = succ->left;
 
         root->key = succ->key;
         root->inf = succ->inf;
 
-        delete succ;
-        return root;
+        root->right = _erase_min(root->right);
     }
+
+    return avl_balance(root);
+}
+
+event *queue::_erase_min(event *root)
+{
+    if (root->left == NULL) {
+        event *tmp = root->right;
+        _release(root);
+        return tmp;
+    }
+
+    root->left = _erase_min(root->left);
+    return avl_balance(root);
 }
 
 int queue::empty()
@@ -16,6 +16,11 @@ bool Edge_NO::operator<(const Edge_NO &other) const
   return (p < other.p) || (p == other.p && q < other.q);
 }
 
+bool Edge_NO::operator==(const Edge_NO &other) const
+{
+  return p == other.p && q == other.q;
+}
+
 // Source: Moller-Trumbore algorithm
 E_Int geom_ray_triangle_intersect(E_Float px, E_Float py, E_Float pz,
   E_Float dx, E_Float dy, E_Float dz,
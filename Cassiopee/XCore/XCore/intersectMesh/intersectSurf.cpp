@@ -3,8 +3,9 @@
 PyObject *K_XCORE::intersectSurf(PyObject *self, PyObject *args)
 {
   PyObject *MASTER, *SLAVE, *PATCH, *TAG;
+  E_Int ntiles;
   
-  if (!PYPARSETUPLE_(args, OOOO_, &MASTER, &SLAVE, &PATCH, &TAG)) {
+  if (!PYPARSETUPLE_(args, OOOO_ I_, &MASTER, &SLAVE, &PATCH, &TAG, &ntiles)) {
     RAISE("Bad input.");
     return NULL;
   }
@@ -101,6 +102,7 @@ PyObject *K_XCORE::intersectSurf(PyObject *self, PyObject *args)
   if (ret != 1) {
     RELEASESHAREDU(MASTER, fm, cnm);
     RELEASESHAREDU(SLAVE, fs, cns);
+    Py_DECREF(PATCH);
     RAISE("Bad slave points tag.");
     return NULL;
   }
@@ -130,7 +132,52 @@ PyObject *K_XCORE::intersectSurf(PyObject *self, PyObject *args)
     if (keep) spatch.push_back(i);
   }
 
-  mesh_patch_intersect(M, S, mpatch, mpatch_size, &spatch[0], spatch.size());
+  // PointList is 1-based
+  std::vector<E_Int> mfaces(mpatch, mpatch+mpatch_size);
+  for (auto &f : mfaces) f -= 1;
+
+  std::vector<opoly> O;
+  mesh_patch_intersect_tiles(M, S, mfaces.empty() ? NULL : &mfaces[0], mpatch_size,
+    spatch.empty() ? NULL : &spatch[0], spatch.size(), ntiles, O);
+
+  // Output: parents (master, slave) of the overlay faces (1-based, 0 if no
+  // slave face), loop offsets, x, y
+  E_Int nf = O.size(), np = 0;
+  for (const auto &P : O) np += P.x.size();
+
+  PyObject *PARENTS = K_NUMPY::buildNumpyArray(nf, 2, 1, 1);
+  PyObject *INDPG = K_NUMPY::buildNumpyArray(nf+1, 1, 1, 1);
+  PyObject *XO = K_NUMPY::buildNumpyArray(np, 1, 0, 1);
+  PyObject *YO = K_NUMPY::buildNumpyArray(np, 1, 0, 1);
+  E_Int *parents = K_NUMPY::getNumpyPtrI(PARENTS);
+  E_Int *indPG = K_NUMPY::getNumpyPtrI(INDPG);
+  E_Float *xo = K_NUMPY::getNumpyPtrF(XO);
+  E_Float *yo = K_NUMPY::getNumpyPtrF(YO);
+
+  indPG[0] = 0;
+  for (E_Int i = 0; i < nf; i++) {
+    const auto &P = O[i];
+    parents[i] = P.mf+1;
+    parents[i+nf] = P.sf+1;
+    indPG[i+1] = indPG[i] + P.x.size();
+    for (size_t j = 0; j < P.x.size(); j++) {
+      xo[indPG[i]+j] = P.x[j];
+      yo[indPG[i]+j] = P.y[j];
+    }
+  }
+
+  mesh_drop(M);
+  mesh_drop(S);
+  RELEASESHAREDU(MASTER, fm, cnm);
+  RELEASESHAREDU(SLAVE, fs, cns);
+  Py_DECREF(PATCH);
+  Py_DECREF(TAG);
+
+  PyObject *out = Py_BuildValue("[OOOO]", PARENTS, INDPG, XO, YO);
+  Py_DECREF(PARENTS);
+  Py_DECREF(INDPG);
+  Py_DECREF(XO);
+  Py_DECREF(YO);
 
-  return Py_None;
+  return out;
 }
@@ -105,6 +105,20 @@ Mesh *mesh_init(K_FLD::FldArrayI &cn, E_Float *X, E_Float *Y, E_Float *Z,
   return M;
 }
 
+void mesh_drop(Mesh *M)
+{
+  XFREE(M->x);
+  XFREE(M->y);
+  XFREE(M->z);
+  XFREE(M->indPH);
+  XFREE(M->indPG);
+  XFREE(M->nface);
+  XFREE(M->ngon);
+  XFREE(M->owner);
+  XFREE(M->neigh);
+  delete M;
+}
+
 E_Int *mesh_get_cell(E_Int cell, E_Int &stride, Mesh *M)
 {
   stride = M->indPH[cell+1] - M->indPH[cell];
@@ -229,7 +243,7 @@ Mesh *mesh_extract_from_cell_set(Mesh *M, const std::set<E_Int> &cell_set)
   assert(ptr - O->nface == sizeNFace);
 
   // Hash kept faces and count sizeNGon
-  std::map<E_Int, E_Int> face_table;
+  std::unordered_map<E_Int, E_Int> face_table;
   E_Int sizeNGon = 0;
 
   O->nf = 0;
@@ -261,7 +275,7 @@ Mesh *mesh_extract_from_cell_set(Mesh *M, const std::set<E_Int> &cell_set)
   for (E_Int i = 0; i < O->nf+1; i++) O->indPG[i+1] += O->indPG[i];
 
   // Fill in the points
-  std::map<E_Int, E_Int> point_table;
+  std::unordered_map<E_Int, E_Int> point_table;
 
   O->np = 0;
 
@@ -355,7 +369,7 @@ Mesh *mesh_make_surface_mesh_from_face_list(Mesh *M,
   // Populate nface with edges
   E_Int *ptr = E->nface;
 
-  std::map<Edge_NO, E_Int> edge_table;
+  std::unordered_map<Edge_NO, E_Int, Edge_NO_hash> edge_table;
   std::unordered_map<E_Int, E_Int> point_table;
 
   E->nf = 0;
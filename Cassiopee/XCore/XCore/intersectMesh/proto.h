@@ -9,6 +9,7 @@
 // Mesh
 Mesh *mesh_init(K_FLD::FldArrayI &cn, E_Float *X, E_Float *Y, E_Float *Z,
   E_Int np);
+void mesh_drop(Mesh *M);
 E_Int *mesh_get_cell(E_Int cell, E_Int &stride, Mesh *M);
 E_Int *mesh_get_face(E_Int face, E_Int &stride, Mesh *M);
 E_Int mesh_get_stride(E_Int elem, E_Int *ind);
@@ -26,6 +27,9 @@ Mesh *mesh_make_surface_mesh_from_structured_points(E_Int ni, E_Int nj,
   const std::vector<E_Float> &Z);
 void mesh_patch_intersect(Mesh *M, Mesh *S, E_Int *mpatch, E_Int mpatchc,
   E_Int *spatch, E_Int spatchc);
+void mesh_patch_intersect_tiles(Mesh *M, Mesh *S, E_Int *mpatch,
+  E_Int mpatchc, E_Int *spatch, E_Int spatchc, E_Int ntiles,
+  std::vector<opoly> &out);
 
 // Io
 void point_set_write(const std::set<E_Int> &points, Mesh *M, const char *fname);
@@ -79,10 +83,11 @@ int segments_are_colli(segment *, segment *);
 std::vector<hedge *> dcel_get_incident_hedges(vertex *);
 void dcel_resolve(vertex *, std::vector<segment *> &L,
     std::vector<segment *> &C, std::vector<segment *> &U,
-    std::vector<hedge *> &);
+    std::vector<hedge *> &, arena<hedge> &);
 int hedge_check_without_faces(const std::vector<hedge *> &);
 void dcel_set_cycles_inout(std::vector<cycle *> &);
-std::vector<cycle *> dcel_make_cycles(const std::vector<hedge *> &);
+std::vector<cycle *> dcel_make_cycles(const std::vector<hedge *> &,
+    arena<cycle> &);
 void dcel_read_two(const char *, dcel &, dcel &);
 int dcel_check_faces(const std::vector<hedge *> &,
     const std::vector<face *> &);
@@ -101,7 +106,7 @@ int hedge_cmp_cwise(hedge *, hedge *);
 int hedges_incident_overlap(hedge *h, hedge *w);
 
 void sweep(std::vector<segment *> &S, std::vector<vertex *> &V,
-    std::vector<hedge *> &H, queue &Q, status &T);
+    std::vector<hedge *> &H, queue &Q, status &T, dcel_pool &P);
 
 const char *color_to_str(int);
 
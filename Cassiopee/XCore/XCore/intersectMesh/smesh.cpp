@@ -57,19 +57,26 @@ smesh::smesh(Mesh *M, E_Int *patch, E_Int nf)
   make_edges();
 }
 
-struct o_edge_cmp {
+// Orientation-free hashing of o_edges
+struct o_edge_hash {
+  size_t operator()(const o_edge &e) const
+  {
+    return Edge_NO_hash()(Edge_NO(e.p, e.q));
+  }
+};
+
+struct o_edge_eq {
   bool operator()(const o_edge &e, const o_edge &f) const
   {
-    E_Int e_p = std::min(e.p, e.q);
-    E_Int e_q = std::max(e.p, e.q);
-    E_Int f_p = std::min(f.p, f.q);
-    E_Int f_q = std::max(f.p, f.q);
-    return (e_p < f_p) || (e_p == f_p && e_q < f_q);
+    return std::min(e.p, e.q) == std::min(f.p, f.q) &&
+           std::max(e.p, e.q) == std::max(f.p, f.q);
   }
 };
 
 void smesh::make_edges()
 {
+  if (F.empty()) return; // tile without slave faces
+
   // Order the faces counter-clockwise
   for (size_t i = 0; i < F.size(); i++) {
     auto &face = F[i];
@@ -92,7 +99,7 @@ void smesh::make_edges()
 
   // Make the o_edges
   F2E.resize(F.size());
-  std::map<o_edge, int, o_edge_cmp> o_edges;
+  std::unordered_map<o_edge, int, o_edge_hash, o_edge_eq> o_edges;
 
   for (size_t i = 0; i < F.size(); i++) {
     auto &face = F[i];
@@ -112,8 +119,8 @@ void smesh::make_edges()
     }
   }
 
-  // Euler's formula should always be true
-  assert(F.size()+1 + X.size() == E.size() + 2);
+  // No Euler check: it only holds for a connected patch without holes,
+  // which a tile of a patch (mesh_patch_intersect_tiles) need not be
 
   // Make o_edge_to_face
   E2F.resize(E.size(), {-1, -1});
@@ -1,16 +1,32 @@
 #include "proto.h"
+#include "avl.h"
 #include <cstddef>
 #include <cassert>
 #include <cstdio>
 
 snode::snode(segment *S)
-: s(S), inf(NULL), left(NULL), right(NULL)
+: s(S), inf(NULL), left(NULL), right(NULL), height(1)
 {}
 
 status::status()
-: root(NULL), xs(0), ys(0)
+: root(NULL), xs(0), ys(0), pool(), freed()
 {}
 
+snode *status::_make(segment *s)
+{
+    if (freed.empty())
+        return pool.make(s);
+
+    snode *sit = freed.back();
+    freed.pop_back();
+    return new (sit) snode(s);
+}
+
+void status::_release(snode *sit)
+{
+    freed.push_back(sit);
+}
+
 snode *status::insert(segment *s)
 {
     return _insert(root, s);
@@ -19,7 +35,7 @@ snode *status::insert(segment *s)
 snode *status::_insert(snode *&root, segment *s)
 {
     if (root == NULL) {
-        root = new snode(s);
+        root = _make(s);
         return root;
     }
 
@@ -27,10 +43,10 @@ snode *status::_insert(snode *&root, segment *s)
 
     if (cmp == 0)
         return root;
-    else if (cmp < 0)
-        return _insert(root->right, s);
-    else
-        return _insert(root->left, s);
+
+    snode *sit = (cmp < 0) ? _insert(root->right, s) : _insert(root->left, s);
+    root = avl_balance(root);
+    return sit;
 }
 
 snode *status::locate(segment *s)
@@ -60,19 +76,17 @@ snode *status::lookup(segment *s)
 
 snode *status::_lookup(snode *root, segment *s)
 {
-    if (root == NULL) {
-        root = new snode(s);
-        return root;
-    }
+    if (root == NULL)
+        return NULL;
 
     int cmp = _segment_cmp(root->s, s);
 
     if (cmp == 0)
         return root;
     else if (cmp < 0)
-        return _insert(root->right, s);
+        return _lookup(root->right, s);
     else
-        return _insert(root->left, s);
+        return _lookup(root->left, s);
 }
 
 void status::erase(segment *s)
@@ -89,42 +103,41 @@ snode *status::_erase(snode *root, segment *s)
 
     if (cmp < 0) {
         root->right = _erase(root->right, s);
-        return root;
     } else if (cmp > 0) {
         root->left = _erase(root->left, s);
-        return root;
-    }
-
-    assert(root->s == s);
-
-    if (root->left == NULL) {
-        snode *tmp = root->right;
-        delete root;
-        return tmp;
-    } else if (root->right == NULL) {
-        snode *tmp = root->left;
-        delete root;
-        return tmp;
     } else {
-        snode *succ_parent = root;
+        assert(root->s == s);
 
-        snode *succ = root->right;
-        while (succ->left) {
-            succ_parent = succ;
-            succ = succ->left;
+        if (root->left == NULL || root->right == NULL) {
+            snode *tmp = root->left ? root->left : root->right;
+            _release(root);
+            return tmp;
         }
 
-        if (succ_parent != root)
-            succ_parent->left = succ->right;
-        else
-            succ_parent->right = succ->right;
+        // Two children: pull up the successor
+        snode *succ = root->right;
+        while (succ->left)
+            succ = succ->left;
 
         root->s = succ->s;
         root->inf = succ->inf;
 
-        delete succ;
-        return root;
+        root->right = _erase_min(root->right);
     }
+
+    return avl_balance(root);
+}
+
+snode *status::_erase_min(snode *root)
+{
+    if (root->left == NULL) {
+        snode *tmp = root->right;
+        _release(root);
+        return tmp;
+    }
+
+    root->left = _erase_min(root->left);
+    return avl_balance(root);
 }
 
 snode *status::pred(snode *sit)
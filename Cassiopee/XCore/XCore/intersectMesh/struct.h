@@ -7,6 +7,8 @@
 #include <unordered_map>
 #include <array>
 #include <vector>
+#include <new>
+#include <utility>
 
 #define INTERSECT_TOL 1e-6
 #define TOL 1e-10
@@ -65,6 +67,14 @@ struct Edge_NO {
   Edge_NO(E_Int p, E_Int q);
 
   bool operator<(const Edge_NO &other) const;
+  bool operator==(const Edge_NO &other) const;
+};
+
+struct Edge_NO_hash {
+  size_t operator()(const Edge_NO &e) const
+  {
+    return std::hash<E_Int>()(e.p) ^ (std::hash<E_Int>()(e.q) * 0x9e3779b97f4a7c15ULL);
+  }
 };
 
 struct Ray {
@@ -97,6 +107,45 @@ struct Edge_Hit {
 
 /********************************************/
 
+// Block allocator: objects are built in place inside fixed-size blocks,
+// so their addresses stay valid as the arena grows. Everything is released
+// at once when the arena dies.
+template <typename T>
+struct arena {
+  std::vector<T *> blocks;
+  size_t nused; // objects used in the last block
+  size_t bsize;
+
+  arena(size_t bs = 4096) : blocks(), nused(bs), bsize(bs) {}
+  ~arena() { clear(); }
+
+  arena(const arena &) = delete;
+  arena &operator=(const arena &) = delete;
+
+  template <typename... Args>
+  T *make(Args &&... args)
+  {
+    if (nused == bsize) {
+      blocks.push_back(static_cast<T *>(::operator new(bsize * sizeof(T))));
+      nused = 0;
+    }
+    T *ptr = blocks.back() + nused++;
+    new (ptr) T(std::forward<Args>(args)...);
+    return ptr;
+  }
+
+  void clear()
+  {
+    for (size_t i = 0; i < blocks.size(); i++) {
+      size_t n = (i == blocks.size()-1) ? nused : bsize;
+      for (size_t j = 0; j < n; j++) blocks[i][j].~T();
+      ::operator delete(blocks[i]);
+    }
+    blocks.clear();
+    nused = bsize;
+  }
+};
+
 struct vertex;
 struct face;
 struct cycle;
@@ -163,8 +212,8 @@ struct event {
   segment *inf;
   event *left;
   event *right;
+  int height;
   
-  event(E_Float x, E_Float y, int i);
   event(vertex *);
   void print();
   void inorder(std::vector<vertex *> &);
@@ -175,21 +224,27 @@ struct snode {
   void *inf;
   snode *left;
   snode *right;
+  int height;
 
   snode(segment *);
   void print();
 };
 
+// Event queue and sweep status are AVL trees: events are inserted in
+// lexicographic order, which degenerates a plain binary search tree.
+// Nodes are recycled through a free list.
 struct queue {
   event *root;
   int nelem;
+  arena<event> pool;
+  std::vector<event *> freed;
 
   queue();
 
   void inorder(std::vector<vertex *> &);
 
   event *insert(vertex *);
-  event *insert(E_Float, E_Float, int);
+  event *insert(E_Float, E_Float, int, arena<vertex> &);
   void erase(event *);
   void erase(vertex *);
   event *min();
@@ -199,8 +254,11 @@ struct queue {
   int empty();
 
   event *_insert(event *&, vertex *);
-  event *_insert(event *&, E_Float, E_Float, int);
+  event *_insert(event *&, E_Float, E_Float, int, arena<vertex> &);
   event *_erase(event *, vertex *);
+  event *_erase_min(event *);
+  event *_make(vertex *);
+  void _release(event *);
   event *_locate(event *, E_Float, E_Float);
   event *_lookup(event *, vertex *);
 
@@ -210,6 +268,8 @@ struct queue {
 struct status {
   snode *root;
   E_Float xs, ys;
+  arena<snode> pool;
+  std::vector<snode *> freed;
 
   status();
   void print();
@@ -227,6 +287,9 @@ struct status {
 
   snode *_insert(snode *&, segment *);
   snode *_erase(snode *, segment *);
+  snode *_erase_min(snode *);
+  snode *_make(segment *);
+  void _release(snode *);
   snode *_locate(snode *, segment *);
   snode *_lookup(snode *, segment *);
   void _pred(snode *, segment *, snode *&);
@@ -256,6 +319,15 @@ struct smesh {
   void write_su2(const char *fname);
 };
 
+// Piece of a master patch face in the overlay, with the slave face covering
+// it (-1 if none). Parents are mesh face ids, x/y is the outer loop.
+struct opoly {
+  E_Int mf;
+  E_Int sf;
+  std::vector<E_Float> x;
+  std::vector<E_Float> y;
+};
+
 struct cycle {
   hedge *rep;
   int inout;
@@ -268,7 +340,17 @@ struct cycle {
   int get_size();
 };
 
+// Storage of the dcel entities, released with the dcel
+struct dcel_pool {
+  arena<vertex> V;
+  arena<hedge> H;
+  arena<segment> S;
+  arena<face> F;
+  arena<cycle> C;
+};
+
 struct dcel {
+  dcel_pool P;
   std::vector<vertex *> V;
   std::vector<hedge *> H;
   std::vector<face *> F;
@@ -7,7 +7,7 @@
 
 static
 void _find_new_event(queue &Q, status &T, std::vector<vertex *> &V,
-    snode *sit0, snode *sit1)
+    snode *sit0, snode *sit1, arena<vertex> &VP)
 {
     segment *s0 = sit0->s;
     segment *s1 = sit1->s;
@@ -55,7 +55,7 @@ void _find_new_event(queue &Q, status &T, std::vector<vertex *> &V,
 
     if (I == NULL) {
         // No: insert new event and set its sit to S1
-        vertex *v = new vertex(x, y, V.size(), true);
+        vertex *v = VP.make(x, y, V.size(), true);
         I = Q.insert(v);
         V.push_back(v);
     }
@@ -85,7 +85,7 @@ int _report_intersection(const std::vector<segment *> &L,
 
 static
 void _handle_event(event *E, queue &Q, status &T, std::vector<vertex *> &V,
-    std::vector<segment *> &S, std::vector<hedge *> &H)
+    std::vector<segment *> &S, std::vector<hedge *> &H, dcel_pool &P)
 {
     // Get starting segments
     segment *s = E->inf;
@@ -150,7 +150,7 @@ void _handle_event(event *E, queue &Q, status &T, std::vector<vertex *> &V,
     if (L.size() + C.size() + U.size() > 1) {
         int intersect = _report_intersection(L, C, U);
         if (intersect)
-            dcel_resolve(v, L, C, U, H);
+            dcel_resolve(v, L, C, U, H, P.H);
     }
 
     for (segment *s : C) {
@@ -204,11 +204,11 @@ void _handle_event(event *E, queue &Q, status &T, std::vector<vertex *> &V,
         snode *sit_pred = T.lookup(s_pred);
         
         snode *sit_first = T.succ(sit_pred);
-        _find_new_event(Q, T, V, sit_pred, sit_first);
+        _find_new_event(Q, T, V, sit_pred, sit_first, P.V);
 
         snode *sit_last = T.pred(sit_succ);
         if (sit_last != sit_pred)
-            _find_new_event(Q, T, V, sit_last, sit_succ);
+            _find_new_event(Q, T, V, sit_last, sit_succ, P.V);
 
 
         // Store the half-edge immediately to the left of v on the sweep line
@@ -217,13 +217,13 @@ void _handle_event(event *E, queue &Q, status &T, std::vector<vertex *> &V,
 }
 
 void sweep(std::vector<segment *> &S, std::vector<vertex *> &V,
-    std::vector<hedge *> &H, queue &Q, status &T)
+    std::vector<hedge *> &H, queue &Q, status &T, dcel_pool &P)
 {
     puts("SWEEP START...");
 
     while (!Q.empty()) {
         event *E = Q.min();
-        _handle_event(E, Q, T, V, S, H);
+        _handle_event(E, Q, T, V, S, H, P);
         Q.erase(E);
     }
 
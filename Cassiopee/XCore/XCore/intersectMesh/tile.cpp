@@ -0,0 +1,157 @@
+/*
+    Copyright 2013-2024 Onera.
+
+    This file is part of Cassiopee.
+
+    Cassiopee is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cassiopee is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cassiopee.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "proto.h"
+#include <algorithm>
+#include <cmath>
+
+// xy bounding box of a face: xmin, xmax, ymin, ymax
+static
+void face_box(Mesh *M, E_Int face, E_Float *b)
+{
+  E_Int np = -1;
+  E_Int *pn = mesh_get_face(face, np, M);
+  b[0] = b[2] = E_FLOAT_MAX;
+  b[1] = b[3] = -E_FLOAT_MAX;
+  for (E_Int j = 0; j < np; j++) {
+    E_Int p = pn[j];
+    b[0] = std::min(b[0], M->x[p]);
+    b[1] = std::max(b[1], M->x[p]);
+    b[2] = std::min(b[2], M->y[p]);
+    b[3] = std::max(b[3], M->y[p]);
+  }
+}
+
+// Overlay faces of D lying in a master face. Local face ids are mapped back
+// to mesh face ids. Loops start at their lowest vertex.
+static
+void tile_collect(dcel &D, const std::vector<E_Int> &mlist,
+  const std::vector<E_Int> &slist, std::vector<opoly> &out)
+{
+  for (face *f : D.F) {
+    if (f->ofp[RED] < 0) continue;
+
+    opoly P;
+    P.mf = mlist[f->ofp[RED]];
+    P.sf = (f->ofp[BLACK] >= 0) ? slist[f->ofp[BLACK]] : -1;
+
+    std::vector<hedge *> loop = dcel_get_face_outer_loop(f);
+    size_t start = 0;
+    for (size_t i = 1; i < loop.size(); i++) {
+      if (vertex_cmp(loop[i]->orig, loop[start]->orig) < 0) start = i;
+    }
+    for (size_t i = 0; i < loop.size(); i++) {
+      vertex *v = loop[(start+i)%loop.size()]->orig;
+      P.x.push_back(v->x);
+      P.y.push_back(v->y);
+    }
+
+    out.push_back(P);
+  }
+}
+
+static
+bool opoly_cmp(const opoly &a, const opoly &b)
+{
+  if (a.mf != b.mf) return a.mf < b.mf;
+  if (a.sf != b.sf) return a.sf < b.sf;
+  int cmp = xy_cmp(a.x[0], a.y[0], b.x[0], b.y[0]);
+  if (cmp) return cmp < 0;
+  return a.x.size() < b.x.size();
+}
+
+// Overlay of the master and slave patches, swept by tiles.
+// The master patch box is split in a grid of ntiles tiles and each master
+// face goes to the tile holding its box center. A tile also takes the slave
+// faces whose box overlaps the boxes of its master faces, so the pieces of
+// a master face only depend on its own tile: tiles are swept concurrently
+// and their outputs are concatenated. The output is sorted by master face,
+// slave face and first vertex, so it does not depend on ntiles.
+void mesh_patch_intersect_tiles(Mesh *M, Mesh *S, E_Int *mpatch,
+  E_Int mpatchc, E_Int *spatch, E_Int spatchc, E_Int ntiles,
+  std::vector<opoly> &out)
+{
+  out.clear();
+  if (mpatchc == 0) return;
+  if (ntiles < 1) ntiles = 1;
+
+  std::vector<E_Float> mbox(4*mpatchc), sbox(4*spatchc);
+  for (E_Int i = 0; i < mpatchc; i++) face_box(M, mpatch[i], &mbox[4*i]);
+  for (E_Int i = 0; i < spatchc; i++) face_box(S, spatch[i], &sbox[4*i]);
+
+  E_Float B[4] = {E_FLOAT_MAX, -E_FLOAT_MAX, E_FLOAT_MAX, -E_FLOAT_MAX};
+  for (E_Int i = 0; i < mpatchc; i++) {
+    B[0] = std::min(B[0], mbox[4*i]);
+    B[1] = std::max(B[1], mbox[4*i+1]);
+    B[2] = std::min(B[2], mbox[4*i+2]);
+    B[3] = std::max(B[3], mbox[4*i+3]);
+  }
+
+  E_Int ntx = (E_Int)ceil(sqrt((E_Float)ntiles));
+  E_Int nty = (ntiles + ntx - 1) / ntx;
+  E_Int nt = ntx * nty;
+  E_Float dx = (B[1] - B[0]) / ntx;
+  E_Float dy = (B[3] - B[2]) / nty;
+  E_Float eps = INTERSECT_TOL * std::max(B[1] - B[0], B[3] - B[2]);
+
+  // Master faces
+  std::vector<std::vector<E_Int>> mtiles(nt);
+  std::vector<std::array<E_Float, 4>> tbox(nt,
+    {E_FLOAT_MAX, -E_FLOAT_MAX, E_FLOAT_MAX, -E_FLOAT_MAX});
+  for (E_Int i = 0; i < mpatchc; i++) {
+    const E_Float *b = &mbox[4*i];
+    E_Int ix = 0, iy = 0;
+    if (dx > 0) ix = std::min(ntx-1, (E_Int)(0.5*(b[0]+b[1]-2*B[0])/dx));
+    if (dy > 0) iy = std::min(nty-1, (E_Int)(0.5*(b[2]+b[3]-2*B[2])/dy));
+    E_Int t = ix + ntx*iy;
+    mtiles[t].push_back(mpatch[i]);
+    auto &tb = tbox[t];
+    tb[0] = std::min(tb[0], b[0]);
+    tb[1] = std::max(tb[1], b[1]);
+    tb[2] = std::min(tb[2], b[2]);
+    tb[3] = std::max(tb[3], b[3]);
+  }
+
+  std::vector<std::vector<opoly>> tout(nt);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (E_Int t = 0; t < nt; t++) {
+    if (mtiles[t].empty()) continue;
+
+    // Slave faces overlapping the master faces of the tile
+    std::vector<E_Int> slist;
+    const auto &tb = tbox[t];
+    for (E_Int i = 0; i < spatchc; i++) {
+      const E_Float *b = &sbox[4*i];
+      if (b[1] < tb[0]-eps || b[0] > tb[1]+eps) continue;
+      if (b[3] < tb[2]-eps || b[2] > tb[3]+eps) continue;
+      slist.push_back(spatch[i]);
+    }
+
+    smesh Mf(M, &mtiles[t][0], mtiles[t].size());
+    smesh Sf(S, slist.empty() ? NULL : &slist[0], slist.size());
+    dcel D(Mf, Sf);
+    D.find_intersections();
+    tile_collect(D, mtiles[t], slist, tout[t]);
+  }
+
+  for (E_Int t = 0; t < nt; t++)
+    out.insert(out.end(), tout[t].begin(), tout[t].end());
+
+  std::sort(out.begin(), out.end(), opoly_cmp);
+}
@@ -32,6 +32,8 @@ static PyMethodDef Pyxcore [] =
   {"chunk2partNGon", K_XCORE::chunk2partNGon, METH_VARARGS},
   {"chunk2partElt", K_XCORE::chunk2partElt, METH_VARARGS},
   {"exchangeFields", K_XCORE::exchangeFields, METH_VARARGS},
+  {"buildHaloNGon", K_XCORE::buildHaloNGon, METH_VARARGS},
+  {"updateHaloNGon", K_XCORE::updateHaloNGon, METH_VARARGS},
 
   {"createAdaptMesh", K_XCORE::createAdaptMesh, METH_VARARGS},
   {"adaptMeshSeq", K_XCORE::adaptMeshSeq, METH_VARARGS},
@@ -36,6 +36,9 @@ namespace K_XCORE
 
   PyObject *exchangeFields(PyObject *self, PyObject *args);
 
+  PyObject *buildHaloNGon(PyObject *self, PyObject *args);
+  PyObject *updateHaloNGon(PyObject *self, PyObject *args);
+
   PyObject *adaptMesh(PyObject *self, PyObject *args);
   
   PyObject *adaptMeshSeq(PyObject *self, PyObject *args);
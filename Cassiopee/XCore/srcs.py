@@ -20,9 +20,12 @@ cpp_srcs = ['XCore/CMP/src/recv_buffer.cpp',
             ]
 if mpi: # source that requires mpi
     cpp_srcs += [
+            'XCore/CMP/src/persistent_exchange.cpp',
+
             'XCore/SplitElement/splitter.cpp',
 
             'XCore/exchangeFields.cpp',
+            'XCore/haloNGon.cpp',
 
             'XCore/common/mem.cpp',
             'XCore/common/common.cpp',
@@ -94,12 +97,14 @@ if mpi: # source that requires mpi
             'XCore/intersectMesh/segment.cpp',
             'XCore/intersectMesh/status.cpp',
             'XCore/intersectMesh/sweep.cpp',
+            'XCore/intersectMesh/tile.cpp',
             'XCore/intersectMesh/vertex.cpp'
             ]
 else:
     cpp_srcs += [
         'XCore/SplitElement/splitter_stub.cpp',
         'XCore/exchangeFields_stub.cpp',
+        'XCore/haloNGon_stub.cpp',
         'XCore/chunk2partNGon_stub.cpp',
         'XCore/chunk2partElt_stub.cpp',
         'XCore/adaptMesh/adaptMesh_stub.cpp',
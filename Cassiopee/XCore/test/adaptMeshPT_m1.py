@@ -0,0 +1,67 @@
+# - AdaptMesh (pyTree) -
+# mpirun -np 4 python3 adaptMeshPT_m1.py
+# Leaves with load rebalancing (global numbering given) and without it
+# (no global numbering) : same leaf mesh, only spread differently
+import Converter.PyTree as C
+import Generator.PyTree as G
+import Converter.Internal as I
+import Converter.Mpi as Cmpi
+import Intersector.PyTree as XOR
+import XCore.PyTree as X
+import numpy as np
+import KCore.test as test
+LOCAL = test.getLocal()
+
+# Sensor on a band near x=0 : refinement piles up on a few ranks
+def F(x, y, z):
+    return float(x < 0.25 and abs(y-0.5) < 0.3)
+
+if Cmpi.rank == 0:
+    a = G.cartHexa((0,0,0), (0.05,0.05,0.1), (21,21,2))
+    a = C.convertArray2NGon(a)
+    a = G.close(a)
+    a = C.fillEmptyBCWith(a, 'wall', 'BCWall', dim=3)
+    I._adaptNGon32NGon4(a)
+    C.convertPyTree2File(a, LOCAL+'/case.cgns')
+Cmpi.barrier()
+
+def adapt(rebalance):
+    a, res = X.loadAndSplitNGon(LOCAL+'/case.cgns')
+    comm = res[1]
+    if rebalance: gcells = res[5]; gfaces = res[6]; gpoints = res[7]
+    else: gcells = None; gfaces = None; gpoints = None
+
+    hmax = XOR.edgeLengthExtrema(a)
+    hmin = hmax / 10.
+    own, nei = X._prepareMeshForAdaptation(a)
+    AM = X.CreateAdaptMesh(a, own, nei, comm, 0.15, 0.07, 0.30, hmin, hmax,
+        False, np.array([0., 0., 1.]), gcells, gfaces, gpoints)
+
+    for it in range(3):
+        C._initVars(a, 'centers:F', F, ['centers:CoordinateX', 'centers:CoordinateY', 'centers:CoordinateZ'])
+        f = I.getNodeFromName(a, 'F')[1]
+        REF = f.astype(I.E_NpyInt)
+        X._assignRefDataToAM(AM, REF)
+        X.AdaptMesh(AM)
+        m, BCs, own, nei = X.ExtractLeafMesh(AM, conformize=1)
+        a = C.newPyTree(['Base', I.createZoneNode('p'+str(Cmpi.rank), m)])
+
+    # Leaf centers of all ranks, sorted
+    fc, fa = G.getFaceCentersAndAreas(a)
+    cx, cy, cz = G.getCellCenters(a, fc, fa, [own], [nei])[0]
+    c = np.vstack([np.round(cx, 10), np.round(cy, 10), np.round(cz, 10)])
+    n = Cmpi.allgather(c.shape[1])
+    c = np.hstack(Cmpi.allgather(c))
+    c = c[:, np.lexsort(c[::-1])]
+    return c, n
+
+c1, n1 = adapt(False)
+c2, n2 = adapt(True)
+
+if Cmpi.rank == 0:
+    print('Leaves per proc without rebalancing:', n1)
+    print('Leaves per proc with rebalancing:', n2)
+    test.testO(c1, 1)
+    test.testO(c2, 1)
+    # rebalancing does not leave a rank more loaded than without it
+    test.testO(max(n2) <= max(n1), 2)
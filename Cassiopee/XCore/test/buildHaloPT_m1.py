@@ -0,0 +1,56 @@
+# - buildHalo (pyTree) -
+import Converter.PyTree as C
+import Generator.PyTree as G
+import Converter.Internal as Internal
+import Converter.Mpi as Cmpi
+import KCore.test as test
+import XCore.PyTree as X
+import numpy
+
+LOCAL = test.getLocal()
+
+rank = Cmpi.rank
+fileName = LOCAL+'/case.cgns'
+
+# 1 - Make the case
+if rank == 0:
+    a = G.cartNGon((0,0,0),(1,1,1),(9,7,5))
+    a = C.initVars(a, '{centers:Density} = {centers:CoordinateX} + 2*{centers:CoordinateY}')
+    Internal._adaptNGon32NGon4(a)
+    C.convertPyTree2File(a, fileName)
+Cmpi.barrier()
+
+# 2 - Load and split
+t, res = X.loadAndSplitNGon(fileName)
+
+# 3 - Two layers of ghost cells
+t, h = X.buildHalo(t, nlayers=2)
+
+# 4 - Refresh ghost values
+# owned cells hold a value of their global id and rank, ghosts a sentinel
+vals = {}
+for z in Internal.getZones(t):
+    halo = Internal.getNodeFromName1(z, '.Halo')
+    ncells = Internal.getValue(Internal.getNodeFromName1(halo, 'NCells'))
+    cg = Internal.getNodeFromName1(halo, 'CellLoc2Glob')[1].ravel()
+    d = Internal.getNodeFromName2(z, 'Density')[1].ravel()
+    d[:ncells] = cg[:ncells] + 0.25*rank
+    d[ncells:] = -1.
+    for c in range(ncells): vals[int(cg[c])] = d[c]
+X._updateHalo(t, h, ['Density'])
+
+# each ghost gets the value of its owner, found by global id
+allvals = {}
+for v in Cmpi.allgather(vals): allvals.update(v)
+ok = 1
+for z in Internal.getZones(t):
+    halo = Internal.getNodeFromName1(z, '.Halo')
+    ncells = Internal.getValue(Internal.getNodeFromName1(halo, 'NCells'))
+    cg = Internal.getNodeFromName1(halo, 'CellLoc2Glob')[1].ravel()
+    d = Internal.getNodeFromName2(z, 'Density')[1].ravel()
+    if d.size == ncells: ok = 0 # no ghost cell
+    for c in range(ncells, d.size):
+        if d[c] != allvals[int(cg[c])]: ok = 0
+ok = Cmpi.allreduce(ok, op=Cmpi.MIN)
+if rank == 0: test.testO(ok, 2)
+if rank == 0: test.testT(t, 1)
@@ -0,0 +1,47 @@
+# - intersectSurf (pyTree) -
+# overlay swept in one tile and in several tiles (threaded)
+import Converter.PyTree as C
+import Generator.PyTree as G
+import Transform.PyTree as T
+import Converter.Internal as I
+import Post.PyTree as P
+import XCore.PyTree as X
+import numpy as np
+import KCore.test as test
+
+# master : patch on the z=0 face of a box
+m = G.cartNGon((0,0,0), (0.1,0.1,0.1), (11,11,3))
+ind = []
+P.exteriorFaces(m, indices=ind)
+ind = ind[0].ravel()
+f = C.node2Center(T.subzone(m, ind, type='faces'))
+zc = I.getNodeFromName2(f, 'CoordinateZ')[1].ravel()
+m = C.addBC2Zone(m, 'patch', 'BCWall', faceList=ind[abs(zc) < 1.e-12])
+
+# slave : rotated box, its z=0 face tagged
+s = G.cartNGon((0.3,0.3,0), (0.06,0.06,0.1), (9,9,3))
+s = T.rotate(s, (0.54,0.54,0), (0,0,1), 17.)
+C._initVars(s, 'tag', 0.)
+z = I.getNodeFromName2(s, 'CoordinateZ')[1].ravel()
+tag = I.getNodeFromName2(s, 'tag')
+tag[1] = (abs(z) < 1.e-12).astype(np.float64)
+
+def area(r):
+    (parents, indPG, x, y) = r
+    a = np.zeros(indPG.size-1)
+    for i in range(indPG.size-1):
+        xs = x[indPG[i]:indPG[i+1]]; ys = y[indPG[i]:indPG[i+1]]
+        a[i] = 0.5*np.sum(xs*np.roll(ys, -1)-np.roll(xs, -1)*ys)
+    return a
+
+r1 = X.intersectSurf(m, s, 'patch', ntiles=1)
+r4 = X.intersectSurf(m, s, 'patch', ntiles=4)
+
+# the overlay faces pave the master patch
+test.testO(abs(np.sum(area(r1))-1.) < 1.e-12, 1)
+test.testO(abs(np.sum(area(r4))-1.) < 1.e-12, 1)
+
+# same overlay whatever the tiling
+for i in range(4):
+    test.testO(r1[i], 2+i)
+    test.testO(r4[i], 2+i)